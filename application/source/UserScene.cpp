@@ -6,40 +6,57 @@
 #include <GLFW/glfw3.h>
 #include <spdlog/spdlog.h>
 
+#include <cmath>
+
 #include <Crenderr/ImGui/ImGuiContext.hpp>
 
 UserScene::UserScene(std::unique_ptr<Window>& windowRef)
     : Scene{ windowRef },
       m_RendererContext{ std::make_unique<Renderer::Renderer3DInstance>() },
-      m_Camera{ {
-        .Position = { 0.0f, 0.0f, 2.0f, },
-        .Ratio = Scene::GetWindow()->GetAspectRatio(),
-      } } {}
+      m_RenderSystem{ Scene::GetRegistry() } {}
 
 bool UserScene::OnInit()
 {
     if (!m_RendererContext->OnInitialization()) return false;
 
-    m_Model = LoadOBJModel("assets/models/spaceship.obj", FaceType::Triangle);
-    if (!m_Model->OnInitialize()) return false;
+    RenderMesh spaceship{};
 
-    m_DiffuseMap = Renderer::AllocateResource<Renderer::Texture2D>({
-        .Filepath = "assets/textures/spaceship/diffuse_map.jpg",
+    spaceship.VertexArrayPtr = AcquireOBJModel("assets/models/spaceship.obj", OBJLoaderProps{
+        .Face   = FaceType::Triangle,
+        .Format = VertexFormat::Packed,
     });
-    if (!m_DiffuseMap->OnInitialize()) return false;
-    m_DiffuseMap->Unbind();
+    if (!spaceship.VertexArrayPtr) return false;
 
-    m_SpecularMap = Renderer::AllocateResource<Renderer::Texture2D>({
+    // Decoded on the thread pool and uploaded over the next frames, the model is drawn white until then.
+    auto& textures{ m_RendererContext->GetTextures() };
+
+    spaceship.DiffuseMap = textures.Load({
+        .Filepath = "assets/textures/spaceship/diffuse_map.jpg",
+    });
+    spaceship.SpecularMap = textures.Load({
         .Filepath = "assets/textures/spaceship/specular_map.jpg",
     });
-    if (!m_SpecularMap->OnInitialize()) return false;
-    m_SpecularMap->Unbind();
-
-    m_EmissionMap = Renderer::AllocateResource<Renderer::Texture2D>({
+    spaceship.EmissionMap = textures.Load({
         .Filepath = "assets/textures/spaceship/emissive_map.jpg",
     });
-    if (!m_EmissionMap->OnInitialize()) return false;
-    m_EmissionMap->Unbind();
+    if (!spaceship.DiffuseMap || !spaceship.SpecularMap || !spaceship.EmissionMap) return false;
+
+    auto& registry{ Scene::GetRegistry() };
+
+    const auto model{ Scene::CreateEntity({ .Scale = glm::vec3(0.1f), }) };
+    registry.emplace<MeshRendererComponent>(model, m_RenderSystem.AddMesh(spaceship));
+    registry.emplace<MaterialComponent>(model);
+
+    m_CameraEntity = Scene::CreateEntity();
+    registry.emplace<CameraComponent>(m_CameraEntity, Renderer::PerspectiveCamera{ {
+        .Position = { 0.0f, 0.0f, 2.0f, },
+        .Ratio = Scene::GetWindow()->GetAspectRatio(),
+    } });
+
+    m_LightEntity = Scene::CreateEntity();
+    registry.emplace<LightComponent>(m_LightEntity);
+
+    UserScene::BuildOrbits();
 
     return true;
 }
@@ -64,6 +81,8 @@ void UserScene::OnUpdate(const Timestamp& timestamp)
                 glfwGetCursorPos(window, &xpos, &ypos);
                 m_PrevFrameCursorPos = { xpos, ypos, };
                 m_CurrFrameCursorPos = { xpos, ypos, };
+
+                UserScene::PickEntity(m_CurrFrameCursorPos);
             }
 
             if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_RELEASE)
@@ -90,23 +109,44 @@ void UserScene::OnUpdate(const Timestamp& timestamp)
         m_CurrFrameCursorPos = { xpos, ypos };
     }
 
-    m_Camera.OnUpdate(Scene::GetWindow()->GetAspectRatio());
+    auto& registry{ Scene::GetRegistry() };
+    auto& camera{ registry.get<CameraComponent>(m_CameraEntity).Camera };
+
+    camera.OnUpdate(Scene::GetWindow()->GetAspectRatio());
 
     glm::vec3 newPosition{};
     newPosition.x = m_CameraArmLength * sin(timestamp.TotalTime);
     newPosition.z = m_CameraArmLength * cos(timestamp.TotalTime);
 
-    m_Camera
+    camera
         .SetPosition(newPosition)
         .SetLookDirection(glm::vec3(0.0f));
+
+    // The light follows the camera.
+    registry.get<TransformComponent>(m_LightEntity).Translation.Position = newPosition;
+
+    m_Orbits.SetLocal(m_OrbitPivot, {
+        .Position = { 0.0f, 0.6f, 0.0f, },
+        .Rotation = { 0.0f, timestamp.TotalTime * 30.0f, 0.0f, },
+    });
+    for (std::size_t i = 0u; i < m_OrbitMoons.size(); ++i)
+    {
+        auto local{ m_Orbits.GetLocal(m_OrbitMoons[i]) };
+        local.Rotation.y = timestamp.TotalTime * (60.0f + 10.0f * static_cast<float>(i));
+        m_Orbits.SetLocal(m_OrbitMoons[i], local);
+    }
+    m_Orbits.Update();
 }
 
 void UserScene::OnRender()
 {
-    m_RendererContext->BeginScene(&m_Camera);
-    m_RendererContext->SetPointLight(m_Camera.GetPosition(), glm::vec3(1.0f));
+    if (!m_RenderSystem.BeginScene(*m_RendererContext)) return;
 
-    m_RendererContext->DrawArrays(m_Model, m_DiffuseMap, m_SpecularMap, m_EmissionMap);
+    m_RenderSystem.Submit(*m_RendererContext);
+
+    // The pivot and arms are only transforms, each moon's subtree is drawn and the renderer merges them back into one batch.
+    for (const auto moon : m_OrbitMoons)
+        m_RendererContext->DrawCubes(m_Orbits.GetWorldMatrices(moon));
 
     m_RendererContext->EndScene();
 }
@@ -115,5 +155,137 @@ void UserScene::OnImGuiRender(ImGuiIO& io, const Timestamp& timestamp)
 {
     ImGui::Begin("Scene parameters");
     ImGui::SliderFloat("Camera Arm Length", &m_CameraArmLength, 0.1f, 3.0f);
+    if (ImGui::SliderInt("Cube Count", &m_CubeCount, 0, 100000))
+        UserScene::BuildCubeField();
+
+    bool isCulling{ m_RendererContext->IsFrustumCullingEnabled() };
+    if (ImGui::Checkbox("Frustum Culling", &isCulling))
+        m_RendererContext->SetFrustumCulling(isCulling);
+
+    // Switched in between frames, the textures are resolved again from the next one on.
+    bool isBindless{ m_RendererContext->IsBindlessTexturesEnabled() };
+    if (ImGui::Checkbox("Bindless Textures", &isBindless) && !m_RendererContext->SetBindlessTextures(isBindless))
+        spdlog::warn("Bindless textures are not supported by this context!");
+
+    auto& textures{ m_RendererContext->GetTextures() };
+    int uploadBudget{ static_cast<int>(textures.GetUploadBudget() / 1024u) };
+    if (ImGui::SliderInt("Texture Upload Budget (KB)", &uploadBudget, 64, 4096))
+        textures.SetUploadBudget(static_cast<std::size_t>(uploadBudget) * 1024u);
+
+    int residentBudget{ static_cast<int>(textures.GetResidentBudget() / (1024u * 1024u)) };
+    if (ImGui::SliderInt("Texture Resident Budget (MB)", &residentBudget, 4, 1024))
+        textures.SetResidentBudget(static_cast<std::size_t>(residentBudget) * 1024u * 1024u);
+    ImGui::End();
+
+    const auto& statistics{ m_RendererContext->GetStatistics() };
+
+    ImGui::Begin("Renderer statistics");
+    ImGui::Text("Packets: %zu", statistics.Packets);
+    ImGui::Text("Draw calls: %zu", statistics.DrawCalls);
+    ImGui::Text("Instances: %zu", statistics.Instances);
+    ImGui::Text("Batches: %zu (%.2f packets per draw)", m_RendererContext->GetBatchCount(), m_RendererContext->GetBatchEfficiency());
+    ImGui::Text("State changes: %zu", statistics.StateChanges);
+    ImGui::Text("Primitives: %zu", statistics.Primitives);
+    ImGui::Text("Sort time: %.3f ms", statistics.SortTime);
+    ImGui::Text("State calls avoided: %zu / %zu", statistics.StateAvoided, statistics.StateCalls);
+    ImGui::Text("Visible instances: %zu (%zu culled in %.3f ms)", statistics.VisibleInstances, statistics.CulledInstances, statistics.CullTime);
+
+    const auto& streaming{ m_RendererContext->GetTextures().GetStatistics() };
+    ImGui::Text("Textures: %zu decoding, %zu uploading, %zu done", streaming.Decoding, streaming.Uploading, streaming.Completed);
+    ImGui::Text("Texture upload: %zu KB in %.3f ms", streaming.UploadedBytes / 1024u, streaming.UploadTime);
+    ImGui::Text("Texture memory: %.1f / %zu MB, %zu levels evicted", streaming.ResidentBytes / (1024.0 * 1024.0), textures.GetResidentBudget() / (1024u * 1024u), streaming.Evictions);
+
+    const auto& textureTable{ m_RendererContext->GetTextureTable().GetStatistics() };
+    ImGui::Text("Texture arrays: %zu holding %zu textures, %.1f MB, %zu copies", textureTable.Arrays, textureTable.Textures, textureTable.ArrayBytes / (1024.0 * 1024.0), textureTable.Copies);
+
+    auto& resourceCache{ Renderer::ResourceCache::Get() };
+    resourceCache.Prune();
+
+    const auto& resources{ resourceCache.GetStatistics() };
+    ImGui::Text("Shared resources: %zu, %.1f MB, %zu hits / %zu misses (%.1f MB reused)", resources.Resources, resources.ResidentBytes / (1024.0 * 1024.0), resources.Hits, resources.Misses, resources.ReusedBytes / (1024.0 * 1024.0));
+    if (Scene::GetRegistry().valid(m_PickedEntity))
+        ImGui::Text("Picked: entity %u at %.2f", static_cast<std::uint32_t>(entt::to_integral(m_PickedEntity)), m_PickedDistance);
     ImGui::End();
 }
+
+void UserScene::BuildCubeField()
+{
+    auto& registry{ Scene::GetRegistry() };
+
+    registry.destroy(m_CubeEntities.begin(), m_CubeEntities.end());
+    m_CubeEntities.resize(static_cast<std::size_t>(m_CubeCount));
+    registry.create(m_CubeEntities.begin(), m_CubeEntities.end());
+
+    // A flat square grid below the model.
+    const auto side{ static_cast<int>(std::ceil(std::sqrt(static_cast<float>(m_CubeCount)))) };
+    constexpr float c_Spacing{ 0.05f };
+
+    for (int i = 0; i < m_CubeCount; ++i)
+    {
+        const auto x{ static_cast<float>(i % side - side / 2) };
+        const auto z{ static_cast<float>(i / side - side / 2) };
+
+        const auto entity{ m_CubeEntities[i] };
+        registry.emplace<TransformComponent>(entity, Renderer::Translation{
+            .Scale    = glm::vec3(c_Spacing * 0.5f),
+            .Position = { x * c_Spacing, -0.5f, z * c_Spacing, },
+        });
+        registry.emplace<MeshRendererComponent>(entity, RenderSystem::c_CubeMesh);
+        registry.emplace<MaterialComponent>(entity, Renderer::MaterialRegistry::c_DefaultMaterial,
+            glm::vec3{ 0.5f + 0.5f * std::sin(x * 0.1f), 0.5f + 0.5f * std::cos(z * 0.1f), 1.0f, });
+    }
+}
+
+void UserScene::PickEntity(const glm::vec2& cursor)
+{
+    auto& registry{ Scene::GetRegistry() };
+    const auto& camera{ registry.get<CameraComponent>(m_CameraEntity).Camera };
+
+    const auto size{ glm::vec2{ Scene::GetWindow()->GetSize() } };
+    const glm::vec2 point{ 2.0f * cursor.x / size.x - 1.0f, 1.0f - 2.0f * cursor.y / size.y, };
+
+    // Only the color is written, without patch() the draw order and the bounds are left alone.
+    if (auto* material{ registry.valid(m_PickedEntity) ? registry.try_get<MaterialComponent>(m_PickedEntity) : nullptr })
+        material->Color = m_PickedColor;
+
+    m_PickedEntity = m_RenderSystem.Pick(camera.GetRay(point), &m_PickedDistance);
+    if (m_PickedEntity == entt::null) return;
+
+    auto& material{ registry.get<MaterialComponent>(m_PickedEntity) };
+    m_PickedColor = material.Color;
+    material.Color = { 1.0f, 0.2f, 0.2f, };
+}
+
+void UserScene::BuildOrbits()
+{
+    m_Orbits.Clear();
+    m_OrbitMoons.clear();
+
+    constexpr std::size_t c_MoonCount{ 8u };
+    constexpr std::size_t c_SatelliteCount{ 4u };
+
+    m_OrbitPivot = m_Orbits.AddNode({});
+    for (std::size_t i = 0u; i < c_MoonCount; ++i)
+    {
+        const auto angle{ 360.0f * static_cast<float>(i) / static_cast<float>(c_MoonCount) };
+
+        // The arm only places the moon, the moon's own rotation spins its satellites.
+        const auto arm{ m_Orbits.AddNode({ .Rotation = { 0.0f, angle, 0.0f, }, }, m_OrbitPivot) };
+        const auto moon{ m_Orbits.AddNode({
+            .Scale    = glm::vec3(0.05f),
+            .Position = { 0.8f, 0.0f, 0.0f, },
+        }, arm) };
+        m_OrbitMoons.push_back(moon);
+
+        for (std::size_t j = 0u; j < c_SatelliteCount; ++j)
+        {
+            const auto satelliteAngle{ glm::radians(360.0f * static_cast<float>(j) / static_cast<float>(c_SatelliteCount)) };
+            m_Orbits.AddNode({
+                .Scale    = glm::vec3(0.4f),
+                .Position = { 3.0f * std::cos(satelliteAngle), 0.0f, 3.0f * std::sin(satelliteAngle), },
+            }, moon);
+        }
+    }
+
+    m_Orbits.Update();
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <Crenderr/Application/Scene.hpp>
+#include <Crenderr/Application/RenderSystem.hpp>
 #include <Crenderr/Renderer/Renderer.hpp>
 
+#include <vector>
+
 class UserScene : public Scene
 {
 public:
@@ -15,16 +18,34 @@ public:
     virtual void OnRender() override;
     virtual void OnImGuiRender(ImGuiIO& io, const Timestamp& timestamp) override;
 
+private:
+    void BuildCubeField();
+    void BuildOrbits();
+
+    // Tints whatever is under the cursor, given in window coordinates.
+    void PickEntity(const glm::vec2& cursor);
+
 public:
     std::unique_ptr<Renderer::Renderer3DInstance> m_RendererContext;
 
-    Renderer::PerspectiveCamera m_Camera{};
+    RenderSystem m_RenderSystem;
+
+    entt::entity m_CameraEntity{ entt::null };
+    entt::entity m_LightEntity{ entt::null };
     float m_CameraArmLength{ 2.0f };
 
-    std::shared_ptr<Renderer::VertexArray> m_Model{};
-    std::shared_ptr<Renderer::Texture2D> m_DiffuseMap{};
-    std::shared_ptr<Renderer::Texture2D> m_SpecularMap{};
-    std::shared_ptr<Renderer::Texture2D> m_EmissionMap{};
+    // Cubes below the model, recreated when the count changes.
+    int m_CubeCount{ 0 };
+    std::vector<entt::entity> m_CubeEntities{};
+
+    // Cubes orbiting above the model, only the pivot is animated and the rest follows through the hierarchy.
+    Renderer::TransformHierarchy m_Orbits{};
+    Renderer::NodeHandle m_OrbitPivot{ Renderer::TransformHierarchy::c_NoParent };
+    std::vector<Renderer::NodeHandle> m_OrbitMoons{};
+
+    entt::entity m_PickedEntity{ entt::null };
+    glm::vec3 m_PickedColor{};
+    float m_PickedDistance{};
 
     bool m_IsMouseCaptured{ false };
     bool m_IsFirstCaptureFrame{ false };
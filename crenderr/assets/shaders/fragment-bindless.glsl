@@ -0,0 +1,80 @@
+#version 460
+#extension GL_ARB_bindless_texture : require
+
+out vec4 FragColor;
+
+in vec3 vertexPosition;
+in vec3 vertexNormal;
+in vec2 vertexTexcoord;
+in vec4 vertexColor;
+flat in uvec4 vertexMaterial;
+
+// Per-frame data, has to match FrameUniformData (Renderer/RendererElements.hpp).
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewProjectionMatrix;
+    vec4 u_ViewPosition;
+    vec4 u_LightPosition;
+    vec4 u_LightColor;
+};
+
+// Has to match Renderer::Material (Renderer/MaterialRegistry.hpp).
+struct Material
+{
+    vec3 Ambient;
+    vec3 Diffuse;
+    vec3 Specular;
+    float Shininess;
+};
+
+layout (std430, binding = 0) readonly buffer MaterialTable
+{
+    Material u_Materials[];
+};
+
+// Texture handles, the instance picks an entry per slot (Renderer/TextureTable.hpp).
+layout (std430, binding = 2) readonly buffer TextureTable
+{
+    uvec2 u_TextureHandles[];
+};
+
+const uint c_EmptySlot = 0xFFFFFFFFu;
+
+// An empty slot reads black, like an unbound texture unit.
+vec4 SampleTexture(uint index)
+{
+    return index == c_EmptySlot ? vec4(0.0, 0.0, 0.0, 1.0) : texture(sampler2D(u_TextureHandles[index]), vertexTexcoord);
+}
+
+void main()
+{
+    Material material = u_Materials[vertexMaterial.x];
+
+    vec3 diffuseColor  = vec3(SampleTexture(vertexMaterial.y));
+    vec3 specularColor = vec3(SampleTexture(vertexMaterial.z));
+
+    // #1. Ambient lighting.
+    vec3 ambient = u_LightColor.rgb * material.Ambient * diffuseColor;
+
+    // #2. Diffuse lighting.
+    vec3 norm = normalize(vertexNormal);
+    vec3 lightDir = normalize(u_LightPosition.xyz - vertexPosition);
+    float diffuseStrength = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = u_LightColor.rgb * diffuseStrength * material.Diffuse * diffuseColor;
+
+    // #3. Specular lighting.
+    float specularStrength = 0.5;
+    vec3 viewDir = normalize(u_ViewPosition.xyz - vertexPosition);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.Shininess);
+    vec3 specular = u_LightColor.rgb * spec * material.Specular * specularColor;
+
+    // #4. Emission.
+    vec3 emission = vec3(SampleTexture(vertexMaterial.w));
+
+    // #5. Everything combined.
+    vec3 result = (ambient + diffuse + specular + emission) * vertexColor.rgb;
+    FragColor = vec4(result, vertexColor.a);
+}
@@ -5,15 +5,21 @@ out vec4 FragColor;
 in vec3 vertexPosition;
 in vec3 vertexNormal;
 in vec2 vertexTexcoord;
+in vec4 vertexColor;
+flat in uvec4 vertexMaterial;
 
-struct Light
+// Per-frame data, has to match FrameUniformData (Renderer/RendererElements.hpp).
+layout (std140, binding = 0) uniform FrameData
 {
-    vec3 Color;
-    vec3 Position;
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewProjectionMatrix;
+    vec4 u_ViewPosition;
+    vec4 u_LightPosition;
+    vec4 u_LightColor;
 };
 
-uniform Light u_Light;
-
+// Has to match Renderer::Material (Renderer/MaterialRegistry.hpp).
 struct Material
 {
     vec3 Ambient;
@@ -22,36 +28,51 @@ struct Material
     float Shininess;
 };
 
-uniform Material u_Material;
+layout (std430, binding = 0) readonly buffer MaterialTable
+{
+    Material u_Materials[];
+};
+
+// Each unit holds the texture array of its slot, the instance picks the layer (Renderer/TextureTable.hpp).
+uniform sampler2DArray u_DiffuseTexture;
+uniform sampler2DArray u_SpecularTexture;
+uniform sampler2DArray u_EmissionTexture;
 
-uniform sampler2D u_DiffuseTexture;
-uniform sampler2D u_SpecularTexture;
-uniform sampler2D u_EmissionTexture;
+const uint c_EmptySlot = 0xFFFFFFFFu;
 
-uniform vec3 u_ViewPosition;
+// An empty slot reads black, like an unbound texture unit.
+vec4 SampleTexture(sampler2DArray textures, uint layer)
+{
+    return layer == c_EmptySlot ? vec4(0.0, 0.0, 0.0, 1.0) : texture(textures, vec3(vertexTexcoord, float(layer)));
+}
 
 void main()
 {
+    Material material = u_Materials[vertexMaterial.x];
+
+    vec3 diffuseColor  = vec3(SampleTexture(u_DiffuseTexture,  vertexMaterial.y));
+    vec3 specularColor = vec3(SampleTexture(u_SpecularTexture, vertexMaterial.z));
+
     // #1. Ambient lighting.
-    vec3 ambient = u_Light.Color * u_Material.Ambient * vec3(texture(u_DiffuseTexture, vertexTexcoord));
+    vec3 ambient = u_LightColor.rgb * material.Ambient * diffuseColor;
 
     // #2. Diffuse lighting.
     vec3 norm = normalize(vertexNormal);
-    vec3 lightDir = normalize(u_Light.Position - vertexPosition);
+    vec3 lightDir = normalize(u_LightPosition.xyz - vertexPosition);
     float diffuseStrength = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = u_Light.Color * diffuseStrength * u_Material.Diffuse * vec3(texture(u_DiffuseTexture, vertexTexcoord));
+    vec3 diffuse = u_LightColor.rgb * diffuseStrength * material.Diffuse * diffuseColor;
 
     // #3. Specular lighting.
     float specularStrength = 0.5;
-    vec3 viewDir = normalize(u_ViewPosition - vertexPosition);
+    vec3 viewDir = normalize(u_ViewPosition.xyz - vertexPosition);
     vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), u_Material.Shininess);
-    vec3 specular = u_Light.Color * spec * u_Material.Specular * vec3(texture(u_SpecularTexture, vertexTexcoord));
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.Shininess);
+    vec3 specular = u_LightColor.rgb * spec * material.Specular * specularColor;
 
     // #4. Emission.
-    vec3 emission = vec3(texture(u_EmissionTexture, vertexTexcoord));
+    vec3 emission = vec3(SampleTexture(u_EmissionTexture, vertexMaterial.w));
 
     // #5. Everything combined.
-    vec3 result = ambient + diffuse + specular + emission;
-    FragColor = vec4(result, 1.0);
+    vec3 result = (ambient + diffuse + specular + emission) * vertexColor.rgb;
+    FragColor = vec4(result, vertexColor.a);
 }
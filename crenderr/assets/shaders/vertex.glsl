@@ -7,16 +7,42 @@ layout (location = 2) in vec2 a_Texcoord;
 out vec3 vertexPosition;
 out vec3 vertexNormal;
 out vec2 vertexTexcoord;
+out vec4 vertexColor;
+flat out uvec4 vertexMaterial;
 
-uniform mat4 u_ProjectionMatrix;
-uniform mat4 u_ModelMatrix;
-uniform mat4 u_ViewMatrix;
+// Per-frame data, has to match FrameUniformData (Renderer/RendererElements.hpp).
+layout (std140, binding = 0) uniform FrameData
+{
+    mat4 u_ViewMatrix;
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewProjectionMatrix;
+    vec4 u_ViewPosition;
+    vec4 u_LightPosition;
+    vec4 u_LightColor;
+};
+
+// Has to match Renderer::InstanceData (Renderer/RendererElements.hpp).
+struct Instance
+{
+    mat4 ModelMatrix;
+    vec4 Color;
+    uvec4 Material; // material, then the diffuse, specular and emission texture indices
+};
+
+layout (std430, binding = 1) readonly buffer InstanceTable
+{
+    Instance u_Instances[];
+};
 
 void main()
 {
-    gl_Position = u_ProjectionMatrix * u_ViewMatrix * u_ModelMatrix * vec4(a_Position, 1.0);
+    Instance instance = u_Instances[gl_BaseInstance + gl_InstanceID];
+
+    gl_Position = u_ViewProjectionMatrix * instance.ModelMatrix * vec4(a_Position, 1.0);
 
-    vertexPosition = vec3(u_ModelMatrix * vec4(a_Position, 1.0));
-    vertexNormal   = mat3(transpose(inverse(u_ModelMatrix))) * a_Normal;
+    vertexPosition = vec3(instance.ModelMatrix * vec4(a_Position, 1.0));
+    vertexNormal   = mat3(transpose(inverse(instance.ModelMatrix))) * a_Normal;
     vertexTexcoord = a_Texcoord;
+    vertexColor    = instance.Color;
+    vertexMaterial = instance.Material;
 }
@@ -8,10 +8,14 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
 
 Application::Application(const ApplicationProps& props) noexcept
     : m_Window      { std::make_unique<Window>(props.Name, props.WindowSize) },
-      m_ImGuiContext{ std::make_unique<ImGuiBuildContext>()                  }
+      m_ImGuiContext{ std::make_unique<ImGuiBuildContext>()                  },
+      m_StartTime   { std::chrono::steady_clock::now()                       }
 {
     m_Window->AddKeybinds({
         { WindowAction::Maximize, { GLFW_KEY_F10, }, },
@@ -57,6 +61,14 @@ void Application::Run()
         m_ImGuiContext->PreRender();
         OnImGuiRender(m_ImGuiContext->GetIO());
         m_ImGuiContext->PostRender();
+
+        // From the construction on, so the window, the context and the scene's OnInit() are all in.
+        if (!m_IsFirstFrameDone)
+        {
+            m_IsFirstFrameDone = true;
+            spdlog::info("[Application]: First frame after {:.1f} ms",
+                std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - m_StartTime }.count());
+        }
     }
 }
 
@@ -5,6 +5,8 @@
 
 #include "Scene.hpp"
 
+#include <chrono>
+
 struct ApplicationProps
 {
     std::string_view Name{};
@@ -35,4 +37,8 @@ private:
     std::unique_ptr<Window> m_Window;
     std::unique_ptr<ImGuiBuildContext> m_ImGuiContext;
     Timestamp m_Timestamp{};
+
+    // Time to first frame, logged once.
+    std::chrono::steady_clock::time_point m_StartTime{};
+    bool m_IsFirstFrameDone{ false };
 };
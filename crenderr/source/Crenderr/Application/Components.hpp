@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Renderer/RendererElements.hpp"
+#include "Renderer/MaterialRegistry.hpp"
+#include "Renderer/Camera/PerspectiveCamera.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+// Index into the RenderSystem's mesh table, the components only hold plain values.
+using MeshHandle = std::uint32_t;
+
+struct TransformComponent
+{
+    Renderer::Translation Translation{};
+};
+
+struct MeshRendererComponent
+{
+    MeshHandle Mesh{ 0u };
+};
+
+struct MaterialComponent
+{
+    Renderer::MaterialIndex Material{ Renderer::MaterialRegistry::c_DefaultMaterial };
+    glm::vec3 Color{ 1.0f };
+};
+
+// A point light at the entity's position.
+struct LightComponent
+{
+    glm::vec3 Color{ 1.0f };
+};
+
+struct CameraComponent
+{
+    Renderer::PerspectiveCamera Camera{};
+    bool IsPrimary{ true };
+};
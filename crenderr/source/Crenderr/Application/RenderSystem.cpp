@@ -0,0 +1,271 @@
+#include "RenderSystem.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace Internal
+{
+    // Every system touching these three asks for the same group, so they stay packed together.
+    static auto GetRenderables(entt::registry& registry)
+    {
+        return registry.group<MeshRendererComponent, MaterialComponent, TransformComponent>();
+    }
+
+    static bool HasSameState(const MeshRendererComponent& lhsMesh, const MaterialComponent& lhsMaterial, const MeshRendererComponent& rhsMesh, const MaterialComponent& rhsMaterial) noexcept
+    {
+        return lhsMesh.Mesh == rhsMesh.Mesh && lhsMaterial.Material == rhsMaterial.Material;
+    }
+}
+
+RenderSystem::RenderSystem(entt::registry& registry)
+    : m_Registry{ registry }
+{
+    m_Meshes.emplace_back(); // c_CubeMesh
+
+    // Edits done through registry.patch() or replace() are seen here, the order is restored lazily.
+    // Removing one swaps the last renderable into its slot, so that counts as well.
+    m_Registry.on_construct<MeshRendererComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+    m_Registry.on_update<MeshRendererComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+    m_Registry.on_destroy<MeshRendererComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+    m_Registry.on_construct<MaterialComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+    m_Registry.on_update<MaterialComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+    m_Registry.on_destroy<MaterialComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+    m_Registry.on_construct<TransformComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+    m_Registry.on_destroy<TransformComponent>().connect<&RenderSystem::OnRenderableChanged>(*this);
+
+    // Moving one only refits its box, a transform written without patch() keeps the old one.
+    m_Registry.on_update<TransformComponent>().connect<&RenderSystem::OnTransformChanged>(*this);
+
+    Internal::GetRenderables(m_Registry);
+}
+
+RenderSystem::~RenderSystem()
+{
+    m_Registry.on_construct<MeshRendererComponent>().disconnect(*this);
+    m_Registry.on_update<MeshRendererComponent>().disconnect(*this);
+    m_Registry.on_destroy<MeshRendererComponent>().disconnect(*this);
+    m_Registry.on_construct<MaterialComponent>().disconnect(*this);
+    m_Registry.on_update<MaterialComponent>().disconnect(*this);
+    m_Registry.on_destroy<MaterialComponent>().disconnect(*this);
+    m_Registry.on_construct<TransformComponent>().disconnect(*this);
+    m_Registry.on_destroy<TransformComponent>().disconnect(*this);
+    m_Registry.on_update<TransformComponent>().disconnect(*this);
+}
+
+MeshHandle RenderSystem::AddMesh(const RenderMesh& mesh)
+{
+    if (!mesh.VertexArrayPtr)
+    {
+        spdlog::error("[RenderSystem]: Mesh without a vertex array, falling back to the cube!");
+        return c_CubeMesh;
+    }
+
+    m_Meshes.push_back(mesh);
+    return static_cast<MeshHandle>(m_Meshes.size() - 1u);
+}
+
+bool RenderSystem::BeginScene(Renderer::Renderer3DInstance& renderer)
+{
+    Renderer::PerspectiveCamera* camera{ nullptr };
+    for (auto [entity, component] : m_Registry.view<CameraComponent>().each())
+    {
+        if (!component.IsPrimary) continue;
+
+        camera = &component.Camera;
+        break;
+    }
+
+    if (!camera) return false;
+    renderer.BeginScene(camera);
+
+    m_ViewFrustum = camera->GetFrustum();
+
+    // The renderer shades with a single point light.
+    for (auto [entity, transform, light] : m_Registry.view<TransformComponent, LightComponent>().each())
+    {
+        renderer.SetPointLight(transform.Translation.Position, light.Color);
+        break;
+    }
+
+    return true;
+}
+
+void RenderSystem::Prepare(const Renderer::MeshBounds& cubeBounds)
+{
+    RenderSystem::SortRenderables();
+    RenderSystem::UpdateBounds(cubeBounds);
+}
+
+void RenderSystem::Submit(Renderer::Renderer3DInstance& renderer)
+{
+    RenderSystem::Prepare(renderer.GetCubeBounds());
+
+    auto renderables{ Internal::GetRenderables(m_Registry) };
+    if (renderables.empty()) return;
+
+    const MeshRendererComponent* runMesh{ nullptr };
+    const MaterialComponent* runMaterial{ nullptr };
+
+    const auto gather{ [&](const MeshRendererComponent& mesh, const MaterialComponent& material, const TransformComponent& transform) {
+        if (runMesh && !Internal::HasSameState(*runMesh, *runMaterial, mesh, material))
+            RenderSystem::FlushRun(renderer, *runMesh, *runMaterial);
+
+        runMesh     = &mesh;
+        runMaterial = &material;
+
+        m_RunTranslations.Push(transform.Translation);
+        m_RunColors.push_back(material.Color);
+    } };
+
+    if (renderer.IsFrustumCullingEnabled())
+    {
+        // Whole regions of the scene go at once, the renderer's own per instance test only sees what is left.
+        m_VisibleObjects.clear();
+        m_Bounds.QueryFrustum(m_ViewFrustum, m_VisibleObjects);
+        for (auto& object : m_VisibleObjects) object = m_TreeObjects[object];
+
+        // Never in the tree, so they cannot have been found twice.
+        m_VisibleObjects.insert(m_VisibleObjects.end(), m_UnboundedObjects.begin(), m_UnboundedObjects.end());
+
+        // Back in group order, so the runs of equal state stay together.
+        std::sort(m_VisibleObjects.begin(), m_VisibleObjects.end());
+
+        for (const auto object : m_VisibleObjects)
+        {
+            auto [mesh, material, transform] = renderables.get<MeshRendererComponent, MaterialComponent, TransformComponent>(m_ObjectEntities[object]);
+            gather(mesh, material, transform);
+        }
+    }
+    else
+    {
+        for (auto [entity, mesh, material, transform] : renderables.each())
+            gather(mesh, material, transform);
+    }
+
+    if (runMesh) RenderSystem::FlushRun(renderer, *runMesh, *runMaterial);
+}
+
+entt::entity RenderSystem::Pick(const Renderer::Ray& ray, float* distance) const
+{
+    if (!m_IsBoundsValid) return entt::null;
+
+    const auto hit{ m_Bounds.Raycast(ray) };
+    if (!hit.IsValid()) return entt::null;
+
+    const auto entity{ m_ObjectEntities[m_TreeObjects[hit.Object]] };
+    if (!m_Registry.valid(entity)) return entt::null;
+
+    if (distance) *distance = hit.Distance;
+    return entity;
+}
+
+void RenderSystem::SortRenderables()
+{
+    if (m_IsSorted) return;
+
+    // Insertion sort, after a few edits the order is almost right already.
+    Internal::GetRenderables(m_Registry).sort<MeshRendererComponent, MaterialComponent>([](const auto& lhs, const auto& rhs) {
+        const auto& [lhsMesh, lhsMaterial] = lhs;
+        const auto& [rhsMesh, rhsMaterial] = rhs;
+
+        return lhsMesh.Mesh != rhsMesh.Mesh ? lhsMesh.Mesh < rhsMesh.Mesh : lhsMaterial.Material < rhsMaterial.Material;
+    }, entt::insertion_sort{});
+
+    m_IsSorted = true;
+}
+
+void RenderSystem::UpdateBounds(const Renderer::MeshBounds& cubeBounds)
+{
+    auto renderables{ Internal::GetRenderables(m_Registry) };
+
+    if (m_IsBoundsValid)
+    {
+        for (const auto entity : m_MovedEntities)
+        {
+            if (!m_Registry.valid(entity) || !renderables.contains(entity)) continue;
+
+            // Unbounded ones are drawn wherever they are.
+            const auto treeObject{ m_EntityTreeObjects[entt::to_entity(entity)] };
+            if (treeObject == Renderer::c_InvalidValue<std::uint32_t>) continue;
+
+            const auto [mesh, transform] = renderables.get<MeshRendererComponent, TransformComponent>(entity);
+
+            bool isBounded{};
+            m_Bounds.SetBounds(treeObject, RenderSystem::GetWorldBounds(mesh, transform, isBounded));
+        }
+
+        m_MovedEntities.clear();
+        m_Bounds.Refit();
+        return;
+    }
+
+    m_CubeBounds = cubeBounds;
+
+    m_ObjectEntities.clear();
+    m_TreeObjects.clear();
+    m_UnboundedObjects.clear();
+    m_WorldBounds.clear();
+
+    for (auto [entity, mesh, material, transform] : renderables.each())
+    {
+        const auto object{ static_cast<std::uint32_t>(m_ObjectEntities.size()) };
+        m_ObjectEntities.push_back(entity);
+
+        const auto index{ static_cast<std::size_t>(entt::to_entity(entity)) };
+        if (index >= m_EntityTreeObjects.size())
+            m_EntityTreeObjects.resize(index + 1u, Renderer::c_InvalidValue<std::uint32_t>);
+
+        bool isBounded{};
+        const auto bounds{ RenderSystem::GetWorldBounds(mesh, transform, isBounded) };
+        if (!isBounded)
+        {
+            m_EntityTreeObjects[index] = Renderer::c_InvalidValue<std::uint32_t>;
+            m_UnboundedObjects.push_back(object);
+            continue;
+        }
+
+        m_EntityTreeObjects[index] = static_cast<std::uint32_t>(m_TreeObjects.size());
+        m_TreeObjects.push_back(object);
+        m_WorldBounds.push_back(bounds);
+    }
+
+    m_Bounds.Build(m_WorldBounds);
+
+    m_MovedEntities.clear();
+    m_IsBoundsValid = true;
+}
+
+Renderer::BoundingBox RenderSystem::GetWorldBounds(const MeshRendererComponent& mesh, const TransformComponent& transform, bool& isBounded) const
+{
+    const auto& bounds{ mesh.Mesh == c_CubeMesh || mesh.Mesh >= m_Meshes.size() ? m_CubeBounds : m_Meshes[mesh.Mesh].VertexArrayPtr->GetBounds() };
+
+    isBounded = bounds.IsValid();
+    if (!isBounded)
+        return Renderer::BoundingBox{ .Min = transform.Translation.Position, .Max = transform.Translation.Position, };
+
+    // The bounds are taken before the mesh's base transform, the model matrix alone places them.
+    return bounds.Box.Transform(transform.Translation.ComposeModelMatrix());
+}
+
+void RenderSystem::FlushRun(Renderer::Renderer3DInstance& renderer, const MeshRendererComponent& mesh, const MaterialComponent& material)
+{
+    if (!m_RunTranslations.GetSize()) return;
+
+    if (mesh.Mesh == c_CubeMesh || mesh.Mesh >= m_Meshes.size())
+    {
+        renderer.DrawCubes(m_RunTranslations, m_RunColors, material.Material);
+    }
+    else
+    {
+        m_RunMatrices.resize(m_RunTranslations.GetSize());
+        Renderer::ComposeModelMatrices(m_RunTranslations, m_RunMatrices.data());
+
+        const auto& renderMesh{ m_Meshes[mesh.Mesh] };
+        renderer.DrawInstanced(renderMesh.VertexArrayPtr, m_RunMatrices, m_RunColors,
+            renderMesh.DiffuseMap, renderMesh.SpecularMap, renderMesh.EmissionMap, material.Material);
+    }
+
+    m_RunTranslations.Clear();
+    m_RunColors.clear();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Components.hpp"
+
+#include "Renderer/BoundingVolumeHierarchy.hpp"
+#include "Renderer/Renderer.hpp"
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct RenderMesh
+{
+    std::shared_ptr<Renderer::VertexArray> VertexArrayPtr{};
+    std::shared_ptr<Renderer::Texture2D> DiffuseMap{};
+    std::shared_ptr<Renderer::Texture2D> SpecularMap{};
+    std::shared_ptr<Renderer::Texture2D> EmissionMap{};
+};
+
+/**
+ * Turns the scene's entities into draws. Everything with a transform, a mesh renderer and a material
+ * lives in one owning group, so the three pools are packed in the same order and kept sorted by mesh
+ * and material. Submit() walks them linearly and issues one instanced draw per run of equal state,
+ * the shared pointers of a mesh are only touched once per run.
+ *
+ * Their world space boxes are kept in a bounding volume hierarchy, rebuilt whenever the order changes
+ * and refitted for the transforms updated through the registry. With frustum culling on, only what the
+ * tree finds in view is walked, and picking casts against the same boxes.
+ */
+class RenderSystem
+{
+public:
+    // The renderer's built-in cube, always present.
+    static constexpr MeshHandle c_CubeMesh{ 0u };
+
+public:
+    explicit RenderSystem(entt::registry& registry);
+    ~RenderSystem();
+
+    RenderSystem(const RenderSystem&) = delete;
+    RenderSystem& operator=(const RenderSystem&) = delete;
+
+    MeshHandle AddMesh(const RenderMesh& mesh);
+
+    // Begins the scene with the primary camera and the first light, false when there is no camera.
+    bool BeginScene(Renderer::Renderer3DInstance& renderer);
+
+    // Restores the order and brings the boxes up to date, Submit() does it first. Needs no GL context.
+    void Prepare(const Renderer::MeshBounds& cubeBounds);
+
+    // Records the draws of every renderable entity, in between the renderer's BeginScene() and EndScene().
+    void Submit(Renderer::Renderer3DInstance& renderer);
+
+    // The renderable whose box the ray enters first as of the last Prepare(), entt::null when it hits nothing.
+    entt::entity Pick(const Renderer::Ray& ray, float* distance = nullptr) const;
+
+private:
+    void SortRenderables();
+    void UpdateBounds(const Renderer::MeshBounds& cubeBounds);
+    void FlushRun(Renderer::Renderer3DInstance& renderer, const MeshRendererComponent& mesh, const MaterialComponent& material);
+
+    // A mesh without bounds gets an empty box at its position and isBounded is cleared.
+    Renderer::BoundingBox GetWorldBounds(const MeshRendererComponent& mesh, const TransformComponent& transform, bool& isBounded) const;
+
+    void OnRenderableChanged(entt::registry&, entt::entity) noexcept { m_IsSorted = false; m_IsBoundsValid = false; }
+    void OnTransformChanged(entt::registry&, entt::entity entity) { m_MovedEntities.push_back(entity); }
+
+private:
+    entt::registry& m_Registry;
+
+    std::vector<RenderMesh> m_Meshes{};
+    bool m_IsSorted{ false };
+
+    // Objects are the renderables in group order, the tree only holds the bounded ones.
+    Renderer::BoundingVolumeHierarchy m_Bounds{};
+    Renderer::MeshBounds m_CubeBounds{};
+    bool m_IsBoundsValid{ false };
+
+    std::vector<entt::entity> m_ObjectEntities{};
+    std::vector<std::uint32_t> m_TreeObjects{}; // object of each tree object
+    std::vector<std::uint32_t> m_EntityTreeObjects{}; // by entt::to_entity(), invalid when unbounded
+    std::vector<std::uint32_t> m_UnboundedObjects{}; // never culled
+    std::vector<entt::entity> m_MovedEntities{};
+
+    Renderer::Frustum m_ViewFrustum{};
+    std::vector<std::uint32_t> m_VisibleObjects{};
+    std::vector<Renderer::BoundingBox> m_WorldBounds{};
+
+    // Reused every frame for the run being gathered.
+    Renderer::TranslationBatch m_RunTranslations{};
+    std::vector<glm::vec3> m_RunColors{};
+    std::vector<glm::mat4> m_RunMatrices{};
+};
@@ -11,3 +11,10 @@ void Scene::OnImGuiRender(ImGuiIO& io, const Timestamp& timestamp)
 
 Scene::Scene(std::unique_ptr<Window>& window) noexcept
     : m_WindowRef{ window } {}
+
+entt::entity Scene::CreateEntity(const Renderer::Translation& translation)
+{
+    const auto entity{ m_Registry.create() };
+    m_Registry.emplace<TransformComponent>(entity, translation);
+    return entity;
+}
@@ -3,6 +3,9 @@
 #include "ImGui/ImGuiContext.hpp"
 
 #include "Timestamp.hpp"
+#include "Components.hpp"
+
+#include <entt/entt.hpp>
 
 class Scene
 {
@@ -22,6 +25,14 @@ protected:
 
     inline auto& GetWindow() { return m_WindowRef; }
 
+    // Every entity of a scene has a transform.
+    entt::entity CreateEntity(const Renderer::Translation& translation = {});
+
+    inline auto& GetRegistry() noexcept { return m_Registry; }
+    inline const auto& GetRegistry() const noexcept { return m_Registry; }
+
 private:
     std::unique_ptr<Window>& m_WindowRef;
+
+    entt::registry m_Registry{};
 };
@@ -1,5 +1,6 @@
 #include "Buffers.hpp"
 
+#include <algorithm>
 #include <array>
 #include <spdlog/spdlog.h>
 #include <glad/glad.h>
@@ -11,6 +12,7 @@ static constexpr std::size_t _GetSize(const LayoutDataType& type) noexcept
     constexpr auto booleanSize{ static_cast<std::size_t>(sizeof(bool))  };
     constexpr auto integerSize{ static_cast<std::size_t>(sizeof(int))   };
     constexpr auto floatSize  { static_cast<std::size_t>(sizeof(float)) };
+    constexpr auto shortSize  { static_cast<std::size_t>(sizeof(short)) };
 
     switch (type)
     {
@@ -28,6 +30,15 @@ static constexpr std::size_t _GetSize(const LayoutDataType& type) noexcept
 
     case LayoutDataType::Mat3: return floatSize * 3u * 3u;
     case LayoutDataType::Mat4: return floatSize * 4u * 4u;
+
+    case LayoutDataType::Half2: return shortSize * 2u;
+    case LayoutDataType::Half4: return shortSize * 4u;
+
+    case LayoutDataType::Short2Norm: return shortSize * 2u;
+    case LayoutDataType::Short4Norm: return shortSize * 4u;
+    case LayoutDataType::UShort2Norm: return shortSize * 2u;
+
+    case LayoutDataType::Int2101010Norm: return integerSize * 1u;
     }
 }
 
@@ -40,21 +51,40 @@ static constexpr std::size_t _GetComponentCount(const LayoutDataType& type) noex
         case LayoutDataType::Float1: return 1u;
 
         case LayoutDataType::Integer2:
-        case LayoutDataType::Float2: return 2u;
+        case LayoutDataType::Float2:
+        case LayoutDataType::Half2:
+        case LayoutDataType::Short2Norm:
+        case LayoutDataType::UShort2Norm: return 2u;
 
         case LayoutDataType::Integer3:
         case LayoutDataType::Float3: return 3u;
 
         case LayoutDataType::Integer4:
-        case LayoutDataType::Float4: return 4u;
+        case LayoutDataType::Float4:
+        case LayoutDataType::Half4:
+        case LayoutDataType::Short4Norm:
+        case LayoutDataType::Int2101010Norm: return 4u;
 
         case LayoutDataType::Mat3: return 3u * 3u;
         case LayoutDataType::Mat4: return 4u * 4u;
     }
 }
 
+static constexpr bool _IsNormalized(const LayoutDataType& type) noexcept
+{
+    switch (type)
+    {
+        case LayoutDataType::Short2Norm:
+        case LayoutDataType::Short4Norm:
+        case LayoutDataType::UShort2Norm:
+        case LayoutDataType::Int2101010Norm: return true;
+
+        default: return false;
+    }
+}
+
 BufferElement::BufferElement(const LayoutDataType type, const std::string_view name, const bool normalized)
-    : Type{ type }, Name{ name }, Normalized{ normalized}, Size{ _GetSize(type) } {}
+    : Type{ type }, Name{ name }, Normalized{ normalized || _IsNormalized(type) }, Size{ _GetSize(type) } {}
 
 std::size_t BufferElement::GetComponentCount() const noexcept
 {
@@ -85,13 +115,25 @@ bool VertexBuffer::OnInitialize() noexcept
     if (m_RendererID != c_EmptyValue<RendererID>)
         glDeleteBuffers(1, &m_RendererID);
     
-    glGenBuffers(1, &m_RendererID);
-    glBindBuffer(GL_ARRAY_BUFFER, { m_RendererID });
-    glBufferData(GL_ARRAY_BUFFER, { static_cast<GLsizeiptr>(m_Props.DataSize * m_Props.VertSize) }, { m_Props.Data }, { static_cast<GLenum>(m_Props.Usage) });
+    // Data is uploaded straight from the given pointer, which may point into a mapped file.
+    glCreateBuffers(1, &m_RendererID);
+    glNamedBufferData({ m_RendererID }, { static_cast<GLsizeiptr>(m_Props.DataSize * m_Props.VertSize) }, { m_Props.Data }, { static_cast<GLenum>(m_Props.Usage) });
 
     return true;
 }
 
+bool VertexBuffer::SetData(const void* data, const std::size_t count, const std::size_t offset) const noexcept
+{
+    if (offset + count > m_Props.DataSize)
+    {
+        spdlog::error("[VertexBuffer]: Write of {} vertices at {} exceeds the buffer size ({})!", count, offset, m_Props.DataSize);
+        return false;
+    }
+
+    glNamedBufferSubData({ m_RendererID }, { static_cast<GLintptr>(offset * m_Props.VertSize) }, { static_cast<GLsizeiptr>(count * m_Props.VertSize) }, { data });
+    return true;
+}
+
 void VertexBuffer::Bind() const
 {
     glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
@@ -116,10 +158,11 @@ bool IndexBuffer::OnInitialize() noexcept
     if (m_RendererID != c_EmptyValue<RendererID>)
         glDeleteBuffers(1, &m_RendererID);
 
-    glGenBuffers(1, &m_RendererID);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, { m_RendererID });
-    glBufferData(
-        GL_ELEMENT_ARRAY_BUFFER,
+    // Binding GL_ELEMENT_ARRAY_BUFFER would attach the buffer to whichever vertex array
+    // happens to be bound, so the storage is created without binding it.
+    glCreateBuffers(1, &m_RendererID);
+    glNamedBufferData(
+        { m_RendererID },
         { static_cast<GLsizeiptr>(m_Props.Count * sizeof(uint32_t)) },
         { m_Props.Data },
         { static_cast<GLenum>(m_Props.Usage) }
@@ -128,6 +171,18 @@ bool IndexBuffer::OnInitialize() noexcept
     return true;
 }
 
+bool IndexBuffer::SetData(const std::uint32_t* data, const std::size_t count, const std::size_t offset) const noexcept
+{
+    if (offset + count > m_Props.Count)
+    {
+        spdlog::error("[IndexBuffer]: Write of {} indices at {} exceeds the buffer size ({})!", count, offset, m_Props.Count);
+        return false;
+    }
+
+    glNamedBufferSubData({ m_RendererID }, { static_cast<GLintptr>(offset * sizeof(std::uint32_t)) }, { static_cast<GLsizeiptr>(count * sizeof(std::uint32_t)) }, { data });
+    return true;
+}
+
 void IndexBuffer::Bind() const
 {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
@@ -138,4 +193,160 @@ void IndexBuffer::Unbind() const
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, c_EmptyValue<RendererID>);
 }
 
+RingBuffer::RingBuffer(const RingBufferProps& props)
+    : m_Props{ props }, m_CurrentRegion{ props.RegionCount ? props.RegionCount - 1u : 0u } {}
+
+RingBuffer::~RingBuffer()
+{
+    for (auto fence : m_Fences)
+        if (fence) glDeleteSync(static_cast<GLsync>(fence));
+
+    if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        glUnmapNamedBuffer(m_RendererID);
+        glDeleteBuffers(1, &m_RendererID);
+    }
+}
+
+void* RingBuffer::AcquireRegion() noexcept
+{
+    if (!m_MappedData) return nullptr;
+
+    m_CurrentRegion = (m_CurrentRegion + 1u) % m_Props.RegionCount;
+
+    if (auto& fence{ m_Fences[m_CurrentRegion] }; fence)
+    {
+        constexpr GLuint64 c_Timeout{ 1'000'000'000u }; // 1s
+
+        // Only the first wait flushes, the following ones just keep waiting on the same commands.
+        auto result{ glClientWaitSync(static_cast<GLsync>(fence), GL_SYNC_FLUSH_COMMANDS_BIT, c_Timeout) };
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            spdlog::warn("[RingBuffer]: Waiting for the GPU to release region {}! [id={}]", m_CurrentRegion, m_RendererID);
+            result = glClientWaitSync(static_cast<GLsync>(fence), 0u, c_Timeout);
+        }
+
+        glDeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+
+    return m_MappedData + m_CurrentRegion * m_RegionStride;
+}
+
+void RingBuffer::ReleaseRegion() noexcept
+{
+    if (!m_MappedData) return;
+
+    auto& fence{ m_Fences[m_CurrentRegion] };
+    if (fence) glDeleteSync(static_cast<GLsync>(fence));
+
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0u);
+}
+
+bool RingBuffer::OnInitialize() noexcept
+{
+    if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        glUnmapNamedBuffer(m_RendererID);
+        glDeleteBuffers(1, &m_RendererID);
+    }
+
+    if (!m_Props.RegionSize || !m_Props.RegionCount) return false;
+
+    // Every region has to start at an offset the target can be bound at, indirect commands and pixels only need 4 bytes.
+    GLint alignment{ static_cast<GLint>(sizeof(GLuint)) };
+    if (RingBuffer::IsIndexedTarget(m_Props.Target))
+    {
+        glGetIntegerv(m_Props.Target == BufferTarget::Uniform
+            ? GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+            : GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    }
+
+    const auto align{ static_cast<std::size_t>(std::max(alignment, 1)) };
+    m_RegionStride = (m_Props.RegionSize + align - 1u) / align * align;
+
+    constexpr GLbitfield c_Flags{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+    const auto size{ static_cast<GLsizeiptr>(m_RegionStride * m_Props.RegionCount) };
+
+    glCreateBuffers(1, &m_RendererID);
+    glNamedBufferStorage({ m_RendererID }, size, nullptr, c_Flags);
+
+    m_MappedData = static_cast<std::uint8_t*>(glMapNamedBufferRange({ m_RendererID }, 0, size, c_Flags));
+    if (!m_MappedData)
+    {
+        spdlog::error("[RingBuffer]: Failed to map the buffer persistently! [id={}]", m_RendererID);
+        return false;
+    }
+
+    m_Fences.assign(m_Props.RegionCount, nullptr);
+    return true;
+}
+
+void RingBuffer::Bind() const
+{
+    if (!RingBuffer::IsIndexedTarget(m_Props.Target))
+    {
+        glBindBuffer({ static_cast<GLenum>(m_Props.Target) }, m_RendererID);
+        return;
+    }
+
+    glBindBufferRange({ static_cast<GLenum>(m_Props.Target) }, { static_cast<GLuint>(m_Props.Binding) }, m_RendererID,
+        { static_cast<GLintptr>(m_CurrentRegion * m_RegionStride) }, { static_cast<GLsizeiptr>(m_Props.RegionSize) });
+}
+
+void RingBuffer::Unbind() const
+{
+    if (!RingBuffer::IsIndexedTarget(m_Props.Target))
+    {
+        glBindBuffer({ static_cast<GLenum>(m_Props.Target) }, c_EmptyValue<RendererID>);
+        return;
+    }
+
+    glBindBufferBase({ static_cast<GLenum>(m_Props.Target) }, { static_cast<GLuint>(m_Props.Binding) }, c_EmptyValue<RendererID>);
+}
+
+UniformBuffer::UniformBuffer(const UniformBufferProps& props)
+    : m_Props{ props } {}
+
+UniformBuffer::~UniformBuffer()
+{
+    if (m_RendererID != c_EmptyValue<RendererID>)
+        glDeleteBuffers(1, &m_RendererID);
+}
+
+void UniformBuffer::SetData(const void* data, const std::size_t size, const std::size_t offset) const noexcept
+{
+    if (offset + size > m_Props.Size)
+    {
+        spdlog::error("[UniformBuffer]: Write of {} bytes at offset {} exceeds the buffer size ({})!", size, offset, m_Props.Size);
+        return;
+    }
+
+    glNamedBufferSubData({ m_RendererID }, { static_cast<GLintptr>(offset) }, { static_cast<GLsizeiptr>(size) }, { data });
+}
+
+bool UniformBuffer::OnInitialize() noexcept
+{
+    if (m_RendererID != c_EmptyValue<RendererID>)
+        glDeleteBuffers(1, &m_RendererID);
+
+    if (!m_Props.Size) return false;
+
+    glCreateBuffers(1, &m_RendererID);
+    glNamedBufferData({ m_RendererID }, { static_cast<GLsizeiptr>(m_Props.Size) }, { nullptr }, { static_cast<GLenum>(m_Props.Usage) });
+
+    UniformBuffer::Bind();
+    return true;
+}
+
+void UniformBuffer::Bind() const
+{
+    glBindBufferBase(GL_UNIFORM_BUFFER, { static_cast<GLuint>(m_Props.Binding) }, m_RendererID);
+}
+
+void UniformBuffer::Unbind() const
+{
+    glBindBufferBase(GL_UNIFORM_BUFFER, { static_cast<GLuint>(m_Props.Binding) }, c_EmptyValue<RendererID>);
+}
+
 NAMESPACE_END(Renderer)
@@ -26,6 +26,12 @@ enum class LayoutDataType : RendererEnum
     Integer1, Integer2, Integer3, Integer4,
     Float1, Float2, Float3, Float4,
     Mat3, Mat4,
+
+    // Packed types, the normalized ones are always read as [-1, 1] or [0, 1] floats.
+    Half2, Half4,
+    Short2Norm, Short4Norm,
+    UShort2Norm,
+    Int2101010Norm,
 };
 
 struct BufferElement
@@ -76,6 +82,10 @@ public:
 
     inline const auto& GetLayout() const noexcept { return m_Props.Layout; }
     inline const auto& GetSize() const noexcept { return m_Props.DataSize; }
+    inline auto GetByteSize() const noexcept { return m_Props.DataSize * m_Props.VertSize; }
+
+    // Overwrites count vertices starting at the given vertex, the buffer is never resized.
+    bool SetData(const void* data, const std::size_t count, const std::size_t offset = 0u) const noexcept;
 
 public:
     virtual bool OnInitialize() noexcept override;
@@ -106,6 +116,10 @@ public:
     ~IndexBuffer();
 
     inline const auto GetCount() const noexcept { return m_Props.Count; }
+    inline auto GetByteSize() const noexcept { return m_Props.Count * sizeof(std::uint32_t); }
+
+    // Overwrites count indices starting at the given index, the buffer is never resized.
+    bool SetData(const std::uint32_t* data, const std::size_t count, const std::size_t offset = 0u) const noexcept;
 
 public:
     virtual bool OnInitialize() noexcept override;
@@ -122,4 +136,105 @@ private:
     IndexBufferProps m_Props{};
 };
 
+enum class BufferTarget : RendererEnum
+{
+    Uniform       = 0x8A11,
+    ShaderStorage = 0x90D2,
+    DrawIndirect  = 0x8F3F, // Not indexed, the draws take GetCurrentOffset() as the indirect pointer.
+    PixelUnpack   = 0x88EC, // Not indexed, texture uploads take GetCurrentOffset() as the pixel pointer.
+};
+
+struct RingBufferProps
+{
+    std::size_t RegionSize{ 0u };
+    std::size_t RegionCount{ 3u };
+    BufferTarget Target{ BufferTarget::ShaderStorage };
+    std::uint32_t Binding{ 0u };
+};
+
+/**
+ * Persistently mapped buffer split into regions, the CPU writes the next region while the GPU
+ * still reads the previous ones. A fence per region keeps the CPU from overwriting data in use.
+ */
+class RingBuffer : public RendererResource<RingBufferProps>
+{
+public:
+    explicit RingBuffer(const RingBufferProps& props);
+    ~RingBuffer();
+
+    // Moves to the next region and waits until the GPU is done with it.
+    void* AcquireRegion() noexcept;
+
+    // Fences the commands submitted so far, they are the last ones reading the current region.
+    void ReleaseRegion() noexcept;
+
+    inline const auto& GetCurrentRegion() const noexcept { return m_CurrentRegion; }
+    inline auto GetCurrentOffset() const noexcept { return m_CurrentRegion * m_RegionStride; }
+    inline const auto& GetRegionSize() const noexcept { return m_Props.RegionSize; }
+    inline const auto& GetRegionCount() const noexcept { return m_Props.RegionCount; }
+
+public:
+    virtual bool OnInitialize() noexcept override;
+
+public:
+    // Binds the current region only.
+    virtual void Bind() const override;
+    virtual void Unbind() const override;
+
+public:
+    inline virtual RendererID GetResourceHandle() const override { return m_RendererID; }
+
+private:
+    // Uniform and shader storage regions are bound by range to their binding point, the rest by target only.
+    static constexpr bool IsIndexedTarget(const BufferTarget target) noexcept
+    {
+        return target == BufferTarget::Uniform || target == BufferTarget::ShaderStorage;
+    }
+
+private:
+    RendererID m_RendererID{ c_EmptyValue<RendererID> };
+    RingBufferProps m_Props{};
+
+    std::uint8_t* m_MappedData{ nullptr };
+    std::size_t m_RegionStride{ 0u };
+    std::size_t m_CurrentRegion{ 0u };
+
+    // GLsync objects, kept opaque so the header does not need glad.
+    std::vector<void*> m_Fences{};
+};
+
+struct UniformBufferProps
+{
+    std::size_t Size{ 0u };
+    std::uint32_t Binding{ 0u };
+    BufferUsage Usage{ BufferUsage::DynamicDraw };
+};
+
+// Bound to a fixed binding point, every program declaring a block with that binding reads the same data.
+class UniformBuffer : public RendererResource<UniformBufferProps>
+{
+public:
+    explicit UniformBuffer(const UniformBufferProps& props);
+    ~UniformBuffer();
+
+    inline const auto& GetSize() const noexcept { return m_Props.Size; }
+    inline const auto& GetBinding() const noexcept { return m_Props.Binding; }
+
+    void SetData(const void* data, const std::size_t size, const std::size_t offset = 0u) const noexcept;
+
+public:
+    virtual bool OnInitialize() noexcept override;
+
+public:
+    virtual void Bind() const override;
+    virtual void Unbind() const override;
+
+public:
+    inline virtual RendererID GetResourceHandle() const override { return m_RendererID; }
+
+private:
+    RendererID m_RendererID{ c_EmptyValue<RendererID> };
+    UniformBufferProps m_Props{};
+};
+
 NAMESPACE_END(Renderer)
@@ -1,5 +1,7 @@
 #include "Framebuffer.hpp"
 
+#include "StateCache.hpp"
+
 #include <glad/glad.h>
 
 #include <spdlog/spdlog.h>
@@ -15,19 +17,25 @@ Framebuffer::~Framebuffer()
         glDeleteRenderbuffers(1, &m_Renderbuffer);
 
     if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetFramebuffer(m_RendererID);
         glDeleteFramebuffers(1, &m_RendererID);
+    }
 }
 
 bool Framebuffer::OnInitialize() noexcept
 {
     if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetFramebuffer(m_RendererID);
         glDeleteFramebuffers(1, &m_RendererID);
+    }
 
     glGenFramebuffers(1, &m_RendererID);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+    StateCache::Get().BindFramebuffer(FramebufferTarget::Both, m_RendererID);
 
     glGenTextures(1, &m_Colorbuffer);
-    glBindTexture(GL_TEXTURE_2D, { m_Colorbuffer });
+    StateCache::Get().BindTexture(GL_TEXTURE_2D, m_Colorbuffer);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, { static_cast<GLsizei>(m_Size.x) }, { static_cast<GLsizei>(m_Size.y) }, { 0 }, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -49,12 +57,12 @@ bool Framebuffer::OnInitialize() noexcept
 
 void Framebuffer::Bind() const
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, { m_RendererID });
+    StateCache::Get().BindFramebuffer(FramebufferTarget::Both, m_RendererID);
 }
 
 void Framebuffer::Unbind() const
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, { c_EmptyValue<RendererID> });
+    StateCache::Get().BindFramebuffer(FramebufferTarget::Both, c_EmptyValue<RendererID>);
 }
 
 NAMESPACE_END(Renderer)
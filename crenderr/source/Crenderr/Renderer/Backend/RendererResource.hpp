@@ -36,6 +36,7 @@ public:
 };
 
 // TODO: force this method as the only one to allocated renderer's resources, creational pattern
+// Always a new object, AcquireResource() (Renderer/ResourceCache.hpp) shares the ones loaded from the same props.
 template<typename _Ty, typename _Props = typename _Ty::PropsType>
 inline std::shared_ptr<_Ty> AllocateResource(const _Props& props) noexcept
 {
@@ -1,7 +1,10 @@
 #include "Shader.hpp"
 
+#include "StateCache.hpp"
+
 #include <spdlog/spdlog.h>
 #include <optional>
+#include <bit>
 
 NAMESPACE_BEGIN(Renderer)
 
@@ -26,6 +29,22 @@ namespace Internal
     );
 }
 
+Hash::ValueType GetPropsHash(const ShaderProps& props) noexcept
+{
+    // The map has no order of its own, the stages go in enum order.
+    auto hash{ Hash::c_OffsetBasis };
+    for (auto type = static_cast<int>(ShaderType::Vertex); type < static_cast<int>(ShaderType::EnumEnd); ++type)
+    {
+        const auto found{ props.Sources.find(static_cast<ShaderType>(type)) };
+        if (found == props.Sources.end()) continue;
+
+        hash = Hash::FNV1aValue(type, hash);
+        hash = Hash::FNV1a(found->second.GetContent(), hash);
+    }
+
+    return hash;
+}
+
 Shader::Shader(const ShaderProps& props) noexcept
 {
     for (const auto& [type, file] : props.Sources)
@@ -35,7 +54,10 @@ Shader::Shader(const ShaderProps& props) noexcept
 Shader::~Shader() noexcept
 {
     if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetProgram(m_RendererID);
         glDeleteProgram(m_RendererID);
+    }
 }
 
 bool Shader::LoadSource(const ShaderType type, const std::string& source) noexcept
@@ -62,12 +84,8 @@ bool Shader::LoadSource(const ShaderType type, const FileManager& source) noexce
 
 bool Shader::OnInitialize() noexcept
 {
-    if (m_RendererID != c_EmptyValue<RendererID>)
-        glDeleteProgram(m_RendererID);
-
-    //?...
-
-    return true;
+    // Link() replaces the current program only once the new one is linked.
+    return Shader::Compile() && Shader::Link();
 }
 
 bool Shader::Compile() noexcept
@@ -109,20 +127,25 @@ bool Shader::Link() noexcept
     }
 
     if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetProgram(m_RendererID);
         glDeleteProgram(m_RendererID);
+    }
 
     m_RendererID = program;
+    Shader::InternalReflectUniforms();
+
     return true;
 }
 
 void Shader::Bind() const
 {
-    glUseProgram(m_RendererID);
+    StateCache::Get().UseProgram(m_RendererID);
 }
 
 void Shader::Unbind() const
 {
-    glUseProgram(c_EmptyValue<RendererID>);
+    StateCache::Get().UseProgram(c_EmptyValue<RendererID>);
 }
 
 bool Shader::InternalLoadSource(const ShaderType type, const FileManager& source) noexcept
@@ -172,6 +195,67 @@ bool Shader::InternalCompileShader(const std::size_t index)
     return true;
 }
 
+void Shader::InternalReflectUniforms() noexcept
+{
+    m_Uniforms.clear();
+    m_UniformMask = 0u;
+
+    GLint uniformCount{};
+    glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniformCount);
+
+    GLint maxNameLength{};
+    glGetProgramInterfaceiv(m_RendererID, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
+
+    if (uniformCount <= 0) return;
+
+    // Every uniform can take two slots, its name and the plain name of an array. Kept at most half full, so the probe sequences stay short.
+    const auto capacity{ std::bit_ceil(static_cast<std::size_t>(uniformCount) * 4u) };
+    m_Uniforms.resize(capacity);
+    m_UniformMask = capacity - 1u;
+
+    const auto insert{ [this](const std::string_view name, const GLint location) {
+        const auto hash{ Hash::FNV1a(name) };
+        auto index{ hash & m_UniformMask };
+        for (std::size_t step = 0u; step < m_Uniforms.size(); ++step, index = (index + 1u) & m_UniformMask)
+        {
+            auto& slot{ m_Uniforms[index] };
+            if (slot.Location == -1)
+            {
+                slot = { .NameHash = hash, .Location = location, };
+                return true;
+            }
+
+            if (slot.NameHash == hash) return slot.Location == location;
+        }
+
+        return false;
+    } };
+
+    std::string name(static_cast<std::size_t>(std::max(maxNameLength, 1)), '\0');
+    for (GLint i = 0; i < uniformCount; ++i)
+    {
+        constexpr std::array<GLenum, 1u> c_Properties{ GL_LOCATION };
+        GLint location{ -1 };
+        glGetProgramResourceiv(m_RendererID, GL_UNIFORM, { static_cast<GLuint>(i) },
+            { static_cast<GLsizei>(c_Properties.size()) }, c_Properties.data(), 1, nullptr, &location);
+
+        // Members of uniform blocks have no location.
+        if (location == -1) continue;
+
+        GLsizei nameLength{};
+        glGetProgramResourceName(m_RendererID, GL_UNIFORM, { static_cast<GLuint>(i) },
+            { static_cast<GLsizei>(name.size()) }, &nameLength, name.data());
+
+        std::string_view view{ name.data(), static_cast<std::size_t>(nameLength) };
+        if (!insert(view, location))
+            spdlog::warn("[Shader]: Uniform hash collision, {} cannot be set by name! (ID: {})", view, m_RendererID);
+
+        // Arrays are reported as "name[0]", make them reachable by the plain name too.
+        if (view.ends_with("[0]"))
+            insert(view.substr(0u, view.size() - 3u), location);
+    }
+}
+
 ShaderDataExtractor::ShaderDataExtractor(const std::shared_ptr<Shader>& shader) noexcept
 {
     ShaderDataExtractor::Extract(shader);
@@ -4,6 +4,7 @@
 
 #include "Utility/FileManager.hpp"
 #include "Utility/NonCopyable.hpp"
+#include "Utility/Hash.hpp"
 
 #include <unordered_map>
 #include <filesystem>
@@ -37,11 +38,23 @@ enum class ShaderType
 //     Evaluation  = 0x8E87,
 // };
 
+// Pre-hashed uniform name, create it once (constexpr if possible) so setting the uniform never touches the string.
+struct UniformHandle
+{
+    Hash::ValueType Value{ 0u };
+
+    constexpr explicit UniformHandle(const std::string_view name) noexcept
+        : Value{ Hash::FNV1a(name) } {}
+};
+
 struct ShaderProps
 {
     std::unordered_map<ShaderType, FileManager> Sources{};
 };
 
+// Key of a shader in the ResourceCache, made of the stages and their source code, wherever it was read from.
+Hash::ValueType GetPropsHash(const ShaderProps& props) noexcept;
+
 class Shader : public RendererResource<ShaderProps>
 {
 public:
@@ -63,9 +76,19 @@ public:
 
 public:
     template<typename _Ty>
-    inline void SetUniform(const std::string_view, const _Ty&) noexcept;
+    inline void SetUniform(const UniformHandle, const _Ty&) noexcept;
+
+    template<typename _Ty>
+    inline void SetUniform(const std::string_view name, const _Ty& value) noexcept
+    {
+        Shader::SetUniform<_Ty>(UniformHandle{ name }, value);
+    }
+
+    // Returns -1 for unknown or inactive uniforms, which glUniform*() silently ignores.
+    inline GLint GetUniformLocation(const UniformHandle handle) const noexcept;
 
 public:
+    // Compiles and links the loaded sources.
     virtual bool OnInitialize() noexcept override;
 
 public:
@@ -78,12 +101,24 @@ public:
 private:
     bool InternalLoadSource(const ShaderType type, const FileManager& source) noexcept;
     bool InternalCompileShader(const std::size_t index);
+    void InternalReflectUniforms() noexcept;
+
+private:
+    struct UniformSlot
+    {
+        Hash::ValueType NameHash{ 0u };
+        GLint Location{ -1 };
+    };
 
 private:
     RendererID m_RendererID{ c_EmptyValue<RendererID> };
     std::array<RendererID, Shader::c_ShaderCount> m_Handles{ 0u };
     std::array<FileManager, Shader::c_ShaderCount> m_Sources{};
     std::array<bool, Shader::c_ShaderCount> m_Compiled{ false };
+
+    // Open addressing table of the active uniforms, filled after every successful Link().
+    std::vector<UniformSlot> m_Uniforms{};
+    std::size_t m_UniformMask{ 0u };
 };
 
 struct ShaderData
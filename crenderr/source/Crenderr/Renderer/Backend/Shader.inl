@@ -3,31 +3,54 @@
 
 NAMESPACE_BEGIN(Renderer)
 
+inline GLint Shader::GetUniformLocation(const UniformHandle handle) const noexcept
+{
+    if (m_Uniforms.empty()) return -1;
+
+    // Bounded by the capacity, a full table must not loop forever on a missing name.
+    auto index{ handle.Value & m_UniformMask };
+    for (std::size_t step = 0u; step < m_Uniforms.size(); ++step, index = (index + 1u) & m_UniformMask)
+    {
+        const auto& slot{ m_Uniforms[index] };
+        if (slot.Location == -1) return -1;
+        if (slot.NameHash == handle.Value) return slot.Location;
+    }
+
+    return -1;
+}
+
 template<>
-inline void Shader::SetUniform<int>(const std::string_view name, const int& value) noexcept
+inline void Shader::SetUniform<int>(const UniformHandle handle, const int& value) noexcept
 {
-    const auto location{ glGetUniformLocation(m_RendererID, name.data()) };
+    const auto location{ Shader::GetUniformLocation(handle) };
     glUniform1i(location, value);
 }
 
 template<>
-inline void Shader::SetUniform<float>(const std::string_view name, const float& value) noexcept
+inline void Shader::SetUniform<std::uint32_t>(const UniformHandle handle, const std::uint32_t& value) noexcept
+{
+    const auto location{ Shader::GetUniformLocation(handle) };
+    glUniform1ui(location, value);
+}
+
+template<>
+inline void Shader::SetUniform<float>(const UniformHandle handle, const float& value) noexcept
 {
-    const auto location{ glGetUniformLocation(m_RendererID, name.data()) };
+    const auto location{ Shader::GetUniformLocation(handle) };
     glUniform1f(location, value);
 }
 
 template<>
-inline void Shader::SetUniform<glm::vec3>(const std::string_view name, const glm::vec3& value) noexcept
+inline void Shader::SetUniform<glm::vec3>(const UniformHandle handle, const glm::vec3& value) noexcept
 {
-    const auto location{ glGetUniformLocation(m_RendererID, name.data()) };
+    const auto location{ Shader::GetUniformLocation(handle) };
     glUniform3f(location, value.x, value.y, value.z);
 }
 
 template<>
-inline void Shader::SetUniform<glm::mat4>(const std::string_view name, const glm::mat4& value) noexcept
+inline void Shader::SetUniform<glm::mat4>(const UniformHandle handle, const glm::mat4& value) noexcept
 {
-    const auto location{ glGetUniformLocation(m_RendererID, name.data()) };
+    const auto location{ Shader::GetUniformLocation(handle) };
     glUniformMatrix4fv(location, 1u, GL_FALSE, glm::value_ptr(value));
 }
 
@@ -0,0 +1,191 @@
+#include "StateCache.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    CREATE_ENUM_MAPPING(Capability, RendererEnum, c_CapabilityGLType,
+        GL_DEPTH_TEST, // <- Capability::DepthTest
+        GL_BLEND,      // <- Capability::Blend
+        GL_CULL_FACE,  // <- Capability::CullFace
+    );
+
+    constexpr std::uint32_t c_Disabled{ 0u };
+    constexpr std::uint32_t c_Enabled { 1u };
+}
+
+GLFunctionTable GLFunctionTable::CreateDefault() noexcept
+{
+    // glad resolves its pointers at runtime, so they are looked up on every call.
+    return {
+        .UseProgram      = [](std::uint32_t program) { glUseProgram(program); },
+        .BindVertexArray = [](std::uint32_t array) { glBindVertexArray(array); },
+        .ActiveTexture   = [](std::uint32_t texture) { glActiveTexture(texture); },
+        .BindTexture     = [](std::uint32_t target, std::uint32_t texture) { glBindTexture(target, texture); },
+        .BindTextureUnit = [](std::uint32_t unit, std::uint32_t texture) { glBindTextureUnit(unit, texture); },
+        .BindFramebuffer = [](std::uint32_t target, std::uint32_t framebuffer) { glBindFramebuffer(target, framebuffer); },
+        .Enable          = [](std::uint32_t capability) { glEnable(capability); },
+        .Disable         = [](std::uint32_t capability) { glDisable(capability); },
+        .PolygonMode     = [](std::uint32_t face, std::uint32_t mode) { glPolygonMode(face, mode); },
+        .BlendFunc       = [](std::uint32_t source, std::uint32_t destination) { glBlendFunc(source, destination); },
+    };
+}
+
+StateCache::StateCache(const GLFunctionTable& functions) noexcept
+    : m_Functions{ functions }
+{
+    StateCache::Invalidate();
+}
+
+StateCache& StateCache::Get() noexcept
+{
+    static StateCache s_Instance{ GLFunctionTable::CreateDefault() };
+    return s_Instance;
+}
+
+void StateCache::SetFunctionTable(const GLFunctionTable& functions) noexcept
+{
+    m_Functions = functions;
+    StateCache::Invalidate();
+}
+
+void StateCache::Invalidate() noexcept
+{
+    m_Program         = c_InvalidValue<RendererID>;
+    m_VertexArray     = c_InvalidValue<RendererID>;
+    m_ReadFramebuffer = c_InvalidValue<RendererID>;
+    m_DrawFramebuffer = c_InvalidValue<RendererID>;
+
+    m_ActiveTexture = c_InvalidValue<std::uint32_t>;
+    m_Textures.fill(c_InvalidValue<RendererID>);
+
+    m_Capabilities.fill(c_InvalidValue<std::uint32_t>);
+
+    m_PolygonMode = c_InvalidValue<PolygonMode>;
+    m_BlendFunc.fill(c_InvalidValue<RendererEnum>);
+}
+
+void StateCache::UseProgram(const RendererID program) noexcept
+{
+    if (StateCache::Update(m_Program, program))
+        m_Functions.UseProgram(program);
+}
+
+void StateCache::BindVertexArray(const RendererID array) noexcept
+{
+    if (StateCache::Update(m_VertexArray, array))
+        m_Functions.BindVertexArray(array);
+}
+
+void StateCache::ActiveTexture(const std::uint32_t unit) noexcept
+{
+    if (StateCache::Update(m_ActiveTexture, unit))
+        m_Functions.ActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void StateCache::BindTexture(const RendererEnum target, const RendererID texture) noexcept
+{
+    // Other targets and units past the tracked ones go straight through.
+    if (target != GL_TEXTURE_2D || m_ActiveTexture >= c_MaxTextureUnits)
+    {
+        ++m_Statistics.Calls;
+        m_Functions.BindTexture(target, texture);
+        return;
+    }
+
+    if (StateCache::Update(m_Textures[m_ActiveTexture], texture))
+        m_Functions.BindTexture(target, texture);
+}
+
+void StateCache::BindTextureUnit(const std::uint32_t unit, const RendererID texture) noexcept
+{
+    if (unit >= c_MaxTextureUnits)
+    {
+        ++m_Statistics.Calls;
+        m_Functions.BindTextureUnit(unit, texture);
+        return;
+    }
+
+    if (StateCache::Update(m_Textures[unit], texture))
+        m_Functions.BindTextureUnit(unit, texture);
+}
+
+void StateCache::BindFramebuffer(const FramebufferTarget target, const RendererID framebuffer) noexcept
+{
+    switch (target)
+    {
+    case FramebufferTarget::Read:
+        if (StateCache::Update(m_ReadFramebuffer, framebuffer))
+            m_Functions.BindFramebuffer(static_cast<RendererEnum>(target), framebuffer);
+        return;
+
+    case FramebufferTarget::Draw:
+        if (StateCache::Update(m_DrawFramebuffer, framebuffer))
+            m_Functions.BindFramebuffer(static_cast<RendererEnum>(target), framebuffer);
+        return;
+
+    case FramebufferTarget::Both:
+        ++m_Statistics.Calls;
+        if (m_ReadFramebuffer == framebuffer && m_DrawFramebuffer == framebuffer)
+        {
+            ++m_Statistics.Avoided;
+            return;
+        }
+
+        m_ReadFramebuffer = m_DrawFramebuffer = framebuffer;
+        m_Functions.BindFramebuffer(static_cast<RendererEnum>(target), framebuffer);
+        return;
+    }
+}
+
+void StateCache::SetCapability(const Capability capability, const bool enabled) noexcept
+{
+    if (!EnumHelpers::IsEnumClassValid(capability)) return;
+
+    const auto state{ enabled ? Internal::c_Enabled : Internal::c_Disabled };
+    if (!StateCache::Update(m_Capabilities[EnumHelpers::ToIndex(capability)], state)) return;
+
+    const auto glCapability{ EnumHelpers::MapEnumClass(capability, Internal::c_CapabilityGLType) };
+    enabled
+        ? m_Functions.Enable(glCapability)
+        : m_Functions.Disable(glCapability);
+}
+
+void StateCache::SetPolygonMode(const PolygonMode mode) noexcept
+{
+    if (StateCache::Update(m_PolygonMode, mode))
+        m_Functions.PolygonMode(GL_FRONT_AND_BACK, static_cast<RendererEnum>(mode));
+}
+
+void StateCache::SetBlendFunc(const RendererEnum source, const RendererEnum destination) noexcept
+{
+    if (StateCache::Update(m_BlendFunc, { source, destination }))
+        m_Functions.BlendFunc(source, destination);
+}
+
+void StateCache::ForgetProgram(const RendererID program) noexcept
+{
+    if (m_Program == program) m_Program = c_InvalidValue<RendererID>;
+}
+
+void StateCache::ForgetVertexArray(const RendererID array) noexcept
+{
+    if (m_VertexArray == array) m_VertexArray = c_InvalidValue<RendererID>;
+}
+
+void StateCache::ForgetTexture(const RendererID texture) noexcept
+{
+    std::replace(m_Textures.begin(), m_Textures.end(), texture, c_InvalidValue<RendererID>);
+}
+
+void StateCache::ForgetFramebuffer(const RendererID framebuffer) noexcept
+{
+    if (m_ReadFramebuffer == framebuffer) m_ReadFramebuffer = c_InvalidValue<RendererID>;
+    if (m_DrawFramebuffer == framebuffer) m_DrawFramebuffer = c_InvalidValue<RendererID>;
+}
+
+NAMESPACE_END(Renderer)
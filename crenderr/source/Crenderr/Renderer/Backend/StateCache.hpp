@@ -0,0 +1,143 @@
+#pragma once
+
+#include "Renderer/RendererCore.hpp"
+
+#include <cstdint>
+#include <array>
+
+NAMESPACE_BEGIN(Renderer)
+
+/**
+ * GL entry points the state cache forwards to. Defaults to the loaded driver functions,
+ * a test can swap in its own table and run without any GL context.
+ */
+struct GLFunctionTable
+{
+    void (*UseProgram)(std::uint32_t program){ nullptr };
+    void (*BindVertexArray)(std::uint32_t array){ nullptr };
+    void (*ActiveTexture)(std::uint32_t texture){ nullptr };
+    void (*BindTexture)(std::uint32_t target, std::uint32_t texture){ nullptr };
+    void (*BindTextureUnit)(std::uint32_t unit, std::uint32_t texture){ nullptr };
+    void (*BindFramebuffer)(std::uint32_t target, std::uint32_t framebuffer){ nullptr };
+    void (*Enable)(std::uint32_t capability){ nullptr };
+    void (*Disable)(std::uint32_t capability){ nullptr };
+    void (*PolygonMode)(std::uint32_t face, std::uint32_t mode){ nullptr };
+    void (*BlendFunc)(std::uint32_t source, std::uint32_t destination){ nullptr };
+
+    static GLFunctionTable CreateDefault() noexcept;
+};
+
+enum class Capability
+{
+    None = 0,
+    DepthTest = 1, Blend, CullFace,
+    EnumEnd,
+};
+
+enum class FramebufferTarget : RendererEnum
+{
+    Both = 0x8D40,
+    Read = 0x8CA8,
+    Draw = 0x8CA9,
+};
+
+enum class PolygonMode : RendererEnum
+{
+    Point = 0x1B00,
+    Line  = 0x1B01,
+    Fill  = 0x1B02,
+};
+
+struct StateCacheStatistics
+{
+    std::size_t Calls{ 0u };
+    std::size_t Avoided{ 0u };
+};
+
+/**
+ * Shadow copy of the GL binding state, every bind in the renderer goes through here and the
+ * ones that would not change anything never reach the driver. Anything else touching GL
+ * (ImGui, a third party library) has to be followed by Invalidate().
+ */
+class StateCache
+{
+public:
+    static constexpr std::size_t c_MaxTextureUnits{ 32u };
+
+public:
+    explicit StateCache(const GLFunctionTable& functions) noexcept;
+
+    // The instance used by the renderer's resources.
+    static StateCache& Get() noexcept;
+
+    void SetFunctionTable(const GLFunctionTable& functions) noexcept;
+
+    // Forgets everything, the next call of every kind goes to GL.
+    void Invalidate() noexcept;
+
+public:
+    void UseProgram(const RendererID program) noexcept;
+    void BindVertexArray(const RendererID array) noexcept;
+
+    // Binds to the active unit, like glBindTexture() does. Only GL_TEXTURE_2D bindings are tracked.
+    void ActiveTexture(const std::uint32_t unit) noexcept;
+    void BindTexture(const RendererEnum target, const RendererID texture) noexcept;
+    void BindTextureUnit(const std::uint32_t unit, const RendererID texture) noexcept;
+
+    void BindFramebuffer(const FramebufferTarget target, const RendererID framebuffer) noexcept;
+
+    void SetCapability(const Capability capability, const bool enabled) noexcept;
+    void SetPolygonMode(const PolygonMode mode) noexcept;
+    void SetBlendFunc(const RendererEnum source, const RendererEnum destination) noexcept;
+
+public:
+    // Deleted objects are forgotten, GL may hand their names out again.
+    void ForgetProgram(const RendererID program) noexcept;
+    void ForgetVertexArray(const RendererID array) noexcept;
+    void ForgetTexture(const RendererID texture) noexcept;
+    void ForgetFramebuffer(const RendererID framebuffer) noexcept;
+
+public:
+    inline const auto& GetStatistics() const noexcept { return m_Statistics; }
+    inline void ResetStatistics() noexcept { m_Statistics = {}; }
+
+    inline const auto& GetProgram() const noexcept { return m_Program; }
+    inline const auto& GetVertexArray() const noexcept { return m_VertexArray; }
+    inline const auto& GetActiveTexture() const noexcept { return m_ActiveTexture; }
+
+private:
+    // Counts the call, returns true when it has to reach GL.
+    template<typename _Ty>
+    inline bool Update(_Ty& cached, const _Ty& value) noexcept
+    {
+        ++m_Statistics.Calls;
+        if (cached == value)
+        {
+            ++m_Statistics.Avoided;
+            return false;
+        }
+
+        cached = value;
+        return true;
+    }
+
+private:
+    GLFunctionTable m_Functions{};
+    StateCacheStatistics m_Statistics{};
+
+    RendererID m_Program{};
+    RendererID m_VertexArray{};
+    RendererID m_ReadFramebuffer{};
+    RendererID m_DrawFramebuffer{};
+
+    std::uint32_t m_ActiveTexture{};
+    std::array<RendererID, c_MaxTextureUnits> m_Textures{};
+
+    // 0 - disabled, 1 - enabled, c_InvalidValue - unknown.
+    std::array<std::uint32_t, EnumHelpers::c_EnumClassSize<Capability>> m_Capabilities{};
+
+    PolygonMode m_PolygonMode{};
+    std::array<RendererEnum, 2u> m_BlendFunc{};
+};
+
+NAMESPACE_END(Renderer)
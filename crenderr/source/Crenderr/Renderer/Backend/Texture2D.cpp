@@ -1,10 +1,18 @@
 #include "Texture2D.hpp"
 
+#include "StateCache.hpp"
+
+#include "Renderer/MipChain.hpp"
+#include "Renderer/Loaders/DDSFile.hpp"
+
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <filesystem>
+#include <utility>
 
 #include <array>
+#include <vector>
 #include <glad/glad.h>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -15,35 +23,49 @@ NAMESPACE_BEGIN(Renderer)
 const static auto c_InternalFormat{ GL_RGBA8 };
 const static auto c_DataFormat    { GL_RGBA  };
 
+// Shared by every texture, only ever touched on the GL thread.
+static std::uint64_t s_LastRevision{ 0u };
+
+Hash::ValueType GetPropsHash(const Texture2DProps& props) noexcept
+{
+    auto hash{ Hash::FNV1a(std::filesystem::path{ props.Filepath }.lexically_normal().generic_string()) };
+    hash = Hash::FNV1aValue(props.Size, hash);
+    hash = Hash::FNV1aValue(props.Wrapping, hash);
+    hash = Hash::FNV1aValue(props.Filtering, hash);
+
+    return Hash::FNV1aValue(props.Mipmaps, hash);
+}
+
 Texture2D::Texture2D(const Texture2DProps& props)
-    : m_Size{ props.Size }, m_Wrapping{ props.Wrapping }, m_Filtering{ props.Filtering }, m_Filepath{ props.Filepath } {}
+    : m_Size{ props.Size }, m_Wrapping{ props.Wrapping }, m_Filtering{ props.Filtering }, m_Filepath{ props.Filepath }, m_IsMipmapped{ props.Mipmaps } {}
 
 Texture2D::~Texture2D()
 {
     if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetTexture(m_RendererID);
         glDeleteTextures(1, &m_RendererID);
+    }
 }
 
 bool Texture2D::OnInitialize() noexcept
 {
-    if (m_RendererID != c_EmptyValue<RendererID>)
-        glDeleteTextures(1, &m_RendererID);
-    
-    glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-    glBindTexture(GL_TEXTURE_2D, { m_RendererID });
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, { static_cast<GLint>(m_Wrapping) });
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, { static_cast<GLint>(m_Wrapping) });
+    // Converted by the texture compressor, the blocks go to the GPU as they are.
+    if (const auto compressedPath{ FindCompressedTexture(m_Filepath) }; !compressedPath.empty())
+    {
+        MipChain levels{};
+        if (!ReadDDSFile(compressedPath, levels, m_IsMipmapped ? 0u : 1u)) return false;
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, { static_cast<GLint>(m_Filtering) });
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, { static_cast<GLint>(m_Filtering) });
+        return Texture2D::UploadLevels(levels);
+    }
 
     if (!m_Filepath.empty())
     {
         int width{}, height{}, channels{};
         stbi_set_flip_vertically_on_load(1);
 
-        auto* data{ stbi_load(m_Filepath.c_str(), &width, &height, &channels, 0) };
+        // Expanded to RGBA, so the storage is always RGBA8 and the texture can be copied into texture arrays.
+        auto* data{ stbi_load(m_Filepath.c_str(), &width, &height, &channels, STBI_rgb_alpha) };
         if (!data)
         {
             if (stbi_failure_reason())
@@ -57,42 +79,153 @@ bool Texture2D::OnInitialize() noexcept
         m_Size.x = { static_cast<float>(width)  };
         m_Size.y = { static_cast<float>(height) };
 
-        const auto internalFormat{ channels == 4 ? GL_RGBA8 : channels == 3 ? GL_RGB8 : c_InvalidValue<RendererEnum> };
-        const auto dataFormat    { channels == 4 ? GL_RGBA  : channels == 3 ? GL_RGB  : c_InvalidValue<RendererEnum> };
+        const auto levelCount{ m_IsMipmapped ? MipChain::GetLevelCount({ width, height, }) : 1u };
+        Texture2D::CreateTexture(levelCount);
 
-        // #1. Weird, idk why.
-        // glTexImage2D(GL_TEXTURE_2D, 0, { static_cast<GLint>(internalFormat) }, { width }, { height }, 0, { dataFormat }, GL_UNSIGNED_BYTE, data);
-        // glGenerateMipmap(GL_TEXTURE_2D);
+        glTextureStorage2D({ m_RendererID }, { static_cast<GLsizei>(levelCount) }, { c_InternalFormat }, { width }, { height });
+        glTextureSubImage2D({ m_RendererID }, 0, 0, 0, { width }, { height }, { c_DataFormat }, GL_UNSIGNED_BYTE, data);
 
-        // #2. Maybe better method.
-        glTextureStorage2D({ m_RendererID }, 1, { internalFormat }, { width }, { height });
-        glTextureSubImage2D({ m_RendererID }, 0, 0, 0, { width }, { height }, { dataFormat }, GL_UNSIGNED_BYTE, data);
-        // glGenerateMipmap(GL_TEXTURE_2D);
+        // Box filtered by the driver, TextureStreamer does it on the CPU instead.
+        if (levelCount > 1u)
+            glGenerateTextureMipmap({ m_RendererID });
 
         stbi_image_free(data);
     }
     else
     {
+        // A single color, minifying it never needs any levels.
+        Texture2D::CreateTexture(1u);
+
         const auto dataSize{ static_cast<std::size_t>(m_Size.x * m_Size.y * 4u) };
-        auto data = new unsigned char[dataSize]{};
-        std::fill(data, data + static_cast<std::ptrdiff_t>(dataSize), 255u);
+        const std::vector<unsigned char> data(dataSize, 255u);
 
         glTextureStorage2D(m_RendererID, 1, { c_InternalFormat }, { static_cast<int>(m_Size.x) }, { static_cast<int>(m_Size.y) });
-        glTextureSubImage2D(m_RendererID, 0, 0, 0, { static_cast<int>(m_Size.x) }, { static_cast<int>(m_Size.y) }, { c_DataFormat }, GL_UNSIGNED_BYTE, data);
-        // glGenerateMipmap(GL_TEXTURE_2D);
+        glTextureSubImage2D(m_RendererID, 0, 0, 0, { static_cast<int>(m_Size.x) }, { static_cast<int>(m_Size.y) }, { c_DataFormat }, GL_UNSIGNED_BYTE, data.data());
+    }
+
+    return true;
+}
+
+std::size_t Texture2D::GetByteSize() const noexcept
+{
+    if (m_RendererID == c_EmptyValue<RendererID>) return 0u;
+
+    std::size_t byteSize{ 0u };
+    for (std::uint32_t level = 0u; level < m_LevelCount; ++level)
+        byteSize += GetFormatImageSize(m_Format, MipChain::GetLevelSize(glm::ivec2{ m_Size }, level));
+
+    return byteSize;
+}
+
+bool Texture2D::AllocateStorage(const glm::ivec2& size, const std::uint32_t levelCount, const TextureFormat format) noexcept
+{
+    if (size.x <= 0 || size.y <= 0 || !levelCount || levelCount > MipChain::GetLevelCount(size)) return false;
+
+    Texture2D::CreateTexture(levelCount);
+
+    m_Size   = glm::vec2{ size };
+    m_Format = format;
+    glTextureStorage2D({ m_RendererID }, { static_cast<GLsizei>(levelCount) }, { static_cast<GLenum>(format) }, { size.x }, { size.y });
+
+    return true;
+}
+
+void Texture2D::SetRows(const std::uint32_t level, const std::uint32_t firstRow, const std::uint32_t rowCount, const void* pixels) const noexcept
+{
+    const auto size{ MipChain::GetLevelSize(glm::ivec2{ m_Size }, level) };
+    Texture2D::UpdateRevision();
+
+    if (!IsBlockCompressed(m_Format))
+    {
+        glTextureSubImage2D({ m_RendererID }, { static_cast<GLint>(level) }, 0, { static_cast<GLint>(firstRow) }, { size.x }, { static_cast<GLsizei>(rowCount) },
+            { c_DataFormat }, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+
+    // Whole blocks, only the last row of them may reach past the edge of the level.
+    const auto y{ static_cast<GLint>(firstRow * 4u) };
+    const auto height{ std::min(static_cast<GLsizei>(rowCount * 4u), size.y - y) };
+    const auto byteSize{ GetFormatRowSize(m_Format, size.x) * rowCount };
+
+    glCompressedTextureSubImage2D({ m_RendererID }, { static_cast<GLint>(level) }, 0, { y }, { size.x }, { height },
+        { static_cast<GLenum>(m_Format) }, { static_cast<GLsizei>(byteSize) }, pixels);
+}
+
+void Texture2D::CopyLevels(const Texture2D& source, const std::uint32_t sourceLevel, const std::uint32_t level, const std::uint32_t count) const noexcept
+{
+    Texture2D::UpdateRevision();
+
+    for (std::uint32_t i = 0u; i < count; ++i)
+    {
+        const auto size{ MipChain::GetLevelSize(glm::ivec2{ m_Size }, level + i) };
+        glCopyImageSubData({ source.m_RendererID }, GL_TEXTURE_2D, { static_cast<GLint>(sourceLevel + i) }, 0, 0, 0,
+            { m_RendererID }, GL_TEXTURE_2D, { static_cast<GLint>(level + i) }, 0, 0, 0, { size.x }, { size.y }, 1);
     }
+}
+
+void Texture2D::Swap(Texture2D& other) noexcept
+{
+    std::swap(m_RendererID, other.m_RendererID);
+    std::swap(m_Size, other.m_Size);
+    std::swap(m_LevelCount, other.m_LevelCount);
+    std::swap(m_Format, other.m_Format);
+
+    Texture2D::UpdateRevision();
+    other.UpdateRevision();
+}
+
+void Texture2D::CreateTexture(const std::uint32_t levelCount) noexcept
+{
+    if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetTexture(m_RendererID);
+        glDeleteTextures(1, &m_RendererID);
+    }
+
+    // Direct state access, the texture bindings of the units stay untouched.
+    glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+    m_LevelCount = levelCount;
+    Texture2D::UpdateRevision();
+
+    glTextureParameteri({ m_RendererID }, GL_TEXTURE_WRAP_S, { static_cast<GLint>(m_Wrapping) });
+    glTextureParameteri({ m_RendererID }, GL_TEXTURE_WRAP_T, { static_cast<GLint>(m_Wrapping) });
+
+    // Trilinear for linear filtering, nearest texels of the nearest level otherwise.
+    const auto minFilter{ levelCount == 1u ? static_cast<GLint>(m_Filtering)
+        : m_Filtering == TextureFiltering::Linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST };
+
+    glTextureParameteri({ m_RendererID }, GL_TEXTURE_MIN_FILTER, { minFilter });
+    glTextureParameteri({ m_RendererID }, GL_TEXTURE_MAG_FILTER, { static_cast<GLint>(m_Filtering) });
+}
+
+void Texture2D::UpdateRevision() const noexcept
+{
+    m_Revision = ++s_LastRevision;
+}
+
+bool Texture2D::UploadLevels(const MipChain& levels) noexcept
+{
+    if (levels.IsEmpty() || !Texture2D::AllocateStorage(levels.GetSize(0u), levels.GetLevelCount(), levels.GetFormat())) return false;
+
+    for (std::uint32_t level = 0u; level < levels.GetLevelCount(); ++level)
+        Texture2D::SetRows(level, 0u, levels.GetRowCount(level), levels.GetPixels(level));
 
     return true;
 }
 
 void Texture2D::Bind() const
 {
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
+    StateCache::Get().BindTexture(GL_TEXTURE_2D, m_RendererID);
+}
+
+void Texture2D::Bind(const std::uint32_t unit) const
+{
+    StateCache::Get().BindTextureUnit(unit, m_RendererID);
 }
 
 void Texture2D::Unbind() const
 {
-    glBindTexture(GL_TEXTURE_2D, 0u);
+    StateCache::Get().BindTexture(GL_TEXTURE_2D, c_EmptyValue<RendererID>);
 }
 
 NAMESPACE_END(Renderer)
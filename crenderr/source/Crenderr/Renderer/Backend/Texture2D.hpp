@@ -3,12 +3,17 @@
 #include "RendererResource.hpp"
 
 #include "Utility/NonCopyable.hpp"
+#include "Utility/Hash.hpp"
 
 #include <glm/glm.hpp>
+
+#include <cstdint>
 #include <string>
 
 NAMESPACE_BEGIN(Renderer)
 
+class MipChain;
+
 enum class TextureWrapping : RendererEnum
 {
     Repeat         = 0x2901,
@@ -23,14 +28,53 @@ enum class TextureFiltering : RendererEnum
     Linear  = 0x2601,
 };
 
+// Internal formats of the storage. The block compressed ones are uploaded as they are and decoded by the GPU on sampling.
+enum class TextureFormat : RendererEnum
+{
+    RGBA8 = 0x8058,
+    BC1   = 0x83F1, // RGB and 1 bit alpha, 8 bytes per 4x4 block. S3TC is an extension, but every desktop driver has it
+    BC3   = 0x83F3, // RGBA, BC1 color and an 8 bit alpha block, 16 bytes
+    BC5   = 0x8DBD, // RG, two alpha style blocks, e.g. normal maps, 16 bytes
+    BC7   = 0x8E8C, // RGBA, 16 bytes
+};
+
+constexpr bool IsBlockCompressed(const TextureFormat format) noexcept
+{
+    return format != TextureFormat::RGBA8;
+}
+
+// Rows of texels, or of 4x4 blocks for compressed formats, in an image this many texels high.
+constexpr std::uint32_t GetFormatRowCount(const TextureFormat format, const int height) noexcept
+{
+    return static_cast<std::uint32_t>(IsBlockCompressed(format) ? (height + 3) / 4 : height);
+}
+
+constexpr std::size_t GetFormatRowSize(const TextureFormat format, const int width) noexcept
+{
+    const auto blockSize{ format == TextureFormat::BC1 ? 8u : 16u };
+    return IsBlockCompressed(format) ? static_cast<std::size_t>((width + 3) / 4) * blockSize : static_cast<std::size_t>(width) * 4u;
+}
+
+constexpr std::size_t GetFormatImageSize(const TextureFormat format, const glm::ivec2& size) noexcept
+{
+    return GetFormatRowSize(format, size.x) * GetFormatRowCount(format, size.y);
+}
+
 struct Texture2DProps
 {
     glm::vec2 Size{ 0u, 0u };
     TextureWrapping Wrapping{ TextureWrapping::Repeat };
     TextureFiltering Filtering{ TextureFiltering::Linear };
     std::string Filepath{ "" };
+
+    // Full chain down to 1x1 for images loaded from a file, OnInitialize() generates it on the GPU.
+    // A .dds file is uploaded block compressed with the levels it comes with.
+    bool Mipmaps{ true };
 };
 
+// Key of a texture in the ResourceCache, the filepath is compared lexically normalized.
+Hash::ValueType GetPropsHash(const Texture2DProps& props) noexcept;
+
 class Texture2D : public RendererResource<Texture2DProps>
 {
 public:
@@ -40,6 +84,16 @@ public:
     inline const auto& GetSize() const noexcept { return m_Size; }
     inline auto GetWidth() const noexcept { return m_Size.x; }
     inline auto GetHeight() const noexcept { return m_Size.y; }
+    inline auto GetLevelCount() const noexcept { return m_LevelCount; }
+    inline auto GetFormat() const noexcept { return m_Format; }
+    inline auto GetWrapping() const noexcept { return m_Wrapping; }
+    inline auto GetFiltering() const noexcept { return m_Filtering; }
+
+    // Changes with the GL object and with every write to it, never the same for two textures. Lets copies of the texture tell they are stale.
+    inline auto GetRevision() const noexcept { return m_Revision; }
+
+    // GPU memory of every level, 0 before OnInitialize().
+    std::size_t GetByteSize() const noexcept;
 
 public:
     virtual bool OnInitialize() noexcept override;
@@ -48,17 +102,50 @@ public:
     virtual void Bind() const override;
     virtual void Unbind() const override;
 
+    // Binds to the given texture unit, the active one is left as it is.
+    void Bind(const std::uint32_t unit) const;
+
+public:
+    /**
+     * Recreates the texture as storage of the given size, level count and format without any contents,
+     * for images uploaded in pieces with SetRows(). Anything holding the old handle keeps sampling the
+     * old object until it is deleted, so a texture in use is better streamed into a second one and Swap()ped in.
+     */
+    bool AllocateStorage(const glm::ivec2& size, const std::uint32_t levelCount = 1u, const TextureFormat format = TextureFormat::RGBA8) noexcept;
+
+    // Tightly packed rows [firstRow, firstRow + rowCount) of a level, rows of blocks for compressed formats.
+    // With a pixel unpack buffer bound, pixels is an offset into it.
+    void SetRows(const std::uint32_t level, const std::uint32_t firstRow, const std::uint32_t rowCount, const void* pixels) const noexcept;
+
+    // GPU side copy of count levels starting at sourceLevel of the source into the ones starting at level, the sizes have to match.
+    void CopyLevels(const Texture2D& source, const std::uint32_t sourceLevel, const std::uint32_t level, const std::uint32_t count) const noexcept;
+
+    // Exchanges the GL objects, e.g. to replace a placeholder with the texture streamed in behind it.
+    void Swap(Texture2D& other) noexcept;
+
 public:
     inline virtual RendererID GetResourceHandle() const override { return m_RendererID; }
 
+private:
+    // Deletes the current object and creates an empty one with the wrapping and filtering applied.
+    void CreateTexture(const std::uint32_t levelCount) noexcept;
+    void UpdateRevision() const noexcept;
+
+    // Allocates and uploads every level of a chain, e.g. one read from a .dds file.
+    bool UploadLevels(const MipChain& levels) noexcept;
+
 private:
     RendererID m_RendererID{ c_EmptyValue<RendererID> };
 
     std::string m_Filepath{};
     glm::vec2 m_Size{};
+    std::uint32_t m_LevelCount{ 1u };
+    TextureFormat m_Format{ TextureFormat::RGBA8 };
+    mutable std::uint64_t m_Revision{ 0u }; // SetRows() and CopyLevels() write through const textures
 
     TextureWrapping m_Wrapping{};
     TextureFiltering m_Filtering{};
+    bool m_IsMipmapped{};
 };
 
 NAMESPACE_END(Renderer)
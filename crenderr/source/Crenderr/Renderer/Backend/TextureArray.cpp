@@ -0,0 +1,139 @@
+#include "TextureArray.hpp"
+
+#include "StateCache.hpp"
+
+#include "Renderer/MipChain.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+NAMESPACE_BEGIN(Renderer)
+
+TextureArray::TextureArray(const TextureArrayProps& props)
+    : m_Props{ props } {}
+
+TextureArray::~TextureArray()
+{
+    TextureArray::DeleteTexture();
+}
+
+std::size_t TextureArray::GetByteSize() const noexcept
+{
+    std::size_t byteSize{ 0u };
+    for (std::uint32_t level = 0u; level < m_Props.LevelCount; ++level)
+        byteSize += GetFormatImageSize(m_Props.Format, MipChain::GetLevelSize(m_Props.Size, level));
+
+    return byteSize * m_Props.LayerCount;
+}
+
+bool TextureArray::IsCompatible(const Texture2D& texture) const noexcept
+{
+    return glm::ivec2{ texture.GetSize() } == m_Props.Size
+        && texture.GetLevelCount() == m_Props.LevelCount
+        && texture.GetFormat() == m_Props.Format
+        && texture.GetWrapping() == m_Props.Wrapping
+        && texture.GetFiltering() == m_Props.Filtering;
+}
+
+bool TextureArray::OnInitialize() noexcept
+{
+    if (m_Props.Size.x <= 0 || m_Props.Size.y <= 0 || !m_Props.LayerCount
+        || !m_Props.LevelCount || m_Props.LevelCount > MipChain::GetLevelCount(m_Props.Size))
+    {
+        spdlog::error("[TextureArray]: Invalid storage of {} layers, {}x{} with {} levels!",
+            m_Props.LayerCount, m_Props.Size.x, m_Props.Size.y, m_Props.LevelCount);
+        return false;
+    }
+
+    TextureArray::DeleteTexture();
+    m_RendererID = TextureArray::CreateTexture(m_Props, m_Props.LayerCount);
+
+    return true;
+}
+
+bool TextureArray::Resize(const std::uint32_t layerCount) noexcept
+{
+    if (!layerCount) return false;
+    if (layerCount == m_Props.LayerCount) return true;
+
+    const auto rendererID{ TextureArray::CreateTexture(m_Props, layerCount) };
+
+    // All the common layers of a level go in one call.
+    const auto copiedLayers{ std::min(layerCount, m_Props.LayerCount) };
+    for (std::uint32_t level = 0u; level < m_Props.LevelCount && m_RendererID != c_EmptyValue<RendererID>; ++level)
+    {
+        const auto size{ MipChain::GetLevelSize(m_Props.Size, level) };
+        glCopyImageSubData({ m_RendererID }, GL_TEXTURE_2D_ARRAY, { static_cast<GLint>(level) }, 0, 0, 0,
+            { rendererID }, GL_TEXTURE_2D_ARRAY, { static_cast<GLint>(level) }, 0, 0, 0, { size.x }, { size.y }, { static_cast<GLsizei>(copiedLayers) });
+    }
+
+    TextureArray::DeleteTexture();
+    m_RendererID       = rendererID;
+    m_Props.LayerCount = layerCount;
+
+    return true;
+}
+
+bool TextureArray::CopyLayer(const Texture2D& source, const std::uint32_t layer) const noexcept
+{
+    if (layer >= m_Props.LayerCount || !TextureArray::IsCompatible(source) || source.GetResourceHandle() == c_EmptyValue<RendererID>) return false;
+
+    for (std::uint32_t level = 0u; level < m_Props.LevelCount; ++level)
+    {
+        const auto size{ MipChain::GetLevelSize(m_Props.Size, level) };
+        glCopyImageSubData({ source.GetResourceHandle() }, GL_TEXTURE_2D, { static_cast<GLint>(level) }, 0, 0, 0,
+            { m_RendererID }, GL_TEXTURE_2D_ARRAY, { static_cast<GLint>(level) }, 0, 0, { static_cast<GLint>(layer) }, { size.x }, { size.y }, 1);
+    }
+
+    return true;
+}
+
+void TextureArray::Bind() const
+{
+    StateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+}
+
+void TextureArray::Bind(const std::uint32_t unit) const
+{
+    StateCache::Get().BindTextureUnit(unit, m_RendererID);
+}
+
+void TextureArray::Unbind() const
+{
+    StateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, c_EmptyValue<RendererID>);
+}
+
+RendererID TextureArray::CreateTexture(const TextureArrayProps& props, const std::uint32_t layerCount) noexcept
+{
+    RendererID rendererID{ c_EmptyValue<RendererID> };
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &rendererID);
+
+    glTextureParameteri({ rendererID }, GL_TEXTURE_WRAP_S, { static_cast<GLint>(props.Wrapping) });
+    glTextureParameteri({ rendererID }, GL_TEXTURE_WRAP_T, { static_cast<GLint>(props.Wrapping) });
+
+    // Same filters a Texture2D of these props gets.
+    const auto minFilter{ props.LevelCount == 1u ? static_cast<GLint>(props.Filtering)
+        : props.Filtering == TextureFiltering::Linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_NEAREST };
+
+    glTextureParameteri({ rendererID }, GL_TEXTURE_MIN_FILTER, { minFilter });
+    glTextureParameteri({ rendererID }, GL_TEXTURE_MAG_FILTER, { static_cast<GLint>(props.Filtering) });
+
+    glTextureStorage3D({ rendererID }, { static_cast<GLsizei>(props.LevelCount) }, { static_cast<GLenum>(props.Format) },
+        { props.Size.x }, { props.Size.y }, { static_cast<GLsizei>(layerCount) });
+
+    return rendererID;
+}
+
+void TextureArray::DeleteTexture() noexcept
+{
+    if (m_RendererID == c_EmptyValue<RendererID>) return;
+
+    StateCache::Get().ForgetTexture(m_RendererID);
+    glDeleteTextures(1, &m_RendererID);
+    m_RendererID = c_EmptyValue<RendererID>;
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "RendererResource.hpp"
+#include "Texture2D.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+NAMESPACE_BEGIN(Renderer)
+
+struct TextureArrayProps
+{
+    glm::ivec2 Size{ 1, 1 };
+    std::uint32_t LevelCount{ 1u };
+    std::uint32_t LayerCount{ 1u };
+    TextureFormat Format{ TextureFormat::RGBA8 };
+    TextureWrapping Wrapping{ TextureWrapping::Repeat };
+    TextureFiltering Filtering{ TextureFiltering::Linear };
+};
+
+// GL_TEXTURE_2D_ARRAY of equally sized layers, sampled with the layer as the third coordinate.
+class TextureArray : public RendererResource<TextureArrayProps>
+{
+public:
+    explicit TextureArray(const TextureArrayProps& props);
+    ~TextureArray();
+
+    inline const auto& GetSize() const noexcept { return m_Props.Size; }
+    inline auto GetLevelCount() const noexcept { return m_Props.LevelCount; }
+    inline auto GetLayerCount() const noexcept { return m_Props.LayerCount; }
+    inline auto GetFormat() const noexcept { return m_Props.Format; }
+    inline auto GetWrapping() const noexcept { return m_Props.Wrapping; }
+    inline auto GetFiltering() const noexcept { return m_Props.Filtering; }
+
+    // GPU memory of every level of every layer.
+    std::size_t GetByteSize() const noexcept;
+
+    // Whether a texture fits a layer as it is: same size, level count, format and sampling.
+    bool IsCompatible(const Texture2D& texture) const noexcept;
+
+public:
+    virtual bool OnInitialize() noexcept override;
+
+public:
+    virtual void Bind() const override;
+    virtual void Unbind() const override;
+
+    // Binds to the given texture unit, the active one is left as it is.
+    void Bind(const std::uint32_t unit) const;
+
+public:
+    // Recreates the storage with layerCount layers, the layers both have in common are copied over on the GPU. The handle changes.
+    bool Resize(const std::uint32_t layerCount) noexcept;
+
+    // GPU side copy of every level of a compatible texture into the layer.
+    bool CopyLayer(const Texture2D& source, const std::uint32_t layer) const noexcept;
+
+public:
+    inline virtual RendererID GetResourceHandle() const override { return m_RendererID; }
+
+private:
+    // An empty texture with the sampling parameters set and storage for layerCount layers.
+    static RendererID CreateTexture(const TextureArrayProps& props, const std::uint32_t layerCount) noexcept;
+    void DeleteTexture() noexcept;
+
+private:
+    TextureArrayProps m_Props{};
+    RendererID m_RendererID{ c_EmptyValue<RendererID> };
+};
+
+NAMESPACE_END(Renderer)
@@ -1,5 +1,7 @@
 #include "VertexArray.hpp"
 
+#include "StateCache.hpp"
+
 #include <glad/glad.h>
 
 #include <spdlog/spdlog.h>
@@ -26,27 +28,43 @@ namespace Internal
         case LayoutDataType::Mat3:
         case LayoutDataType::Mat4: return GL_FLOAT;
 
+        case LayoutDataType::Half2:
+        case LayoutDataType::Half4: return GL_HALF_FLOAT;
+
+        case LayoutDataType::Short2Norm:
+        case LayoutDataType::Short4Norm: return GL_SHORT;
+
+        case LayoutDataType::UShort2Norm: return GL_UNSIGNED_SHORT;
+
+        case LayoutDataType::Int2101010Norm: return GL_INT_2_10_10_10_REV;
+
         default: return c_InvalidValue<RendererEnum>;
         }
     }
 }
 
 VertexArray::VertexArray(const VertexArrayProps& props)
-    : m_VertexBuffer{ props.VertexBufferPtr }, m_IndexBuffer{ props.IndexBufferPtr } {}
+    : m_VertexBuffer{ props.VertexBufferPtr }, m_IndexBuffer{ props.IndexBufferPtr }, m_BaseTransform{ props.BaseTransform }, m_Bounds{ props.Bounds } {}
 
 VertexArray::~VertexArray()
 {
     if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetVertexArray(m_RendererID);
         glDeleteVertexArrays(1, &m_RendererID);
+    }
 }
 
 bool VertexArray::OnInitialize() noexcept
 {
     if (m_RendererID != c_EmptyValue<RendererID>)
+    {
+        StateCache::Get().ForgetVertexArray(m_RendererID);
         glDeleteVertexArrays(1, &m_RendererID);
+    }
 
     glCreateVertexArrays(1, &m_RendererID);
-    glBindVertexArray(m_RendererID);
+    StateCache::Get().BindVertexArray(m_RendererID);
 
     if (!m_VertexBuffer.get() || m_VertexBuffer->GetLayout().GetElements().empty()) return false;
 
@@ -83,12 +101,12 @@ bool VertexArray::OnInitialize() noexcept
 
 void VertexArray::Bind() const
 {
-    glBindVertexArray(m_RendererID);
+    StateCache::Get().BindVertexArray(m_RendererID);
 }
 
 void VertexArray::Unbind() const
 {
-    glBindVertexArray(c_EmptyValue<RendererID>);
+    StateCache::Get().BindVertexArray(c_EmptyValue<RendererID>);
 }
 
 NAMESPACE_END(Renderer)
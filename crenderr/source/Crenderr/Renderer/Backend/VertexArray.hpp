@@ -3,12 +3,22 @@
 #include "RendererResource.hpp"
 #include "Buffers.hpp"
 
+#include "Renderer/Bounds.hpp"
+
+#include <glm/glm.hpp>
+
 NAMESPACE_BEGIN(Renderer)
 
 struct VertexArrayProps
 {
     std::shared_ptr<VertexBuffer> VertexBufferPtr;
     std::shared_ptr<IndexBuffer> IndexBufferPtr;
+
+    // Object space transform applied before the model matrix, e.g. dequantization of packed positions.
+    glm::mat4 BaseTransform{ 1.0f };
+
+    // Object space, before the BaseTransform is applied.
+    MeshBounds Bounds{};
 };
 
 class VertexArray : public RendererResource<VertexArrayProps>
@@ -19,6 +29,14 @@ public:
 
     inline const auto& GetVertexBuffer() const noexcept { return m_VertexBuffer; }
     inline const auto& GetIndexBuffer() const noexcept { return m_IndexBuffer; }
+    inline const auto& GetBaseTransform() const noexcept { return m_BaseTransform; }
+    inline const auto& GetBounds() const noexcept { return m_Bounds; }
+
+    // GPU memory of both buffers.
+    inline std::size_t GetByteSize() const noexcept
+    {
+        return (m_VertexBuffer ? m_VertexBuffer->GetByteSize() : 0u) + (m_IndexBuffer ? m_IndexBuffer->GetByteSize() : 0u);
+    }
 
 public:
     virtual bool OnInitialize() noexcept;
@@ -34,6 +52,8 @@ private:
     RendererID m_RendererID{ c_EmptyValue<RendererID> };
     std::shared_ptr<VertexBuffer> m_VertexBuffer;
     std::shared_ptr<IndexBuffer> m_IndexBuffer;
+    glm::mat4 m_BaseTransform{ 1.0f };
+    MeshBounds m_Bounds{};
 };
 
 NAMESPACE_END(Renderer)
@@ -0,0 +1,466 @@
+#include "BlockCompression.hpp"
+
+#include "Utility/ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    constexpr int c_BlockSide{ 4 };
+    constexpr int c_BlockTexels{ c_BlockSide * c_BlockSide };
+
+    // Row major, 0-255 per channel.
+    using Block = std::array<glm::vec4, c_BlockTexels>;
+
+    // The 4 bit index weights of BC7, out of 64.
+    constexpr std::array<int, 16u> c_Weights4{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    static void LoadBlock(const std::uint8_t* pixels, const glm::ivec2& size, const int blockX, const int blockY, Block& block) noexcept
+    {
+        for (int y = 0; y < c_BlockSide; ++y)
+        {
+            const auto sourceY{ std::min(blockY * c_BlockSide + y, size.y - 1) };
+            for (int x = 0; x < c_BlockSide; ++x)
+            {
+                const auto sourceX{ std::min(blockX * c_BlockSide + x, size.x - 1) };
+                const auto* texel{ pixels + (static_cast<std::size_t>(sourceY) * size.x + sourceX) * 4u };
+
+                block[y * c_BlockSide + x] = glm::vec4{ glm::u8vec4{ texel[0], texel[1], texel[2], texel[3], } };
+            }
+        }
+    }
+
+    static inline float GetError(const glm::vec4& a, const glm::vec4& b, const glm::vec4& mask) noexcept
+    {
+        const auto difference{ (a - b) * mask };
+        return glm::dot(difference, difference);
+    }
+
+    /**
+     * Ends of the segment the texels spread along, in the channels the mask keeps. The direction is the
+     * principal axis of their covariance, found by power iteration, the ends are the extreme projections.
+     */
+    static void FitLine(const glm::vec4* texels, const int count, const glm::vec4& mask, glm::vec4& low, glm::vec4& high) noexcept
+    {
+        glm::vec4 mean{ 0.0f };
+        glm::vec4 minimum{ std::numeric_limits<float>::max() }, maximum{ std::numeric_limits<float>::lowest() };
+
+        for (int i = 0; i < count; ++i)
+        {
+            mean += texels[i];
+            minimum = glm::min(minimum, texels[i]);
+            maximum = glm::max(maximum, texels[i]);
+        }
+        mean = mean / static_cast<float>(count) * mask;
+
+        glm::mat4 covariance{ 0.0f };
+        for (int i = 0; i < count; ++i)
+        {
+            const auto difference{ texels[i] * mask - mean };
+            for (int column = 0; column < 4; ++column)
+                covariance[column] += difference * difference[column];
+        }
+
+        // The bounding box diagonal is a good first guess and never orthogonal to the axis in practice.
+        auto axis{ (maximum - minimum) * mask };
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            axis = covariance * axis;
+
+            const auto largest{ std::max({ std::abs(axis.x), std::abs(axis.y), std::abs(axis.z), std::abs(axis.w) }) };
+            if (largest < 1e-6f) break;
+            axis /= largest;
+        }
+
+        const auto length{ glm::length(axis) };
+        if (length < 1e-6f)
+        {
+            low = high = mean;
+            return;
+        }
+        axis /= length;
+
+        auto lowest{ std::numeric_limits<float>::max() }, highest{ std::numeric_limits<float>::lowest() };
+        for (int i = 0; i < count; ++i)
+        {
+            const auto projection{ glm::dot(texels[i] * mask - mean, axis) };
+            lowest  = std::min(lowest, projection);
+            highest = std::max(highest, projection);
+        }
+
+        low  = glm::clamp(mean + axis * lowest,  glm::vec4{ 0.0f }, glm::vec4{ 255.0f });
+        high = glm::clamp(mean + axis * highest, glm::vec4{ 0.0f }, glm::vec4{ 255.0f });
+    }
+
+    // Least squares endpoints for texels at fractions weights of the way from first to second. False when the weights do not pin them down.
+    static bool SolveEndpoints(const glm::vec4* texels, const float* weights, const int count, glm::vec4& first, glm::vec4& second) noexcept
+    {
+        float a{ 0.0f }, b{ 0.0f }, c{ 0.0f };
+        glm::vec4 firstSum{ 0.0f }, secondSum{ 0.0f };
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto t{ weights[i] };
+            a += (1.0f - t) * (1.0f - t);
+            b += (1.0f - t) * t;
+            c += t * t;
+
+            firstSum  += (1.0f - t) * texels[i];
+            secondSum += t * texels[i];
+        }
+
+        const auto determinant{ a * c - b * b };
+        if (std::abs(determinant) < 1e-6f) return false;
+
+        first  = glm::clamp((c * firstSum - b * secondSum) / determinant, glm::vec4{ 0.0f }, glm::vec4{ 255.0f });
+        second = glm::clamp((a * secondSum - b * firstSum) / determinant, glm::vec4{ 0.0f }, glm::vec4{ 255.0f });
+        return true;
+    }
+
+    static std::uint16_t PackColor565(const glm::vec4& color) noexcept
+    {
+        const auto r{ static_cast<std::uint16_t>(std::lround(std::clamp(color.r, 0.0f, 255.0f) * 31.0f / 255.0f)) };
+        const auto g{ static_cast<std::uint16_t>(std::lround(std::clamp(color.g, 0.0f, 255.0f) * 63.0f / 255.0f)) };
+        const auto b{ static_cast<std::uint16_t>(std::lround(std::clamp(color.b, 0.0f, 255.0f) * 31.0f / 255.0f)) };
+
+        return static_cast<std::uint16_t>(r << 11u | g << 5u | b);
+    }
+
+    static glm::vec4 UnpackColor565(const std::uint16_t color) noexcept
+    {
+        const auto r{ (color >> 11u) & 31u }, g{ (color >> 5u) & 63u }, b{ color & 31u };
+        return glm::vec4{ glm::uvec4{ (r << 3u) | (r >> 2u), (g << 2u) | (g >> 4u), (b << 3u) | (b >> 2u), 255u, } };
+    }
+
+    /**
+     * BC1 color block, 8 bytes. With four colors c0 > c1 and the two in between are interpolated,
+     * otherwise there is a single midpoint and index 3 is transparent black.
+     */
+    static void EncodeColorBlock(const Block& block, const bool allowTransparent, std::uint8_t* destination) noexcept
+    {
+        constexpr glm::vec4 c_Mask{ 1.0f, 1.0f, 1.0f, 0.0f };
+
+        std::array<glm::vec4, c_BlockTexels> opaque{};
+        std::array<bool, c_BlockTexels> isTransparent{};
+        int opaqueCount{ 0 };
+
+        for (int i = 0; i < c_BlockTexels; ++i)
+        {
+            isTransparent[i] = allowTransparent && block[i].a < 128.0f;
+            if (!isTransparent[i]) opaque[opaqueCount++] = block[i];
+        }
+
+        const auto isFourColor{ opaqueCount == c_BlockTexels };
+
+        std::uint16_t bestColors[2]{};
+        std::uint32_t bestIndices{ 0xFFFFFFFFu };
+        auto bestError{ std::numeric_limits<float>::max() };
+
+        glm::vec4 low{ 0.0f }, high{ 0.0f };
+        if (opaqueCount) Internal::FitLine(opaque.data(), opaqueCount, c_Mask, low, high);
+
+        // The fitted endpoints first, then the least squares ones of the indices they produced.
+        for (int pass = 0; pass < 2 && opaqueCount; ++pass)
+        {
+            auto color0{ Internal::PackColor565(high) }, color1{ Internal::PackColor565(low) };
+            if (isFourColor ? color0 < color1 : color0 > color1) std::swap(color0, color1);
+
+            const auto endpoint0{ Internal::UnpackColor565(color0) }, endpoint1{ Internal::UnpackColor565(color1) };
+
+            std::array<glm::vec4, 4u> palette{ endpoint0, endpoint1, };
+            std::array<float, 4u> fractions{ 0.0f, 1.0f, };
+            if (isFourColor)
+            {
+                palette[2] = (2.0f * endpoint0 + endpoint1) / 3.0f; fractions[2] = 1.0f / 3.0f;
+                palette[3] = (endpoint0 + 2.0f * endpoint1) / 3.0f; fractions[3] = 2.0f / 3.0f;
+            }
+            else
+            {
+                palette[2] = (endpoint0 + endpoint1) * 0.5f; fractions[2] = 0.5f;
+            }
+
+            // Equal endpoints in four color mode would read as the three color one, every texel takes the first.
+            const auto paletteSize{ color0 == color1 ? 1 : isFourColor ? 4 : 3 };
+
+            std::uint32_t indices{ 0u };
+            std::array<float, c_BlockTexels> weights{};
+            float error{ 0.0f };
+            int weightCount{ 0 };
+
+            for (int i = 0; i < c_BlockTexels; ++i)
+            {
+                auto index{ 3 };
+                if (!isTransparent[i])
+                {
+                    auto closest{ std::numeric_limits<float>::max() };
+                    for (int entry = 0; entry < paletteSize; ++entry)
+                    {
+                        const auto entryError{ Internal::GetError(block[i], palette[entry], c_Mask) };
+                        if (entryError < closest)
+                        {
+                            closest = entryError;
+                            index   = entry;
+                        }
+                    }
+
+                    error += closest;
+                    weights[weightCount++] = fractions[index];
+                }
+
+                indices |= static_cast<std::uint32_t>(index) << (2u * i);
+            }
+
+            if (error < bestError)
+            {
+                bestError      = error;
+                bestColors[0]  = color0;
+                bestColors[1]  = color1;
+                bestIndices    = indices;
+            }
+
+            if (!Internal::SolveEndpoints(opaque.data(), weights.data(), opaqueCount, high, low)) break;
+        }
+
+        std::memcpy(destination, bestColors, sizeof(bestColors));
+        std::memcpy(destination + sizeof(bestColors), &bestIndices, sizeof(bestIndices));
+    }
+
+    // BC4 block of one channel, 8 bytes. Eight values between a0 > a1, 3 bit indices of the texels after the endpoints.
+    static void EncodeChannelBlock(const Block& block, const int channel, std::uint8_t* destination) noexcept
+    {
+        auto minimum{ 255.0f }, maximum{ 0.0f };
+        for (const auto& texel : block)
+        {
+            minimum = std::min(minimum, texel[channel]);
+            maximum = std::max(maximum, texel[channel]);
+        }
+
+        const auto value0{ static_cast<std::uint8_t>(std::lround(maximum)) };
+        const auto value1{ static_cast<std::uint8_t>(std::lround(minimum)) };
+
+        std::array<float, 8u> palette{ static_cast<float>(value0), static_cast<float>(value1), };
+        for (int i = 2; i < 8; ++i)
+            palette[i] = static_cast<float>(((8 - i) * value0 + (i - 1) * value1) / 7);
+
+        std::uint64_t indices{ 0u };
+        if (value0 != value1)
+        {
+            for (int i = 0; i < c_BlockTexels; ++i)
+            {
+                auto index{ 0 };
+                for (int entry = 1; entry < 8; ++entry)
+                    if (std::abs(block[i][channel] - palette[entry]) < std::abs(block[i][channel] - palette[index])) index = entry;
+
+                indices |= static_cast<std::uint64_t>(index) << (3u * i);
+            }
+        }
+
+        destination[0] = value0;
+        destination[1] = value1;
+        for (int i = 0; i < 6; ++i)
+            destination[2 + i] = static_cast<std::uint8_t>(indices >> (8u * i));
+    }
+
+    struct BitWriter
+    {
+        std::uint8_t* Data{ nullptr };
+        std::uint32_t Position{ 0u };
+
+        inline void Write(const std::uint32_t value, const std::uint32_t bitCount) noexcept
+        {
+            for (std::uint32_t i = 0u; i < bitCount; ++i, ++Position)
+                Data[Position >> 3u] |= static_cast<std::uint8_t>(((value >> i) & 1u) << (Position & 7u));
+        }
+    };
+
+    // 7 bits per channel and a shared lowest bit per endpoint, whichever of the two lands closer.
+    static void QuantizeEndpoint(const glm::vec4& endpoint, glm::ivec4& quantized, int& parity) noexcept
+    {
+        auto bestError{ std::numeric_limits<float>::max() };
+        for (int bit = 0; bit < 2; ++bit)
+        {
+            const auto candidate{ glm::clamp(glm::ivec4{ glm::round((endpoint - static_cast<float>(bit)) * 0.5f) }, glm::ivec4{ 0 }, glm::ivec4{ 127 }) };
+            const auto error{ Internal::GetError(glm::vec4{ candidate * 2 + bit }, endpoint, glm::vec4{ 1.0f }) };
+            if (error < bestError)
+            {
+                bestError = error;
+                quantized = candidate;
+                parity    = bit;
+            }
+        }
+    }
+
+    // BC7 mode 6, 16 bytes: one RGBA line, 7 bit endpoints with a parity bit each and 4 bit indices.
+    static void EncodeMode6Block(const Block& block, std::uint8_t* destination) noexcept
+    {
+        constexpr glm::vec4 c_Mask{ 1.0f };
+
+        glm::vec4 low{}, high{};
+        Internal::FitLine(block.data(), c_BlockTexels, c_Mask, low, high);
+
+        glm::ivec4 bestEndpoints[2]{};
+        int bestParities[2]{};
+        std::array<int, c_BlockTexels> bestIndices{};
+        auto bestError{ std::numeric_limits<float>::max() };
+
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            glm::ivec4 endpoints[2]{};
+            int parities[2]{};
+            Internal::QuantizeEndpoint(low,  endpoints[0], parities[0]);
+            Internal::QuantizeEndpoint(high, endpoints[1], parities[1]);
+
+            const auto endpoint0{ endpoints[0] * 2 + parities[0] }, endpoint1{ endpoints[1] * 2 + parities[1] };
+
+            std::array<glm::vec4, 16u> palette{};
+            for (std::size_t i = 0u; i < palette.size(); ++i)
+                palette[i] = glm::vec4{ ((64 - c_Weights4[i]) * endpoint0 + c_Weights4[i] * endpoint1 + 32) >> 6 };
+
+            std::array<int, c_BlockTexels> indices{};
+            std::array<float, c_BlockTexels> weights{};
+            float error{ 0.0f };
+
+            for (int i = 0; i < c_BlockTexels; ++i)
+            {
+                auto closest{ std::numeric_limits<float>::max() };
+                for (int entry = 0; entry < 16; ++entry)
+                {
+                    const auto entryError{ Internal::GetError(block[i], palette[entry], c_Mask) };
+                    if (entryError < closest)
+                    {
+                        closest    = entryError;
+                        indices[i] = entry;
+                    }
+                }
+
+                error += closest;
+                weights[i] = static_cast<float>(c_Weights4[indices[i]]) / 64.0f;
+            }
+
+            if (error < bestError)
+            {
+                bestError        = error;
+                bestEndpoints[0] = endpoints[0];
+                bestEndpoints[1] = endpoints[1];
+                bestParities[0]  = parities[0];
+                bestParities[1]  = parities[1];
+                bestIndices      = indices;
+            }
+
+            if (!Internal::SolveEndpoints(block.data(), weights.data(), c_BlockTexels, low, high)) break;
+        }
+
+        // The first texel's index is stored without its top bit, the line is flipped when that bit would be set.
+        if (bestIndices[0] >= 8)
+        {
+            std::swap(bestEndpoints[0], bestEndpoints[1]);
+            std::swap(bestParities[0], bestParities[1]);
+            for (auto& index : bestIndices)
+                index = 15 - index;
+        }
+
+        std::memset(destination, 0, 16u);
+        Internal::BitWriter writer{ .Data = destination };
+
+        writer.Write(1u << 6u, 7u);
+        for (int channel = 0; channel < 4; ++channel)
+        {
+            writer.Write(static_cast<std::uint32_t>(bestEndpoints[0][channel]), 7u);
+            writer.Write(static_cast<std::uint32_t>(bestEndpoints[1][channel]), 7u);
+        }
+
+        writer.Write(static_cast<std::uint32_t>(bestParities[0]), 1u);
+        writer.Write(static_cast<std::uint32_t>(bestParities[1]), 1u);
+
+        for (int i = 0; i < c_BlockTexels; ++i)
+            writer.Write(static_cast<std::uint32_t>(bestIndices[i]), i ? 4u : 3u);
+    }
+
+    static void CompressBlockRow(const std::uint8_t* pixels, const glm::ivec2& size, const TextureFormat format, const int blockY, std::uint8_t* destination) noexcept
+    {
+        const auto blockSize{ GetFormatRowSize(format, c_BlockSide) };
+        const auto blockCount{ (size.x + c_BlockSide - 1) / c_BlockSide };
+
+        Block block{};
+        for (int blockX = 0; blockX < blockCount; ++blockX, destination += blockSize)
+        {
+            Internal::LoadBlock(pixels, size, blockX, blockY, block);
+
+            switch (format)
+            {
+            case TextureFormat::BC1:
+                Internal::EncodeColorBlock(block, true, destination);
+                break;
+
+            case TextureFormat::BC3:
+                Internal::EncodeChannelBlock(block, 3, destination);
+                Internal::EncodeColorBlock(block, false, destination + 8u);
+                break;
+
+            case TextureFormat::BC5:
+                Internal::EncodeChannelBlock(block, 0, destination);
+                Internal::EncodeChannelBlock(block, 1, destination + 8u);
+                break;
+
+            case TextureFormat::BC7:
+                Internal::EncodeMode6Block(block, destination);
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+}
+
+void CompressImage(const std::uint8_t* pixels, const glm::ivec2& size, const TextureFormat format, std::uint8_t* destination) noexcept
+{
+    if (!IsBlockCompressed(format))
+    {
+        std::memcpy(destination, pixels, GetFormatImageSize(format, size));
+        return;
+    }
+
+    const auto rowSize{ GetFormatRowSize(format, size.x) };
+    for (std::uint32_t row = 0u; row < GetFormatRowCount(format, size.y); ++row)
+        Internal::CompressBlockRow(pixels, size, format, static_cast<int>(row), destination + row * rowSize);
+}
+
+bool CompressMipChain(const MipChain& source, const TextureFormat format, MipChain& destination)
+{
+    if (source.IsEmpty() || source.GetFormat() != TextureFormat::RGBA8) return false;
+
+    std::vector<std::uint8_t> blocks{};
+    for (std::uint32_t level = 0u; level < source.GetLevelCount(); ++level)
+    {
+        const auto& size{ source.GetSize(level) };
+        const auto rowSize{ GetFormatRowSize(format, size.x) };
+        const auto offset{ blocks.size() };
+
+        blocks.resize(offset + GetFormatImageSize(format, size));
+
+        auto* levelBlocks{ blocks.data() + offset };
+        const auto* pixels{ source.GetPixels(level) };
+
+        if (!IsBlockCompressed(format))
+        {
+            std::memcpy(levelBlocks, pixels, GetFormatImageSize(format, size));
+            continue;
+        }
+
+        ThreadPool::GetShared().ParallelFor(GetFormatRowCount(format, size.y), [&](const std::size_t row) {
+            Internal::CompressBlockRow(pixels, size, format, static_cast<int>(row), levelBlocks + row * rowSize);
+        });
+    }
+
+    return destination.Assign(format, source.GetSize(0u), source.GetLevelCount(), blocks.data(), blocks.size());
+}
+
+NAMESPACE_END(Renderer)
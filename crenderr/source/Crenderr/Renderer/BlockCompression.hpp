@@ -0,0 +1,33 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/MipChain.hpp"
+#include "Renderer/Backend/Texture2D.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+NAMESPACE_BEGIN(Renderer)
+
+/**
+ * CPU encoders of the block compressed formats, meant for converting textures ahead of time. Every
+ * 4x4 block is fitted on its own: the endpoints start at the ends of the texels' principal axis, each
+ * texel takes the closest palette entry and a least squares pass moves the endpoints towards the
+ * texels that picked them.
+ *
+ *   BC1 - RGB, a block with a texel below 128 alpha switches to the punch-through mode
+ *   BC3 - BC1 color and the alpha in its own 8 value block
+ *   BC5 - red and green as two of those blocks, blue and alpha are dropped
+ *   BC7 - mode 6 only, one RGBA line with 16 steps. Gradients come out far better than BC1,
+ *         sharp multi-colored blocks lose more than a full mode search would
+ *
+ * Blocks reaching past the edge of the image repeat its last row and column.
+ */
+void CompressImage(const std::uint8_t* pixels, const glm::ivec2& size, const TextureFormat format, std::uint8_t* destination) noexcept;
+
+// Every level of an RGBA8 chain, the rows of blocks are spread over the shared thread pool.
+bool CompressMipChain(const MipChain& source, const TextureFormat format, MipChain& destination);
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,519 @@
+#include "BoundingVolumeHierarchy.hpp"
+
+#include "Utility/ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    static constexpr std::uint32_t c_BinCount{ 16u };
+
+    // Below this the build stays on the calling thread, handing the work out costs more than it saves.
+    static constexpr std::uint32_t c_MinParallelObjects{ 16384u };
+
+    struct Bin
+    {
+        BoundingBox Bounds{ BoundingBox::Empty() };
+        std::uint32_t Count{ 0u };
+    };
+
+    static inline std::uint32_t GetBinIndex(const float center, const float min, const float scale) noexcept
+    {
+        const auto bin{ static_cast<std::int32_t>((center - min) * scale) };
+        return static_cast<std::uint32_t>(std::clamp(bin, 0, static_cast<std::int32_t>(c_BinCount) - 1));
+    }
+}
+
+void BoundingVolumeHierarchy::Build(std::span<const BoundingBox> bounds)
+{
+    BoundingVolumeHierarchy::Clear();
+    if (bounds.empty()) return;
+
+    const auto objectCount{ static_cast<std::uint32_t>(bounds.size()) };
+
+    // Partitioning moves the boxes along with the objects, every pass of the build reads them in order.
+    m_References.resize(objectCount);
+    for (std::uint32_t i = 0u; i < objectCount; ++i)
+        m_References[i] = BuildReference{ .Bounds = bounds[i], .Center = bounds[i].GetCenter(), .Object = i, };
+
+    // Every leaf holds at least one object, so there can never be more than 2n - 1 nodes.
+    m_Nodes.resize(2u * static_cast<std::size_t>(objectCount) - 1u);
+    m_Parents.resize(m_Nodes.size());
+
+    m_Nodes[0] = BVHNode{ .FirstObject = 0u, .ObjectCount = objectCount, };
+    m_Parents[0] = c_InvalidValue<std::uint32_t>;
+
+    std::atomic<std::uint32_t> nodeCount{ 1u };
+
+    auto& threadPool{ ThreadPool::GetShared() };
+    if (objectCount < Internal::c_MinParallelObjects || threadPool.GetThreadCount() < 2u)
+    {
+        BoundingVolumeHierarchy::BuildSubtree(0u, nodeCount, 0u, nullptr);
+        m_TopNodeCount = nodeCount;
+    }
+    else
+    {
+        // The first splits see the most objects and run alone, once there are a few subtrees per thread
+        // each of them is finished on its own. Their nodes are allocated from the same counter.
+        const auto splitLimit{ std::max(objectCount / static_cast<std::uint32_t>(threadPool.GetThreadCount() * 8u), Internal::c_MinParallelObjects / 4u) };
+
+        BoundingVolumeHierarchy::BuildSubtree(0u, nodeCount, splitLimit, &m_SubtreeRoots);
+        m_TopNodeCount = nodeCount;
+
+        threadPool.ParallelFor(m_SubtreeRoots.size(), [this, &nodeCount](const std::size_t index) {
+            BoundingVolumeHierarchy::BuildSubtree(m_SubtreeRoots[index], nodeCount, 0u, nullptr);
+        });
+    }
+
+    m_Nodes.resize(nodeCount);
+    m_Parents.resize(nodeCount);
+    m_DirtyFlags.assign(nodeCount, 0u);
+
+    m_Objects.resize(objectCount);
+    m_ObjectBounds.resize(objectCount);
+    m_ObjectSlots.resize(objectCount);
+    m_ObjectLeaves.resize(objectCount);
+
+    for (std::uint32_t i = 0u; i < objectCount; ++i)
+    {
+        const auto& reference{ m_References[i] };
+
+        m_Objects[i] = reference.Object;
+        m_ObjectBounds[i] = reference.Bounds;
+        m_ObjectSlots[reference.Object] = i;
+    }
+
+    m_References.clear();
+    m_References.shrink_to_fit();
+
+    // Parents are allocated before their children, one forward pass sees every parent's depth first.
+    std::vector<std::uint32_t> depths(m_Nodes.size(), 0u);
+
+    for (std::uint32_t i = 0u; i < m_Nodes.size(); ++i)
+    {
+        const auto& node{ m_Nodes[i] };
+        if (i) depths[i] = depths[m_Parents[i]] + 1u;
+
+        m_MaxDepth = std::max(m_MaxDepth, depths[i]);
+        if (!node.IsLeaf()) continue;
+
+        ++m_LeafCount;
+        for (std::uint32_t j = 0u; j < node.ObjectCount; ++j)
+            m_ObjectLeaves[m_Objects[node.FirstObject + j]] = i;
+    }
+}
+
+void BoundingVolumeHierarchy::Clear() noexcept
+{
+    m_Nodes.clear();
+    m_Parents.clear();
+    m_Objects.clear();
+    m_ObjectBounds.clear();
+    m_ObjectSlots.clear();
+    m_ObjectLeaves.clear();
+    m_References.clear();
+    m_SubtreeRoots.clear();
+    m_DirtyLeaves.clear();
+    m_DirtyFlags.clear();
+
+    m_TopNodeCount = 0u;
+    m_LeafCount = 0u;
+    m_MaxDepth = 0u;
+}
+
+void BoundingVolumeHierarchy::SetBounds(const std::uint32_t object, const BoundingBox& bounds) noexcept
+{
+    m_ObjectBounds[m_ObjectSlots[object]] = bounds;
+
+    const auto leaf{ m_ObjectLeaves[object] };
+    if (m_DirtyFlags[leaf]) return;
+
+    m_DirtyFlags[leaf] = 1u;
+    m_DirtyLeaves.push_back(leaf);
+}
+
+std::size_t BoundingVolumeHierarchy::Refit() noexcept
+{
+    if (m_DirtyLeaves.empty()) return 0u;
+
+    // Walking up from every leaf visits the upper levels over and over, past some point one pass over everything is cheaper.
+    if (m_DirtyLeaves.size() > m_LeafCount / 8u)
+    {
+        for (const auto leaf : m_DirtyLeaves)
+            m_DirtyFlags[leaf] = 0u;
+        m_DirtyLeaves.clear();
+
+        BoundingVolumeHierarchy::RefitAll();
+        return m_Nodes.size();
+    }
+
+    std::size_t changed{ 0u };
+    for (const auto leaf : m_DirtyLeaves)
+    {
+        m_DirtyFlags[leaf] = 0u;
+
+        // Once a box comes out the same, nothing above it moves because of this leaf.
+        for (auto node{ leaf }; node != c_InvalidValue<std::uint32_t>; node = m_Parents[node])
+        {
+            if (!BoundingVolumeHierarchy::RefitNode(node)) break;
+            ++changed;
+        }
+    }
+
+    m_DirtyLeaves.clear();
+    return changed;
+}
+
+std::size_t BoundingVolumeHierarchy::QueryFrustum(const Frustum& frustum, std::vector<std::uint32_t>& objects) const
+{
+    if (m_Nodes.empty()) return 0u;
+
+    struct Entry
+    {
+        std::uint32_t Node{};
+        std::uint32_t PlaneMask{};
+    };
+
+    constexpr std::uint32_t c_AllPlanes{ (1u << Frustum::PlaneCount) - 1u };
+
+    // Depth first with the second child waiting, at most one entry per level plus the one being split.
+    std::vector<Entry> stack(m_MaxDepth + 2u);
+    std::size_t stackSize{ 0u };
+    stack[stackSize++] = { 0u, c_AllPlanes, };
+
+    const auto previousSize{ objects.size() };
+
+    while (stackSize)
+    {
+        const auto [index, planeMask] = stack[--stackSize];
+        const auto& node{ m_Nodes[index] };
+
+        const auto center{ node.Bounds.GetCenter() };
+        const auto extent{ node.Bounds.GetExtent() };
+
+        auto mask{ planeMask };
+        bool isOutside{ false };
+
+        for (std::uint32_t plane = 0u; plane < Frustum::PlaneCount; ++plane)
+        {
+            if (!(mask & (1u << plane))) continue;
+
+            const auto& equation{ frustum.Planes[plane] };
+            const auto normal{ glm::vec3{ equation } };
+
+            const auto distance{ glm::dot(normal, center) + equation.w };
+            const auto radius{ glm::dot(glm::abs(normal), extent) };
+
+            if (distance + radius < 0.0f) { isOutside = true; break; }
+            if (distance - radius >= 0.0f) mask &= ~(1u << plane);
+        }
+
+        if (isOutside) continue;
+
+        if (!mask || node.IsLeaf())
+        {
+            // A leaf is only partially inside, its objects get their own test against what is left.
+            for (std::uint32_t i = 0u; i < node.ObjectCount; ++i)
+            {
+                const auto slot{ node.FirstObject + i };
+                if (!mask || frustum.Intersects(m_ObjectBounds[slot]))
+                    objects.push_back(m_Objects[slot]);
+            }
+            continue;
+        }
+
+        stack[stackSize++] = { node.Child + 1u, mask, };
+        stack[stackSize++] = { node.Child, mask, };
+    }
+
+    return objects.size() - previousSize;
+}
+
+std::size_t BoundingVolumeHierarchy::QueryBox(const BoundingBox& box, std::vector<std::uint32_t>& objects) const
+{
+    if (m_Nodes.empty()) return 0u;
+
+    std::vector<std::uint32_t> stack(m_MaxDepth + 2u);
+    std::size_t stackSize{ 0u };
+    stack[stackSize++] = 0u;
+
+    const auto previousSize{ objects.size() };
+
+    while (stackSize)
+    {
+        const auto& node{ m_Nodes[stack[--stackSize]] };
+        if (!node.Bounds.Overlaps(box)) continue;
+
+        const auto isContained{ box.Contains(node.Bounds) };
+        if (isContained || node.IsLeaf())
+        {
+            for (std::uint32_t i = 0u; i < node.ObjectCount; ++i)
+            {
+                const auto slot{ node.FirstObject + i };
+                if (isContained || m_ObjectBounds[slot].Overlaps(box))
+                    objects.push_back(m_Objects[slot]);
+            }
+            continue;
+        }
+
+        stack[stackSize++] = node.Child + 1u;
+        stack[stackSize++] = node.Child;
+    }
+
+    return objects.size() - previousSize;
+}
+
+RaycastHit BoundingVolumeHierarchy::Raycast(const Ray& ray, const float maxDistance) const noexcept
+{
+    RaycastHit hit{ .Distance = maxDistance, };
+    if (m_Nodes.empty()) return hit;
+
+    const auto inverseDirection{ glm::vec3{ 1.0f } / ray.Direction };
+
+    float enter{};
+    if (!m_Nodes[0].Bounds.IntersectRay(ray.Origin, inverseDirection, hit.Distance, enter)) return hit;
+
+    struct Entry
+    {
+        std::uint32_t Node{};
+        float Enter{};
+    };
+
+    std::vector<Entry> stack(m_MaxDepth + 2u);
+    std::size_t stackSize{ 0u };
+    stack[stackSize++] = { 0u, enter, };
+
+    while (stackSize)
+    {
+        const auto [index, nodeEnter] = stack[--stackSize];
+
+        // Something closer was found after this one got pushed.
+        if (nodeEnter > hit.Distance) continue;
+
+        const auto& node{ m_Nodes[index] };
+        if (node.IsLeaf())
+        {
+            for (std::uint32_t i = 0u; i < node.ObjectCount; ++i)
+            {
+                const auto slot{ node.FirstObject + i };
+                if (m_ObjectBounds[slot].IntersectRay(ray.Origin, inverseDirection, hit.Distance, enter) && enter < hit.Distance)
+                    hit = RaycastHit{ .Object = m_Objects[slot], .Distance = enter, };
+            }
+            continue;
+        }
+
+        float leftEnter{}, rightEnter{};
+        const auto isLeftHit { m_Nodes[node.Child].Bounds.IntersectRay(ray.Origin, inverseDirection, hit.Distance, leftEnter) };
+        const auto isRightHit{ m_Nodes[node.Child + 1u].Bounds.IntersectRay(ray.Origin, inverseDirection, hit.Distance, rightEnter) };
+
+        // The nearer child goes on top, its hits usually let the other one be skipped.
+        if (isLeftHit && isRightHit)
+        {
+            const auto isLeftNearer{ leftEnter <= rightEnter };
+            stack[stackSize++] = isLeftNearer ? Entry{ node.Child + 1u, rightEnter, } : Entry{ node.Child, leftEnter, };
+            stack[stackSize++] = isLeftNearer ? Entry{ node.Child, leftEnter, } : Entry{ node.Child + 1u, rightEnter, };
+        }
+        else if (isLeftHit)  stack[stackSize++] = { node.Child, leftEnter, };
+        else if (isRightHit) stack[stackSize++] = { node.Child + 1u, rightEnter, };
+    }
+
+    return hit;
+}
+
+void BoundingVolumeHierarchy::BuildSubtree(const std::uint32_t root, std::atomic<std::uint32_t>& nodeCount, const std::uint32_t splitLimit, std::vector<std::uint32_t>* deferred) noexcept
+{
+    // Depth first with an explicit stack, a degenerate split sequence could otherwise run out of call stack.
+    std::vector<std::uint32_t> stack{ root };
+
+    while (!stack.empty())
+    {
+        const auto index{ stack.back() };
+        stack.pop_back();
+
+        auto& node{ m_Nodes[index] };
+        if (deferred && node.ObjectCount <= splitLimit)
+        {
+            deferred->push_back(index);
+            continue;
+        }
+
+        std::uint32_t leftCount{};
+        if (!BoundingVolumeHierarchy::SplitNode(index, leftCount)) continue;
+
+        const auto child{ nodeCount.fetch_add(2u, std::memory_order_relaxed) };
+        node.Child = child;
+
+        m_Nodes[child]      = BVHNode{ .FirstObject = node.FirstObject, .ObjectCount = leftCount, };
+        m_Nodes[child + 1u] = BVHNode{ .FirstObject = node.FirstObject + leftCount, .ObjectCount = node.ObjectCount - leftCount, };
+        m_Parents[child] = m_Parents[child + 1u] = index;
+
+        stack.push_back(child + 1u);
+        stack.push_back(child);
+    }
+}
+
+bool BoundingVolumeHierarchy::SplitNode(const std::uint32_t index, std::uint32_t& leftCount) noexcept
+{
+    auto& node{ m_Nodes[index] };
+
+    const auto first{ m_References.begin() + node.FirstObject };
+    const auto last { first + node.ObjectCount };
+
+    auto centerBounds{ BoundingBox::Empty() };
+    node.Bounds = BoundingBox::Empty();
+
+    for (auto reference{ first }; reference != last; ++reference)
+    {
+        node.Bounds.Expand(reference->Bounds);
+        centerBounds.Expand(reference->Center);
+    }
+
+    // Small enough for a leaf, the SAH could only trade one box test for a traversal step down here.
+    if (node.ObjectCount <= c_MaxLeafObjects) return false;
+
+    // All three axes are binned in the same pass, the references are only read once.
+    std::array<std::array<Internal::Bin, Internal::c_BinCount>, 3u> bins{};
+    glm::vec3 scale{ 0.0f };
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const auto size{ centerBounds.Max[axis] - centerBounds.Min[axis] };
+        scale[axis] = size > 0.0f ? static_cast<float>(Internal::c_BinCount) / size : 0.0f;
+    }
+
+    for (auto reference{ first }; reference != last; ++reference)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            auto& bin{ bins[axis][Internal::GetBinIndex(reference->Center[axis], centerBounds.Min[axis], scale[axis])] };
+            bin.Bounds.Expand(reference->Bounds);
+            ++bin.Count;
+        }
+    }
+
+    auto bestCost{ std::numeric_limits<float>::max() };
+    int bestAxis{ -1 };
+    std::uint32_t bestBin{ 0u };
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (scale[axis] <= 0.0f) continue;
+
+        const auto& axisBins{ bins[axis] };
+
+        // Sweep from the right first, then evaluate every plane in between two bins while sweeping from the left.
+        std::array<float, Internal::c_BinCount> rightAreas{};
+        std::array<std::uint32_t, Internal::c_BinCount> rightCounts{};
+
+        auto bounds{ BoundingBox::Empty() };
+        std::uint32_t count{ 0u };
+        for (auto bin{ Internal::c_BinCount - 1u }; bin > 0u; --bin)
+        {
+            bounds.Expand(axisBins[bin].Bounds);
+            count += axisBins[bin].Count;
+
+            rightAreas[bin]  = bounds.GetSurfaceArea();
+            rightCounts[bin] = count;
+        }
+
+        bounds = BoundingBox::Empty();
+        count = 0u;
+        for (std::uint32_t bin = 0u; bin < Internal::c_BinCount - 1u; ++bin)
+        {
+            bounds.Expand(axisBins[bin].Bounds);
+            count += axisBins[bin].Count;
+
+            if (!count || !rightCounts[bin + 1u]) continue;
+
+            const auto cost{ bounds.GetSurfaceArea() * static_cast<float>(count) + rightAreas[bin + 1u] * static_cast<float>(rightCounts[bin + 1u]) };
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin  = bin;
+            }
+        }
+    }
+
+    if (bestAxis < 0)
+    {
+        // All the centers in one spot, no plane separates them. Halving keeps the leaves small at least.
+        leftCount = node.ObjectCount / 2u;
+        return true;
+    }
+
+    const auto min{ centerBounds.Min[bestAxis] };
+    const auto axisScale{ scale[bestAxis] };
+
+    const auto middle{ std::partition(first, last, [&](const BuildReference& reference) {
+        return Internal::GetBinIndex(reference.Center[bestAxis], min, axisScale) <= bestBin;
+    }) };
+
+    leftCount = static_cast<std::uint32_t>(middle - first);
+    return true;
+}
+
+bool BoundingVolumeHierarchy::RefitNode(const std::uint32_t index) noexcept
+{
+    auto& node{ m_Nodes[index] };
+
+    auto bounds{ BoundingBox::Empty() };
+    if (node.IsLeaf())
+    {
+        for (std::uint32_t i = 0u; i < node.ObjectCount; ++i)
+            bounds.Expand(m_ObjectBounds[node.FirstObject + i]);
+    }
+    else
+    {
+        bounds = m_Nodes[node.Child].Bounds;
+        bounds.Expand(m_Nodes[node.Child + 1u].Bounds);
+    }
+
+    if (bounds.Min == node.Bounds.Min && bounds.Max == node.Bounds.Max) return false;
+
+    node.Bounds = bounds;
+    return true;
+}
+
+void BoundingVolumeHierarchy::RefitSubtree(const std::uint32_t root, std::vector<std::uint32_t>& order) noexcept
+{
+    // Children always come after their parent in depth first order, backwards every node sees refitted children.
+    order.clear();
+    order.push_back(root);
+
+    for (std::size_t i = 0u; i < order.size(); ++i)
+    {
+        const auto& node{ m_Nodes[order[i]] };
+        if (node.IsLeaf()) continue;
+
+        order.push_back(node.Child);
+        order.push_back(node.Child + 1u);
+    }
+
+    for (auto node{ order.rbegin() }; node != order.rend(); ++node)
+        BoundingVolumeHierarchy::RefitNode(*node);
+}
+
+void BoundingVolumeHierarchy::RefitAll() noexcept
+{
+    if (m_SubtreeRoots.empty())
+    {
+        std::vector<std::uint32_t> order{};
+        BoundingVolumeHierarchy::RefitSubtree(0u, order);
+        return;
+    }
+
+    ThreadPool::GetShared().ParallelFor(m_SubtreeRoots.size(), [this](const std::size_t index) {
+        thread_local std::vector<std::uint32_t> order{};
+        BoundingVolumeHierarchy::RefitSubtree(m_SubtreeRoots[index], order);
+    });
+
+    // The nodes above them were allocated before any subtree node, so every child has the larger index.
+    for (auto index{ m_TopNodeCount }; index > 0u; --index)
+        BoundingVolumeHierarchy::RefitNode(index - 1u);
+}
+
+NAMESPACE_END(Renderer)
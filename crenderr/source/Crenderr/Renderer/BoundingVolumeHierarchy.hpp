@@ -0,0 +1,135 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/Bounds.hpp"
+#include "Renderer/Culling.hpp"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+struct BVHNode
+{
+    BoundingBox Bounds{};
+
+    // The objects under the node are m_Objects[FirstObject, FirstObject + ObjectCount), for inner nodes too.
+    std::uint32_t FirstObject{ 0u };
+    std::uint32_t ObjectCount{ 0u };
+
+    // The children are always allocated as a pair, Child and Child + 1. The root is never anyone's child, so 0 means a leaf.
+    std::uint32_t Child{ 0u };
+
+    inline bool IsLeaf() const noexcept { return Child == 0u; }
+};
+
+struct RaycastHit
+{
+    std::uint32_t Object{ c_InvalidValue<std::uint32_t> };
+    float Distance{ std::numeric_limits<float>::max() };
+
+    inline bool IsValid() const noexcept { return Object != c_InvalidValue<std::uint32_t>; }
+};
+
+/**
+ * Axis aligned box tree over world space object bounds. An object is just its index in the span
+ * given to Build(), the tree never sees what it stands for. Built top down with binned SAH, the
+ * subtrees below the first few splits are built in parallel on the shared thread pool.
+ *
+ * Moving objects are handled by refitting instead of rebuilding: SetBounds() marks the object's
+ * leaf and Refit() grows or shrinks the boxes on the way up to the root. The topology stays what
+ * it was at build time, so once the objects have moved far from where they started the queries
+ * slow down and a Build() is due. Keeping static and dynamic objects in two trees avoids that.
+ */
+class BoundingVolumeHierarchy
+{
+public:
+    static constexpr std::uint32_t c_MaxLeafObjects{ 4u };
+
+public:
+    BoundingVolumeHierarchy() = default;
+    ~BoundingVolumeHierarchy() = default;
+
+    void Build(std::span<const BoundingBox> bounds);
+    void Clear() noexcept;
+
+    // Takes effect on the next Refit().
+    void SetBounds(const std::uint32_t object, const BoundingBox& bounds) noexcept;
+
+    // Refits what SetBounds() touched, or the whole tree in parallel when most of it moved. Returns how many nodes changed.
+    std::size_t Refit() noexcept;
+
+public:
+    /**
+     * Appends every object whose box is at least partially inside the frustum. Planes a node is fully
+     * inside of are not tested again below it, and a node inside all six adds its objects untested.
+     */
+    std::size_t QueryFrustum(const Frustum& frustum, std::vector<std::uint32_t>& objects) const;
+
+    // Appends every object whose box overlaps the given one.
+    std::size_t QueryBox(const BoundingBox& box, std::vector<std::uint32_t>& objects) const;
+
+    // The nearest object box the ray enters within maxDistance, starting inside one counts as a hit at 0.
+    RaycastHit Raycast(const Ray& ray, const float maxDistance = std::numeric_limits<float>::max()) const noexcept;
+
+public:
+    inline const auto& GetBounds(const std::uint32_t object) const noexcept { return m_ObjectBounds[m_ObjectSlots[object]]; }
+    inline const auto& GetNodes() const noexcept { return m_Nodes; }
+
+    // The objects in tree order, a node's FirstObject and ObjectCount index into it.
+    inline const auto& GetObjects() const noexcept { return m_Objects; }
+
+    inline auto GetObjectCount() const noexcept { return m_ObjectBounds.size(); }
+    inline auto GetNodeCount() const noexcept { return m_Nodes.size(); }
+    inline auto GetMaxDepth() const noexcept { return m_MaxDepth; }
+    inline auto IsEmpty() const noexcept { return m_Nodes.empty(); }
+
+private:
+    struct BuildReference
+    {
+        BoundingBox Bounds{};
+        glm::vec3 Center{};
+        std::uint32_t Object{};
+    };
+
+    // Builds below node, subtrees with at most splitLimit objects are left to deferred when one is given.
+    void BuildSubtree(const std::uint32_t node, std::atomic<std::uint32_t>& nodeCount, const std::uint32_t splitLimit, std::vector<std::uint32_t>* deferred) noexcept;
+    bool SplitNode(const std::uint32_t node, std::uint32_t& leftCount) noexcept;
+
+    bool RefitNode(const std::uint32_t node) noexcept;
+    void RefitSubtree(const std::uint32_t root, std::vector<std::uint32_t>& order) noexcept;
+    void RefitAll() noexcept;
+
+private:
+    std::vector<BVHNode> m_Nodes{};
+
+    // The nodes above the subtrees built in parallel come first, [0, m_TopNodeCount).
+    std::uint32_t m_TopNodeCount{ 0u };
+    std::vector<std::uint32_t> m_SubtreeRoots{};
+    std::uint32_t m_LeafCount{ 0u };
+    std::uint32_t m_MaxDepth{ 0u }; // sizes the query stacks
+
+    // Indexed by node.
+    std::vector<std::uint32_t> m_Parents{};
+
+    // Objects and their boxes in tree order, each node owns a contiguous range of them.
+    std::vector<std::uint32_t> m_Objects{};
+    std::vector<BoundingBox> m_ObjectBounds{};
+
+    // Indexed by object.
+    std::vector<std::uint32_t> m_ObjectSlots{};
+    std::vector<std::uint32_t> m_ObjectLeaves{};
+
+    std::vector<BuildReference> m_References{}; // only alive during Build()
+
+    std::vector<std::uint32_t> m_DirtyLeaves{};
+    std::vector<std::uint8_t> m_DirtyFlags{}; // by node, so a leaf is queued once
+};
+
+NAMESPACE_END(Renderer)
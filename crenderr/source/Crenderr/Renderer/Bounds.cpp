@@ -0,0 +1,65 @@
+#include "Bounds.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+NAMESPACE_BEGIN(Renderer)
+
+BoundingBox BoundingBox::Transform(const glm::mat4& transform) const noexcept
+{
+    const auto center{ glm::vec3{ transform * glm::vec4{ GetCenter(), 1.0f } } };
+    const auto extent{ GetExtent() };
+
+    glm::vec3 reach{ 0.0f };
+    for (int column = 0; column < 3; ++column)
+        reach += glm::abs(glm::vec3{ transform[column] }) * extent[column];
+
+    return BoundingBox{ .Min = center - reach, .Max = center + reach, };
+}
+
+BoundingSphere BoundingSphere::Transform(const glm::mat4& transform) const noexcept
+{
+    const auto scale2{ std::max({
+        glm::dot(glm::vec3{ transform[0] }, glm::vec3{ transform[0] }),
+        glm::dot(glm::vec3{ transform[1] }, glm::vec3{ transform[1] }),
+        glm::dot(glm::vec3{ transform[2] }, glm::vec3{ transform[2] }),
+    }) };
+
+    return BoundingSphere{
+        .Center = glm::vec3{ transform * glm::vec4{ Center, 1.0f } },
+        .Radius = Radius * std::sqrt(scale2),
+    };
+}
+
+MeshBounds MeshBounds::FromPositions(const glm::vec3* positions, const std::size_t count, const std::size_t stride) noexcept
+{
+    if (!positions || !count) return {};
+
+    const auto* bytes{ reinterpret_cast<const std::uint8_t*>(positions) };
+    const auto getPosition{ [bytes, stride](const std::size_t i) -> const glm::vec3& {
+        return *reinterpret_cast<const glm::vec3*>(bytes + i * stride);
+    } };
+
+    MeshBounds bounds{ .Box = { getPosition(0u), getPosition(0u) }, };
+    for (std::size_t i = 1u; i < count; ++i)
+    {
+        bounds.Box.Min = glm::min(bounds.Box.Min, getPosition(i));
+        bounds.Box.Max = glm::max(bounds.Box.Max, getPosition(i));
+    }
+
+    // Centered on the box, the farthest vertex gives a tighter radius than the box diagonal.
+    bounds.Sphere.Center = bounds.Box.GetCenter();
+
+    float radius2{ 0.0f };
+    for (std::size_t i = 0u; i < count; ++i)
+    {
+        const auto offset{ getPosition(i) - bounds.Sphere.Center };
+        radius2 = std::max(radius2, glm::dot(offset, offset));
+    }
+    bounds.Sphere.Radius = std::sqrt(radius2);
+
+    return bounds;
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+NAMESPACE_BEGIN(Renderer)
+
+struct BoundingBox
+{
+    glm::vec3 Min{ 0.0f };
+    glm::vec3 Max{ 0.0f };
+
+    // Inside out, expanding it by anything gives that thing's box.
+    static constexpr BoundingBox Empty() noexcept
+    {
+        constexpr auto c_Max{ std::numeric_limits<float>::max() };
+        return BoundingBox{ .Min = glm::vec3{ c_Max }, .Max = glm::vec3{ -c_Max }, };
+    }
+
+    inline glm::vec3 GetCenter() const noexcept { return (Min + Max) * 0.5f; }
+    inline glm::vec3 GetExtent() const noexcept { return (Max - Min) * 0.5f; }
+
+    inline float GetSurfaceArea() const noexcept
+    {
+        const auto size{ glm::max(Max - Min, glm::vec3{ 0.0f }) };
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    inline void Expand(const glm::vec3& point) noexcept { Min = glm::min(Min, point); Max = glm::max(Max, point); }
+    inline void Expand(const BoundingBox& box) noexcept { Min = glm::min(Min, box.Min); Max = glm::max(Max, box.Max); }
+
+    inline bool Overlaps(const BoundingBox& box) const noexcept
+    {
+        return Min.x <= box.Max.x && box.Min.x <= Max.x && Min.y <= box.Max.y && box.Min.y <= Max.y && Min.z <= box.Max.z && box.Min.z <= Max.z;
+    }
+
+    inline bool Contains(const BoundingBox& box) const noexcept
+    {
+        return Min.x <= box.Min.x && Min.y <= box.Min.y && Min.z <= box.Min.z && box.Max.x <= Max.x && box.Max.y <= Max.y && box.Max.z <= Max.z;
+    }
+
+    // Box around the transformed box (Arvo), not around the transformed geometry, so it can only grow.
+    BoundingBox Transform(const glm::mat4& transform) const noexcept;
+
+    /**
+     * Slab test against a ray given by its origin and reciprocal direction, zero components turn into
+     * infinities and still work. enter is where the ray gets in, 0 when it starts inside.
+     */
+    inline bool IntersectRay(const glm::vec3& origin, const glm::vec3& inverseDirection, const float maxDistance, float& enter) const noexcept
+    {
+        const auto t0{ (Min - origin) * inverseDirection };
+        const auto t1{ (Max - origin) * inverseDirection };
+
+        enter = 0.0f;
+        auto leave{ maxDistance };
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            // A ray in the plane of a face gives 0 * inf = NaN, it runs along the face and so stays inside this slab.
+            if (std::isnan(t0[axis]) || std::isnan(t1[axis])) continue;
+
+            enter = std::max(enter, std::min(t0[axis], t1[axis]));
+            leave = std::min(leave, std::max(t0[axis], t1[axis]));
+        }
+
+        return enter <= leave;
+    }
+};
+
+struct Ray
+{
+    glm::vec3 Origin{ 0.0f };
+    glm::vec3 Direction{ 0.0f, 0.0f, -1.0f }; // unit length
+
+    inline glm::vec3 GetPoint(const float distance) const noexcept { return Origin + Direction * distance; }
+};
+
+struct BoundingSphere
+{
+    glm::vec3 Center{ 0.0f };
+    float Radius{ 0.0f };
+
+    // Still encloses the object after the transform, the radius grows with the largest axis scale.
+    BoundingSphere Transform(const glm::mat4& transform) const noexcept;
+};
+
+// Object space bounds of a mesh, computed once when it is loaded.
+struct MeshBounds
+{
+    BoundingBox Box{};
+    BoundingSphere Sphere{};
+
+    // Empty bounds mean unknown, such a mesh is never culled.
+    inline bool IsValid() const noexcept { return Sphere.Radius > 0.0f; }
+
+    // Positions are read stride bytes apart, so they can come straight out of a vertex array.
+    static MeshBounds FromPositions(const glm::vec3* positions, const std::size_t count, const std::size_t stride = sizeof(glm::vec3)) noexcept;
+};
+
+NAMESPACE_END(Renderer)
@@ -46,6 +46,23 @@ const glm::mat4& PerspectiveCamera::GetProjectionMatrix() const
     return m_ProjectionMatrix;
 }
 
+Frustum PerspectiveCamera::GetFrustum() const noexcept
+{
+    return Frustum::FromMatrix(m_ProjectionMatrix * m_ViewMatrix);
+}
+
+Ray PerspectiveCamera::GetRay(const glm::vec2& point) const noexcept
+{
+    const auto inverseViewProjection{ glm::inverse(m_ProjectionMatrix * m_ViewMatrix) };
+
+    auto nearPoint{ inverseViewProjection * glm::vec4{ point, -1.0f, 1.0f } };
+    auto farPoint { inverseViewProjection * glm::vec4{ point,  1.0f, 1.0f } };
+    nearPoint /= nearPoint.w;
+    farPoint  /= farPoint.w;
+
+    return Ray{ .Origin = glm::vec3{ nearPoint }, .Direction = glm::normalize(glm::vec3{ farPoint - nearPoint }), };
+}
+
 void PerspectiveCamera::RecalculateViewMatrix()
 {
     m_Front = glm::normalize(glm::vec3{
@@ -2,6 +2,8 @@
 
 #include "Camera.hpp"
 
+#include "Renderer/Culling.hpp"
+
 NAMESPACE_BEGIN(Renderer)
 
 struct PerspectiveProjection
@@ -38,6 +40,12 @@ public:
     virtual const glm::mat4& GetViewMatrix() const override;
     virtual const glm::mat4& GetProjectionMatrix() const override;
 
+    // World space planes of the current view and projection.
+    Frustum GetFrustum() const noexcept;
+
+    // World space ray from the near plane through a point in normalized device coordinates, e.g. the cursor.
+    Ray GetRay(const glm::vec2& point) const noexcept;
+
 private:
     void RecalculateViewMatrix();
 
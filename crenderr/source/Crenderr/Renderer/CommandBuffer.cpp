@@ -0,0 +1,84 @@
+#include "CommandBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    constexpr std::size_t c_RadixBits{ 8u };
+    constexpr std::size_t c_RadixSize{ 1u << c_RadixBits };
+    constexpr std::size_t c_RadixPasses{ sizeof(std::uint64_t) * 8u / c_RadixBits };
+}
+
+std::uint32_t SortKey::QuantizeDepth(const float distance, const float farDistance) noexcept
+{
+    constexpr auto c_MaxDepth{ static_cast<float>((1u << c_DepthBits) - 1u) };
+
+    if (!(distance > 0.0f) || !(farDistance > 0.0f)) return 0u;
+
+    const auto normalized{ std::log2(1.0f + std::min(distance, farDistance)) / std::log2(1.0f + farDistance) };
+    return static_cast<std::uint32_t>(normalized * c_MaxDepth);
+}
+
+void CommandBuffer::Reset() noexcept
+{
+    m_Packets.clear();
+    m_Payloads.clear();
+}
+
+void CommandBuffer::Submit(const std::uint64_t key, const DrawPayload& payload)
+{
+    m_Packets.push_back({
+        .Key          = key,
+        .PayloadIndex = static_cast<std::uint32_t>(m_Payloads.size()),
+    });
+    m_Payloads.push_back(payload);
+}
+
+void CommandBuffer::Sort() noexcept
+{
+    if (m_Packets.size() < 2u) return;
+
+    // All the histograms in one go, a pass is skipped when every key has the same digit.
+    std::array<std::array<std::size_t, Internal::c_RadixSize>, Internal::c_RadixPasses> histograms{};
+    for (const auto& packet : m_Packets)
+    {
+        for (std::size_t pass = 0u; pass < Internal::c_RadixPasses; ++pass)
+            ++histograms[pass][(packet.Key >> (pass * Internal::c_RadixBits)) & (Internal::c_RadixSize - 1u)];
+    }
+
+    m_SortBuffer.resize(m_Packets.size());
+
+    auto* source{ &m_Packets };
+    auto* target{ &m_SortBuffer };
+
+    for (std::size_t pass = 0u; pass < Internal::c_RadixPasses; ++pass)
+    {
+        auto& histogram{ histograms[pass] };
+
+        const auto firstDigit{ (source->front().Key >> (pass * Internal::c_RadixBits)) & (Internal::c_RadixSize - 1u) };
+        if (histogram[firstDigit] == source->size()) continue;
+
+        std::size_t offset{ 0u };
+        for (auto& count : histogram)
+        {
+            const auto bucketSize{ count };
+            count = offset;
+            offset += bucketSize;
+        }
+
+        for (const auto& packet : *source)
+        {
+            const auto digit{ (packet.Key >> (pass * Internal::c_RadixBits)) & (Internal::c_RadixSize - 1u) };
+            (*target)[histogram[digit]++] = packet;
+        }
+
+        std::swap(source, target);
+    }
+
+    if (source != &m_Packets) m_Packets.swap(m_SortBuffer);
+}
+
+NAMESPACE_END(Renderer)
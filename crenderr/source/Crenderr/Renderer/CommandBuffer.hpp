@@ -0,0 +1,134 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/MaterialRegistry.hpp"
+#include "Renderer/GeometryPool.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <array>
+
+NAMESPACE_BEGIN(Renderer)
+
+class Shader;
+class VertexArray;
+class Texture2D;
+class TextureArray;
+
+/**
+ * Bit layout of a sort key, the most significant fields change the most expensive state:
+ *
+ *   63    60 59     50 49       40 39          26 25       16 15    0
+ *   | layer | shader  | textures  | vertex array | material  | depth |
+ *   |   4   |   10    |    10     |      14      |    10     |  16   |
+ *
+ * The textures are the arrays they were resolved to, the material only groups equal ones inside a
+ * batch. Packets are sorted in ascending order, so opaque geometry goes front to back. The ids are
+ * truncated to fit, a collision only costs a state change, the submission compares real handles.
+ */
+struct SortKey
+{
+    static constexpr std::uint32_t c_LayerBits      { 4u  };
+    static constexpr std::uint32_t c_ShaderBits     { 10u };
+    static constexpr std::uint32_t c_TexturesBits   { 10u };
+    static constexpr std::uint32_t c_VertexArrayBits{ 14u };
+    static constexpr std::uint32_t c_MaterialBits   { 10u };
+    static constexpr std::uint32_t c_DepthBits      { 16u };
+
+    static_assert(c_LayerBits + c_ShaderBits + c_TexturesBits + c_VertexArrayBits + c_MaterialBits + c_DepthBits == 64u);
+
+    static constexpr std::uint64_t Encode(
+        const std::uint32_t layer,
+        const std::uint32_t shader,
+        const std::uint32_t textures,
+        const std::uint32_t vertexArray,
+        const std::uint32_t material,
+        const std::uint32_t depth) noexcept
+    {
+        const auto field{ [](std::uint64_t key, const std::uint32_t value, const std::uint32_t bits) {
+            return (key << bits) | (static_cast<std::uint64_t>(value) & ((1ull << bits) - 1u));
+        } };
+
+        std::uint64_t key{ 0u };
+        key = field(key, layer,       c_LayerBits);
+        key = field(key, shader,      c_ShaderBits);
+        key = field(key, textures,    c_TexturesBits);
+        key = field(key, vertexArray, c_VertexArrayBits);
+        key = field(key, material,    c_MaterialBits);
+        key = field(key, depth,       c_DepthBits);
+        return key;
+    }
+
+    // Maps a view distance to the depth field, logarithmically so the near range keeps its precision.
+    static std::uint32_t QuantizeDepth(const float distance, const float farDistance) noexcept;
+};
+
+enum class DrawLayer : std::uint32_t
+{
+    Opaque    = 0u,
+    Wireframe = 1u,
+};
+
+// Everything a draw needs besides the key, the resources have to stay alive until the buffer is flushed.
+struct DrawPayload
+{
+    Shader* ShaderPtr{ nullptr };
+    const VertexArray* VertexArrayPtr{ nullptr };
+    std::array<const Texture2D*, 3u> Textures{};
+
+    // Arrays the textures were resolved to by the submission, all empty when they are sampled through bindless handles.
+    std::array<const TextureArray*, 3u> TextureArrays{};
+
+    // Range of the frame's instance data, drawn with a single instanced call.
+    std::uint32_t InstanceOffset{ 0u };
+    std::uint32_t InstanceCount{ 1u };
+
+    // Mesh of a GeometryPool, an empty range draws the whole vertex array.
+    GeometryRange Range{};
+
+    MaterialIndex Material{ MaterialRegistry::c_DefaultMaterial };
+    DrawLayer Layer{ DrawLayer::Opaque };
+
+    // Same state besides the instances, the two can go out as one instanced draw. The instances carry
+    // their material and texture indices, only the texture arrays have to match. Pool meshes only have
+    // to share the pool, different ranges become separate commands of one multi draw.
+    inline bool CanBatchWith(const DrawPayload& other) const noexcept
+    {
+        return ShaderPtr == other.ShaderPtr
+            && VertexArrayPtr == other.VertexArrayPtr
+            && TextureArrays == other.TextureArrays
+            && Layer == other.Layer
+            && (Range.IndexCount != 0u) == (other.Range.IndexCount != 0u);
+    }
+};
+
+struct DrawPacket
+{
+    std::uint64_t Key{ 0u };
+    std::uint32_t PayloadIndex{ 0u };
+};
+
+// Frame-local list of draws, recorded in any order and sorted by key before the submission.
+class CommandBuffer
+{
+public:
+    CommandBuffer() = default;
+
+    void Reset() noexcept;
+    void Submit(const std::uint64_t key, const DrawPayload& payload);
+
+    // LSD radix sort of the packets, passes over bytes every key shares are skipped.
+    void Sort() noexcept;
+
+    inline const auto& GetPackets() const noexcept { return m_Packets; }
+    inline const auto& GetPayload(const DrawPacket& packet) const noexcept { return m_Payloads[packet.PayloadIndex]; }
+    inline auto GetSize() const noexcept { return m_Packets.size(); }
+
+private:
+    std::vector<DrawPacket> m_Packets{};
+    std::vector<DrawPacket> m_SortBuffer{};
+    std::vector<DrawPayload> m_Payloads{};
+};
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,374 @@
+#include "Culling.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    static glm::vec4 NormalizePlane(const glm::vec4& plane) noexcept
+    {
+        const auto length{ std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z) };
+        return length > 0.0f ? plane / length : plane;
+    }
+
+    static float GetDistance(const glm::vec4& plane, const float x, const float y, const float z) noexcept
+    {
+        return plane.x * x + plane.y * y + plane.z * z + plane.w;
+    }
+
+    static bool IsSphereVisible(const Frustum& frustum, const float x, const float y, const float z, const float radius) noexcept
+    {
+        for (const auto& plane : frustum.Planes)
+            if (GetDistance(plane, x, y, z) < -radius) return false;
+
+        return true;
+    }
+
+    // The extent projected on the plane normal is how far the box reaches towards it.
+    static bool IsBoxVisible(const Frustum& frustum, const float x, const float y, const float z, const float ex, const float ey, const float ez) noexcept
+    {
+        for (const auto& plane : frustum.Planes)
+        {
+            const auto reach{ std::abs(plane.x) * ex + std::abs(plane.y) * ey + std::abs(plane.z) * ez };
+            if (GetDistance(plane, x, y, z) < -reach) return false;
+        }
+
+        return true;
+    }
+
+    static std::size_t CullSpheresScalar(const Frustum& frustum, const SphereBatch& spheres, std::size_t first, std::uint8_t* visibility) noexcept
+    {
+        std::size_t visible{ 0u };
+        for (; first < spheres.GetSize(); ++first)
+        {
+            visibility[first] = Internal::IsSphereVisible(frustum,
+                spheres.CenterX[first], spheres.CenterY[first], spheres.CenterZ[first], spheres.Radius[first]);
+            visible += visibility[first];
+        }
+
+        return visible;
+    }
+
+    static std::size_t CullBoxesScalar(const Frustum& frustum, const BoxBatch& boxes, std::size_t first, std::uint8_t* visibility) noexcept
+    {
+        std::size_t visible{ 0u };
+        for (; first < boxes.GetSize(); ++first)
+        {
+            visibility[first] = Internal::IsBoxVisible(frustum,
+                boxes.CenterX[first], boxes.CenterY[first], boxes.CenterZ[first],
+                boxes.ExtentX[first], boxes.ExtentY[first], boxes.ExtentZ[first]);
+            visible += visibility[first];
+        }
+
+        return visible;
+    }
+
+    static std::size_t WriteVisibility(const unsigned mask, const std::size_t lanes, std::uint8_t* visibility) noexcept
+    {
+        for (std::size_t lane = 0u; lane < lanes; ++lane)
+            visibility[lane] = static_cast<std::uint8_t>((mask >> lane) & 1u);
+
+        return static_cast<std::size_t>(std::popcount(mask));
+    }
+
+#if CRENDERR_X86_SIMD
+    // Planes splatted once per call, one register per coefficient.
+    struct PlanesSSE
+    {
+        __m128 X[Frustum::PlaneCount], Y[Frustum::PlaneCount], Z[Frustum::PlaneCount], W[Frustum::PlaneCount];
+        __m128 AbsX[Frustum::PlaneCount], AbsY[Frustum::PlaneCount], AbsZ[Frustum::PlaneCount];
+    };
+
+    struct PlanesAVX2
+    {
+        __m256 X[Frustum::PlaneCount], Y[Frustum::PlaneCount], Z[Frustum::PlaneCount], W[Frustum::PlaneCount];
+        __m256 AbsX[Frustum::PlaneCount], AbsY[Frustum::PlaneCount], AbsZ[Frustum::PlaneCount];
+    };
+
+    static PlanesSSE SplatPlanesSSE(const Frustum& frustum) noexcept
+    {
+        PlanesSSE planes{};
+        for (std::size_t i = 0u; i < Frustum::PlaneCount; ++i)
+        {
+            const auto& plane{ frustum.Planes[i] };
+            planes.X[i] = _mm_set1_ps(plane.x);
+            planes.Y[i] = _mm_set1_ps(plane.y);
+            planes.Z[i] = _mm_set1_ps(plane.z);
+            planes.W[i] = _mm_set1_ps(plane.w);
+
+            planes.AbsX[i] = _mm_set1_ps(std::abs(plane.x));
+            planes.AbsY[i] = _mm_set1_ps(std::abs(plane.y));
+            planes.AbsZ[i] = _mm_set1_ps(std::abs(plane.z));
+        }
+
+        return planes;
+    }
+
+    static std::size_t CullSpheresSSE(const Frustum& frustum, const SphereBatch& spheres, std::uint8_t* visibility) noexcept
+    {
+        const auto planes{ SplatPlanesSSE(frustum) };
+        const auto zero{ _mm_setzero_ps() };
+
+        std::size_t first{ 0u }, visible{ 0u };
+        for (; first + 4u <= spheres.GetSize(); first += 4u)
+        {
+            const auto x{ _mm_loadu_ps(&spheres.CenterX[first]) };
+            const auto y{ _mm_loadu_ps(&spheres.CenterY[first]) };
+            const auto z{ _mm_loadu_ps(&spheres.CenterZ[first]) };
+            const auto r{ _mm_loadu_ps(&spheres.Radius[first]) };
+
+            auto inside{ _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+            for (std::size_t i = 0u; i < Frustum::PlaneCount; ++i)
+            {
+                auto distance{ _mm_add_ps(_mm_mul_ps(planes.X[i], x), planes.W[i]) };
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes.Y[i], y));
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes.Z[i], z));
+
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, r), zero));
+            }
+
+            visible += WriteVisibility(static_cast<unsigned>(_mm_movemask_ps(inside)), 4u, visibility + first);
+        }
+
+        return visible + CullSpheresScalar(frustum, spheres, first, visibility);
+    }
+
+    static std::size_t CullBoxesSSE(const Frustum& frustum, const BoxBatch& boxes, std::uint8_t* visibility) noexcept
+    {
+        const auto planes{ SplatPlanesSSE(frustum) };
+        const auto zero{ _mm_setzero_ps() };
+
+        std::size_t first{ 0u }, visible{ 0u };
+        for (; first + 4u <= boxes.GetSize(); first += 4u)
+        {
+            const auto x{ _mm_loadu_ps(&boxes.CenterX[first]) };
+            const auto y{ _mm_loadu_ps(&boxes.CenterY[first]) };
+            const auto z{ _mm_loadu_ps(&boxes.CenterZ[first]) };
+            const auto ex{ _mm_loadu_ps(&boxes.ExtentX[first]) };
+            const auto ey{ _mm_loadu_ps(&boxes.ExtentY[first]) };
+            const auto ez{ _mm_loadu_ps(&boxes.ExtentZ[first]) };
+
+            auto inside{ _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+            for (std::size_t i = 0u; i < Frustum::PlaneCount; ++i)
+            {
+                auto distance{ _mm_add_ps(_mm_mul_ps(planes.X[i], x), planes.W[i]) };
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes.Y[i], y));
+                distance = _mm_add_ps(distance, _mm_mul_ps(planes.Z[i], z));
+
+                auto reach{ _mm_mul_ps(planes.AbsX[i], ex) };
+                reach = _mm_add_ps(reach, _mm_mul_ps(planes.AbsY[i], ey));
+                reach = _mm_add_ps(reach, _mm_mul_ps(planes.AbsZ[i], ez));
+
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, reach), zero));
+            }
+
+            visible += WriteVisibility(static_cast<unsigned>(_mm_movemask_ps(inside)), 4u, visibility + first);
+        }
+
+        return visible + CullBoxesScalar(frustum, boxes, first, visibility);
+    }
+
+    // Filled in place, a 256-bit return value would need AVX in the caller's ABI too.
+    CRENDERR_TARGET_AVX2 static void SplatPlanesAVX2(const Frustum& frustum, PlanesAVX2& planes) noexcept
+    {
+        for (std::size_t i = 0u; i < Frustum::PlaneCount; ++i)
+        {
+            const auto& plane{ frustum.Planes[i] };
+            planes.X[i] = _mm256_set1_ps(plane.x);
+            planes.Y[i] = _mm256_set1_ps(plane.y);
+            planes.Z[i] = _mm256_set1_ps(plane.z);
+            planes.W[i] = _mm256_set1_ps(plane.w);
+
+            planes.AbsX[i] = _mm256_set1_ps(std::abs(plane.x));
+            planes.AbsY[i] = _mm256_set1_ps(std::abs(plane.y));
+            planes.AbsZ[i] = _mm256_set1_ps(std::abs(plane.z));
+        }
+    }
+
+    CRENDERR_TARGET_AVX2 static std::size_t CullSpheresAVX2(const Frustum& frustum, const SphereBatch& spheres, std::uint8_t* visibility) noexcept
+    {
+        PlanesAVX2 planes{};
+        SplatPlanesAVX2(frustum, planes);
+        const auto zero{ _mm256_setzero_ps() };
+
+        std::size_t first{ 0u }, visible{ 0u };
+        for (; first + 8u <= spheres.GetSize(); first += 8u)
+        {
+            const auto x{ _mm256_loadu_ps(&spheres.CenterX[first]) };
+            const auto y{ _mm256_loadu_ps(&spheres.CenterY[first]) };
+            const auto z{ _mm256_loadu_ps(&spheres.CenterZ[first]) };
+            const auto r{ _mm256_loadu_ps(&spheres.Radius[first]) };
+
+            auto inside{ _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+            for (std::size_t i = 0u; i < Frustum::PlaneCount; ++i)
+            {
+                auto distance{ _mm256_fmadd_ps(planes.X[i], x, _mm256_add_ps(planes.W[i], r)) };
+                distance = _mm256_fmadd_ps(planes.Y[i], y, distance);
+                distance = _mm256_fmadd_ps(planes.Z[i], z, distance);
+
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+            }
+
+            visible += WriteVisibility(static_cast<unsigned>(_mm256_movemask_ps(inside)), 8u, visibility + first);
+        }
+
+        return visible + CullSpheresScalar(frustum, spheres, first, visibility);
+    }
+
+    CRENDERR_TARGET_AVX2 static std::size_t CullBoxesAVX2(const Frustum& frustum, const BoxBatch& boxes, std::uint8_t* visibility) noexcept
+    {
+        PlanesAVX2 planes{};
+        SplatPlanesAVX2(frustum, planes);
+        const auto zero{ _mm256_setzero_ps() };
+
+        std::size_t first{ 0u }, visible{ 0u };
+        for (; first + 8u <= boxes.GetSize(); first += 8u)
+        {
+            const auto x{ _mm256_loadu_ps(&boxes.CenterX[first]) };
+            const auto y{ _mm256_loadu_ps(&boxes.CenterY[first]) };
+            const auto z{ _mm256_loadu_ps(&boxes.CenterZ[first]) };
+            const auto ex{ _mm256_loadu_ps(&boxes.ExtentX[first]) };
+            const auto ey{ _mm256_loadu_ps(&boxes.ExtentY[first]) };
+            const auto ez{ _mm256_loadu_ps(&boxes.ExtentZ[first]) };
+
+            auto inside{ _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+            for (std::size_t i = 0u; i < Frustum::PlaneCount; ++i)
+            {
+                // distance + reach in one chain.
+                auto sum{ _mm256_fmadd_ps(planes.X[i], x, planes.W[i]) };
+                sum = _mm256_fmadd_ps(planes.Y[i], y, sum);
+                sum = _mm256_fmadd_ps(planes.Z[i], z, sum);
+                sum = _mm256_fmadd_ps(planes.AbsX[i], ex, sum);
+                sum = _mm256_fmadd_ps(planes.AbsY[i], ey, sum);
+                sum = _mm256_fmadd_ps(planes.AbsZ[i], ez, sum);
+
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(sum, zero, _CMP_GE_OQ));
+            }
+
+            visible += WriteVisibility(static_cast<unsigned>(_mm256_movemask_ps(inside)), 8u, visibility + first);
+        }
+
+        return visible + CullBoxesScalar(frustum, boxes, first, visibility);
+    }
+#endif
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4& viewProjection) noexcept
+{
+    // glm is column major, row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i]).
+    const auto getRow{ [&viewProjection](const int i) {
+        return glm::vec4{ viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i] };
+    } };
+
+    const auto x{ getRow(0) }, y{ getRow(1) }, z{ getRow(2) }, w{ getRow(3) };
+
+    Frustum frustum{};
+    frustum.Planes[Left]   = Internal::NormalizePlane(w + x);
+    frustum.Planes[Right]  = Internal::NormalizePlane(w - x);
+    frustum.Planes[Bottom] = Internal::NormalizePlane(w + y);
+    frustum.Planes[Top]    = Internal::NormalizePlane(w - y);
+    frustum.Planes[Near]   = Internal::NormalizePlane(w + z);
+    frustum.Planes[Far]    = Internal::NormalizePlane(w - z);
+
+    return frustum;
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const noexcept
+{
+    return Internal::IsSphereVisible(*this, sphere.Center.x, sphere.Center.y, sphere.Center.z, sphere.Radius);
+}
+
+bool Frustum::Intersects(const BoundingBox& box) const noexcept
+{
+    const auto center{ box.GetCenter() };
+    const auto extent{ box.GetExtent() };
+    return Internal::IsBoxVisible(*this, center.x, center.y, center.z, extent.x, extent.y, extent.z);
+}
+
+void SphereBatch::Resize(const std::size_t size)
+{
+    for (auto* component : { &CenterX, &CenterY, &CenterZ, &Radius })
+        component->resize(size, 0.0f);
+}
+
+void SphereBatch::Clear() noexcept
+{
+    SphereBatch::Resize(0u);
+}
+
+void SphereBatch::Push(const BoundingSphere& sphere)
+{
+    SphereBatch::Resize(SphereBatch::GetSize() + 1u);
+    SphereBatch::Set(SphereBatch::GetSize() - 1u, sphere);
+}
+
+void SphereBatch::Set(const std::size_t index, const BoundingSphere& sphere) noexcept
+{
+    CenterX[index] = sphere.Center.x;
+    CenterY[index] = sphere.Center.y;
+    CenterZ[index] = sphere.Center.z;
+    Radius[index]  = sphere.Radius;
+}
+
+void BoxBatch::Resize(const std::size_t size)
+{
+    for (auto* component : { &CenterX, &CenterY, &CenterZ, &ExtentX, &ExtentY, &ExtentZ })
+        component->resize(size, 0.0f);
+}
+
+void BoxBatch::Clear() noexcept
+{
+    BoxBatch::Resize(0u);
+}
+
+void BoxBatch::Push(const BoundingBox& box)
+{
+    BoxBatch::Resize(BoxBatch::GetSize() + 1u);
+    BoxBatch::Set(BoxBatch::GetSize() - 1u, box);
+}
+
+void BoxBatch::Set(const std::size_t index, const BoundingBox& box) noexcept
+{
+    const auto center{ box.GetCenter() };
+    const auto extent{ box.GetExtent() };
+
+    CenterX[index] = center.x;
+    CenterY[index] = center.y;
+    CenterZ[index] = center.z;
+    ExtentX[index] = extent.x;
+    ExtentY[index] = extent.y;
+    ExtentZ[index] = extent.z;
+}
+
+std::size_t CullSpheres(const Frustum& frustum, const SphereBatch& spheres, std::uint8_t* visibility, const SimdLevel level) noexcept
+{
+    if (!visibility || !spheres.GetSize()) return 0u;
+
+    switch (std::min(level, GetSupportedSimdLevel()))
+    {
+#if CRENDERR_X86_SIMD
+    case SimdLevel::AVX2: return Internal::CullSpheresAVX2(frustum, spheres, visibility);
+    case SimdLevel::SSE:  return Internal::CullSpheresSSE(frustum, spheres, visibility);
+#endif
+    default:              return Internal::CullSpheresScalar(frustum, spheres, 0u, visibility);
+    }
+}
+
+std::size_t CullBoxes(const Frustum& frustum, const BoxBatch& boxes, std::uint8_t* visibility, const SimdLevel level) noexcept
+{
+    if (!visibility || !boxes.GetSize()) return 0u;
+
+    switch (std::min(level, GetSupportedSimdLevel()))
+    {
+#if CRENDERR_X86_SIMD
+    case SimdLevel::AVX2: return Internal::CullBoxesAVX2(frustum, boxes, visibility);
+    case SimdLevel::SSE:  return Internal::CullBoxesSSE(frustum, boxes, visibility);
+#endif
+    default:              return Internal::CullBoxesScalar(frustum, boxes, 0u, visibility);
+    }
+}
+
+NAMESPACE_END(Renderer)
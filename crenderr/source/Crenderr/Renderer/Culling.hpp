@@ -0,0 +1,68 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/Bounds.hpp"
+#include "Renderer/Simd.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+// Six planes facing inwards, xyz is the unit normal and w the distance, so dot(normal, p) + w >= 0 is inside.
+struct Frustum
+{
+    enum PlaneIndex { Left, Right, Bottom, Top, Near, Far, PlaneCount, };
+
+    std::array<glm::vec4, PlaneCount> Planes{};
+
+    // Extracted from projection * view (Gribb/Hartmann), the clip space depth is the OpenGL [-1, 1].
+    static Frustum FromMatrix(const glm::mat4& viewProjection) noexcept;
+
+    bool Intersects(const BoundingSphere& sphere) const noexcept;
+    bool Intersects(const BoundingBox& box) const noexcept;
+};
+
+// Structure of arrays of world space spheres, the layout the cull kernels read.
+struct SphereBatch
+{
+    std::vector<float> CenterX{}, CenterY{}, CenterZ{};
+    std::vector<float> Radius{};
+
+    inline auto GetSize() const noexcept { return CenterX.size(); }
+
+    void Resize(const std::size_t size);
+    void Clear() noexcept;
+
+    void Push(const BoundingSphere& sphere);
+    void Set(const std::size_t index, const BoundingSphere& sphere) noexcept;
+};
+
+// Same for axis aligned boxes, stored as center and half extent.
+struct BoxBatch
+{
+    std::vector<float> CenterX{}, CenterY{}, CenterZ{};
+    std::vector<float> ExtentX{}, ExtentY{}, ExtentZ{};
+
+    inline auto GetSize() const noexcept { return CenterX.size(); }
+
+    void Resize(const std::size_t size);
+    void Clear() noexcept;
+
+    void Push(const BoundingBox& box);
+    void Set(const std::size_t index, const BoundingBox& box) noexcept;
+};
+
+/**
+ * Tests every volume of the batch against the frustum, 4 or 8 at a time. visibility receives one byte
+ * per volume, 1 when it is at least partially inside, and the number of visible ones is returned.
+ * The tests are conservative, a volume is only rejected when it is fully behind one of the planes.
+ */
+std::size_t CullSpheres(const Frustum& frustum, const SphereBatch& spheres, std::uint8_t* visibility, const SimdLevel level = GetSupportedSimdLevel()) noexcept;
+std::size_t CullBoxes(const Frustum& frustum, const BoxBatch& boxes, std::uint8_t* visibility, const SimdLevel level = GetSupportedSimdLevel()) noexcept;
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,85 @@
+#include "GeometryPool.hpp"
+
+#include <spdlog/spdlog.h>
+
+NAMESPACE_BEGIN(Renderer)
+
+GeometryPool::GeometryPool(const GeometryPoolProps& props)
+    : m_Props{ props } {}
+
+GeometryMesh GeometryPool::Allocate(
+    const void* vertices, const std::size_t vertexCount,
+    const std::uint32_t* indices, const std::size_t indexCount,
+    const glm::mat4& baseTransform,
+    const MeshBounds& bounds) noexcept
+{
+    if (!m_VertexArray || !vertexCount || !indexCount) return {};
+
+    if (m_VertexCount + vertexCount > m_Props.VertexCapacity || m_IndexCount + indexCount > m_Props.IndexCapacity)
+    {
+        spdlog::error("[GeometryPool]: Out of space for a mesh of {} vertices and {} indices! ({}/{} vertices, {}/{} indices used)",
+            vertexCount, indexCount, m_VertexCount, m_Props.VertexCapacity, m_IndexCount, m_Props.IndexCapacity);
+        return {};
+    }
+
+    if (!m_VertexBuffer->SetData(vertices, vertexCount, m_VertexCount)) return {};
+    if (!m_IndexBuffer->SetData(indices, indexCount, m_IndexCount))     return {};
+
+    const GeometryMesh mesh{
+        .Range = {
+            .IndexCount = static_cast<std::uint32_t>(indexCount),
+            .FirstIndex = static_cast<std::uint32_t>(m_IndexCount),
+            .BaseVertex = static_cast<std::int32_t>(m_VertexCount),
+        },
+        .BaseTransform = baseTransform,
+        .Bounds        = bounds,
+    };
+
+    m_VertexCount += vertexCount;
+    m_IndexCount  += indexCount;
+
+    return mesh;
+}
+
+bool GeometryPool::OnInitialize() noexcept
+{
+    if (!m_Props.Layout.GetStride() || !m_Props.VertexCapacity || !m_Props.IndexCapacity) return false;
+
+    // Storage only, the meshes are written in with Allocate().
+    m_VertexBuffer = AllocateResource<VertexBuffer>({
+        .DataSize = m_Props.VertexCapacity,
+        .VertSize = m_Props.Layout.GetStride(),
+        .Usage    = BufferUsage::DynamicDraw,
+        .Layout   = m_Props.Layout,
+    });
+    if (!m_VertexBuffer->OnInitialize()) return false;
+
+    m_IndexBuffer = AllocateResource<IndexBuffer>({
+        .Count = m_Props.IndexCapacity,
+        .Usage = BufferUsage::DynamicDraw,
+    });
+    if (!m_IndexBuffer->OnInitialize()) return false;
+
+    m_VertexArray = AllocateResource<VertexArray>({
+        .VertexBufferPtr = m_VertexBuffer,
+        .IndexBufferPtr  = m_IndexBuffer,
+    });
+    if (!m_VertexArray->OnInitialize()) return false;
+
+    m_VertexCount = 0u;
+    m_IndexCount  = 0u;
+
+    return true;
+}
+
+void GeometryPool::Bind() const
+{
+    if (m_VertexArray) m_VertexArray->Bind();
+}
+
+void GeometryPool::Unbind() const
+{
+    if (m_VertexArray) m_VertexArray->Unbind();
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/RendererElements.hpp"
+#include "Renderer/Bounds.hpp"
+#include "Renderer/Backend/VertexArray.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+NAMESPACE_BEGIN(Renderer)
+
+// Mirrors the layout glMultiDrawElementsIndirect() reads its commands in.
+struct DrawIndirectCommand
+{
+    std::uint32_t IndexCount{ 0u };
+    std::uint32_t InstanceCount{ 0u };
+    std::uint32_t FirstIndex{ 0u };
+    std::int32_t BaseVertex{ 0 };
+    std::uint32_t BaseInstance{ 0u };
+};
+
+static_assert(sizeof(DrawIndirectCommand) == 5u * sizeof(std::uint32_t), "DrawIndirectCommand has to be tightly packed!");
+
+// Indices of one mesh inside the pool, they are relative to its BaseVertex.
+struct GeometryRange
+{
+    std::uint32_t IndexCount{ 0u };
+    std::uint32_t FirstIndex{ 0u };
+    std::int32_t BaseVertex{ 0 };
+
+    inline bool operator==(const GeometryRange&) const noexcept = default;
+};
+
+struct GeometryMesh
+{
+    GeometryRange Range{};
+
+    // Applied before the model matrix, like VertexArray::GetBaseTransform().
+    glm::mat4 BaseTransform{ 1.0f };
+
+    // Object space, like VertexArray::GetBounds().
+    MeshBounds Bounds{};
+
+    inline bool IsValid() const noexcept { return Range.IndexCount != 0u; }
+};
+
+struct GeometryPoolProps
+{
+    BufferLayout Layout{ Vertex3D::c_Layout };
+    std::size_t VertexCapacity{ 1u << 20u };
+    std::size_t IndexCapacity{ 1u << 22u };
+};
+
+/**
+ * One vertex buffer, one index buffer and one vertex array shared by every static mesh in it.
+ * Meshes are only ever appended, a draw of any of them needs no vertex array switch, so the
+ * renderer submits all of them with a single multi draw.
+ */
+class GeometryPool : public RendererResource<GeometryPoolProps>
+{
+public:
+    explicit GeometryPool(const GeometryPoolProps& props);
+    ~GeometryPool() = default;
+
+    // Returns an invalid mesh when the pool is out of space.
+    GeometryMesh Allocate(
+        const void* vertices, const std::size_t vertexCount,
+        const std::uint32_t* indices, const std::size_t indexCount,
+        const glm::mat4& baseTransform = glm::mat4(1.0f),
+        const MeshBounds& bounds = {}) noexcept;
+
+    inline const auto& GetLayout() const noexcept { return m_Props.Layout; }
+    inline const auto& GetVertexArray() const noexcept { return m_VertexArray; }
+
+    inline auto GetVertexCount() const noexcept { return m_VertexCount; }
+    inline auto GetIndexCount() const noexcept { return m_IndexCount; }
+
+public:
+    virtual bool OnInitialize() noexcept override;
+
+public:
+    virtual void Bind() const override;
+    virtual void Unbind() const override;
+
+public:
+    inline virtual RendererID GetResourceHandle() const override { return m_VertexArray ? m_VertexArray->GetResourceHandle() : c_EmptyValue<RendererID>; }
+
+private:
+    GeometryPoolProps m_Props{};
+
+    std::shared_ptr<VertexBuffer> m_VertexBuffer{};
+    std::shared_ptr<IndexBuffer> m_IndexBuffer{};
+    std::shared_ptr<VertexArray> m_VertexArray{};
+
+    std::size_t m_VertexCount{ 0u };
+    std::size_t m_IndexCount{ 0u };
+};
+
+NAMESPACE_END(Renderer)
@@ -1,5 +1,8 @@
 #include "GraphicsContext.hpp"
 
+#include "Renderer/Backend/StateCache.hpp"
+#include "Renderer/MipChain.hpp"
+
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <spdlog/spdlog.h>
@@ -35,7 +38,12 @@ bool GraphicsContext::Initialize() noexcept
     // glEnable(GL_DEBUG_OUTPUT);
     // glDebugMessageCallback(GLADErrorCallback, nullptr);
 
-    glEnable(GL_DEPTH_TEST);
+    StateCache::Get().SetCapability(Capability::DepthTest, true);
+
+    // Mip chains larger than this, e.g. of a .dds file, are rejected before anything is allocated for them.
+    GLint maxTextureSize{};
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (maxTextureSize > 0) MipChain::SetMaxSize(maxTextureSize);
     glfwSwapInterval(1);
 
     // glEnable(GL_CULL_FACE);
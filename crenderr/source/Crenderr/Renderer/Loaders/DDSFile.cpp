@@ -0,0 +1,320 @@
+#include "DDSFile.hpp"
+
+#include "Utility/MappedFile.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+
+namespace Internal
+{
+    constexpr std::uint32_t MakeFourCC(const char a, const char b, const char c, const char d) noexcept
+    {
+        return static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b) << 8u | static_cast<std::uint32_t>(c) << 16u | static_cast<std::uint32_t>(d) << 24u;
+    }
+
+    constexpr std::uint32_t c_Magic{ Internal::MakeFourCC('D', 'D', 'S', ' ') };
+
+    constexpr std::uint32_t c_FourCCDXT1{ Internal::MakeFourCC('D', 'X', 'T', '1') };
+    constexpr std::uint32_t c_FourCCDXT5{ Internal::MakeFourCC('D', 'X', 'T', '5') };
+    constexpr std::uint32_t c_FourCCATI2{ Internal::MakeFourCC('A', 'T', 'I', '2') };
+    constexpr std::uint32_t c_FourCCBC5U{ Internal::MakeFourCC('B', 'C', '5', 'U') };
+    constexpr std::uint32_t c_FourCCDX10{ Internal::MakeFourCC('D', 'X', '1', '0') };
+
+    // DDSD_*, DDPF_* and DDSCAPS_* of the original header.
+    constexpr std::uint32_t c_FlagsRequired    { 0x1u | 0x2u | 0x4u | 0x1000u };
+    constexpr std::uint32_t c_FlagMipMapCount  { 0x20000u };
+    constexpr std::uint32_t c_FlagLinearSize   { 0x80000u };
+    constexpr std::uint32_t c_FlagPitch        { 0x8u };
+    constexpr std::uint32_t c_PixelAlpha       { 0x1u };
+    constexpr std::uint32_t c_PixelFourCC      { 0x4u };
+    constexpr std::uint32_t c_PixelRGB         { 0x40u };
+    constexpr std::uint32_t c_CapsComplex      { 0x8u };
+    constexpr std::uint32_t c_CapsTexture      { 0x1000u };
+    constexpr std::uint32_t c_CapsMipMap       { 0x400000u };
+
+    // DXGI_FORMAT values of the DX10 header.
+    constexpr std::uint32_t c_DxgiRGBA8{ 28u };
+    constexpr std::uint32_t c_DxgiBC1  { 71u };
+    constexpr std::uint32_t c_DxgiBC3  { 77u };
+    constexpr std::uint32_t c_DxgiBC5  { 83u };
+    constexpr std::uint32_t c_DxgiBC7  { 98u };
+
+    constexpr std::uint32_t c_DimensionTexture2D{ 3u };
+
+    struct PixelFormat
+    {
+        std::uint32_t Size{ sizeof(PixelFormat) };
+        std::uint32_t Flags{ 0u };
+        std::uint32_t FourCC{ 0u };
+        std::uint32_t BitCount{ 0u };
+        std::uint32_t RedMask{ 0u };
+        std::uint32_t GreenMask{ 0u };
+        std::uint32_t BlueMask{ 0u };
+        std::uint32_t AlphaMask{ 0u };
+    };
+
+    struct Header
+    {
+        std::uint32_t Size{ sizeof(Header) };
+        std::uint32_t Flags{ 0u };
+        std::uint32_t Height{ 0u };
+        std::uint32_t Width{ 0u };
+        std::uint32_t PitchOrLinearSize{ 0u };
+        std::uint32_t Depth{ 0u };
+        std::uint32_t MipMapCount{ 0u };
+        std::uint32_t Reserved1[11]{};
+        PixelFormat Format{};
+        std::uint32_t Caps{ 0u };
+        std::uint32_t Caps2{ 0u };
+        std::uint32_t Caps3{ 0u };
+        std::uint32_t Caps4{ 0u };
+        std::uint32_t Reserved2{ 0u };
+    };
+
+    struct HeaderDX10
+    {
+        std::uint32_t DxgiFormat{ 0u };
+        std::uint32_t Dimension{ c_DimensionTexture2D };
+        std::uint32_t MiscFlags{ 0u };
+        std::uint32_t ArraySize{ 1u };
+        std::uint32_t MiscFlags2{ 0u };
+    };
+
+    static_assert(sizeof(PixelFormat) == 32u && sizeof(Header) == 124u && sizeof(HeaderDX10) == 20u);
+
+    static bool GetFormat(const std::uint32_t dxgiFormat, Renderer::TextureFormat& format) noexcept
+    {
+        switch (dxgiFormat)
+        {
+        case c_DxgiRGBA8: format = Renderer::TextureFormat::RGBA8; return true;
+        case c_DxgiBC1:   format = Renderer::TextureFormat::BC1;   return true;
+        case c_DxgiBC3:   format = Renderer::TextureFormat::BC3;   return true;
+        case c_DxgiBC5:   format = Renderer::TextureFormat::BC5;   return true;
+        case c_DxgiBC7:   format = Renderer::TextureFormat::BC7;   return true;
+        default:          return false;
+        }
+    }
+
+    static bool GetFormat(const PixelFormat& pixelFormat, Renderer::TextureFormat& format) noexcept
+    {
+        if (pixelFormat.Flags & c_PixelFourCC)
+        {
+            switch (pixelFormat.FourCC)
+            {
+            case c_FourCCDXT1: format = Renderer::TextureFormat::BC1; return true;
+            case c_FourCCDXT5: format = Renderer::TextureFormat::BC3; return true;
+            case c_FourCCATI2:
+            case c_FourCCBC5U: format = Renderer::TextureFormat::BC5; return true;
+            default:           return false;
+            }
+        }
+
+        // Only the byte order GL_RGBA reads, R in the lowest byte.
+        format = Renderer::TextureFormat::RGBA8;
+        return (pixelFormat.Flags & c_PixelRGB) && pixelFormat.BitCount == 32u
+            && pixelFormat.RedMask == 0x000000FFu && pixelFormat.GreenMask == 0x0000FF00u && pixelFormat.BlueMask == 0x00FF0000u;
+    }
+
+    // The legacy header for everything but BC7.
+    static void SetFormat(const Renderer::TextureFormat format, Header& header, HeaderDX10& headerDX10, bool& isDX10) noexcept
+    {
+        auto& pixelFormat{ header.Format };
+        isDX10 = false;
+
+        switch (format)
+        {
+        case Renderer::TextureFormat::BC1: pixelFormat.Flags = c_PixelFourCC; pixelFormat.FourCC = c_FourCCDXT1; break;
+        case Renderer::TextureFormat::BC3: pixelFormat.Flags = c_PixelFourCC; pixelFormat.FourCC = c_FourCCDXT5; break;
+        case Renderer::TextureFormat::BC5: pixelFormat.Flags = c_PixelFourCC; pixelFormat.FourCC = c_FourCCATI2; break;
+
+        case Renderer::TextureFormat::BC7:
+            pixelFormat.Flags     = c_PixelFourCC;
+            pixelFormat.FourCC    = c_FourCCDX10;
+            headerDX10.DxgiFormat = c_DxgiBC7;
+            isDX10 = true;
+            break;
+
+        default:
+            pixelFormat.Flags     = c_PixelRGB | c_PixelAlpha;
+            pixelFormat.BitCount  = 32u;
+            pixelFormat.RedMask   = 0x000000FFu;
+            pixelFormat.GreenMask = 0x0000FF00u;
+            pixelFormat.BlueMask  = 0x00FF0000u;
+            pixelFormat.AlphaMask = 0xFF000000u;
+            break;
+        }
+    }
+}
+
+std::string GetCompressedTexturePath(const std::string& sourcePath)
+{
+    return std::filesystem::path{ sourcePath }.replace_extension(".dds").string();
+}
+
+std::string FindCompressedTexture(const std::string& sourcePath) noexcept
+{
+    if (sourcePath.empty()) return {};
+
+    std::error_code error{};
+    const auto compressedPath{ GetCompressedTexturePath(sourcePath) };
+
+    const auto compressedTime{ std::filesystem::last_write_time(compressedPath, error) };
+    if (error) return {};
+
+    if (compressedPath == sourcePath) return compressedPath;
+
+    // Outdated once the source was edited after the conversion.
+    const auto sourceTime{ std::filesystem::last_write_time(sourcePath, error) };
+    if (!error && sourceTime > compressedTime) return {};
+
+    return compressedPath;
+}
+
+bool ReadDDSFile(const std::string& filepath, Renderer::MipChain& levels, const std::uint32_t levelCount) noexcept
+{
+    const MappedFile file{ filepath };
+    if (!file.IsOpen())
+    {
+        spdlog::error("[DDSFile]: Cannot open the file: {}", filepath);
+        return false;
+    }
+
+    std::uint32_t magic{};
+    Internal::Header header{};
+    Internal::HeaderDX10 headerDX10{};
+
+    auto offset{ sizeof(magic) + sizeof(Internal::Header) };
+    if (file.GetSize() < offset)
+    {
+        spdlog::error("[DDSFile]: The file is too short: {}", filepath);
+        return false;
+    }
+
+    std::memcpy(&magic, file.GetData(), sizeof(magic));
+    std::memcpy(&header, file.GetData() + sizeof(magic), sizeof(Internal::Header));
+    if (magic != Internal::c_Magic || header.Size != sizeof(Internal::Header) || header.Format.Size != sizeof(Internal::PixelFormat))
+    {
+        spdlog::error("[DDSFile]: Not a DDS file: {}", filepath);
+        return false;
+    }
+
+    Renderer::TextureFormat format{};
+    auto isSupported{ false };
+
+    if ((header.Format.Flags & Internal::c_PixelFourCC) && header.Format.FourCC == Internal::c_FourCCDX10)
+    {
+        if (file.GetSize() >= offset + sizeof(Internal::HeaderDX10))
+        {
+            std::memcpy(&headerDX10, file.GetData() + offset, sizeof(Internal::HeaderDX10));
+            offset += sizeof(Internal::HeaderDX10);
+
+            isSupported = headerDX10.Dimension == Internal::c_DimensionTexture2D && headerDX10.ArraySize == 1u
+                && Internal::GetFormat(headerDX10.DxgiFormat, format);
+        }
+    }
+    else isSupported = Internal::GetFormat(header.Format, format);
+
+    // Cube maps and volumes are not 2D textures either.
+    if (!isSupported || header.Caps2 || header.Depth > 1u)
+    {
+        spdlog::error("[DDSFile]: Unsupported format, only 2D RGBA8, BC1, BC3, BC5 and BC7 textures load: {}", filepath);
+        return false;
+    }
+
+    // Everything the header claims is checked before anything is allocated for it.
+    const auto maxSize{ static_cast<std::uint32_t>(Renderer::MipChain::GetMaxSize()) };
+    if (!header.Width || !header.Height || header.Width > maxSize || header.Height > maxSize)
+    {
+        spdlog::error("[DDSFile]: {}x{} is not a supported texture size, the maximum is {}: {}", header.Width, header.Height, maxSize, filepath);
+        return false;
+    }
+
+    const glm::ivec2 size{ static_cast<int>(header.Width), static_cast<int>(header.Height), };
+    const auto fileLevelCount{ (header.Flags & Internal::c_FlagMipMapCount) ? std::max(header.MipMapCount, 1u) : 1u };
+    if (fileLevelCount > Renderer::MipChain::GetLevelCount(size))
+    {
+        spdlog::error("[DDSFile]: Corrupted file, {} levels for {}x{}: {}", fileLevelCount, size.x, size.y, filepath);
+        return false;
+    }
+
+    const auto count{ levelCount ? std::min(levelCount, fileLevelCount) : fileLevelCount };
+
+    std::size_t byteSize{};
+    if (!Renderer::MipChain::GetChainByteSize(format, size, count, byteSize) || byteSize > file.GetSize() - offset)
+    {
+        spdlog::error("[DDSFile]: Corrupted file, {}x{} with {} levels does not fit: {}", size.x, size.y, count, filepath);
+        return false;
+    }
+
+    const auto* data{ reinterpret_cast<const std::uint8_t*>(file.GetData()) + offset };
+    if (!levels.Assign(format, size, count, data, file.GetSize() - offset))
+    {
+        spdlog::error("[DDSFile]: Failed to copy the levels: {}", filepath);
+        return false;
+    }
+
+    return true;
+}
+
+bool WriteDDSFile(const std::string& filepath, const Renderer::MipChain& levels) noexcept
+{
+    if (levels.IsEmpty()) return false;
+
+    const auto& size{ levels.GetSize(0u) };
+    const auto format{ levels.GetFormat() };
+    const auto isCompressed{ Renderer::IsBlockCompressed(format) };
+
+    Internal::Header header{
+        .Flags             = Internal::c_FlagsRequired | Internal::c_FlagMipMapCount | (isCompressed ? Internal::c_FlagLinearSize : Internal::c_FlagPitch),
+        .Height            = static_cast<std::uint32_t>(size.y),
+        .Width             = static_cast<std::uint32_t>(size.x),
+        .PitchOrLinearSize = static_cast<std::uint32_t>(isCompressed ? levels.GetByteSize(0u) : levels.GetRowSize(0u)),
+        .MipMapCount       = levels.GetLevelCount(),
+        .Caps              = Internal::c_CapsTexture | (levels.GetLevelCount() > 1u ? Internal::c_CapsComplex | Internal::c_CapsMipMap : 0u),
+    };
+
+    Internal::HeaderDX10 headerDX10{};
+    auto isDX10{ false };
+    Internal::SetFormat(format, header, headerDX10, isDX10);
+
+    const auto temporaryPath{ filepath + ".tmp" };
+
+    {
+        std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+        if (!file.is_open())
+        {
+            spdlog::error("[DDSFile]: Cannot create the file: {}", filepath);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&Internal::c_Magic), sizeof(Internal::c_Magic));
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Internal::Header));
+        if (isDX10) file.write(reinterpret_cast<const char*>(&headerDX10), sizeof(Internal::HeaderDX10));
+
+        // The levels are already back to back in the chain.
+        file.write(reinterpret_cast<const char*>(levels.GetPixels(0u)), static_cast<std::streamsize>(levels.GetByteSize(0u, levels.GetLevelCount())));
+
+        if (!file.good())
+        {
+            spdlog::error("[DDSFile]: Failed to write the file: {}", filepath);
+            return false;
+        }
+    }
+
+    // Written aside and renamed, a reader never sees a truncated file.
+    std::error_code error{};
+    std::filesystem::remove(filepath, error);
+    std::filesystem::rename(temporaryPath, filepath, error);
+    if (error)
+    {
+        spdlog::error("[DDSFile]: Failed to move the file into place: {} ({})", filepath, error.message());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    return true;
+}
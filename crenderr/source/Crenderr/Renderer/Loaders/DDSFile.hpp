@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Renderer/MipChain.hpp"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Textures with all their levels in the DirectDraw Surface container. BC1, BC3 and BC5 are written
+ * with the legacy FourCC header every tool understands, BC7 needs the DX10 extension header and
+ * RGBA8 is stored as plain 32 bit RGB with alpha. Reading accepts both headers for any of them.
+ *
+ * The rows are stored bottom up, the order GL expects and the one the loaders flip decoded images
+ * into. Other DDS viewers show the files upside down, files made by other tools load flipped.
+ */
+
+// sourcePath with its extension replaced by .dds.
+std::string GetCompressedTexturePath(const std::string& sourcePath);
+
+// The .dds next to the source when it exists and is not older than the source, an empty string otherwise.
+// A path to a .dds file itself is returned as it is when the file exists.
+std::string FindCompressedTexture(const std::string& sourcePath) noexcept;
+
+// levelCount = 0 reads every level the file has, anything else at most that many.
+bool ReadDDSFile(const std::string& filepath, Renderer::MipChain& levels, const std::uint32_t levelCount = 0u) noexcept;
+bool WriteDDSFile(const std::string& filepath, const Renderer::MipChain& levels) noexcept;
@@ -0,0 +1,240 @@
+#include "MeshCache.hpp"
+
+#include "Utility/Hash.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <vector>
+
+namespace Internal
+{
+    constexpr std::uint64_t c_BlobAlignment{ 16u };
+
+    struct SourceFileInfo
+    {
+        std::uint64_t Size{ 0u };
+        std::int64_t Time{ 0 };
+    };
+
+    inline std::uint64_t AlignUp(const std::uint64_t value, const std::uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1u) / alignment * alignment;
+    }
+
+    static bool GetSourceFileInfo(const std::string& filepath, SourceFileInfo& info) noexcept
+    {
+        std::error_code error{};
+
+        const auto size{ std::filesystem::file_size(filepath, error) };
+        if (error) return false;
+
+        const auto time{ std::filesystem::last_write_time(filepath, error) };
+        if (error) return false;
+
+        info.Size = static_cast<std::uint64_t>(size);
+        info.Time = static_cast<std::int64_t>(time.time_since_epoch().count());
+        return true;
+    }
+
+    static bool HashSourceFile(const std::string& filepath, std::uint64_t& hash) noexcept
+    {
+        const MappedFile file{ filepath };
+        if (!file.IsOpen()) return false;
+
+        hash = Hash::FNV1a(file.GetView());
+        return true;
+    }
+
+    static bool IsLayoutMatching(const MeshCacheHeader& header, const MeshCacheElement* elements, const Renderer::BufferLayout& layout) noexcept
+    {
+        const auto& layoutElements{ layout.GetElements() };
+        if (header.Stride != layout.GetStride() || header.ElementCount != layoutElements.size()) return false;
+
+        for (std::size_t i = 0u; i < layoutElements.size(); ++i)
+        {
+            const auto& element{ layoutElements[i] };
+
+            if (elements[i].Type       != static_cast<std::uint32_t>(element.Type) ||
+                elements[i].Offset     != element.Offset ||
+                elements[i].Size       != element.Size   ||
+                elements[i].Normalized != static_cast<std::uint32_t>(element.Normalized))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+std::string GetMeshCachePath(const std::string& sourcePath)
+{
+    return sourcePath + ".crmesh";
+}
+
+bool ReadMeshCache(const std::string& sourcePath, std::uint64_t loaderKey, const Renderer::BufferLayout& layout, MeshCacheData& data) noexcept
+{
+    const auto cachePath{ GetMeshCachePath(sourcePath) };
+
+    std::error_code error{};
+    if (!std::filesystem::exists(cachePath, error)) return false;
+
+    if (!data.File.Open(cachePath) || data.File.GetSize() < sizeof(MeshCacheHeader))
+    {
+        spdlog::warn("[MeshCache]: Cannot read the cache file: {}", cachePath);
+        return false;
+    }
+
+    MeshCacheHeader header{};
+    std::memcpy(&header, data.File.GetData(), sizeof(MeshCacheHeader));
+
+    if (header.Magic != MeshCacheHeader::c_Magic || header.Version != MeshCacheHeader::c_Version)
+    {
+        spdlog::info("[MeshCache]: Outdated cache format, it will be rebuilt: {}", cachePath);
+        return false;
+    }
+
+    if (header.LoaderKey != loaderKey) return false;
+
+    // The counts are bounded by the file before anything is multiplied or added, so nothing below can wrap around.
+    const auto fileSize{ static_cast<std::uint64_t>(data.File.GetSize()) };
+    const auto isCountValid{ header.Stride
+        && header.ElementCount <= (fileSize - sizeof(MeshCacheHeader)) / sizeof(MeshCacheElement)
+        && header.VertexCount <= fileSize / header.Stride
+        && header.IndexCount <= fileSize / sizeof(std::uint32_t) };
+
+    const auto elementsEnd{ sizeof(MeshCacheHeader) + static_cast<std::uint64_t>(header.ElementCount) * sizeof(MeshCacheElement) };
+    const auto vertexBytes{ isCountValid ? header.VertexCount * header.Stride : 0u };
+    const auto indexBytes { isCountValid ? header.IndexCount * sizeof(std::uint32_t) : 0u };
+
+    if (!isCountValid ||
+        header.VertexOffset < elementsEnd || header.VertexOffset > fileSize - vertexBytes ||
+        header.IndexOffset < header.VertexOffset + vertexBytes || header.IndexOffset > fileSize - indexBytes ||
+        header.IndexOffset % alignof(std::uint32_t))
+    {
+        spdlog::warn("[MeshCache]: Corrupted cache file, it will be rebuilt: {}", cachePath);
+        return false;
+    }
+
+    const auto* elements{ reinterpret_cast<const MeshCacheElement*>(data.File.GetData() + sizeof(MeshCacheHeader)) };
+    if (!Internal::IsLayoutMatching(header, elements, layout)) return false;
+
+    Internal::SourceFileInfo source{};
+    if (!Internal::GetSourceFileInfo(sourcePath, source) || source.Size != header.SourceSize) return false;
+
+    if (source.Time != header.SourceTime)
+    {
+        std::uint64_t sourceHash{};
+        if (!Internal::HashSourceFile(sourcePath, sourceHash) || sourceHash != header.SourceHash) return false;
+
+        spdlog::debug("[MeshCache]: Source was touched but its content did not change: {}", sourcePath);
+    }
+
+    // The indices go straight to the GPU and to the CPU side users, one out of range would read past the vertices.
+    const auto* indices{ reinterpret_cast<const std::uint32_t*>(data.File.GetData() + header.IndexOffset) };
+    for (std::uint64_t i = 0u; i < header.IndexCount; ++i)
+    {
+        if (indices[i] < header.VertexCount) continue;
+
+        spdlog::warn("[MeshCache]: Corrupted cache file, index {} is out of range, it will be rebuilt: {}", i, cachePath);
+        return false;
+    }
+
+    data.Vertices    = data.File.GetData() + header.VertexOffset;
+    data.VertexCount = static_cast<std::size_t>(header.VertexCount);
+    data.Indices     = indices;
+    data.IndexCount  = static_cast<std::size_t>(header.IndexCount);
+
+    data.Quantization = header.Quantization;
+    data.Bounds       = header.Bounds;
+
+    return true;
+}
+
+bool WriteMeshCache(const std::string& sourcePath, std::uint64_t loaderKey, const MeshCacheWriteProps& props) noexcept
+{
+    if (!props.Layout) return false;
+
+    Internal::SourceFileInfo source{};
+    std::uint64_t sourceHash{};
+    if (!Internal::GetSourceFileInfo(sourcePath, source) || !Internal::HashSourceFile(sourcePath, sourceHash))
+        return false;
+
+    const auto& layoutElements{ props.Layout->GetElements() };
+
+    std::vector<MeshCacheElement> elements{};
+    elements.reserve(layoutElements.size());
+    for (const auto& element : layoutElements)
+    {
+        elements.push_back({
+            .Type       = static_cast<std::uint32_t>(element.Type),
+            .Offset     = static_cast<std::uint32_t>(element.Offset),
+            .Size       = static_cast<std::uint32_t>(element.Size),
+            .Normalized = static_cast<std::uint32_t>(element.Normalized),
+        });
+    }
+
+    MeshCacheHeader header{
+        .SourceSize   = source.Size,
+        .SourceTime   = source.Time,
+        .SourceHash   = sourceHash,
+        .LoaderKey    = loaderKey,
+        .Stride       = static_cast<std::uint32_t>(props.Layout->GetStride()),
+        .ElementCount = static_cast<std::uint32_t>(elements.size()),
+        .VertexCount  = props.VertexCount,
+        .IndexCount   = props.IndexCount,
+        .Quantization = props.Quantization,
+        .Bounds       = props.Bounds,
+    };
+
+    const auto vertexBytes{ header.VertexCount * header.Stride };
+    header.VertexOffset = Internal::AlignUp(sizeof(MeshCacheHeader) + elements.size() * sizeof(MeshCacheElement), Internal::c_BlobAlignment);
+    header.IndexOffset  = Internal::AlignUp(header.VertexOffset + vertexBytes, Internal::c_BlobAlignment);
+
+    const auto cachePath{ GetMeshCachePath(sourcePath) };
+    const auto temporaryPath{ cachePath + ".tmp" };
+
+    {
+        std::ofstream file{ temporaryPath, std::ios::binary | std::ios::trunc };
+        if (!file.is_open())
+        {
+            spdlog::warn("[MeshCache]: Cannot create the cache file: {}", cachePath);
+            return false;
+        }
+
+        const auto writePadding{ [&file](const std::uint64_t offset) {
+            static constexpr char c_Zeros[Internal::c_BlobAlignment]{};
+            const auto current{ static_cast<std::uint64_t>(file.tellp()) };
+            file.write(c_Zeros, static_cast<std::streamsize>(offset - current));
+        } };
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(MeshCacheHeader));
+        file.write(reinterpret_cast<const char*>(elements.data()), static_cast<std::streamsize>(elements.size() * sizeof(MeshCacheElement)));
+
+        writePadding(header.VertexOffset);
+        file.write(static_cast<const char*>(props.Vertices), static_cast<std::streamsize>(vertexBytes));
+
+        writePadding(header.IndexOffset);
+        file.write(reinterpret_cast<const char*>(props.Indices), static_cast<std::streamsize>(header.IndexCount * sizeof(std::uint32_t)));
+
+        if (!file.good())
+        {
+            spdlog::warn("[MeshCache]: Failed to write the cache file: {}", cachePath);
+            return false;
+        }
+    }
+
+    // Written aside and renamed, so an interrupted run never leaves a truncated cache behind.
+    std::error_code error{};
+    std::filesystem::remove(cachePath, error);
+    std::filesystem::rename(temporaryPath, cachePath, error);
+    if (error)
+    {
+        spdlog::warn("[MeshCache]: Failed to move the cache file into place: {} ({})", cachePath, error.message());
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Renderer/RendererElements.hpp"
+#include "Renderer/Bounds.hpp"
+
+#include "Utility/MappedFile.hpp"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Binary cache of a loaded mesh, stored next to the source file. Layout of the file:
+ *
+ *   MeshCacheHeader
+ *   MeshCacheElement[ElementCount]  - matches the BufferLayout of the vertices
+ *   vertex blob                     - VertexCount * Stride bytes, 16-byte aligned
+ *   index blob                      - IndexCount uint32_t indices
+ *
+ * A cache is valid while the source file keeps its size and modification time. If only the
+ * time changed, the stored content hash decides, so touching or copying a file does not
+ * force a re-parse.
+ */
+struct MeshCacheHeader
+{
+    static constexpr std::uint32_t c_Magic{ 0x434D5243u }; // "CRMC"
+    static constexpr std::uint32_t c_Version{ 4u };
+
+    std::uint32_t Magic{ c_Magic };
+    std::uint32_t Version{ c_Version };
+
+    std::uint64_t SourceSize{ 0u };
+    std::int64_t SourceTime{ 0 };
+    std::uint64_t SourceHash{ 0u };
+
+    // Hash of the loader settings the cached data was produced with.
+    std::uint64_t LoaderKey{ 0u };
+
+    std::uint32_t Stride{ 0u };
+    std::uint32_t ElementCount{ 0u };
+
+    std::uint64_t VertexCount{ 0u };
+    std::uint64_t VertexOffset{ 0u };
+    std::uint64_t IndexCount{ 0u };
+    std::uint64_t IndexOffset{ 0u };
+
+    // Identity unless the positions are packed.
+    Renderer::PositionQuantization Quantization{};
+
+    // Object space bounds, so a cached load does not have to walk the vertices.
+    Renderer::MeshBounds Bounds{};
+};
+
+struct MeshCacheElement
+{
+    std::uint32_t Type{ 0u };
+    std::uint32_t Offset{ 0u };
+    std::uint32_t Size{ 0u };
+    std::uint32_t Normalized{ 0u };
+};
+
+// Mapped cache file, the pointers stay valid as long as the object is alive.
+struct MeshCacheData
+{
+    MappedFile File{};
+
+    const void* Vertices{ nullptr };
+    std::size_t VertexCount{ 0u };
+
+    const std::uint32_t* Indices{ nullptr };
+    std::size_t IndexCount{ 0u };
+
+    Renderer::PositionQuantization Quantization{};
+    Renderer::MeshBounds Bounds{};
+};
+
+struct MeshCacheWriteProps
+{
+    const void* Vertices{ nullptr };
+    std::size_t VertexCount{ 0u };
+
+    const std::uint32_t* Indices{ nullptr };
+    std::size_t IndexCount{ 0u };
+
+    const Renderer::BufferLayout* Layout{ nullptr };
+    Renderer::PositionQuantization Quantization{};
+    Renderer::MeshBounds Bounds{};
+};
+
+std::string GetMeshCachePath(const std::string& sourcePath);
+
+bool ReadMeshCache(const std::string& sourcePath, std::uint64_t loaderKey, const Renderer::BufferLayout& layout, MeshCacheData& data) noexcept;
+bool WriteMeshCache(const std::string& sourcePath, std::uint64_t loaderKey, const MeshCacheWriteProps& props) noexcept;
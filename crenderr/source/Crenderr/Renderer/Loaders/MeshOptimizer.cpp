@@ -0,0 +1,348 @@
+#include "MeshOptimizer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include <cmath>
+
+namespace Internal
+{
+    constexpr std::size_t c_ForsythCacheSize{ 32u };
+    constexpr std::uint32_t c_ForsythMaxValence{ 32u };
+
+    constexpr float c_CacheDecayPower   { 1.5f  };
+    constexpr float c_LastTriangleScore { 0.75f };
+    constexpr float c_ValenceBoostScale { 2.0f  };
+    constexpr float c_ValenceBoostPower { 0.5f  };
+
+    struct ForsythScoreTable
+    {
+        float Cache[c_ForsythCacheSize]{};
+        float Valence[c_ForsythMaxValence + 1u]{};
+
+        ForsythScoreTable() noexcept
+        {
+            for (std::size_t i = 0u; i < c_ForsythCacheSize; ++i)
+            {
+                // The last triangle gets a fixed score, so the next one does not simply reuse its edge.
+                if (i < 3u) Cache[i] = c_LastTriangleScore;
+                else
+                {
+                    const auto scaler{ 1.0f / static_cast<float>(c_ForsythCacheSize - 3u) };
+                    Cache[i] = std::pow(1.0f - static_cast<float>(i - 3u) * scaler, c_CacheDecayPower);
+                }
+            }
+
+            // Vertices with few triangles left are finished first, they would be orphaned otherwise.
+            for (std::uint32_t i = 1u; i <= c_ForsythMaxValence; ++i)
+                Valence[i] = c_ValenceBoostScale * std::pow(static_cast<float>(i), -c_ValenceBoostPower);
+        }
+    };
+
+    inline float GetVertexScore(const ForsythScoreTable& table, const std::int32_t cachePosition, const std::uint32_t valence) noexcept
+    {
+        if (valence == 0u) return -1.0f;
+
+        const auto cacheScore{ cachePosition >= 0 ? table.Cache[cachePosition] : 0.0f };
+        return cacheScore + table.Valence[std::min(valence, c_ForsythMaxValence)];
+    }
+
+    inline glm::vec3 ReadPosition(const void* positions, const std::size_t stride, const std::uint32_t index) noexcept
+    {
+        glm::vec3 position{};
+        std::memcpy(&position, static_cast<const std::uint8_t*>(positions) + index * stride, sizeof(glm::vec3));
+        return position;
+    }
+
+    // FIFO cache simulated with timestamps, a vertex is cached while fewer than cacheSize misses happened since its own.
+    class FIFOCache
+    {
+    public:
+        FIFOCache(const std::size_t vertexCount, const std::size_t cacheSize)
+            : m_Timestamps(vertexCount, 0u), m_CacheSize{ static_cast<std::uint32_t>(cacheSize) }, m_Time{ m_CacheSize + 1u } {}
+
+        inline std::uint32_t Access(const std::uint32_t* triangle) noexcept
+        {
+            std::uint32_t misses{ 0u };
+            for (std::size_t i = 0u; i < 3u; ++i)
+            {
+                if (m_Time - m_Timestamps[triangle[i]] > m_CacheSize)
+                {
+                    m_Timestamps[triangle[i]] = m_Time++;
+                    ++misses;
+                }
+            }
+
+            return misses;
+        }
+
+        inline void Flush() noexcept { m_Time += m_CacheSize + 1u; }
+
+    private:
+        std::vector<std::uint32_t> m_Timestamps;
+        std::uint32_t m_CacheSize;
+        std::uint32_t m_Time;
+    };
+}
+
+VertexCacheStats AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount, std::size_t cacheSize)
+{
+    VertexCacheStats stats{};
+    if (indexCount < 3u || vertexCount == 0u) return stats;
+
+    Internal::FIFOCache cache{ vertexCount, cacheSize };
+    for (std::size_t i = 0u; i + 2u < indexCount; i += 3u)
+        stats.VerticesTransformed += cache.Access(indices + i);
+
+    stats.ACMR = static_cast<float>(stats.VerticesTransformed) / static_cast<float>(indexCount / 3u);
+    stats.ATVR = static_cast<float>(stats.VerticesTransformed) / static_cast<float>(vertexCount);
+    return stats;
+}
+
+void OptimizeVertexCache(std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+{
+    const auto triangleCount{ indexCount / 3u };
+    if (triangleCount < 2u || vertexCount == 0u) return;
+
+    static const Internal::ForsythScoreTable s_ScoreTable{};
+
+    // Triangles adjacent to every vertex, the live ones are kept in front of each range.
+    std::vector<std::uint32_t> valences(vertexCount, 0u);
+    for (std::size_t i = 0u; i < triangleCount * 3u; ++i) ++valences[indices[i]];
+
+    std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1u, 0u);
+    std::inclusive_scan(valences.begin(), valences.end(), adjacencyOffsets.begin() + 1u);
+
+    std::vector<std::uint32_t> adjacency(triangleCount * 3u);
+    {
+        std::vector<std::uint32_t> fill{ adjacencyOffsets.begin(), adjacencyOffsets.end() - 1u };
+        for (std::size_t i = 0u; i < triangleCount * 3u; ++i)
+            adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3u);
+    }
+
+    std::vector<std::int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (std::size_t i = 0u; i < vertexCount; ++i)
+        vertexScores[i] = Internal::GetVertexScore(s_ScoreTable, -1, valences[i]);
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<std::uint32_t> result(triangleCount * 3u);
+
+    std::uint32_t cache[Internal::c_ForsythCacheSize + 3u]{};
+    std::uint32_t nextCache[Internal::c_ForsythCacheSize + 3u]{};
+    std::size_t cacheCount{ 0u };
+
+    std::size_t bestTriangle{ 0u };
+    std::size_t scanCursor{ 0u };
+
+    for (std::size_t output = 0u; output < triangleCount; ++output)
+    {
+        // Nothing in the cache has triangles left, continue with the next one in the original order.
+        if (bestTriangle == triangleCount)
+        {
+            while (emitted[scanCursor]) ++scanCursor;
+            bestTriangle = scanCursor;
+        }
+
+        const auto* triangle{ indices + bestTriangle * 3u };
+        std::copy_n(triangle, 3u, result.data() + output * 3u);
+        emitted[bestTriangle] = true;
+
+        // The vertices of the triangle go to the front of the LRU cache.
+        std::size_t nextCount{ 0u };
+        for (std::size_t i = 0u; i < 3u; ++i)
+        {
+            const auto vertex{ triangle[i] };
+            nextCache[nextCount++] = vertex;
+
+            // Retire the triangle from the adjacency of its vertices.
+            auto* begin{ adjacency.data() + adjacencyOffsets[vertex] };
+            auto* end  { begin + valences[vertex] };
+            auto* found{ std::find(begin, end, static_cast<std::uint32_t>(bestTriangle)) };
+            if (found != end)
+            {
+                *found = *(end - 1u);
+                --valences[vertex];
+            }
+        }
+
+        for (std::size_t i = 0u; i < cacheCount; ++i)
+        {
+            const auto vertex{ cache[i] };
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                nextCache[nextCount++] = vertex;
+        }
+
+        // Rescore every vertex that moved, the ones pushed past the cache size included.
+        for (std::size_t i = 0u; i < nextCount; ++i)
+        {
+            const auto vertex{ nextCache[i] };
+            cachePositions[vertex] = i < Internal::c_ForsythCacheSize ? static_cast<std::int32_t>(i) : -1;
+            vertexScores[vertex] = Internal::GetVertexScore(s_ScoreTable, cachePositions[vertex], valences[vertex]);
+        }
+
+        // Only triangles touching those vertices could have changed their score.
+        auto bestScore{ -1.0f };
+        bestTriangle = triangleCount;
+
+        for (std::size_t i = 0u; i < nextCount; ++i)
+        {
+            const auto vertex{ nextCache[i] };
+            const auto* begin{ adjacency.data() + adjacencyOffsets[vertex] };
+
+            for (const auto* it = begin; it != begin + valences[vertex]; ++it)
+            {
+                const auto* adjacent{ indices + *it * 3u };
+                const auto score{ vertexScores[adjacent[0]] + vertexScores[adjacent[1]] + vertexScores[adjacent[2]] };
+
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = *it;
+                }
+            }
+        }
+
+        cacheCount = std::min(nextCount, Internal::c_ForsythCacheSize);
+        std::copy_n(nextCache, cacheCount, cache);
+    }
+
+    std::copy(result.begin(), result.end(), indices);
+}
+
+void OptimizeOverdraw(std::uint32_t* indices, std::size_t indexCount, const void* positions, std::size_t positionStride, std::size_t vertexCount, float threshold)
+{
+    const auto triangleCount{ indexCount / 3u };
+    if (triangleCount < 2u || vertexCount == 0u || !positions) return;
+
+    // #1. Hard boundaries, where the cache had to start over anyway (every vertex of a triangle missed).
+    std::vector<std::uint32_t> misses(triangleCount);
+    std::vector<std::size_t> hardClusters{};
+    {
+        Internal::FIFOCache cache{ vertexCount, c_DefaultVertexCacheSize };
+        for (std::size_t i = 0u; i < triangleCount; ++i)
+        {
+            misses[i] = cache.Access(indices + i * 3u);
+            if (misses[i] == 3u) hardClusters.push_back(i);
+        }
+    }
+
+    hardClusters.push_back(triangleCount);
+
+    // #2. Soft boundaries, a hard cluster is split wherever its ACMR so far is close enough to the total one.
+    std::vector<std::size_t> clusters{};
+    {
+        Internal::FIFOCache cache{ vertexCount, c_DefaultVertexCacheSize };
+        for (std::size_t c = 0u; c + 1u < hardClusters.size(); ++c)
+        {
+            const auto begin{ hardClusters[c] };
+            const auto end  { hardClusters[c + 1u] };
+
+            std::size_t clusterMisses{ 0u };
+            for (std::size_t i = begin; i < end; ++i) clusterMisses += misses[i];
+
+            const auto limit{ static_cast<float>(clusterMisses) / static_cast<float>(end - begin) * threshold };
+
+            clusters.push_back(begin);
+            cache.Flush();
+
+            std::size_t runMisses{ 0u };
+            std::size_t runTriangles{ 0u };
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                runMisses += cache.Access(indices + i * 3u);
+                ++runTriangles;
+
+                if (i + 1u < end && static_cast<float>(runMisses) / static_cast<float>(runTriangles) <= limit)
+                {
+                    clusters.push_back(i + 1u);
+                    cache.Flush();
+                    runMisses = runTriangles = 0u;
+                }
+            }
+        }
+    }
+
+    clusters.push_back(triangleCount);
+
+    // #3. Sort key of a cluster, how far out from the mesh centroid it lies along its average normal.
+    const auto clusterCount{ clusters.size() - 1u };
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3{ 0.0f });
+    std::vector<glm::vec3> normals(clusterCount, glm::vec3{ 0.0f });
+
+    glm::vec3 meshCentroid{ 0.0f };
+    float meshArea{ 0.0f };
+
+    for (std::size_t c = 0u; c < clusterCount; ++c)
+    {
+        float clusterArea{ 0.0f };
+        for (std::size_t i = clusters[c]; i < clusters[c + 1u]; ++i)
+        {
+            const auto p0{ Internal::ReadPosition(positions, positionStride, indices[i * 3u + 0u]) };
+            const auto p1{ Internal::ReadPosition(positions, positionStride, indices[i * 3u + 1u]) };
+            const auto p2{ Internal::ReadPosition(positions, positionStride, indices[i * 3u + 2u]) };
+
+            const auto normal{ glm::cross(p1 - p0, p2 - p0) };
+            const auto area{ glm::length(normal) };
+
+            centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            normals[c] += normal;
+            clusterArea += area;
+        }
+
+        meshCentroid += centroids[c];
+        meshArea += clusterArea;
+
+        centroids[c] = clusterArea > 0.0f ? centroids[c] / clusterArea : glm::vec3{ 0.0f };
+    }
+
+    if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+    std::vector<float> keys(clusterCount, 0.0f);
+    for (std::size_t c = 0u; c < clusterCount; ++c)
+    {
+        const auto length{ glm::length(normals[c]) };
+        if (length > 0.0f) keys[c] = glm::dot(centroids[c] - meshCentroid, normals[c] / length);
+    }
+
+    std::vector<std::size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), std::size_t{ 0u });
+    std::stable_sort(order.begin(), order.end(), [&keys](std::size_t lhs, std::size_t rhs) { return keys[lhs] > keys[rhs]; });
+
+    std::vector<std::uint32_t> result{};
+    result.reserve(triangleCount * 3u);
+    for (const auto c : order)
+        result.insert(result.end(), indices + clusters[c] * 3u, indices + clusters[c + 1u] * 3u);
+
+    std::copy(result.begin(), result.end(), indices);
+}
+
+std::size_t OptimizeVertexFetch(void* vertices, std::size_t vertexSize, std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount)
+{
+    constexpr auto c_Unused{ static_cast<std::uint32_t>(-1) };
+
+    std::vector<std::uint32_t> remap(vertexCount, c_Unused);
+    std::uint32_t nextVertex{ 0u };
+
+    for (std::size_t i = 0u; i < indexCount; ++i)
+    {
+        auto& target{ remap[indices[i]] };
+        if (target == c_Unused) target = nextVertex++;
+        indices[i] = target;
+    }
+
+    auto* bytes{ static_cast<std::uint8_t*>(vertices) };
+    std::vector<std::uint8_t> reordered(static_cast<std::size_t>(nextVertex) * vertexSize);
+
+    for (std::size_t i = 0u; i < vertexCount; ++i)
+    {
+        if (remap[i] != c_Unused)
+            std::memcpy(reordered.data() + remap[i] * vertexSize, bytes + i * vertexSize, vertexSize);
+    }
+
+    std::memcpy(bytes, reordered.data(), reordered.size());
+    return nextVertex;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Post-transform cache and overdraw optimisation of indexed triangle lists.
+ *
+ * Usual order of the passes:
+ *   OptimizeVertexCache() -> OptimizeOverdraw() (optional) -> OptimizeVertexFetch()
+ *
+ * Sources:
+ *   https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+ *   https://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/tipsy.pdf
+ */
+
+constexpr std::size_t c_DefaultVertexCacheSize{ 16u };
+
+// Result of running an index buffer through a simulated FIFO post-transform cache.
+struct VertexCacheStats
+{
+    std::size_t VerticesTransformed{ 0u };
+
+    // Average cache miss ratio, transformed vertices per triangle (0.5 at best, 3.0 at worst).
+    float ACMR{ 0.0f };
+
+    // Average transform to vertex ratio, transformed vertices per vertex (1.0 at best).
+    float ATVR{ 0.0f };
+};
+
+VertexCacheStats AnalyzeVertexCache(const std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount, std::size_t cacheSize = c_DefaultVertexCacheSize);
+
+// Reorders the triangles for the post-transform cache hit rate (Forsyth's linear-speed algorithm).
+void OptimizeVertexCache(std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount);
+
+// Splits the cache-optimised triangles into clusters and draws the outward facing ones first.
+// The threshold is how much worse the ACMR of a cluster is allowed to get, 1.05 costs ~5% of
+// the cache hits. Positions are read as three floats every positionStride bytes.
+void OptimizeOverdraw(std::uint32_t* indices, std::size_t indexCount, const void* positions, std::size_t positionStride, std::size_t vertexCount, float threshold = 1.05f);
+
+// Reorders the vertices by their first use in the index buffer and remaps the indices.
+// Unreferenced vertices are dropped, returns the new vertex count.
+std::size_t OptimizeVertexFetch(void* vertices, std::size_t vertexSize, std::uint32_t* indices, std::size_t indexCount, std::size_t vertexCount);
@@ -1,238 +1,513 @@
-// #include "OBJLoader.hpp"
-
-// #include <fstream>
-
-// static std::tuple<std::uint32_t, std::uint32_t, std::uint32_t> SplitFace(const std::string& face)
-// {
-//     constexpr char delimeter{ '/' };
-
-//     const auto firstDelimeter{ face.find(delimeter) };
-//     const auto secondDelimeter{ face.find(delimeter, firstDelimeter + 1u) };
-
-//     const auto substr1{ face.substr(0u, firstDelimeter) };
-//     const auto substr2{ firstDelimeter == std::string::npos ? "" : face.substr(firstDelimeter + 1u, secondDelimeter - firstDelimeter - 1u) };
-//     const auto substr3{ secondDelimeter == std::string::npos ? "" : face.substr(secondDelimeter + 1u, face.size() - secondDelimeter) };
-
-//     return std::make_tuple(
-//         static_cast<std::uint32_t>(std::stoi(substr1.empty() ? "-1" : substr1)),
-//         static_cast<std::uint32_t>(std::stoi(substr2.empty() ? "-1" : substr2)),
-//         static_cast<std::uint32_t>(std::stoi(substr3.empty() ? "-1" : substr3))
-//     );
-// }
-
-// std::vector<Renderer::Vertex3D> OBJLoader::LoadData(const std::string& filepath)
-// {
-//     std::ifstream file{ filepath };
-//     if (!file.is_open())
-//     {
-//         spdlog::info("Bad file!");
-//         return {};
-//     }
-
-//     std::vector<glm::vec3> vertices{};
-//     std::vector<glm::vec3> normals{};
-//     std::vector<glm::vec2> texCoords{};
-
-//     decltype(OBJModelData::Data) data{};
-
-//     while (!file.eof())
-//     {
-//         std::string lineHeader{};
-//         file >> lineHeader;
-
-//         if (lineHeader == "v")
-//         {
-//             glm::vec3 vertex{};
-//             file >> vertex.x >> vertex.y >> vertex.z;
-//             vertices.push_back(vertex);
-//         }
-//         else if (lineHeader == "vt")
-//         {
-//             glm::vec2 texCoord{};
-//             file >> texCoord.x >> texCoord.y;
-//             texCoords.push_back(texCoord);
-//         }
-//         else if (lineHeader == "vn")
-//         {
-//             glm::vec3 normal{};
-//             file >> normal.x >> normal.y >> normal.z;
-//             normals.push_back(normal);
-//         }
-//         else if (lineHeader == "f")
-//         {
-//             if (m_FaceType == FaceType::Triangle)
-//             {
-//                 std::string faces[3u]{};
-//                 file >> faces[0u] >> faces[1u] >> faces[2u];
-
-//                 for (std::size_t i = 0u; i < 3u; ++i)
-//                 {
-//                     constexpr auto invalidValue{ static_cast<std::uint32_t>(-1) };
-//                     const auto [vi, ti, ni]{ SplitFace(faces[i]) };
-
-//                     data.push_back({
-//                         vi == invalidValue ? glm::vec3{} : vertices.at(vi - 1u),
-//                         ni == invalidValue ? glm::vec3{} : normals.at(ni - 1u),
-//                         ti == invalidValue ? glm::vec2{} : texCoords.at(ti - 1u)
-//                     });
-//                 }
-//             }
-//             else if (m_FaceType == FaceType::Quad)
-//             {
-//                 OBJVertexData quad[4u]{};
-
-//                 std::string faces[4u]{};
-//                 file >> faces[0u] >> faces[1u] >> faces[2u] >> faces[3u];
-
-//                 for (std::size_t i = 0u; i < 4u; ++i)
-//                 {
-//                     constexpr auto invalidValue{ static_cast<std::uint32_t>(-1) };
-//                     const auto [vi, ti, ni]{ SplitFace(faces[i]) };
-
-//                     quad[i] = {
-//                         vi == invalidValue ? glm::vec3{} : vertices.at(vi - 1u),
-//                         ni == invalidValue ? glm::vec3{} : normals.at(ni - 1u),
-//                         ti == invalidValue ? glm::vec2{} : texCoords.at(ti - 1u)
-//                     };
-//                 }
-
-//                 data.push_back(quad[2u]); data.push_back(quad[3u]); data.push_back(quad[1u]);
-//                 data.push_back(quad[0u]); data.push_back(quad[1u]); data.push_back(quad[3u]);
-//             }
-//         }
-//     }
-
-//     return { data };
-// }
-
-// std::shared_ptr<Renderer::VertexArray> OBJLoader::LoadModel(const std::string& filepath)
-// {
-//     const auto vertexData{ OBJLoader::LoadData(filepath) };
-
-    
-// }
-
 #include "OBJLoader.hpp"
 
+#include "MeshCache.hpp"
+#include "MeshOptimizer.hpp"
+
+#include "Utility/MappedFile.hpp"
+#include "Utility/ThreadPool.hpp"
+#include "Utility/Hash.hpp"
+
 #include <spdlog/spdlog.h>
-#include <fstream>
 
-#include <iostream>
-#include <sstream>
-#include <map>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <limits>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <atomic>
 
-static std::tuple<std::uint32_t, std::uint32_t, std::uint32_t> SplitFace(const std::string& face)
+namespace Internal
 {
-    constexpr char delimeter{ '/' };
+    constexpr std::int32_t c_NoIndex{ -1 };
 
-    const auto firstDelimeter{ face.find(delimeter) };
-    const auto secondDelimeter{ face.find(delimeter, firstDelimeter + 1u) };
+    // Chunks smaller than this are not worth handing to another thread.
+    constexpr std::size_t c_MinChunkSize{ 4u * 1024u * 1024u };
 
-    const auto substr1{ face.substr(0u, firstDelimeter) };
-    const auto substr2{ firstDelimeter == std::string::npos ? "" : face.substr(firstDelimeter + 1u, secondDelimeter - firstDelimeter - 1u) };
-    const auto substr3{ secondDelimeter == std::string::npos ? "" : face.substr(secondDelimeter + 1u, face.size() - secondDelimeter) };
+    // Zero-based, already resolved indices of a single face corner.
+    struct OBJCorner
+    {
+        std::int32_t Position{ c_NoIndex };
+        std::int32_t Texcoord{ c_NoIndex };
+        std::int32_t Normal  { c_NoIndex };
+    };
 
-    return std::make_tuple(
-        static_cast<std::uint32_t>(std::stoi(substr1.empty() ? "-1" : substr1)),
-        static_cast<std::uint32_t>(std::stoi(substr2.empty() ? "-1" : substr2)),
-        static_cast<std::uint32_t>(std::stoi(substr3.empty() ? "-1" : substr3))
-    );
-}
+    struct OBJRecords
+    {
+        std::vector<glm::vec3> Positions{};
+        std::vector<glm::vec3> Normals{};
+        std::vector<glm::vec2> Texcoords{};
+        std::vector<OBJCorner> Corners{};
+    };
 
-OBJModelData LoadOBJFile(const std::string& filepath, FaceType faceType)
-{
-    std::ifstream file{ filepath };
-    if (!file.is_open())
+    struct OBJRecordCounts
     {
-        spdlog::info("Bad file!");
-        return {};
-    }
+        std::size_t Lines{ 0u };
+        std::size_t Positions{ 0u };
+        std::size_t Normals{ 0u };
+        std::size_t Texcoords{ 0u };
+        std::size_t Corners{ 0u };
 
-    std::vector<glm::vec3> vertices{};
-    std::vector<glm::vec3> normals{};
-    std::vector<glm::vec2> texCoords{};
+        inline OBJRecordCounts& operator+=(const OBJRecordCounts& other) noexcept
+        {
+            Lines     += other.Lines;
+            Positions += other.Positions;
+            Normals   += other.Normals;
+            Texcoords += other.Texcoords;
+            Corners   += other.Corners;
+            return *this;
+        }
+    };
 
-    decltype(OBJModelData::Data) data{};
+    // Newline-aligned part of the file. Offsets are the global counts of everything before it.
+    struct OBJChunk
+    {
+        std::string_view Text{};
+        OBJRecordCounts Counts{};
+        OBJRecordCounts Offsets{};
+    };
 
-    while (!file.eof())
+    inline bool IsSpace(const char c) noexcept
     {
-        std::string lineHeader{};
-        file >> lineHeader;
+        return c == ' ' || c == '\t' || c == '\r';
+    }
 
-        if (lineHeader == "v")
+    inline const char* SkipSpaces(const char* it, const char* end) noexcept
+    {
+        while (it != end && IsSpace(*it)) ++it;
+        return it;
+    }
+
+    inline const char* FindLineEnd(const char* it, const char* end) noexcept
+    {
+        const auto lineEnd{ static_cast<const char*>(std::memchr(it, '\n', static_cast<std::size_t>(end - it))) };
+        return lineEnd ? lineEnd : end;
+    }
+
+    // Polygons are split into a fan of triangles, a face with fewer than three corners is reserved as one.
+    inline std::size_t GetCornersPerFace(const char* it, const char* end) noexcept
+    {
+        std::size_t tokens{ 0u };
+        for (it = SkipSpaces(it, end); it != end; it = SkipSpaces(it, end))
         {
-            glm::vec3 vertex{};
-            file >> vertex.x >> vertex.y >> vertex.z;
-            vertices.push_back(vertex);
+            ++tokens;
+            while (it != end && !IsSpace(*it)) ++it;
         }
-        else if (lineHeader == "vt")
+
+        return (std::max<std::size_t>(tokens, 3u) - 2u) * 3u;
+    }
+
+    inline bool ParseFloat(const char*& it, const char* end, float& value) noexcept
+    {
+        it = SkipSpaces(it, end);
+        if (it != end && *it == '+') ++it;
+
+        const auto [ptr, error]{ std::from_chars(it, end, value) };
+
+        // Values too small to be represented as a float (denormals) are flushed to zero.
+        if (error == std::errc::result_out_of_range) value = 0.0f;
+        else if (error != std::errc{}) return false;
+
+        it = ptr;
+        return true;
+    }
+
+    // Parses a 1-based (or negative, relative) OBJ index and turns it into a zero-based one.
+    inline bool ParseIndex(const char*& it, const char* end, const std::size_t count, std::int32_t& index) noexcept
+    {
+        std::int64_t value{};
+        const auto [ptr, error]{ std::from_chars(it, end, value) };
+        if (error != std::errc{} || value == 0) return false;
+
+        const auto resolved{ value > 0 ? value - 1 : static_cast<std::int64_t>(count) + value };
+        if (resolved < 0 || resolved > std::numeric_limits<std::int32_t>::max()) return false;
+
+        index = static_cast<std::int32_t>(resolved);
+        it = ptr;
+        return true;
+    }
+
+    // Accepts all of the "v", "v/t", "v//n" and "v/t/n" corner forms.
+    // The counts are the global number of attributes defined so far, used by relative indices.
+    inline bool ParseCorner(const char*& it, const char* end, const OBJRecordCounts& counts, OBJCorner& corner) noexcept
+    {
+        if (!ParseIndex(it, end, counts.Positions, corner.Position)) return false;
+        if (it == end || *it != '/') return true;
+
+        ++it;
+        if (it != end && *it != '/' && !IsSpace(*it))
+            if (!ParseIndex(it, end, counts.Texcoords, corner.Texcoord)) return false;
+
+        if (it == end || *it != '/') return true;
+
+        ++it;
+        return ParseIndex(it, end, counts.Normals, corner.Normal);
+    }
+
+    static OBJRecordCounts CountRecords(const std::string_view text) noexcept
+    {
+        OBJRecordCounts counts{};
+
+        const char* it{ text.data() };
+        const char* end{ text.data() + text.size() };
+
+        while (it < end)
         {
-            glm::vec2 texCoord{};
-            file >> texCoord.x >> texCoord.y;
-            texCoords.push_back(texCoord);
+            const char* lineEnd{ FindLineEnd(it, end) };
+            ++counts.Lines;
+
+            it = SkipSpaces(it, lineEnd);
+
+            // Has to recognize exactly the same records as ParseChunk().
+            if (lineEnd - it >= 2 && it[0] == 'v' && IsSpace(it[1]))
+                ++counts.Positions;
+            else if (lineEnd - it >= 3 && it[0] == 'v' && it[1] == 'n' && IsSpace(it[2]))
+                ++counts.Normals;
+            else if (lineEnd - it >= 3 && it[0] == 'v' && it[1] == 't' && IsSpace(it[2]))
+                ++counts.Texcoords;
+            else if (lineEnd - it >= 2 && it[0] == 'f' && IsSpace(it[1]))
+                counts.Corners += GetCornersPerFace(it + 1u, lineEnd);
+
+            it = lineEnd + 1;
         }
-        else if (lineHeader == "vn")
+
+        return counts;
+    }
+
+    static std::vector<OBJChunk> SplitIntoChunks(const std::string_view text, const std::size_t maxChunkCount)
+    {
+        const auto chunkCount{ std::clamp<std::size_t>(text.size() / c_MinChunkSize, 1u, std::max<std::size_t>(maxChunkCount, 1u)) };
+
+        std::vector<OBJChunk> chunks{};
+        chunks.reserve(chunkCount);
+
+        std::size_t begin{ 0u };
+        for (std::size_t i = 1u; i <= chunkCount && begin < text.size(); ++i)
         {
-            glm::vec3 normal{};
-            file >> normal.x >> normal.y >> normal.z;
-            normals.push_back(normal);
+            auto end{ i == chunkCount ? text.size() : std::max(begin, text.size() / chunkCount * i) };
+
+            // Move the boundary just past the next newline, so no record is cut in half.
+            if (end < text.size())
+            {
+                const auto newline{ text.find('\n', end) };
+                end = newline == std::string_view::npos ? text.size() : newline + 1u;
+            }
+
+            chunks.push_back({ .Text = text.substr(begin, end - begin) });
+            begin = end;
         }
-        else if (lineHeader == "f")
+
+        return chunks;
+    }
+
+    // Writes the records of a chunk directly into their final place inside the pre-sized arrays.
+    static bool ParseChunk(const OBJChunk& chunk, const FaceType faceType, OBJRecords& records)
+    {
+        const char* it{ chunk.Text.data() };
+        const char* end{ chunk.Text.data() + chunk.Text.size() };
+
+        auto cursor{ chunk.Offsets };
+        while (it < end)
         {
-            if (faceType == FaceType::Triangle)
+            const char* lineEnd{ FindLineEnd(it, end) };
+            ++cursor.Lines;
+
+            it = SkipSpaces(it, lineEnd);
+
+            bool success{ true };
+            if (lineEnd - it >= 2 && it[0] == 'v' && IsSpace(it[1]))
             {
-                std::string faces[3u]{};
-                file >> faces[0u] >> faces[1u] >> faces[2u];
+                auto& position{ records.Positions[cursor.Positions++] };
+                it += 1u;
+                success = ParseFloat(it, lineEnd, position.x)
+                       && ParseFloat(it, lineEnd, position.y)
+                       && ParseFloat(it, lineEnd, position.z);
+            }
+            else if (lineEnd - it >= 3 && it[0] == 'v' && it[1] == 'n' && IsSpace(it[2]))
+            {
+                auto& normal{ records.Normals[cursor.Normals++] };
+                it += 2u;
+                success = ParseFloat(it, lineEnd, normal.x)
+                       && ParseFloat(it, lineEnd, normal.y)
+                       && ParseFloat(it, lineEnd, normal.z);
+            }
+            else if (lineEnd - it >= 3 && it[0] == 'v' && it[1] == 't' && IsSpace(it[2]))
+            {
+                auto& texcoord{ records.Texcoords[cursor.Texcoords++] };
+                it += 2u;
+                success = ParseFloat(it, lineEnd, texcoord.x)
+                       && ParseFloat(it, lineEnd, texcoord.y);
+            }
+            else if (lineEnd - it >= 2 && it[0] == 'f' && IsSpace(it[1]))
+            {
+                OBJCorner first{}, previous{};
+                std::size_t cornerCount{ 0u };
+
+                // Fanned out from the first corner as the corners come, CountRecords() reserved a triangle per corner past the second.
+                auto* output{ records.Corners.data() + cursor.Corners };
 
-                for (std::size_t i = 0u; i < 3u; ++i)
+                it = SkipSpaces(it + 1u, lineEnd);
+                while (success && it != lineEnd)
                 {
-                    constexpr auto invalidValue{ static_cast<std::uint32_t>(-1) };
-                    const auto [vi, ti, ni]{ SplitFace(faces[i]) };
-
-                    data.push_back({
-                        vi == invalidValue ? glm::vec3{} : vertices.at(vi - 1u),
-                        ni == invalidValue ? glm::vec3{} : normals.at(ni - 1u),
-                        ti == invalidValue ? glm::vec2{} : texCoords.at(ti - 1u)
-                    });
+                    OBJCorner corner{};
+                    success = ParseCorner(it, lineEnd, cursor, corner);
+                    it = SkipSpaces(it, lineEnd);
+
+                    if (!success) break;
+                    if (cornerCount >= 2u)
+                    {
+                        *output++ = first; *output++ = previous; *output++ = corner;
+                    }
+
+                    if (cornerCount++ == 0u) first = corner;
+                    previous = corner;
                 }
+
+                if (success && cornerCount < 3u) success = false;
+
+                if (success && faceType == FaceType::Quad && cornerCount == 4u)
+                {
+                    // Quads keep being split along their second diagonal.
+                    output = records.Corners.data() + cursor.Corners;
+
+                    const OBJCorner quad[4u]{ output[0u], output[1u], output[2u], output[5u] };
+                    output[0u] = quad[2u]; output[1u] = quad[3u]; output[2u] = quad[1u];
+                    output[3u] = quad[0u]; output[4u] = quad[1u]; output[5u] = quad[3u];
+                }
+
+                if (success) cursor.Corners += (cornerCount - 2u) * 3u;
             }
-            else if (faceType == FaceType::Quad)
+
+            if (!success)
             {
-                Renderer::Vertex3D quad[4u]{};
+                spdlog::error("[OBJLoader]: Malformed record at line {}: {}",
+                    cursor.Lines, std::string_view{ it, static_cast<std::size_t>(lineEnd - it) });
+                return false;
+            }
+
+            it = lineEnd + 1;
+        }
+
+        return true;
+    }
+
+    inline bool operator==(const OBJCorner& lhs, const OBJCorner& rhs) noexcept
+    {
+        return lhs.Position == rhs.Position && lhs.Texcoord == rhs.Texcoord && lhs.Normal == rhs.Normal;
+    }
+
+    inline std::uint64_t HashCorner(const OBJCorner& corner) noexcept
+    {
+        auto hash{ static_cast<std::uint64_t>(static_cast<std::uint32_t>(corner.Position)) * 0x9E3779B97F4A7C15ull };
+        hash ^= static_cast<std::uint64_t>(static_cast<std::uint32_t>(corner.Texcoord)) * 0xC2B2AE3D27D4EB4Full;
+        hash ^= static_cast<std::uint64_t>(static_cast<std::uint32_t>(corner.Normal))   * 0x165667B19E3779F9ull;
+        return hash ^ (hash >> 29u);
+    }
+
+    // Collapses identical corners, producing the unique ones and an index per input corner.
+    static void IndexCorners(const std::vector<OBJCorner>& corners, std::vector<OBJCorner>& uniqueCorners, std::vector<std::uint32_t>& indices)
+    {
+        constexpr auto c_EmptySlot{ std::numeric_limits<std::uint32_t>::max() };
 
-                std::string faces[4u]{};
-                file >> faces[0u] >> faces[1u] >> faces[2u] >> faces[3u];
+        // Open addressing with linear probing, kept at most half full.
+        const auto capacity{ std::bit_ceil(std::max<std::size_t>(corners.size() * 2u, 16u)) };
+        const auto mask{ capacity - 1u };
+        std::vector<std::uint32_t> table(capacity, c_EmptySlot);
 
-                for (std::size_t i = 0u; i < 4u; ++i)
+        uniqueCorners.clear();
+        indices.resize(corners.size());
+
+        for (std::size_t i = 0u; i < corners.size(); ++i)
+        {
+            const auto& corner{ corners[i] };
+
+            for (auto slot{ HashCorner(corner) & mask };; slot = (slot + 1u) & mask)
+            {
+                if (table[slot] == c_EmptySlot)
                 {
-                    constexpr auto invalidValue{ static_cast<std::uint32_t>(-1) };
-                    const auto [vi, ti, ni]{ SplitFace(faces[i]) };
-
-                    quad[i] = {
-                        vi == invalidValue ? glm::vec3{} : vertices.at(vi - 1u),
-                        ni == invalidValue ? glm::vec3{} : normals.at(ni - 1u),
-                        ti == invalidValue ? glm::vec2{} : texCoords.at(ti - 1u)
-                    };
+                    table[slot] = static_cast<std::uint32_t>(uniqueCorners.size());
+                    uniqueCorners.push_back(corner);
+                }
+                else if (!(uniqueCorners[table[slot]] == corner))
+                {
+                    continue;
                 }
 
-                data.push_back(quad[2u]); data.push_back(quad[3u]); data.push_back(quad[1u]);
-                data.push_back(quad[0u]); data.push_back(quad[1u]); data.push_back(quad[3u]);
+                indices[i] = table[slot];
+                break;
             }
         }
     }
 
-    return { data };
+    static bool BuildVertices(const OBJRecords& records, const std::vector<OBJCorner>& corners, const std::size_t begin, const std::size_t end, Renderer::Vertex3D* vertices)
+    {
+        const auto isValid{ [](const std::int32_t index, const std::size_t count) {
+            return index == c_NoIndex || static_cast<std::size_t>(index) < count;
+        } };
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const auto& corner{ corners[i] };
+
+            if (!isValid(corner.Position, records.Positions.size()) ||
+                !isValid(corner.Texcoord, records.Texcoords.size()) ||
+                !isValid(corner.Normal,   records.Normals.size()))
+            {
+                spdlog::error("[OBJLoader]: A face references a vertex attribute that does not exist! (v={}, vt={}, vn={})",
+                    corner.Position + 1, corner.Texcoord + 1, corner.Normal + 1);
+                return false;
+            }
+
+            vertices[i] = {
+                corner.Position == c_NoIndex ? glm::vec3{} : records.Positions[corner.Position],
+                corner.Normal   == c_NoIndex ? glm::vec3{} : records.Normals  [corner.Normal],
+                corner.Texcoord == c_NoIndex ? glm::vec2{} : records.Texcoords[corner.Texcoord],
+            };
+        }
+
+        return true;
+    }
 }
 
-std::shared_ptr<Renderer::VertexArray> LoadOBJModel(const std::string& filepath, FaceType faceType)
+OBJModelData LoadOBJFile(const std::string& filepath, const OBJLoaderProps& props)
 {
-    const auto modelData{ LoadOBJFile(filepath, faceType).Data };
+    const auto startTime{ std::chrono::steady_clock::now() };
 
+    const MappedFile file{ filepath };
+    if (!file.IsOpen())
+    {
+        spdlog::error("[OBJLoader]: Failed to open the file: {}", filepath);
+        return {};
+    }
+
+    const auto threadCount{ props.ThreadCount ? props.ThreadCount : ThreadPool::GetHardwareThreadCount() };
+    auto chunks{ Internal::SplitIntoChunks(file.GetView(), threadCount) };
+
+    // At most one chunk per thread, so ParallelFor() keeps no more threads busy than asked for.
+    auto& pool{ ThreadPool::GetShared() };
+
+    // #1. Count the records of every chunk, so the arrays can be allocated once.
+    pool.ParallelFor(chunks.size(), [&chunks](std::size_t i) {
+        chunks[i].Counts = Internal::CountRecords(chunks[i].Text);
+    });
+
+    // #2. Prefix sum of the counts gives every chunk its place in the global arrays.
+    Internal::OBJRecordCounts totals{};
+    for (auto& chunk : chunks)
+    {
+        chunk.Offsets = totals;
+        totals += chunk.Counts;
+    }
+
+    Internal::OBJRecords records{};
+    records.Positions.resize(totals.Positions);
+    records.Normals.resize(totals.Normals);
+    records.Texcoords.resize(totals.Texcoords);
+    records.Corners.resize(totals.Corners);
+
+    // #3. Parse the chunks, the global offsets resolve the relative indices too.
+    std::atomic<bool> success{ true };
+    pool.ParallelFor(chunks.size(), [&chunks, &props, &records, &success](std::size_t i) {
+        if (!Internal::ParseChunk(chunks[i], props.Face, records)) success = false;
+    });
+
+    if (!success)
+    {
+        spdlog::error("[OBJLoader]: Failed to parse the file: {}", filepath);
+        return {};
+    }
+
+    // #4. Deduplicate the corners, so every unique vertex is stored and transformed once.
+    OBJModelData modelData{};
+
+    std::vector<Internal::OBJCorner> uniqueCorners{};
+    Internal::IndexCorners(records.Corners, uniqueCorners, modelData.Indices);
+
+    // #5. Build the unique vertices, split evenly between the threads.
+    modelData.Data.resize(uniqueCorners.size());
+
+    const auto rangeSize{ (uniqueCorners.size() + chunks.size() - 1u) / std::max<std::size_t>(chunks.size(), 1u) };
+    pool.ParallelFor(chunks.size(), [&records, &uniqueCorners, &modelData, &success, rangeSize](std::size_t i) {
+        const auto begin{ std::min(i * rangeSize, uniqueCorners.size()) };
+        const auto end  { std::min(begin + rangeSize, uniqueCorners.size()) };
+        if (!Internal::BuildVertices(records, uniqueCorners, begin, end, modelData.Data.data())) success = false;
+    });
+
+    if (!success)
+    {
+        spdlog::error("[OBJLoader]: Failed to build the vertices: {}", filepath);
+        return {};
+    }
+
+    // #6. Reorder the triangles and vertices for the GPU caches, a file without faces has nothing to reorder.
+    if (props.OptimizeVertexCache && !modelData.Indices.empty() && !modelData.Data.empty())
+    {
+        const auto optimizeStartTime{ std::chrono::steady_clock::now() };
+        const auto before{ AnalyzeVertexCache(modelData.Indices.data(), modelData.Indices.size(), modelData.Data.size()) };
+
+        OptimizeVertexCache(modelData.Indices.data(), modelData.Indices.size(), modelData.Data.size());
+        if (props.OptimizeOverdraw)
+        {
+            OptimizeOverdraw(modelData.Indices.data(), modelData.Indices.size(),
+                &modelData.Data.data()->Position, sizeof(Renderer::Vertex3D), modelData.Data.size());
+        }
+
+        const auto vertexCount{ OptimizeVertexFetch(modelData.Data.data(), sizeof(Renderer::Vertex3D),
+            modelData.Indices.data(), modelData.Indices.size(), modelData.Data.size()) };
+        modelData.Data.resize(vertexCount);
+
+        const auto after{ AnalyzeVertexCache(modelData.Indices.data(), modelData.Indices.size(), modelData.Data.size()) };
+        const std::chrono::duration<double, std::milli> optimizeElapsed{ std::chrono::steady_clock::now() - optimizeStartTime };
+
+        spdlog::info("[OBJLoader]: Optimized {} in {:.2f} ms, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+            filepath, optimizeElapsed.count(), before.ACMR, after.ACMR, before.ATVR, after.ATVR);
+    }
+
+    if (!modelData.Data.empty())
+        modelData.Bounds = Renderer::MeshBounds::FromPositions(&modelData.Data.front().Position, modelData.Data.size(), sizeof(Renderer::Vertex3D));
+
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - startTime };
+    const auto megabytes{ static_cast<double>(file.GetSize()) / (1024.0 * 1024.0) };
+
+    spdlog::info("[OBJLoader]: Loaded {} ({:.2f} MB, {} faces, {} chunks) in {:.2f} ms [{:.1f} MB/s]",
+        filepath, megabytes, totals.Corners / 3u, chunks.size(), elapsed.count() * 1000.0,
+        elapsed.count() > 0.0 ? megabytes / elapsed.count() : 0.0);
+    spdlog::info("[OBJLoader]: {} vertices deduplicated to {} vertices + {} indices ({:.2f} MB -> {:.2f} MB)",
+        totals.Corners, modelData.Data.size(), modelData.Indices.size(),
+        static_cast<double>(totals.Corners * sizeof(Renderer::Vertex3D)) / (1024.0 * 1024.0),
+        static_cast<double>(modelData.Data.size() * sizeof(Renderer::Vertex3D) + modelData.Indices.size() * sizeof(std::uint32_t)) / (1024.0 * 1024.0));
+
+    return modelData;
+}
+
+OBJModelData LoadOBJFile(const std::string& filepath, FaceType faceType)
+{
+    return LoadOBJFile(filepath, OBJLoaderProps{ .Face = faceType, });
+}
+
+Renderer::MeshBVH BuildOBJModelBVH(const OBJModelData& model)
+{
+    Renderer::MeshBVH bvh{};
+    if (model.Data.empty()) return bvh;
+
+    bvh.Build(&model.Data.front().Position, model.Data.size(), model.Indices, sizeof(Renderer::Vertex3D));
+    return bvh;
+}
+
+static std::shared_ptr<Renderer::VertexArray> CreateModel(
+    const std::string& filepath,
+    const Renderer::BufferLayout& layout,
+    const void* vertices, std::size_t vertexCount,
+    const std::uint32_t* indices, std::size_t indexCount,
+    const Renderer::PositionQuantization& quantization,
+    const Renderer::MeshBounds& bounds)
+{
     auto modelVB{ Renderer::AllocateResource<Renderer::VertexBuffer>({
-        .Data     = modelData.data(),
-        .DataSize = modelData.size(),
-        .VertSize = sizeof(decltype(modelData)::value_type),
-        .Layout   = decltype(modelData)::value_type::c_Layout,
+        .Data     = vertices,
+        .DataSize = vertexCount,
+        .VertSize = layout.GetStride(),
+        .Layout   = layout,
     }) };
 
     if (!modelVB->OnInitialize())
@@ -241,9 +516,167 @@ std::shared_ptr<Renderer::VertexArray> LoadOBJModel(const std::string& filepath,
         return {};
     }
 
+    auto modelIB{ Renderer::AllocateResource<Renderer::IndexBuffer>({
+        .Data  = indices,
+        .Count = indexCount,
+    }) };
+
+    if (!modelIB->OnInitialize())
+    {
+        spdlog::error("[OBJLoader]: Failed to initialize index buffer: {}", filepath);
+        return {};
+    }
+
     auto model{ Renderer::AllocateResource<Renderer::VertexArray>({
         .VertexBufferPtr = modelVB,
+        .IndexBufferPtr  = modelIB,
+        .BaseTransform   = quantization.GetTransform(),
+        .Bounds          = bounds,
     }) };
 
     return model;
 }
+
+static const Renderer::BufferLayout& GetVertexLayout(const VertexFormat format) noexcept
+{
+    return format == VertexFormat::Packed ? Renderer::Vertex3DPacked::c_Layout : Renderer::Vertex3D::c_Layout;
+}
+
+static Renderer::PositionQuantization PackVertices(const std::vector<Renderer::Vertex3D>& vertices, std::vector<Renderer::Vertex3DPacked>& packed)
+{
+    if (vertices.empty()) return {};
+
+    auto min{ vertices.front().Position };
+    auto max{ vertices.front().Position };
+    for (const auto& vertex : vertices)
+    {
+        min = glm::min(min, vertex.Position);
+        max = glm::max(max, vertex.Position);
+    }
+
+    const auto quantization{ Renderer::PositionQuantization::FromBounds(min, max) };
+
+    packed.resize(vertices.size());
+    for (std::size_t i = 0u; i < vertices.size(); ++i)
+        packed[i] = Renderer::Vertex3DPacked::Pack(vertices[i], quantization);
+
+    return quantization;
+}
+
+// Every setting that changes the loaded data has to be part of the key.
+static std::uint64_t GetCacheKey(const OBJLoaderProps& props) noexcept
+{
+    auto key{ Hash::FNV1aValue(props.Face) };
+    key = Hash::FNV1aValue(props.OptimizeVertexCache, key);
+    key = Hash::FNV1aValue(props.OptimizeOverdraw, key);
+    key = Hash::FNV1aValue(props.Format, key);
+    return key;
+}
+
+// Vertices and indices ready for the GPU, they only live during the upload callback.
+using OBJUploadFunction = std::function<bool(
+    const void* vertices, std::size_t vertexCount,
+    const std::uint32_t* indices, std::size_t indexCount,
+    const Renderer::PositionQuantization& quantization,
+    const Renderer::MeshBounds& bounds)>;
+
+static bool LoadOBJGeometry(const std::string& filepath, const OBJLoaderProps& props, const OBJUploadFunction& upload)
+{
+    const auto startTime{ std::chrono::steady_clock::now() };
+    const auto getElapsedTime{ [&startTime]() {
+        return std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - startTime }.count();
+    } };
+
+    const auto& layout{ GetVertexLayout(props.Format) };
+
+    if (props.UseCache)
+    {
+        // The mapped vertices and indices are uploaded as they are, without any copy on our side.
+        MeshCacheData cache{};
+        if (ReadMeshCache(filepath, GetCacheKey(props), layout, cache))
+        {
+            const auto uploaded{ upload(cache.Vertices, cache.VertexCount, cache.Indices, cache.IndexCount, cache.Quantization, cache.Bounds) };
+
+            spdlog::info("[OBJLoader]: Loaded {} from the mesh cache ({} vertices, {} indices) in {:.2f} ms",
+                filepath, cache.VertexCount, cache.IndexCount, getElapsedTime());
+            return uploaded;
+        }
+    }
+
+    const auto modelData{ LoadOBJFile(filepath, props) };
+
+    std::vector<Renderer::Vertex3DPacked> packedData{};
+    Renderer::PositionQuantization quantization{};
+
+    const void* vertices{ modelData.Data.data() };
+    if (props.Format == VertexFormat::Packed)
+    {
+        quantization = PackVertices(modelData.Data, packedData);
+        vertices = packedData.data();
+    }
+
+    if (props.UseCache && !modelData.Data.empty())
+    {
+        const auto written{ WriteMeshCache(filepath, GetCacheKey(props), {
+            .Vertices     = vertices,
+            .VertexCount  = modelData.Data.size(),
+            .Indices      = modelData.Indices.data(),
+            .IndexCount   = modelData.Indices.size(),
+            .Layout       = &layout,
+            .Quantization = quantization,
+            .Bounds       = modelData.Bounds,
+        }) };
+
+        if (!written) spdlog::warn("[OBJLoader]: Failed to write the mesh cache: {}", filepath);
+    }
+
+    const auto uploaded{ upload(vertices, modelData.Data.size(), modelData.Indices.data(), modelData.Indices.size(), quantization, modelData.Bounds) };
+
+    spdlog::info("[OBJLoader]: Loaded {} from the source file in {:.2f} ms ({} bytes per vertex)",
+        filepath, getElapsedTime(), layout.GetStride());
+    return uploaded;
+}
+
+std::shared_ptr<Renderer::VertexArray> LoadOBJModel(const std::string& filepath, const OBJLoaderProps& props)
+{
+    std::shared_ptr<Renderer::VertexArray> model{};
+    LoadOBJGeometry(filepath, props, [&](const void* vertices, std::size_t vertexCount, const std::uint32_t* indices, std::size_t indexCount, const Renderer::PositionQuantization& quantization, const Renderer::MeshBounds& bounds) {
+        model = CreateModel(filepath, GetVertexLayout(props.Format), vertices, vertexCount, indices, indexCount, quantization, bounds);
+        return model.get() != nullptr;
+    });
+
+    return model;
+}
+
+Renderer::GeometryMesh LoadOBJModel(const std::string& filepath, Renderer::GeometryPool& pool, const OBJLoaderProps& props)
+{
+    if (GetVertexLayout(props.Format).GetStride() != pool.GetLayout().GetStride())
+    {
+        spdlog::error("[OBJLoader]: The vertex format does not match the layout of the geometry pool: {}", filepath);
+        return {};
+    }
+
+    Renderer::GeometryMesh mesh{};
+    LoadOBJGeometry(filepath, props, [&](const void* vertices, std::size_t vertexCount, const std::uint32_t* indices, std::size_t indexCount, const Renderer::PositionQuantization& quantization, const Renderer::MeshBounds& bounds) {
+        mesh = pool.Allocate(vertices, vertexCount, indices, indexCount, quantization.GetTransform(), bounds);
+        return mesh.IsValid();
+    });
+
+    return mesh;
+}
+
+std::shared_ptr<Renderer::VertexArray> LoadOBJModel(const std::string& filepath, FaceType faceType)
+{
+    return LoadOBJModel(filepath, OBJLoaderProps{ .Face = faceType, });
+}
+
+std::shared_ptr<Renderer::VertexArray> AcquireOBJModel(const std::string& filepath, const OBJLoaderProps& props)
+{
+    // ThreadCount and UseCache only change how the file is read, not what comes out of it.
+    const auto key{ Hash::FNV1a(std::filesystem::path{ filepath }.lexically_normal().generic_string(), GetCacheKey(props)) };
+
+    return Renderer::ResourceCache::Get().Acquire<Renderer::VertexArray>(key, [&]() -> std::shared_ptr<Renderer::VertexArray> {
+        auto model{ LoadOBJModel(filepath, props) };
+        return model && model->OnInitialize() ? model : nullptr;
+    });
+}
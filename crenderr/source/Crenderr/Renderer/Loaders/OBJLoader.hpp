@@ -1,27 +1,3 @@
-// #pragma once
-
-// #include "Renderer/Renderer.hpp"
-// #include "Utility/NonConstructible.hpp"
-
-// enum class FaceType
-// {
-//     None = 0,
-//     Triangle, Quad,
-// };
-
-// class OBJLoader
-// {
-// public:
-//     OBJLoader() = default;
-
-// public:
-//     std::vector<Renderer::Vertex3D> LoadData(const std::string& filepath) const;
-//     std::shared_ptr<Renderer::VertexArray> LoadModel(const std::string& filepath) const;
-
-// private:
-//     FaceType m_FaceType{ FaceType::Triangle };
-// };
-
 #pragma once
 
 #include <glm/glm.hpp>
@@ -32,17 +8,63 @@
 
 #include "Renderer/Backend/VertexArray.hpp"
 #include "Renderer/Renderer.hpp"
+#include "Renderer/ResourceCache.hpp"
+#include "Renderer/GeometryPool.hpp"
+#include "Renderer/MeshBVH.hpp"
 
+// Faces with more corners are fanned out from their first one either way, Quad only changes the diagonal quads are split along.
 enum class FaceType
 {
     Triangle,
     Quad,
 };
 
+enum class VertexFormat
+{
+    Float,  // Renderer::Vertex3D, 32 bytes
+    Packed, // Renderer::Vertex3DPacked, 16 bytes
+};
+
+struct OBJLoaderProps
+{
+    FaceType Face{ FaceType::Triangle };
+
+    // Number of threads parsing the file, 0 uses every hardware thread.
+    // Small files are never split, whatever the value.
+    std::size_t ThreadCount{ 0u };
+
+    // Triangle and vertex order tuned for the post-transform cache, see MeshOptimizer.hpp.
+    // Overdraw sorting trades a few cache hits for less shading of hidden triangles, it needs the cache pass.
+    bool OptimizeVertexCache{ true };
+    bool OptimizeOverdraw{ false };
+
+    // Vertex format of the buffers created by LoadOBJModel(), LoadOBJFile() always returns floats.
+    VertexFormat Format{ VertexFormat::Float };
+
+    // LoadOBJModel() keeps a binary copy of the result next to the file and maps it on later runs.
+    bool UseCache{ true };
+};
+
+// Indexed triangle list, every unique (position, texcoord, normal) corner is stored once.
 struct OBJModelData
 {
     std::vector<Renderer::Vertex3D> Data{};
+    std::vector<std::uint32_t> Indices{};
+
+    Renderer::MeshBounds Bounds{};
 };
 
+OBJModelData LoadOBJFile(const std::string& filepath, const OBJLoaderProps& props);
 OBJModelData LoadOBJFile(const std::string& filepath, FaceType faceType = FaceType::Triangle);
+
+// Triangle tree of a model loaded with FaceType::Triangle for CPU ray queries, the hits index model.Indices / 3.
+Renderer::MeshBVH BuildOBJModelBVH(const OBJModelData& model);
+
+std::shared_ptr<Renderer::VertexArray> LoadOBJModel(const std::string& filepath, const OBJLoaderProps& props);
 std::shared_ptr<Renderer::VertexArray> LoadOBJModel(const std::string& filepath, FaceType faceType = FaceType::Triangle);
+
+// Initialized model shared through the ResourceCache, the file is only loaded again once every holder released it.
+std::shared_ptr<Renderer::VertexArray> AcquireOBJModel(const std::string& filepath, const OBJLoaderProps& props);
+
+// Appends the model to the pool instead of creating buffers of its own, props.Format has to match the pool's layout.
+Renderer::GeometryMesh LoadOBJModel(const std::string& filepath, Renderer::GeometryPool& pool, const OBJLoaderProps& props);
@@ -0,0 +1,115 @@
+#include "MaterialRegistry.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    // One bit per region in the dirty masks.
+    constexpr std::size_t c_MaxRegionCount{ 8u };
+    constexpr std::size_t c_MaterialRegionCount{ 3u };
+}
+
+MaterialRegistry::MaterialRegistry(const MaterialRegistryProps& props)
+    : m_Props{ props }, m_PendingUpdates(Internal::c_MaterialRegionCount)
+{
+    static_assert(Internal::c_MaterialRegionCount <= Internal::c_MaxRegionCount);
+    m_Materials.reserve(m_Props.Capacity);
+}
+
+MaterialIndex MaterialRegistry::Register(const Material& material) noexcept
+{
+    if (m_Materials.size() >= m_Props.Capacity)
+    {
+        spdlog::error("[MaterialRegistry]: Cannot register more than {} materials!", m_Props.Capacity);
+        return c_InvalidValue<MaterialIndex>;
+    }
+
+    const auto index{ static_cast<MaterialIndex>(m_Materials.size()) };
+    m_Materials.push_back(material);
+    m_DirtyRegions.push_back(0u);
+
+    MaterialRegistry::MarkDirty(index);
+    return index;
+}
+
+bool MaterialRegistry::Update(const MaterialIndex index, const Material& material) noexcept
+{
+    if (index >= m_Materials.size()) return false;
+
+    m_Materials[index] = material;
+    MaterialRegistry::MarkDirty(index);
+
+    return true;
+}
+
+void MaterialRegistry::BeginFrame() noexcept
+{
+    auto* region{ static_cast<Material*>(m_Buffer->AcquireRegion()) };
+    if (!region) return;
+
+    const auto current{ m_Buffer->GetCurrentRegion() };
+    const auto regionBit{ static_cast<std::uint8_t>(1u << current) };
+
+    for (const auto index : m_PendingUpdates[current])
+    {
+        std::memcpy(region + index, &m_Materials[index], sizeof(Material));
+        m_DirtyRegions[index] &= static_cast<std::uint8_t>(~regionBit);
+    }
+
+    m_PendingUpdates[current].clear();
+    m_Buffer->Bind();
+}
+
+void MaterialRegistry::EndFrame() noexcept
+{
+    m_Buffer->ReleaseRegion();
+}
+
+bool MaterialRegistry::OnInitialize() noexcept
+{
+    m_Buffer = AllocateResource<RingBuffer>({
+        .RegionSize  = m_Props.Capacity * sizeof(Material),
+        .RegionCount = Internal::c_MaterialRegionCount,
+        .Target      = BufferTarget::ShaderStorage,
+        .Binding     = m_Props.Binding,
+    });
+    if (!m_Buffer->OnInitialize()) return false;
+
+    // A new buffer has none of the materials yet.
+    for (auto& pending : m_PendingUpdates) pending.clear();
+    for (std::size_t i = 0u; i < m_Materials.size(); ++i)
+    {
+        m_DirtyRegions[i] = 0u;
+        MaterialRegistry::MarkDirty(static_cast<MaterialIndex>(i));
+    }
+
+    return true;
+}
+
+void MaterialRegistry::Bind() const
+{
+    m_Buffer->Bind();
+}
+
+void MaterialRegistry::Unbind() const
+{
+    m_Buffer->Unbind();
+}
+
+void MaterialRegistry::MarkDirty(const MaterialIndex index) noexcept
+{
+    for (std::size_t region = 0u; region < m_PendingUpdates.size(); ++region)
+    {
+        const auto regionBit{ static_cast<std::uint8_t>(1u << region) };
+        if (m_DirtyRegions[index] & regionBit) continue;
+
+        m_DirtyRegions[index] |= regionBit;
+        m_PendingUpdates[region].push_back(index);
+    }
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/Backend/Buffers.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+using MaterialIndex = std::uint32_t;
+
+// std430, mirrors the Material struct of the shaders.
+struct Material
+{
+    glm::vec3 Ambient{ 0.1f };
+    float Padding0{ 0.0f };
+
+    glm::vec3 Diffuse{ 1.0f };
+    float Padding1{ 0.0f };
+
+    glm::vec3 Specular{ 0.5f };
+    float Shininess{ 32.0f };
+};
+
+static_assert(sizeof(Material) == 3u * sizeof(glm::vec4), "Material has to match the std430 layout!");
+
+struct MaterialRegistryProps
+{
+    std::size_t Capacity{ 1024u };
+    std::uint32_t Binding{ 0u };
+};
+
+/**
+ * Every material lives in one shader storage buffer, each instance selects its entry through
+ * InstanceData::Material. The buffer is a persistently mapped ring, BeginFrame() copies just the
+ * materials changed since the region was written last time.
+ */
+class MaterialRegistry : public RendererResource<MaterialRegistryProps>
+{
+public:
+    static constexpr MaterialIndex c_DefaultMaterial{ 0u };
+
+public:
+    explicit MaterialRegistry(const MaterialRegistryProps& props);
+    ~MaterialRegistry() = default;
+
+    // Returns c_InvalidValue<MaterialIndex> once the capacity is reached.
+    MaterialIndex Register(const Material& material) noexcept;
+    bool Update(const MaterialIndex index, const Material& material) noexcept;
+
+    inline const Material& Get(const MaterialIndex index) const noexcept { return m_Materials[index]; }
+    inline auto GetCount() const noexcept { return m_Materials.size(); }
+
+    // Uploads the pending changes into the next region of the ring and binds it.
+    void BeginFrame() noexcept;
+
+    // Has to be called after the last draw reading the materials of this frame.
+    void EndFrame() noexcept;
+
+public:
+    virtual bool OnInitialize() noexcept override;
+
+public:
+    virtual void Bind() const override;
+    virtual void Unbind() const override;
+
+public:
+    inline virtual RendererID GetResourceHandle() const override { return m_Buffer ? m_Buffer->GetResourceHandle() : c_EmptyValue<RendererID>; }
+
+private:
+    void MarkDirty(const MaterialIndex index) noexcept;
+
+private:
+    MaterialRegistryProps m_Props{};
+    std::shared_ptr<RingBuffer> m_Buffer{};
+
+    std::vector<Material> m_Materials{};
+
+    // Bit N set means region N still holds an outdated copy of the material.
+    std::vector<std::uint8_t> m_DirtyRegions{};
+    std::vector<std::vector<MaterialIndex>> m_PendingUpdates{};
+};
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,554 @@
+#include "MeshBVH.hpp"
+
+#include "Utility/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    // Below this the ray is taken as parallel to the triangle's plane.
+    static constexpr float c_DeterminantEpsilon{ 1e-12f };
+
+    // Rays handed to one task of the thread pool, several packets each.
+    static constexpr std::size_t c_RaysPerTask{ 1024u };
+
+    static inline const glm::vec3& GetPosition(const glm::vec3* positions, const std::size_t index, const std::size_t stride) noexcept
+    {
+        return *reinterpret_cast<const glm::vec3*>(reinterpret_cast<const std::uint8_t*>(positions) + index * stride);
+    }
+
+    // Möller-Trumbore, the packet kernels below do the same math lane by lane.
+    static inline bool IntersectTriangle(const MeshBVH::Triangle& triangle, const glm::vec3& origin, const glm::vec3& direction, const float maxDistance, float& distance, glm::vec2& barycentrics) noexcept
+    {
+        const auto p{ glm::cross(direction, triangle.Edge2) };
+        const auto determinant{ glm::dot(triangle.Edge1, p) };
+        if (std::abs(determinant) <= c_DeterminantEpsilon) return false;
+
+        const auto inverseDeterminant{ 1.0f / determinant };
+
+        const auto t{ origin - triangle.Corner };
+        const auto u{ glm::dot(t, p) * inverseDeterminant };
+        if (u < 0.0f || u > 1.0f) return false;
+
+        const auto q{ glm::cross(t, triangle.Edge1) };
+        const auto v{ glm::dot(direction, q) * inverseDeterminant };
+        if (v < 0.0f || u + v > 1.0f) return false;
+
+        distance = glm::dot(triangle.Edge2, q) * inverseDeterminant;
+        if (distance <= 0.0f || distance >= maxDistance) return false;
+
+        barycentrics = { u, v, };
+        return true;
+    }
+
+    // What the kernels read, all in tree order.
+    struct TraversalData
+    {
+        const BVHNode* Nodes{};
+        const std::uint8_t* ChildOrders{};
+        const MeshBVH::Triangle* Triangles{};
+        const std::uint32_t* TriangleIds{};
+    };
+
+    /**
+     * Child order of an inner node, the axis its children are furthest apart along and a flag when the
+     * left one is the upper one. Against a direction it tells which child to visit first, with a lookup
+     * instead of a dot product the vector kernels would have to leave their registers for.
+     */
+    static constexpr std::uint8_t c_LeftIsUpper{ 4u };
+
+    static std::uint8_t GetChildOrder(const BVHNode& left, const BVHNode& right) noexcept
+    {
+        const auto separation{ right.Bounds.GetCenter() - left.Bounds.GetCenter() };
+        const auto distance{ glm::abs(separation) };
+
+        const auto axis{ distance.x >= distance.y ? (distance.x >= distance.z ? 0u : 2u) : (distance.y >= distance.z ? 1u : 2u) };
+        return static_cast<std::uint8_t>(axis | (separation[axis] < 0.0f ? c_LeftIsUpper : 0u));
+    }
+
+    // One bit per axis, set where the direction is negative.
+    static inline std::uint32_t GetDirectionSigns(const glm::vec3& direction) noexcept
+    {
+        return (direction.x < 0.0f ? 1u : 0u) | (direction.y < 0.0f ? 2u : 0u) | (direction.z < 0.0f ? 4u : 0u);
+    }
+
+    static inline bool IsLeftNearer(const std::uint8_t order, const std::uint32_t directionSigns) noexcept
+    {
+        const auto isNegative{ ((directionSigns >> (order & 3u)) & 1u) != 0u };
+        return isNegative == ((order & c_LeftIsUpper) != 0u);
+    }
+
+    static TriangleHit IntersectSingle(const TraversalData& data, const Ray& ray, const float maxDistance, std::uint32_t* stack) noexcept
+    {
+        const auto inverseDirection{ glm::vec3{ 1.0f } / ray.Direction };
+        const auto directionSigns{ GetDirectionSigns(ray.Direction) };
+
+        TriangleHit hit{ .Distance = maxDistance, };
+
+        std::size_t stackSize{ 0u };
+        stack[stackSize++] = 0u;
+
+        float enter{};
+        while (stackSize)
+        {
+            const auto index{ stack[--stackSize] };
+            const auto& node{ data.Nodes[index] };
+            if (!node.Bounds.IntersectRay(ray.Origin, inverseDirection, hit.Distance, enter)) continue;
+
+            if (!node.IsLeaf())
+            {
+                const auto isLeftNearer{ IsLeftNearer(data.ChildOrders[index], directionSigns) };
+                stack[stackSize++] = isLeftNearer ? node.Child + 1u : node.Child;
+                stack[stackSize++] = isLeftNearer ? node.Child : node.Child + 1u;
+                continue;
+            }
+
+            for (auto slot{ node.FirstObject }; slot < node.FirstObject + node.ObjectCount; ++slot)
+            {
+                float distance{};
+                glm::vec2 barycentrics{};
+
+                if (IntersectTriangle(data.Triangles[slot], ray.Origin, ray.Direction, hit.Distance, distance, barycentrics))
+                    hit = TriangleHit{ .Triangle = data.TriangleIds[slot], .Distance = distance, .Barycentrics = barycentrics, };
+            }
+        }
+
+        return hit.IsValid() ? hit : TriangleHit{};
+    }
+
+#if CRENDERR_X86_SIMD
+    struct RayPacketSSE
+    {
+        __m128 OriginX, OriginY, OriginZ;
+        __m128 DirectionX, DirectionY, DirectionZ;
+        __m128 InverseX, InverseY, InverseZ;
+    };
+
+    struct RayPacketAVX2
+    {
+        __m256 OriginX, OriginY, OriginZ;
+        __m256 DirectionX, DirectionY, DirectionZ;
+        __m256 InverseX, InverseY, InverseZ;
+    };
+
+    // Unused lanes repeat the first ray with a negative range, so they never hit anything.
+    template<std::size_t _Width>
+    struct RayLanes
+    {
+        alignas(32) float OriginX[_Width], OriginY[_Width], OriginZ[_Width];
+        alignas(32) float DirectionX[_Width], DirectionY[_Width], DirectionZ[_Width];
+        alignas(32) float InverseX[_Width], InverseY[_Width], InverseZ[_Width];
+        alignas(32) float MaxDistance[_Width];
+
+        void Load(const Ray* rays, const std::size_t count, const float maxDistance) noexcept
+        {
+            for (std::size_t lane = 0u; lane < _Width; ++lane)
+            {
+                const auto& ray{ rays[lane < count ? lane : 0u] };
+                OriginX[lane] = ray.Origin.x; OriginY[lane] = ray.Origin.y; OriginZ[lane] = ray.Origin.z;
+                DirectionX[lane] = ray.Direction.x; DirectionY[lane] = ray.Direction.y; DirectionZ[lane] = ray.Direction.z;
+                InverseX[lane] = 1.0f / ray.Direction.x; InverseY[lane] = 1.0f / ray.Direction.y; InverseZ[lane] = 1.0f / ray.Direction.z;
+                MaxDistance[lane] = lane < count ? maxDistance : -1.0f;
+            }
+        }
+    };
+
+    template<std::size_t _Width>
+    struct HitLanes
+    {
+        alignas(32) float Distance[_Width];
+        alignas(32) float U[_Width], V[_Width];
+        alignas(32) std::int32_t Slot[_Width];
+
+        void Store(const std::uint32_t* triangleIds, TriangleHit* hits, const std::size_t count) const noexcept
+        {
+            for (std::size_t lane = 0u; lane < count; ++lane)
+            {
+                if (Slot[lane] < 0) { hits[lane] = TriangleHit{}; continue; }
+
+                hits[lane] = TriangleHit{
+                    .Triangle     = triangleIds[Slot[lane]],
+                    .Distance     = Distance[lane],
+                    .Barycentrics = { U[lane], V[lane], },
+                };
+            }
+        }
+    };
+
+    static inline __m128 SelectSSE(const __m128 mask, const __m128 lhs, const __m128 rhs) noexcept
+    {
+        return _mm_or_ps(_mm_and_ps(mask, lhs), _mm_andnot_ps(mask, rhs));
+    }
+
+    // Where the lanes enter and leave one slab, a lane in the plane of a face gives 0 * inf = NaN and stays inside it.
+    static inline void GetSlabSSE(const __m128 t0, const __m128 t1, __m128& enter, __m128& leave) noexcept
+    {
+        const auto isInPlane{ _mm_cmpunord_ps(t0, t1) };
+        enter = SelectSSE(isInPlane, _mm_set1_ps(-std::numeric_limits<float>::infinity()), _mm_min_ps(t0, t1));
+        leave = SelectSSE(isInPlane, _mm_set1_ps(std::numeric_limits<float>::infinity()), _mm_max_ps(t0, t1));
+    }
+
+    // Mask of the lanes whose ray enters the box before its current nearest hit.
+    static inline int IntersectBoxSSE(const BoundingBox& box, const RayPacketSSE& packet, const __m128 maxDistance) noexcept
+    {
+        const auto t0x{ _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Min.x), packet.OriginX), packet.InverseX) };
+        const auto t1x{ _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Max.x), packet.OriginX), packet.InverseX) };
+        const auto t0y{ _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Min.y), packet.OriginY), packet.InverseY) };
+        const auto t1y{ _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Max.y), packet.OriginY), packet.InverseY) };
+        const auto t0z{ _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Min.z), packet.OriginZ), packet.InverseZ) };
+        const auto t1z{ _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Max.z), packet.OriginZ), packet.InverseZ) };
+
+        __m128 enterX, leaveX, enterY, leaveY, enterZ, leaveZ;
+        GetSlabSSE(t0x, t1x, enterX, leaveX);
+        GetSlabSSE(t0y, t1y, enterY, leaveY);
+        GetSlabSSE(t0z, t1z, enterZ, leaveZ);
+
+        const auto enter{ _mm_max_ps(_mm_max_ps(enterX, enterY), _mm_max_ps(enterZ, _mm_setzero_ps())) };
+        const auto leave{ _mm_min_ps(_mm_min_ps(leaveX, leaveY), _mm_min_ps(leaveZ, maxDistance)) };
+
+        return _mm_movemask_ps(_mm_cmple_ps(enter, leave));
+    }
+
+    static void IntersectPacketSSE(const TraversalData& data, const Ray* rays, TriangleHit* hits, const std::size_t count, const float maxDistance, std::uint32_t* stack) noexcept
+    {
+        // The first ray picks the order for the whole packet, they are expected to point roughly the same way.
+        const auto directionSigns{ GetDirectionSigns(rays[0].Direction) };
+
+        RayLanes<4u> lanes{};
+        lanes.Load(rays, count, maxDistance);
+
+        const RayPacketSSE packet{
+            _mm_load_ps(lanes.OriginX), _mm_load_ps(lanes.OriginY), _mm_load_ps(lanes.OriginZ),
+            _mm_load_ps(lanes.DirectionX), _mm_load_ps(lanes.DirectionY), _mm_load_ps(lanes.DirectionZ),
+            _mm_load_ps(lanes.InverseX), _mm_load_ps(lanes.InverseY), _mm_load_ps(lanes.InverseZ),
+        };
+
+        auto nearest{ _mm_load_ps(lanes.MaxDistance) };
+        auto hitU{ _mm_setzero_ps() }, hitV{ _mm_setzero_ps() };
+        auto hitSlot{ _mm_set1_epi32(-1) };
+
+        const auto zero{ _mm_setzero_ps() };
+        const auto one{ _mm_set1_ps(1.0f) };
+        const auto epsilon{ _mm_set1_ps(c_DeterminantEpsilon) };
+        const auto signMask{ _mm_set1_ps(-0.0f) };
+
+        std::size_t stackSize{ 0u };
+        stack[stackSize++] = 0u;
+
+        while (stackSize)
+        {
+            const auto index{ stack[--stackSize] };
+            const auto& node{ data.Nodes[index] };
+            if (!IntersectBoxSSE(node.Bounds, packet, nearest)) continue;
+
+            if (!node.IsLeaf())
+            {
+                const auto isLeftNearer{ IsLeftNearer(data.ChildOrders[index], directionSigns) };
+                stack[stackSize++] = isLeftNearer ? node.Child + 1u : node.Child;
+                stack[stackSize++] = isLeftNearer ? node.Child : node.Child + 1u;
+                continue;
+            }
+
+            for (auto slot{ node.FirstObject }; slot < node.FirstObject + node.ObjectCount; ++slot)
+            {
+                const auto& triangle{ data.Triangles[slot] };
+
+                const auto e1x{ _mm_set1_ps(triangle.Edge1.x) }, e1y{ _mm_set1_ps(triangle.Edge1.y) }, e1z{ _mm_set1_ps(triangle.Edge1.z) };
+                const auto e2x{ _mm_set1_ps(triangle.Edge2.x) }, e2y{ _mm_set1_ps(triangle.Edge2.y) }, e2z{ _mm_set1_ps(triangle.Edge2.z) };
+
+                const auto px{ _mm_sub_ps(_mm_mul_ps(packet.DirectionY, e2z), _mm_mul_ps(packet.DirectionZ, e2y)) };
+                const auto py{ _mm_sub_ps(_mm_mul_ps(packet.DirectionZ, e2x), _mm_mul_ps(packet.DirectionX, e2z)) };
+                const auto pz{ _mm_sub_ps(_mm_mul_ps(packet.DirectionX, e2y), _mm_mul_ps(packet.DirectionY, e2x)) };
+
+                const auto determinant{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz)) };
+                const auto inverseDeterminant{ _mm_div_ps(one, determinant) };
+
+                const auto tx{ _mm_sub_ps(packet.OriginX, _mm_set1_ps(triangle.Corner.x)) };
+                const auto ty{ _mm_sub_ps(packet.OriginY, _mm_set1_ps(triangle.Corner.y)) };
+                const auto tz{ _mm_sub_ps(packet.OriginZ, _mm_set1_ps(triangle.Corner.z)) };
+
+                const auto u{ _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inverseDeterminant) };
+
+                const auto qx{ _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y)) };
+                const auto qy{ _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z)) };
+                const auto qz{ _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x)) };
+
+                const auto v{ _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(packet.DirectionX, qx), _mm_mul_ps(packet.DirectionY, qy)), _mm_mul_ps(packet.DirectionZ, qz)), inverseDeterminant) };
+                const auto t{ _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverseDeterminant) };
+
+                auto hit{ _mm_cmpgt_ps(_mm_andnot_ps(signMask, determinant), epsilon) };
+                hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+                hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+                hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+                hit = _mm_and_ps(hit, _mm_cmpgt_ps(t, zero));
+                hit = _mm_and_ps(hit, _mm_cmplt_ps(t, nearest));
+
+                if (!_mm_movemask_ps(hit)) continue;
+
+                nearest = SelectSSE(hit, t, nearest);
+                hitU    = SelectSSE(hit, u, hitU);
+                hitV    = SelectSSE(hit, v, hitV);
+                hitSlot = _mm_castps_si128(SelectSSE(hit, _mm_castsi128_ps(_mm_set1_epi32(static_cast<std::int32_t>(slot))), _mm_castsi128_ps(hitSlot)));
+            }
+        }
+
+        HitLanes<4u> result{};
+        _mm_store_ps(result.Distance, nearest);
+        _mm_store_ps(result.U, hitU);
+        _mm_store_ps(result.V, hitV);
+        _mm_store_si128(reinterpret_cast<__m128i*>(result.Slot), hitSlot);
+
+        result.Store(data.TriangleIds, hits, count);
+    }
+
+    CRENDERR_TARGET_AVX2 static inline void GetSlabAVX2(const __m256 t0, const __m256 t1, __m256& enter, __m256& leave) noexcept
+    {
+        const auto isInPlane{ _mm256_cmp_ps(t0, t1, _CMP_UNORD_Q) };
+        enter = _mm256_blendv_ps(_mm256_min_ps(t0, t1), _mm256_set1_ps(-std::numeric_limits<float>::infinity()), isInPlane);
+        leave = _mm256_blendv_ps(_mm256_max_ps(t0, t1), _mm256_set1_ps(std::numeric_limits<float>::infinity()), isInPlane);
+    }
+
+    CRENDERR_TARGET_AVX2 static inline int IntersectBoxAVX2(const BoundingBox& box, const RayPacketAVX2& packet, const __m256 maxDistance) noexcept
+    {
+        // Not folded into min * inverse - origin * inverse with FMAs, that is inf - inf for every lane parallel to an axis.
+        const auto t0x{ _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Min.x), packet.OriginX), packet.InverseX) };
+        const auto t1x{ _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Max.x), packet.OriginX), packet.InverseX) };
+        const auto t0y{ _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Min.y), packet.OriginY), packet.InverseY) };
+        const auto t1y{ _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Max.y), packet.OriginY), packet.InverseY) };
+        const auto t0z{ _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Min.z), packet.OriginZ), packet.InverseZ) };
+        const auto t1z{ _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Max.z), packet.OriginZ), packet.InverseZ) };
+
+        __m256 enterX, leaveX, enterY, leaveY, enterZ, leaveZ;
+        GetSlabAVX2(t0x, t1x, enterX, leaveX);
+        GetSlabAVX2(t0y, t1y, enterY, leaveY);
+        GetSlabAVX2(t0z, t1z, enterZ, leaveZ);
+
+        const auto enter{ _mm256_max_ps(_mm256_max_ps(enterX, enterY), _mm256_max_ps(enterZ, _mm256_setzero_ps())) };
+        const auto leave{ _mm256_min_ps(_mm256_min_ps(leaveX, leaveY), _mm256_min_ps(leaveZ, maxDistance)) };
+
+        return _mm256_movemask_ps(_mm256_cmp_ps(enter, leave, _CMP_LE_OQ));
+    }
+
+    CRENDERR_TARGET_AVX2 static void IntersectPacketAVX2(const TraversalData& data, const Ray* rays, TriangleHit* hits, const std::size_t count, const float maxDistance, std::uint32_t* stack) noexcept
+    {
+        // The first ray picks the order for the whole packet, they are expected to point roughly the same way.
+        const auto directionSigns{ GetDirectionSigns(rays[0].Direction) };
+
+        RayLanes<8u> lanes{};
+        lanes.Load(rays, count, maxDistance);
+
+        RayPacketAVX2 packet{};
+        packet.OriginX    = _mm256_load_ps(lanes.OriginX);
+        packet.OriginY    = _mm256_load_ps(lanes.OriginY);
+        packet.OriginZ    = _mm256_load_ps(lanes.OriginZ);
+        packet.DirectionX = _mm256_load_ps(lanes.DirectionX);
+        packet.DirectionY = _mm256_load_ps(lanes.DirectionY);
+        packet.DirectionZ = _mm256_load_ps(lanes.DirectionZ);
+        packet.InverseX   = _mm256_load_ps(lanes.InverseX);
+        packet.InverseY   = _mm256_load_ps(lanes.InverseY);
+        packet.InverseZ   = _mm256_load_ps(lanes.InverseZ);
+
+        auto nearest{ _mm256_load_ps(lanes.MaxDistance) };
+        auto hitU{ _mm256_setzero_ps() }, hitV{ _mm256_setzero_ps() };
+        auto hitSlot{ _mm256_set1_epi32(-1) };
+
+        const auto zero{ _mm256_setzero_ps() };
+        const auto one{ _mm256_set1_ps(1.0f) };
+        const auto epsilon{ _mm256_set1_ps(c_DeterminantEpsilon) };
+        const auto signMask{ _mm256_set1_ps(-0.0f) };
+
+        std::size_t stackSize{ 0u };
+        stack[stackSize++] = 0u;
+
+        while (stackSize)
+        {
+            const auto index{ stack[--stackSize] };
+            const auto& node{ data.Nodes[index] };
+            if (!IntersectBoxAVX2(node.Bounds, packet, nearest)) continue;
+
+            if (!node.IsLeaf())
+            {
+                const auto isLeftNearer{ IsLeftNearer(data.ChildOrders[index], directionSigns) };
+                stack[stackSize++] = isLeftNearer ? node.Child + 1u : node.Child;
+                stack[stackSize++] = isLeftNearer ? node.Child : node.Child + 1u;
+                continue;
+            }
+
+            for (auto slot{ node.FirstObject }; slot < node.FirstObject + node.ObjectCount; ++slot)
+            {
+                const auto& triangle{ data.Triangles[slot] };
+
+                const auto e1x{ _mm256_set1_ps(triangle.Edge1.x) }, e1y{ _mm256_set1_ps(triangle.Edge1.y) }, e1z{ _mm256_set1_ps(triangle.Edge1.z) };
+                const auto e2x{ _mm256_set1_ps(triangle.Edge2.x) }, e2y{ _mm256_set1_ps(triangle.Edge2.y) }, e2z{ _mm256_set1_ps(triangle.Edge2.z) };
+
+                const auto px{ _mm256_fmsub_ps(packet.DirectionY, e2z, _mm256_mul_ps(packet.DirectionZ, e2y)) };
+                const auto py{ _mm256_fmsub_ps(packet.DirectionZ, e2x, _mm256_mul_ps(packet.DirectionX, e2z)) };
+                const auto pz{ _mm256_fmsub_ps(packet.DirectionX, e2y, _mm256_mul_ps(packet.DirectionY, e2x)) };
+
+                const auto determinant{ _mm256_fmadd_ps(e1z, pz, _mm256_fmadd_ps(e1y, py, _mm256_mul_ps(e1x, px))) };
+                const auto inverseDeterminant{ _mm256_div_ps(one, determinant) };
+
+                const auto tx{ _mm256_sub_ps(packet.OriginX, _mm256_set1_ps(triangle.Corner.x)) };
+                const auto ty{ _mm256_sub_ps(packet.OriginY, _mm256_set1_ps(triangle.Corner.y)) };
+                const auto tz{ _mm256_sub_ps(packet.OriginZ, _mm256_set1_ps(triangle.Corner.z)) };
+
+                const auto u{ _mm256_mul_ps(_mm256_fmadd_ps(tz, pz, _mm256_fmadd_ps(ty, py, _mm256_mul_ps(tx, px))), inverseDeterminant) };
+
+                const auto qx{ _mm256_fmsub_ps(ty, e1z, _mm256_mul_ps(tz, e1y)) };
+                const auto qy{ _mm256_fmsub_ps(tz, e1x, _mm256_mul_ps(tx, e1z)) };
+                const auto qz{ _mm256_fmsub_ps(tx, e1y, _mm256_mul_ps(ty, e1x)) };
+
+                const auto v{ _mm256_mul_ps(_mm256_fmadd_ps(packet.DirectionZ, qz, _mm256_fmadd_ps(packet.DirectionY, qy, _mm256_mul_ps(packet.DirectionX, qx))), inverseDeterminant) };
+                const auto t{ _mm256_mul_ps(_mm256_fmadd_ps(e2z, qz, _mm256_fmadd_ps(e2y, qy, _mm256_mul_ps(e2x, qx))), inverseDeterminant) };
+
+                auto hit{ _mm256_cmp_ps(_mm256_andnot_ps(signMask, determinant), epsilon, _CMP_GT_OQ) };
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, zero, _CMP_GT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(t, nearest, _CMP_LT_OQ));
+
+                if (!_mm256_movemask_ps(hit)) continue;
+
+                nearest = _mm256_blendv_ps(nearest, t, hit);
+                hitU    = _mm256_blendv_ps(hitU, u, hit);
+                hitV    = _mm256_blendv_ps(hitV, v, hit);
+                hitSlot = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(hitSlot), _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<std::int32_t>(slot))), hit));
+            }
+        }
+
+        HitLanes<8u> result{};
+        _mm256_store_ps(result.Distance, nearest);
+        _mm256_store_ps(result.U, hitU);
+        _mm256_store_ps(result.V, hitV);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result.Slot), hitSlot);
+
+        result.Store(data.TriangleIds, hits, count);
+    }
+#endif
+}
+
+void MeshBVH::Build(const glm::vec3* positions, const std::size_t vertexCount, std::span<const std::uint32_t> indices, const std::size_t stride)
+{
+    MeshBVH::Clear();
+    if (!positions || indices.size() < 3u) return;
+
+    const auto triangleCount{ indices.size() / 3u };
+
+    std::vector<Triangle> triangles{};
+    std::vector<std::uint32_t> triangleIds{};
+    std::vector<BoundingBox> bounds{};
+
+    triangles.reserve(triangleCount);
+    triangleIds.reserve(triangleCount);
+    bounds.reserve(triangleCount);
+
+    for (std::size_t i = 0u; i < triangleCount; ++i)
+    {
+        const auto* corners{ &indices[i * 3u] };
+        if (corners[0] >= vertexCount || corners[1] >= vertexCount || corners[2] >= vertexCount) continue;
+
+        const auto& a{ Internal::GetPosition(positions, corners[0], stride) };
+        const auto& b{ Internal::GetPosition(positions, corners[1], stride) };
+        const auto& c{ Internal::GetPosition(positions, corners[2], stride) };
+
+        triangles.push_back(Triangle{ .Corner = a, .Edge1 = b - a, .Edge2 = c - a, });
+        triangleIds.push_back(static_cast<std::uint32_t>(i));
+        bounds.push_back(BoundingBox{ .Min = glm::min(glm::min(a, b), c), .Max = glm::max(glm::max(a, b), c), });
+    }
+
+    m_Tree.Build(bounds);
+
+    // Leaf order, a leaf's triangles are read one after the other.
+    const auto& order{ m_Tree.GetObjects() };
+
+    m_Triangles.resize(order.size());
+    m_TriangleIds.resize(order.size());
+
+    for (std::size_t slot = 0u; slot < order.size(); ++slot)
+    {
+        m_Triangles[slot]   = triangles[order[slot]];
+        m_TriangleIds[slot] = triangleIds[order[slot]];
+    }
+
+    const auto& nodes{ m_Tree.GetNodes() };
+    m_ChildOrders.resize(nodes.size());
+
+    for (std::size_t i = 0u; i < nodes.size(); ++i)
+        m_ChildOrders[i] = nodes[i].IsLeaf() ? 0u : Internal::GetChildOrder(nodes[nodes[i].Child], nodes[nodes[i].Child + 1u]);
+}
+
+void MeshBVH::Clear() noexcept
+{
+    m_Tree.Clear();
+    m_Triangles.clear();
+    m_TriangleIds.clear();
+    m_ChildOrders.clear();
+}
+
+TriangleHit MeshBVH::Intersect(const Ray& ray, const float maxDistance) const noexcept
+{
+    TriangleHit hit{};
+    MeshBVH::IntersectRange(&ray, &hit, 1u, maxDistance, SimdLevel::Scalar);
+
+    return hit;
+}
+
+void MeshBVH::IntersectRays(std::span<const Ray> rays, std::span<TriangleHit> hits, const float maxDistance, const SimdLevel level) const
+{
+    const auto count{ std::min(rays.size(), hits.size()) };
+    if (!count) return;
+
+    if (count <= Internal::c_RaysPerTask)
+    {
+        MeshBVH::IntersectRange(rays.data(), hits.data(), count, maxDistance, level);
+        return;
+    }
+
+    const auto taskCount{ (count + Internal::c_RaysPerTask - 1u) / Internal::c_RaysPerTask };
+    ThreadPool::GetShared().ParallelFor(taskCount, [&](const std::size_t task) {
+        const auto first{ task * Internal::c_RaysPerTask };
+        MeshBVH::IntersectRange(rays.data() + first, hits.data() + first, std::min(Internal::c_RaysPerTask, count - first), maxDistance, level);
+    });
+}
+
+void MeshBVH::IntersectRange(const Ray* rays, TriangleHit* hits, const std::size_t count, const float maxDistance, const SimdLevel level) const noexcept
+{
+    if (m_Tree.IsEmpty())
+    {
+        std::fill(hits, hits + count, TriangleHit{});
+        return;
+    }
+
+    // One stack for every packet of the range, a packet never needs more than one entry per level.
+    std::vector<std::uint32_t> stack(m_Tree.GetMaxDepth() + 2u);
+    const Internal::TraversalData data{
+        .Nodes       = m_Tree.GetNodes().data(),
+        .ChildOrders = m_ChildOrders.data(),
+        .Triangles   = m_Triangles.data(),
+        .TriangleIds = m_TriangleIds.data(),
+    };
+
+    switch (std::min(level, GetSupportedSimdLevel()))
+    {
+#if CRENDERR_X86_SIMD
+    case SimdLevel::AVX2:
+        for (std::size_t first = 0u; first < count; first += 8u)
+            Internal::IntersectPacketAVX2(data, rays + first, hits + first, std::min<std::size_t>(8u, count - first), maxDistance, stack.data());
+        break;
+    case SimdLevel::SSE:
+        for (std::size_t first = 0u; first < count; first += 4u)
+            Internal::IntersectPacketSSE(data, rays + first, hits + first, std::min<std::size_t>(4u, count - first), maxDistance, stack.data());
+        break;
+#endif
+    default:
+        for (std::size_t i = 0u; i < count; ++i)
+            hits[i] = Internal::IntersectSingle(data, rays[i], maxDistance, stack.data());
+        break;
+    }
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/BoundingVolumeHierarchy.hpp"
+#include "Renderer/Bounds.hpp"
+#include "Renderer/Simd.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+struct TriangleHit
+{
+    // Position in the index list divided by three.
+    std::uint32_t Triangle{ c_InvalidValue<std::uint32_t> };
+    float Distance{ std::numeric_limits<float>::max() };
+
+    // Weights of the second and third corner, the first one gets 1 - x - y.
+    glm::vec2 Barycentrics{ 0.0f };
+
+    inline bool IsValid() const noexcept { return Triangle != c_InvalidValue<std::uint32_t>; }
+};
+
+/**
+ * Triangle level ray queries against a single mesh, on the CPU and without a GL context. The tree is
+ * a BoundingVolumeHierarchy over the triangle boxes, the triangles themselves are copied next to it in
+ * leaf order as a corner and two edges, which is what the Möller-Trumbore test reads.
+ *
+ * IntersectRays() is the throughput path, the rays are spread over the shared thread pool. At SSE or
+ * AVX2 it cuts them into packets of 4 or 8 that walk the tree together, one slab test covers the whole
+ * packet and a triangle is tested against all of its rays at once. Packets only pay off when their
+ * rays are coherent, a camera's or a bake texel's, and lose against single rays on scattered ones,
+ * so the default is one ray at a time and callers with coherent rays ask for a level.
+ */
+class MeshBVH
+{
+public:
+    struct Triangle
+    {
+        glm::vec3 Corner{};
+        glm::vec3 Edge1{};
+        glm::vec3 Edge2{};
+    };
+
+public:
+    MeshBVH() = default;
+    ~MeshBVH() = default;
+
+    // Object space, indices are a triangle list. Triangles with an out of range index are skipped.
+    void Build(const glm::vec3* positions, const std::size_t vertexCount, std::span<const std::uint32_t> indices, const std::size_t stride = sizeof(glm::vec3));
+    void Clear() noexcept;
+
+    // Single ray, e.g. picking.
+    TriangleHit Intersect(const Ray& ray, const float maxDistance = std::numeric_limits<float>::max()) const noexcept;
+
+    // hits receives one result per ray, the rays need not be normalized but the distances are then in units of their length.
+    void IntersectRays(std::span<const Ray> rays, std::span<TriangleHit> hits, const float maxDistance = std::numeric_limits<float>::max(), const SimdLevel level = SimdLevel::Scalar) const;
+
+public:
+    inline auto GetTriangleCount() const noexcept { return m_Triangles.size(); }
+    inline auto IsEmpty() const noexcept { return m_Triangles.empty(); }
+
+    inline const auto& GetTree() const noexcept { return m_Tree; }
+
+private:
+    // Runs on the calling thread, [first, first + count) of rays and hits.
+    void IntersectRange(const Ray* rays, TriangleHit* hits, const std::size_t count, const float maxDistance, const SimdLevel level) const noexcept;
+
+private:
+    BoundingVolumeHierarchy m_Tree{};
+
+    // Tree order, m_TriangleIds maps them back to the index list.
+    std::vector<Triangle> m_Triangles{};
+    std::vector<std::uint32_t> m_TriangleIds{};
+
+    // By node, which child a ray visits first depending on its direction.
+    std::vector<std::uint8_t> m_ChildOrders{};
+};
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,242 @@
+#include "MipChain.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    constexpr std::size_t c_BytesPerTexel{ 4u };
+
+    // Read by the decoding threads of the texture streamer.
+    static std::atomic<int> s_MaxSize{ MipChain::c_MinMaxSize };
+
+    // Destination texels [first, width) of one row, the right column is clamped for sources 1 texel wide.
+    static void DownsampleRowScalar(const std::uint8_t* row0, const std::uint8_t* row1, const int sourceWidth, std::uint8_t* destination, int first, const int width) noexcept
+    {
+        for (; first < width; ++first)
+        {
+            const auto left { static_cast<std::size_t>(2 * first) * c_BytesPerTexel };
+            const auto right{ static_cast<std::size_t>(std::min(2 * first + 1, sourceWidth - 1)) * c_BytesPerTexel };
+
+            for (std::size_t channel = 0u; channel < c_BytesPerTexel; ++channel)
+            {
+                const auto sum{ row0[left + channel] + row0[right + channel] + row1[left + channel] + row1[right + channel] + 2u };
+                destination[static_cast<std::size_t>(first) * c_BytesPerTexel + channel] = static_cast<std::uint8_t>(sum >> 2u);
+            }
+        }
+    }
+
+#if CRENDERR_X86_SIMD
+    // Two source texels per 16 bit half, the halves are summed into one destination texel each.
+    static inline __m128i AverageBlocksSSE(const __m128i row0, const __m128i row1) noexcept
+    {
+        const auto zero{ _mm_setzero_si128() };
+
+        const auto low { _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero)) };
+        const auto high{ _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero)) };
+
+        const auto lowSum { _mm_add_epi16(low,  _mm_srli_si128(low,  8)) };
+        const auto highSum{ _mm_add_epi16(high, _mm_srli_si128(high, 8)) };
+
+        const auto sum{ _mm_add_epi16(_mm_unpacklo_epi64(lowSum, highSum), _mm_set1_epi16(2)) };
+        return _mm_srli_epi16(sum, 2);
+    }
+
+    // 8 source texels in, 4 destination texels out per iteration. Returns the first texel left to the scalar path.
+    static int DownsampleRowSSE(const std::uint8_t* row0, const std::uint8_t* row1, std::uint8_t* destination, int first, const int width) noexcept
+    {
+        for (; first + 4 <= width; first += 4)
+        {
+            const auto* source0{ reinterpret_cast<const __m128i*>(row0 + static_cast<std::size_t>(2 * first) * c_BytesPerTexel) };
+            const auto* source1{ reinterpret_cast<const __m128i*>(row1 + static_cast<std::size_t>(2 * first) * c_BytesPerTexel) };
+
+            const auto left { Internal::AverageBlocksSSE(_mm_loadu_si128(source0),     _mm_loadu_si128(source1))     };
+            const auto right{ Internal::AverageBlocksSSE(_mm_loadu_si128(source0 + 1), _mm_loadu_si128(source1 + 1)) };
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + static_cast<std::size_t>(first) * c_BytesPerTexel), _mm_packus_epi16(left, right));
+        }
+
+        return first;
+    }
+
+    // Same as above per 128 bit lane, 16 source texels in, 8 destination texels out per iteration.
+    CRENDERR_TARGET_AVX2 static inline __m256i AverageBlocksAVX2(const __m256i row0, const __m256i row1) noexcept
+    {
+        const auto zero{ _mm256_setzero_si256() };
+
+        const auto low { _mm256_add_epi16(_mm256_unpacklo_epi8(row0, zero), _mm256_unpacklo_epi8(row1, zero)) };
+        const auto high{ _mm256_add_epi16(_mm256_unpackhi_epi8(row0, zero), _mm256_unpackhi_epi8(row1, zero)) };
+
+        const auto lowSum { _mm256_add_epi16(low,  _mm256_srli_si256(low,  8)) };
+        const auto highSum{ _mm256_add_epi16(high, _mm256_srli_si256(high, 8)) };
+
+        const auto sum{ _mm256_add_epi16(_mm256_unpacklo_epi64(lowSum, highSum), _mm256_set1_epi16(2)) };
+        return _mm256_srli_epi16(sum, 2);
+    }
+
+    CRENDERR_TARGET_AVX2 static int DownsampleRowAVX2(const std::uint8_t* row0, const std::uint8_t* row1, std::uint8_t* destination, int first, const int width) noexcept
+    {
+        for (; first + 8 <= width; first += 8)
+        {
+            const auto* source0{ reinterpret_cast<const __m256i*>(row0 + static_cast<std::size_t>(2 * first) * c_BytesPerTexel) };
+            const auto* source1{ reinterpret_cast<const __m256i*>(row1 + static_cast<std::size_t>(2 * first) * c_BytesPerTexel) };
+
+            const auto left { Internal::AverageBlocksAVX2(_mm256_loadu_si256(source0),     _mm256_loadu_si256(source1))     };
+            const auto right{ Internal::AverageBlocksAVX2(_mm256_loadu_si256(source0 + 1), _mm256_loadu_si256(source1 + 1)) };
+
+            // The pack interleaves the lanes, texels 0-1 4-5 2-3 6-7 before the permute.
+            const auto packed{ _mm256_permute4x64_epi64(_mm256_packus_epi16(left, right), 0b11'01'10'00) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + static_cast<std::size_t>(first) * c_BytesPerTexel), packed);
+        }
+
+        return first;
+    }
+#endif
+}
+
+void DownsampleBox(const std::uint8_t* source, const glm::ivec2& sourceSize, std::uint8_t* destination, const SimdLevel level) noexcept
+{
+    const auto size{ glm::max(sourceSize / 2, glm::ivec2{ 1 }) };
+    const auto sourceStride{ static_cast<std::size_t>(sourceSize.x) * Internal::c_BytesPerTexel };
+    const auto stride{ static_cast<std::size_t>(size.x) * Internal::c_BytesPerTexel };
+
+    // A source 1 texel wide has no pairs to load, its single column goes through the scalar path.
+    const auto simdLevel{ sourceSize.x > 1 ? std::min(level, GetSupportedSimdLevel()) : SimdLevel::Scalar };
+
+    for (int y = 0; y < size.y; ++y)
+    {
+        const auto* row0{ source + static_cast<std::size_t>(2 * y) * sourceStride };
+        const auto* row1{ source + static_cast<std::size_t>(std::min(2 * y + 1, sourceSize.y - 1)) * sourceStride };
+        auto* output{ destination + static_cast<std::size_t>(y) * stride };
+
+        int first{ 0 };
+
+        // Never above what the CPU runs.
+        switch (simdLevel)
+        {
+#if CRENDERR_X86_SIMD
+        case SimdLevel::AVX2:
+            first = Internal::DownsampleRowAVX2(row0, row1, output, first, size.x);
+            first = Internal::DownsampleRowSSE(row0, row1, output, first, size.x);
+            break;
+
+        case SimdLevel::SSE:
+            first = Internal::DownsampleRowSSE(row0, row1, output, first, size.x);
+            break;
+#endif
+
+        default:
+            break;
+        }
+
+        Internal::DownsampleRowScalar(row0, row1, sourceSize.x, output, first, size.x);
+    }
+}
+
+std::uint32_t MipChain::GetLevelCount(const glm::ivec2& size) noexcept
+{
+    const auto side{ static_cast<std::uint32_t>(std::max({ size.x, size.y, 1 })) };
+    return static_cast<std::uint32_t>(std::bit_width(side));
+}
+
+glm::ivec2 MipChain::GetLevelSize(const glm::ivec2& size, const std::uint32_t level) noexcept
+{
+    return glm::max(glm::ivec2{ size.x >> level, size.y >> level, }, glm::ivec2{ 1 });
+}
+
+void MipChain::SetMaxSize(const int maxSize) noexcept
+{
+    Internal::s_MaxSize.store(std::max(maxSize, 1), std::memory_order_relaxed);
+}
+
+int MipChain::GetMaxSize() noexcept
+{
+    return Internal::s_MaxSize.load(std::memory_order_relaxed);
+}
+
+bool MipChain::IsSizeSupported(const glm::ivec2& size) noexcept
+{
+    const auto maxSize{ MipChain::GetMaxSize() };
+    return size.x > 0 && size.y > 0 && size.x <= maxSize && size.y <= maxSize;
+}
+
+bool MipChain::GetChainByteSize(const TextureFormat format, const glm::ivec2& size, const std::uint32_t levelCount, std::size_t& byteSize) noexcept
+{
+    constexpr auto c_MaxByteSize{ std::numeric_limits<std::size_t>::max() };
+
+    byteSize = 0u;
+    for (std::uint32_t i = 0u; i < levelCount; ++i)
+    {
+        const auto levelSize{ MipChain::GetLevelSize(size, i) };
+        const auto rowSize{ GetFormatRowSize(format, levelSize.x) };
+        const auto rowCount{ static_cast<std::size_t>(GetFormatRowCount(format, levelSize.y)) };
+
+        if (rowCount && rowSize > c_MaxByteSize / rowCount) return false;
+        if (rowSize * rowCount > c_MaxByteSize - byteSize) return false;
+        byteSize += rowSize * rowCount;
+    }
+
+    return true;
+}
+
+void MipChain::Generate(const std::uint8_t* pixels, const glm::ivec2& size, const std::uint32_t levelCount, const SimdLevel level)
+{
+    const auto count{ levelCount ? std::min(levelCount, MipChain::GetLevelCount(size)) : MipChain::GetLevelCount(size) };
+
+    MipChain::Allocate(TextureFormat::RGBA8, size, count);
+    std::memcpy(m_Pixels.data(), pixels, MipChain::GetByteSize(0u));
+
+    for (std::uint32_t i = 1u; i < count; ++i)
+        DownsampleBox(m_Pixels.data() + m_Levels[i - 1u].Offset, m_Levels[i - 1u].Size, m_Pixels.data() + m_Levels[i].Offset, level);
+}
+
+bool MipChain::Assign(const TextureFormat format, const glm::ivec2& size, const std::uint32_t levelCount, const std::uint8_t* data, const std::size_t byteSize)
+{
+    if (!MipChain::IsSizeSupported(size) || !levelCount || levelCount > MipChain::GetLevelCount(size)) return false;
+
+    std::size_t chainByteSize{};
+    if (!MipChain::GetChainByteSize(format, size, levelCount, chainByteSize) || byteSize < chainByteSize) return false;
+
+    MipChain::Allocate(format, size, levelCount);
+    std::memcpy(m_Pixels.data(), data, m_Pixels.size());
+    return true;
+}
+
+void MipChain::Clear() noexcept
+{
+    m_Pixels = {};
+    m_Levels.clear();
+    m_Format = TextureFormat::RGBA8;
+}
+
+void MipChain::Allocate(const TextureFormat format, const glm::ivec2& size, const std::uint32_t levelCount)
+{
+    m_Format = format;
+    m_Levels.resize(levelCount);
+
+    std::size_t byteSize{ 0u };
+    for (std::uint32_t i = 0u; i < levelCount; ++i)
+    {
+        m_Levels[i].Size   = MipChain::GetLevelSize(size, i);
+        m_Levels[i].Offset = byteSize;
+        byteSize += MipChain::GetByteSize(i);
+    }
+
+    m_Pixels.resize(byteSize);
+}
+
+std::size_t MipChain::GetByteSize(const std::uint32_t first, const std::uint32_t last) const noexcept
+{
+    std::size_t byteSize{ 0u };
+    for (auto i = first; i < std::min(last, MipChain::GetLevelCount()); ++i)
+        byteSize += MipChain::GetByteSize(i);
+
+    return byteSize;
+}
+
+NAMESPACE_END(Renderer)
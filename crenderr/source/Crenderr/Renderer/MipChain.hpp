@@ -0,0 +1,89 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/Simd.hpp"
+#include "Renderer/Backend/Texture2D.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+/**
+ * Halves both sides of an RGBA8 image, every texel is the rounded mean of a 2x2 block. An odd last
+ * row or column is dropped, a side of 1 is kept. The destination receives max(1, size / 2) texels
+ * per side, tightly packed like the source.
+ */
+void DownsampleBox(const std::uint8_t* source, const glm::ivec2& sourceSize, std::uint8_t* destination, const SimdLevel level = GetSupportedSimdLevel()) noexcept;
+
+/**
+ * Every level of an image in one allocation, level 0 is the image itself and the last one is 1x1.
+ * Generate() filters the levels of an RGBA8 image, Assign() takes levels that were made elsewhere,
+ * e.g. the block compressed ones of a .dds file.
+ */
+class MipChain
+{
+public:
+    // The smallest GL_MAX_TEXTURE_SIZE an OpenGL 4.6 driver may report, assumed until there is a context.
+    static constexpr int c_MinMaxSize{ 16384 };
+
+    static std::uint32_t GetLevelCount(const glm::ivec2& size) noexcept;
+    static glm::ivec2 GetLevelSize(const glm::ivec2& size, const std::uint32_t level) noexcept;
+
+    // Largest side a texture can have, the graphics context sets GL_MAX_TEXTURE_SIZE once it is created. Safe from any thread.
+    static void SetMaxSize(const int maxSize) noexcept;
+    static int GetMaxSize() noexcept;
+
+    // Both sides in [1, GetMaxSize()].
+    static bool IsSizeSupported(const glm::ivec2& size) noexcept;
+
+    // Bytes of levelCount levels back to back, false when that does not fit in a size_t.
+    static bool GetChainByteSize(const TextureFormat format, const glm::ivec2& size, const std::uint32_t levelCount, std::size_t& byteSize) noexcept;
+
+public:
+    MipChain() = default;
+    ~MipChain() = default;
+
+    // Copies the pixels as level 0 and filters each next level from the previous one, levelCount = 0 builds all of them.
+    void Generate(const std::uint8_t* pixels, const glm::ivec2& size, const std::uint32_t levelCount = 0u, const SimdLevel level = GetSupportedSimdLevel());
+
+    // Copies levelCount levels stored back to back from level 0 on. Returns false without allocating
+    // when the size is not supported, there are more levels than the size has or byteSize is too small for them.
+    bool Assign(const TextureFormat format, const glm::ivec2& size, const std::uint32_t levelCount, const std::uint8_t* data, const std::size_t byteSize);
+    void Clear() noexcept;
+
+    inline auto GetLevelCount() const noexcept { return static_cast<std::uint32_t>(m_Levels.size()); }
+    inline auto IsEmpty() const noexcept { return m_Levels.empty(); }
+    inline auto GetFormat() const noexcept { return m_Format; }
+
+    inline const auto& GetSize(const std::uint32_t level) const noexcept { return m_Levels[level].Size; }
+    inline const std::uint8_t* GetPixels(const std::uint32_t level) const noexcept { return m_Pixels.data() + m_Levels[level].Offset; }
+    inline auto GetByteSize(const std::uint32_t level) const noexcept { return GetFormatImageSize(m_Format, m_Levels[level].Size); }
+
+    // Texel rows, or rows of blocks, of a level and their size in bytes.
+    inline auto GetRowCount(const std::uint32_t level) const noexcept { return GetFormatRowCount(m_Format, m_Levels[level].Size.y); }
+    inline auto GetRowSize(const std::uint32_t level) const noexcept { return GetFormatRowSize(m_Format, m_Levels[level].Size.x); }
+
+    // Levels [first, last), what a texture holding them takes on the GPU.
+    std::size_t GetByteSize(const std::uint32_t first, const std::uint32_t last) const noexcept;
+
+private:
+    struct Level
+    {
+        glm::ivec2 Size{};
+        std::size_t Offset{};
+    };
+
+    // Lays the levels out back to back and sizes m_Pixels for them.
+    void Allocate(const TextureFormat format, const glm::ivec2& size, const std::uint32_t levelCount);
+
+private:
+    std::vector<std::uint8_t> m_Pixels{};
+    std::vector<Level> m_Levels{};
+    TextureFormat m_Format{ TextureFormat::RGBA8 };
+};
+
+NAMESPACE_END(Renderer)
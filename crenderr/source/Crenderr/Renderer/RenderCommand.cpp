@@ -1,5 +1,7 @@
 #include "RenderCommand.hpp"
 
+#include "Renderer/Backend/StateCache.hpp"
+
 #include <glad/glad.h>
 
 NAMESPACE_BEGIN(Renderer)
@@ -12,9 +14,7 @@ void SetViewport(int x, int y, int width, int height)
 
 void SetDepthTest(bool flag)
 {
-    return flag
-        ? glEnable(GL_DEPTH_TEST)
-        : glDisable(GL_DEPTH_TEST);
+    StateCache::Get().SetCapability(Capability::DepthTest, flag);
 }
 
 void SetClearColor(const glm::vec4& color)
@@ -27,6 +27,14 @@ void Clear()
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void Draw(const std::shared_ptr<VertexArray>& vertexArray)
+{
+    const auto& indexBuffer{ vertexArray->GetIndexBuffer() };
+    return indexBuffer.get() && indexBuffer->GetCount()
+        ? RenderCommand::DrawIndexed(vertexArray)
+        : RenderCommand::DrawArrays(vertexArray);
+}
+
 void DrawArrays(const std::shared_ptr<VertexArray>& vertexArray)
 {
     vertexArray->Bind();
@@ -41,8 +49,7 @@ void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray)
 
 void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray, const std::shared_ptr<Texture2D>& texture)
 {
-    glActiveTexture(GL_TEXTURE0);
-    texture->Bind();
+    texture->Bind(0u);
 
     RenderCommand::DrawIndexed(vertexArray);
 }
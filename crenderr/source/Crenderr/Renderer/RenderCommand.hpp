@@ -18,6 +18,9 @@ namespace RenderCommand
     void SetClearColor(const glm::vec4& color);
     void Clear();
 
+    // Picks DrawIndexed() when the vertex array has indices, DrawArrays() otherwise.
+    void Draw(const std::shared_ptr<VertexArray>& vertexArray);
+
     void DrawArrays(const std::shared_ptr<VertexArray>& vertexArray);
 
     void DrawIndexed(const std::shared_ptr<VertexArray>& vertexArray);
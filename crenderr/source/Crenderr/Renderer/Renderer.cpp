@@ -3,14 +3,40 @@
 #include "Renderer/Backend/VertexArray.hpp"
 #include "Renderer/Backend/Texture2D.hpp"
 #include "Renderer/Backend/Shader.hpp"
+#include "Renderer/Backend/StateCache.hpp"
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <chrono>
+
 // Temporary, include obj loading into the main framework.
 // #include "Application/OBJLoader.hpp"
 
 NAMESPACE_BEGIN(Renderer)
 
+namespace Internal
+{
+    // Hashed at compile time, setting them does not look up any strings.
+    constexpr UniformHandle c_DiffuseTexture   { "u_DiffuseTexture" };
+    constexpr UniformHandle c_SpecularTexture  { "u_SpecularTexture" };
+    constexpr UniformHandle c_EmissionTexture  { "u_EmissionTexture" };
+
+    // Beyond this distance every draw gets the same depth in its sort key.
+    constexpr float c_SortFarDistance{ 1000.0f };
+
+    // Per frame, about 12 MB of instance data in each region of the ring.
+    constexpr std::size_t c_MaxInstanceCount{ 1u << 17u };
+
+    // The instance matrices already include the base transform, the object space bounds are taken back before it.
+    static BoundingSphere GetInstanceBounds(const MeshBounds& bounds, const glm::mat4& baseTransform) noexcept
+    {
+        return bounds.IsValid() ? bounds.Sphere.Transform(glm::inverse(baseTransform)) : BoundingSphere{};
+    }
+}
+
 const std::shared_ptr<Shader>& Renderer3DInstance::GetFlatShader() const noexcept
 {
     return m_Storage->FlatShader;
@@ -18,7 +44,65 @@ const std::shared_ptr<Shader>& Renderer3DInstance::GetFlatShader() const noexcep
 
 std::size_t Renderer3DInstance::GetPrimitivesRendered() const noexcept
 {
-    return m_Storage->PrimitivesCount;
+    return m_Storage->Statistics.Primitives;
+}
+
+std::size_t Renderer3DInstance::GetBatchCount() const noexcept
+{
+    return m_Storage->Statistics.Batches;
+}
+
+double Renderer3DInstance::GetBatchEfficiency() const noexcept
+{
+    const auto& statistics{ m_Storage->Statistics };
+    return statistics.DrawCalls ? static_cast<double>(statistics.Packets) / static_cast<double>(statistics.DrawCalls) : 0.0;
+}
+
+const RendererStatistics& Renderer3DInstance::GetStatistics() const noexcept
+{
+    return m_Storage->Statistics;
+}
+
+MaterialRegistry& Renderer3DInstance::GetMaterials() noexcept
+{
+    return *m_Storage->Materials;
+}
+
+TextureStreamer& Renderer3DInstance::GetTextures() noexcept
+{
+    return *m_Storage->Textures;
+}
+
+const TextureTable& Renderer3DInstance::GetTextureTable() const noexcept
+{
+    return *m_Storage->TextureSlots;
+}
+
+bool Renderer3DInstance::SetBindlessTextures(const bool enabled) noexcept
+{
+    // Only switched along with the shader reading the handles.
+    if (enabled && !m_Storage->BindlessShader) return false;
+    return m_Storage->TextureSlots->SetBindless(enabled);
+}
+
+bool Renderer3DInstance::IsBindlessTexturesEnabled() const noexcept
+{
+    return m_Storage->TextureSlots->IsBindless();
+}
+
+void Renderer3DInstance::SetFrustumCulling(const bool enabled) noexcept
+{
+    m_Storage->IsCullingEnabled = enabled;
+}
+
+bool Renderer3DInstance::IsFrustumCullingEnabled() const noexcept
+{
+    return m_Storage->IsCullingEnabled;
+}
+
+const MeshBounds& Renderer3DInstance::GetCubeBounds() const noexcept
+{
+    return m_Storage->CubeVArray->GetBounds();
 }
 
 bool Renderer3DInstance::OnInitialization() noexcept
@@ -62,28 +146,140 @@ bool Renderer3DInstance::OnInitialization() noexcept
     m_Storage->PlaneVArray = AllocateResource<VertexArray>({
         .VertexBufferPtr = vertexBuffer,
         .IndexBufferPtr  = indexBuffer,
+        .Bounds          = MeshBounds::FromPositions(&rectangleVertices.front().Position, rectangleVertices.size(), sizeof(Vertex3D)),
     });
     if (!m_Storage->PlaneVArray->OnInitialize()) return false;
 
-    m_Storage->FlatTexture = AllocateResource<Texture2D>({
+    // Four vertices per face, the normals and texcoords cannot be shared at the corners.
+    const std::array<Vertex3D, 24u> cubeVertices = { {
+        // position                  normal                   texcoord
+        { {  0.5f,  0.5f,  0.5f, }, {  0.0f,  0.0f,  1.0f, }, { 1.0f, 1.0f, }, }, // front
+        { {  0.5f, -0.5f,  0.5f, }, {  0.0f,  0.0f,  1.0f, }, { 1.0f, 0.0f, }, },
+        { { -0.5f, -0.5f,  0.5f, }, {  0.0f,  0.0f,  1.0f, }, { 0.0f, 0.0f, }, },
+        { { -0.5f,  0.5f,  0.5f, }, {  0.0f,  0.0f,  1.0f, }, { 0.0f, 1.0f, }, },
+        { { -0.5f,  0.5f, -0.5f, }, {  0.0f,  0.0f, -1.0f, }, { 1.0f, 1.0f, }, }, // back
+        { { -0.5f, -0.5f, -0.5f, }, {  0.0f,  0.0f, -1.0f, }, { 1.0f, 0.0f, }, },
+        { {  0.5f, -0.5f, -0.5f, }, {  0.0f,  0.0f, -1.0f, }, { 0.0f, 0.0f, }, },
+        { {  0.5f,  0.5f, -0.5f, }, {  0.0f,  0.0f, -1.0f, }, { 0.0f, 1.0f, }, },
+        { {  0.5f,  0.5f, -0.5f, }, {  1.0f,  0.0f,  0.0f, }, { 1.0f, 1.0f, }, }, // right
+        { {  0.5f, -0.5f, -0.5f, }, {  1.0f,  0.0f,  0.0f, }, { 1.0f, 0.0f, }, },
+        { {  0.5f, -0.5f,  0.5f, }, {  1.0f,  0.0f,  0.0f, }, { 0.0f, 0.0f, }, },
+        { {  0.5f,  0.5f,  0.5f, }, {  1.0f,  0.0f,  0.0f, }, { 0.0f, 1.0f, }, },
+        { { -0.5f,  0.5f,  0.5f, }, { -1.0f,  0.0f,  0.0f, }, { 1.0f, 1.0f, }, }, // left
+        { { -0.5f, -0.5f,  0.5f, }, { -1.0f,  0.0f,  0.0f, }, { 1.0f, 0.0f, }, },
+        { { -0.5f, -0.5f, -0.5f, }, { -1.0f,  0.0f,  0.0f, }, { 0.0f, 0.0f, }, },
+        { { -0.5f,  0.5f, -0.5f, }, { -1.0f,  0.0f,  0.0f, }, { 0.0f, 1.0f, }, },
+        { {  0.5f,  0.5f, -0.5f, }, {  0.0f,  1.0f,  0.0f, }, { 1.0f, 1.0f, }, }, // top
+        { {  0.5f,  0.5f,  0.5f, }, {  0.0f,  1.0f,  0.0f, }, { 1.0f, 0.0f, }, },
+        { { -0.5f,  0.5f,  0.5f, }, {  0.0f,  1.0f,  0.0f, }, { 0.0f, 0.0f, }, },
+        { { -0.5f,  0.5f, -0.5f, }, {  0.0f,  1.0f,  0.0f, }, { 0.0f, 1.0f, }, },
+        { {  0.5f, -0.5f,  0.5f, }, {  0.0f, -1.0f,  0.0f, }, { 1.0f, 1.0f, }, }, // bottom
+        { {  0.5f, -0.5f, -0.5f, }, {  0.0f, -1.0f,  0.0f, }, { 1.0f, 0.0f, }, },
+        { { -0.5f, -0.5f, -0.5f, }, {  0.0f, -1.0f,  0.0f, }, { 0.0f, 0.0f, }, },
+        { { -0.5f, -0.5f,  0.5f, }, {  0.0f, -1.0f,  0.0f, }, { 0.0f, 1.0f, }, },
+    } };
+
+    // Every face uses the same two triangles as the plane.
+    std::array<glm::uvec3, 12u> cubeIndices{};
+    for (std::uint32_t face = 0u; face < 6u; ++face)
+    {
+        cubeIndices[face * 2u + 0u] = rectangleIndices[0u] + face * 4u;
+        cubeIndices[face * 2u + 1u] = rectangleIndices[1u] + face * 4u;
+    }
+
+    auto cubeVertexBuffer{ AllocateResource<VertexBuffer>({
+        .Data     = cubeVertices.data(),
+        .DataSize = cubeVertices.size(),
+        .VertSize = sizeof(decltype(cubeVertices)::value_type),
+        .Layout   = decltype(cubeVertices)::value_type::c_Layout,
+    }) };
+    if (!cubeVertexBuffer->OnInitialize()) return false;
+
+    auto cubeIndexBuffer{ AllocateResource<IndexBuffer>({
+        .Data  = cubeIndices.data(),
+        .Count = cubeIndices.size() * (sizeof(decltype(cubeIndices)::value_type) / sizeof(unsigned int)),
+    }) };
+    if (!cubeIndexBuffer->OnInitialize()) return false;
+
+    m_Storage->CubeVArray = AllocateResource<VertexArray>({
+        .VertexBufferPtr = cubeVertexBuffer,
+        .IndexBufferPtr  = cubeIndexBuffer,
+        .Bounds          = MeshBounds::FromPositions(&cubeVertices.front().Position, cubeVertices.size(), sizeof(Vertex3D)),
+    });
+    if (!m_Storage->CubeVArray->OnInitialize()) return false;
+
+    // Shared by every renderer instance, like the shaders below.
+    m_Storage->FlatTexture = AcquireResource<Texture2D>({
         .Size = { 1u, 1u, },
     });
-    if (!m_Storage->FlatTexture->OnInitialize()) return false;
+    if (!m_Storage->FlatTexture) return false;
+
+    m_Storage->Textures = AllocateResource<TextureStreamer>({});
+    if (!m_Storage->Textures->OnInitialize()) return false;
 
-    m_Storage->CubeTexture = AllocateResource<Texture2D>({
+    // White until the image is decoded and uploaded.
+    m_Storage->CubeTexture = m_Storage->Textures->Load({
         .Filtering = TextureFiltering::Nearest,
         .Filepath  = "assets/textures/container.jpg",
     });
-    if (!m_Storage->CubeTexture->OnInitialize()) return false;
+    if (!m_Storage->CubeTexture) return false;
 
-    m_Storage->FlatShader = AllocateResource<Shader>({
+    m_Storage->TextureSlots = AllocateResource<TextureTable>({});
+    if (!m_Storage->TextureSlots->OnInitialize()) return false;
+
+    m_Storage->FrameUniformBuffer = AllocateResource<UniformBuffer>({
+        .Size    = sizeof(FrameUniformData),
+        .Binding = FrameUniformData::c_FrameDataBinding,
+    });
+    if (!m_Storage->FrameUniformBuffer->OnInitialize()) return false;
+
+    // Index 0 is the default material, MaterialRegistry::c_DefaultMaterial.
+    m_Storage->Materials = AllocateResource<MaterialRegistry>({});
+    if (!m_Storage->Materials->OnInitialize()) return false;
+    m_Storage->Materials->Register(Material{});
+
+    m_Storage->InstanceBuffer = AllocateResource<RingBuffer>({
+        .RegionSize = Internal::c_MaxInstanceCount * sizeof(InstanceData),
+        .Target     = BufferTarget::ShaderStorage,
+        .Binding    = InstanceData::c_InstanceDataBinding,
+    });
+    if (!m_Storage->InstanceBuffer->OnInitialize()) return false;
+    m_Storage->Instances.reserve(Internal::c_MaxInstanceCount);
+
+    // Every command draws at least one instance, so there are never more of them.
+    m_Storage->IndirectBuffer = AllocateResource<RingBuffer>({
+        .RegionSize = Internal::c_MaxInstanceCount * sizeof(DrawIndirectCommand),
+        .Target     = BufferTarget::DrawIndirect,
+    });
+    if (!m_Storage->IndirectBuffer->OnInitialize()) return false;
+
+    m_Storage->FlatShader = AcquireResource<Shader>({
         .Sources = {
             { ShaderType::Vertex,   { "assets/shaders/vertex.glsl",   }, },
             { ShaderType::Fragment, { "assets/shaders/fragment.glsl", }, },
         },
     });
-    if (!m_Storage->FlatShader->Compile()) return false;
-    if (!m_Storage->FlatShader->Link())    return false;
+    if (!m_Storage->FlatShader) return false;
+
+    // Samplers are program state, the texture units never change.
+    m_Storage->FlatShader->Bind();
+    m_Storage->FlatShader->SetUniform<int>(Internal::c_DiffuseTexture,  0);
+    m_Storage->FlatShader->SetUniform<int>(Internal::c_SpecularTexture, 1);
+    m_Storage->FlatShader->SetUniform<int>(Internal::c_EmissionTexture, 2);
+
+    // Optional, the texture arrays keep working without it.
+    if (m_Storage->TextureSlots->IsBindlessSupported())
+    {
+        m_Storage->BindlessShader = AcquireResource<Shader>({
+            .Sources = {
+                { ShaderType::Vertex,   { "assets/shaders/vertex.glsl",            }, },
+                { ShaderType::Fragment, { "assets/shaders/fragment-bindless.glsl", }, },
+            },
+        });
+
+        if (!m_Storage->BindlessShader)
+            spdlog::warn("[Renderer3D]: The bindless texture shader failed to build, textures stay in arrays.");
+    }
 
     return true;
 }
@@ -95,53 +291,177 @@ void Renderer3DInstance::OnShutdown() noexcept
 
 void Renderer3DInstance::BeginScene(Camera* camera) noexcept
 {
-    m_Storage->PrimitivesCountTemp = 0u;
-
-    m_Storage->FlatShader->Bind();
-    m_Storage->FlatShader->SetUniform("u_ViewMatrix", camera->GetViewMatrix());
-    m_Storage->FlatShader->SetUniform("u_ProjectionMatrix", camera->GetProjectionMatrix());
-    m_Storage->FlatShader->SetUniform("u_ViewPosition", camera->GetPosition());
+    // ImGui and anything else drawing in between leave the GL state behind the cache's back.
+    auto& stateCache{ StateCache::Get() };
+    stateCache.Invalidate();
+    stateCache.ResetStatistics();
+
+    m_Storage->Commands.Reset();
+    m_Storage->Instances.clear();
+
+    m_Storage->VisibleInstances = 0u;
+    m_Storage->CulledInstances  = 0u;
+    m_Storage->CullTime         = 0.0;
+
+    // Written once per frame, every shader reads it through the FrameData block.
+    auto& frameData{ m_Storage->FrameData };
+    frameData.ViewMatrix           = camera->GetViewMatrix();
+    frameData.ProjectionMatrix     = camera->GetProjectionMatrix();
+    frameData.ViewProjectionMatrix = frameData.ProjectionMatrix * frameData.ViewMatrix;
+    frameData.ViewPosition         = glm::vec4{ camera->GetPosition(), 1.0f };
+
+    m_Storage->ViewFrustum = Frustum::FromMatrix(frameData.ViewProjectionMatrix);
+
+    // The projection maps a length r at distance d to r * [1][1] / d in NDC, which spans 2 units over the viewport height.
+    GLint viewport[4]{};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    m_Storage->DetailScale   = 0.5f * static_cast<float>(viewport[3]) * frameData.ProjectionMatrix[1][1];
+    m_Storage->IsPerspective = frameData.ProjectionMatrix[2][3] != 0.0f;
+
+    m_Storage->FrameUniformBuffer->Bind();
+    m_Storage->FrameUniformBuffer->SetData(&frameData, sizeof(FrameUniformData));
+
+    m_Storage->Materials->BeginFrame();
+    m_Storage->Textures->BeginFrame();
+    m_Storage->TextureSlots->BeginFrame();
 }
 
 void Renderer3DInstance::EndScene() noexcept
 {
-    m_Storage->PrimitivesCount = m_Storage->PrimitivesCountTemp;
+    Renderer3DInstance::Flush();
+    m_Storage->Materials->EndFrame();
+    m_Storage->TextureSlots->EndFrame();
+    m_Storage->InstanceBuffer->ReleaseRegion();
+    m_Storage->IndirectBuffer->ReleaseRegion();
+
+    auto& statistics{ m_Storage->Statistics };
+
+    const auto& stateStatistics{ StateCache::Get().GetStatistics() };
+    statistics.StateCalls   = stateStatistics.Calls;
+    statistics.StateAvoided = stateStatistics.Avoided;
+
+    statistics.VisibleInstances = m_Storage->VisibleInstances;
+    statistics.CulledInstances  = m_Storage->CulledInstances;
+    statistics.CullTime         = m_Storage->CullTime;
 }
 
-void Renderer3DInstance::DrawPlane(const Translation& translation)
+void Renderer3DInstance::DrawPlane(const Translation& translation, MaterialIndex material)
 {
-    m_Storage->FlatShader->SetUniform("u_ModelMatrix", translation.ComposeModelMatrix());
+    std::uint32_t offset{};
+    auto* instance{ Renderer3DInstance::PushInstances(1u, offset) };
+    if (!instance) return;
+
+    instance->ModelMatrix = translation.ComposeModelMatrix();
+    instance->Color       = glm::vec4{ 1.0f };
+
+    const auto& bounds{ m_Storage->PlaneVArray->GetBounds().Sphere };
+    if (!Renderer3DInstance::CullInstances(offset, 1u, bounds)) return;
+
+    const DrawPayload payload{
+        .ShaderPtr      = Renderer3DInstance::GetSceneShader(),
+        .VertexArrayPtr = m_Storage->PlaneVArray.get(),
+        .Textures       = { m_Storage->CubeTexture.get(), },
+        .InstanceOffset = offset,
+        .Material       = material,
+    };
+
+    Renderer3DInstance::RequestTextureDetail(payload, bounds);
+    Renderer3DInstance::Submit(payload);
+}
 
-    m_Storage->FlatShader->SetUniform("u_Material.Ambient",  glm::vec3{ 0.1f, 0.1f, 0.1f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Diffuse",  glm::vec3{ 1.0f, 1.0f, 1.0f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Specular", glm::vec3{ 0.5f, 0.5f, 0.5f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Shininess", 32.0f);
+void Renderer3DInstance::DrawCube(const Translation& translation, const glm::vec3& color, MaterialIndex material)
+{
+    Renderer3DInstance::DrawCubes({ &translation, 1u }, { &color, 1u }, material);
+}
 
-    RenderCommand::DrawIndexed(m_Storage->PlaneVArray, m_Storage->CubeTexture);
+void Renderer3DInstance::DrawCubes(std::span<const Translation> translations, std::span<const glm::vec3> colors, MaterialIndex material)
+{
+    if (translations.empty()) return;
+
+    std::uint32_t offset{};
+    auto* instances{ Renderer3DInstance::PushInstances(translations.size(), offset) };
+    if (!instances) return;
+
+    for (std::size_t i = 0u; i < translations.size(); ++i)
+    {
+        instances[i].ModelMatrix = translations[i].ComposeModelMatrix();
+        instances[i].Color       = glm::vec4{ i < colors.size() ? colors[i] : glm::vec3{ 1.0f }, 1.0f };
+    }
 
-    m_Storage->PrimitivesCountTemp +=
-        m_Storage->PlaneVArray->GetIndexBuffer()->GetCount() / 3u;
+    const auto visible{ Renderer3DInstance::CullInstances(offset, translations.size(), m_Storage->CubeVArray->GetBounds().Sphere) };
+    if (!visible) return;
+
+    Renderer3DInstance::Submit({
+        .ShaderPtr      = Renderer3DInstance::GetSceneShader(),
+        .VertexArrayPtr = m_Storage->CubeVArray.get(),
+        .Textures       = { m_Storage->FlatTexture.get(), m_Storage->FlatTexture.get(), },
+        .InstanceOffset = offset,
+        .InstanceCount  = visible,
+        .Material       = material,
+    });
+}
+
+void Renderer3DInstance::DrawCubes(const TranslationBatch& translations, std::span<const glm::vec3> colors, MaterialIndex material)
+{
+    if (!translations.GetSize()) return;
+
+    std::uint32_t offset{};
+    auto* instances{ Renderer3DInstance::PushInstances(translations.GetSize(), offset) };
+    if (!instances) return;
+
+    ComposeModelMatrices(translations, &instances->ModelMatrix, sizeof(InstanceData));
+    for (std::size_t i = 0u; i < translations.GetSize(); ++i)
+        instances[i].Color = glm::vec4{ i < colors.size() ? colors[i] : glm::vec3{ 1.0f }, 1.0f };
+
+    const auto visible{ Renderer3DInstance::CullInstances(offset, translations.GetSize(), m_Storage->CubeVArray->GetBounds().Sphere) };
+    if (!visible) return;
+
+    Renderer3DInstance::Submit({
+        .ShaderPtr      = Renderer3DInstance::GetSceneShader(),
+        .VertexArrayPtr = m_Storage->CubeVArray.get(),
+        .Textures       = { m_Storage->FlatTexture.get(), m_Storage->FlatTexture.get(), },
+        .InstanceOffset = offset,
+        .InstanceCount  = visible,
+        .Material       = material,
+    });
 }
 
-void Renderer3DInstance::DrawCube(const Translation& translation, const glm::vec3& color)
+void Renderer3DInstance::DrawCubes(std::span<const glm::mat4> modelMatrices, std::span<const glm::vec3> colors, MaterialIndex material)
 {
-    m_Storage->FlatShader->SetUniform("u_ModelMatrix", translation.ComposeModelMatrix());
+    if (modelMatrices.empty()) return;
+
+    std::uint32_t offset{};
+    auto* instances{ Renderer3DInstance::PushInstances(modelMatrices.size(), offset) };
+    if (!instances) return;
 
-    m_Storage->FlatShader->SetUniform("u_Material.Ambient",  glm::vec3{ 0.1f, 0.1f, 0.1f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Diffuse",  glm::vec3{ 1.0f, 1.0f, 1.0f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Specular", glm::vec3{ 0.5f, 0.5f, 0.5f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Shininess", 32.0f);
+    for (std::size_t i = 0u; i < modelMatrices.size(); ++i)
+    {
+        instances[i].ModelMatrix = modelMatrices[i];
+        instances[i].Color       = glm::vec4{ i < colors.size() ? colors[i] : glm::vec3{ 1.0f }, 1.0f };
+    }
 
-    RenderCommand::DrawArrays(m_Storage->CubeVArray);
+    const auto visible{ Renderer3DInstance::CullInstances(offset, modelMatrices.size(), m_Storage->CubeVArray->GetBounds().Sphere) };
+    if (!visible) return;
 
-    m_Storage->PrimitivesCountTemp +=
-        m_Storage->CubeVArray->GetVertexBuffer()->GetSize() / 3u;
+    Renderer3DInstance::Submit({
+        .ShaderPtr      = Renderer3DInstance::GetSceneShader(),
+        .VertexArrayPtr = m_Storage->CubeVArray.get(),
+        .Textures       = { m_Storage->FlatTexture.get(), m_Storage->FlatTexture.get(), },
+        .InstanceOffset = offset,
+        .InstanceCount  = visible,
+        .Material       = material,
+    });
 }
 
 void Renderer3DInstance::SetPointLight(const glm::vec3& position, const glm::vec3& color)
 {
-    m_Storage->FlatShader->SetUniform("u_Light.Position", position);
-    m_Storage->FlatShader->SetUniform("u_Light.Color", color);
+    auto& frameData{ m_Storage->FrameData };
+    frameData.LightPosition = glm::vec4{ position, 1.0f };
+    frameData.LightColor    = glm::vec4{ color, 1.0f };
+
+    // Only the light part of the block changes.
+    constexpr auto c_LightOffset{ offsetof(FrameUniformData, LightPosition) };
+    m_Storage->FrameUniformBuffer->SetData(&frameData.LightPosition, sizeof(FrameUniformData) - c_LightOffset, c_LightOffset);
 }
 
 void Renderer3DInstance::DrawArrays(
@@ -149,45 +469,388 @@ void Renderer3DInstance::DrawArrays(
     const std::shared_ptr<Texture2D>& diffuse,
     const std::shared_ptr<Texture2D>& specular,
     const std::shared_ptr<Texture2D>& emission,
-    bool wireframe)
+    bool wireframe,
+    MaterialIndex material)
 {
     Translation translation{ .Scale = glm::vec3(0.1f), };
 
-    m_Storage->FlatShader->SetUniform("u_ModelMatrix", translation.ComposeModelMatrix());
+    std::uint32_t offset{};
+    auto* instance{ Renderer3DInstance::PushInstances(1u, offset) };
+    if (!instance) return;
 
-    m_Storage->FlatShader->SetUniform("u_Material.Ambient",  glm::vec3{ 0.1f, 0.1f, 0.1f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Diffuse",  glm::vec3{ 1.0f, 1.0f, 1.0f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Specular", glm::vec3{ 0.5f, 0.5f, 0.5f, });
-    m_Storage->FlatShader->SetUniform("u_Material.Shininess", 32.0f);
+    instance->ModelMatrix = translation.ComposeModelMatrix() * vertexArray->GetBaseTransform();
+    instance->Color       = glm::vec4{ 1.0f };
 
-    if (diffuse.get())
+    const auto bounds{ Internal::GetInstanceBounds(vertexArray->GetBounds(), vertexArray->GetBaseTransform()) };
+    if (!Renderer3DInstance::CullInstances(offset, 1u, bounds)) return;
+
+    DrawPayload payload{
+        .ShaderPtr      = Renderer3DInstance::GetSceneShader(),
+        .VertexArrayPtr = vertexArray.get(),
+        .Textures       = { diffuse.get(), specular.get(), emission.get(), },
+        .InstanceOffset = offset,
+        .Material       = material,
+    };
+
+    Renderer3DInstance::RequestTextureDetail(payload, bounds);
+    Renderer3DInstance::Submit(payload);
+
+    if (wireframe)
     {
+        payload.Layer = DrawLayer::Wireframe;
+        Renderer3DInstance::Submit(payload);
     }
+}
 
-    glActiveTexture(GL_TEXTURE0);
-    diffuse->Bind();
-    m_Storage->FlatShader->SetUniform<int>("u_DiffuseTexture", GL_TEXTURE0 - GL_TEXTURE0);
+void Renderer3DInstance::DrawInstanced(
+    const std::shared_ptr<VertexArray>& vertexArray,
+    std::span<const glm::mat4> modelMatrices,
+    std::span<const glm::vec3> colors,
+    const std::shared_ptr<Texture2D>& diffuse,
+    const std::shared_ptr<Texture2D>& specular,
+    const std::shared_ptr<Texture2D>& emission,
+    MaterialIndex material)
+{
+    if (!vertexArray.get() || modelMatrices.empty()) return;
 
-    glActiveTexture(GL_TEXTURE1);
-    specular->Bind();
-    m_Storage->FlatShader->SetUniform<int>("u_SpecularTexture", GL_TEXTURE1 - GL_TEXTURE0);
+    std::uint32_t offset{};
+    auto* instances{ Renderer3DInstance::PushInstances(modelMatrices.size(), offset) };
+    if (!instances) return;
 
-    glActiveTexture(GL_TEXTURE2);
-    emission->Bind();
-    m_Storage->FlatShader->SetUniform<int>("u_EmissionTexture", GL_TEXTURE2 - GL_TEXTURE0);
+    const auto& baseTransform{ vertexArray->GetBaseTransform() };
+    for (std::size_t i = 0u; i < modelMatrices.size(); ++i)
+    {
+        instances[i].ModelMatrix = modelMatrices[i] * baseTransform;
+        instances[i].Color       = glm::vec4{ i < colors.size() ? colors[i] : glm::vec3{ 1.0f }, 1.0f };
+    }
 
-    RenderCommand::DrawArrays(vertexArray);
+    const auto bounds{ Internal::GetInstanceBounds(vertexArray->GetBounds(), baseTransform) };
+    const auto visible{ Renderer3DInstance::CullInstances(offset, modelMatrices.size(), bounds) };
+    if (!visible) return;
+
+    const DrawPayload payload{
+        .ShaderPtr      = Renderer3DInstance::GetSceneShader(),
+        .VertexArrayPtr = vertexArray.get(),
+        .Textures       = { diffuse.get(), specular.get(), emission.get(), },
+        .InstanceOffset = offset,
+        .InstanceCount  = visible,
+        .Material       = material,
+    };
+
+    Renderer3DInstance::RequestTextureDetail(payload, bounds);
+    Renderer3DInstance::Submit(payload);
+}
 
-    if (wireframe)
+void Renderer3DInstance::DrawMesh(
+    const GeometryPool& pool,
+    const GeometryMesh& mesh,
+    std::span<const glm::mat4> modelMatrices,
+    std::span<const glm::vec3> colors,
+    const std::shared_ptr<Texture2D>& diffuse,
+    const std::shared_ptr<Texture2D>& specular,
+    const std::shared_ptr<Texture2D>& emission,
+    MaterialIndex material)
+{
+    if (!pool.GetVertexArray().get() || !mesh.IsValid() || modelMatrices.empty()) return;
+
+    std::uint32_t offset{};
+    auto* instances{ Renderer3DInstance::PushInstances(modelMatrices.size(), offset) };
+    if (!instances) return;
+
+    for (std::size_t i = 0u; i < modelMatrices.size(); ++i)
     {
-        glLineWidth(3.0f);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        
-        m_Storage->FlatShader->SetUniform("u_Color", glm::vec3(0.0f));
-        RenderCommand::DrawArrays(vertexArray);
+        instances[i].ModelMatrix = modelMatrices[i] * mesh.BaseTransform;
+        instances[i].Color       = glm::vec4{ i < colors.size() ? colors[i] : glm::vec3{ 1.0f }, 1.0f };
+    }
 
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    const auto bounds{ Internal::GetInstanceBounds(mesh.Bounds, mesh.BaseTransform) };
+    const auto visible{ Renderer3DInstance::CullInstances(offset, modelMatrices.size(), bounds) };
+    if (!visible) return;
+
+    const DrawPayload payload{
+        .ShaderPtr      = Renderer3DInstance::GetSceneShader(),
+        .VertexArrayPtr = pool.GetVertexArray().get(),
+        .Textures       = { diffuse.get(), specular.get(), emission.get(), },
+        .InstanceOffset = offset,
+        .InstanceCount  = visible,
+        .Range          = mesh.Range,
+        .Material       = material,
+    };
+
+    Renderer3DInstance::RequestTextureDetail(payload, bounds);
+    Renderer3DInstance::Submit(payload);
+}
+
+InstanceData* Renderer3DInstance::PushInstances(const std::size_t count, std::uint32_t& offset) noexcept
+{
+    auto& instances{ m_Storage->Instances };
+    if (instances.size() + count > Internal::c_MaxInstanceCount)
+    {
+        spdlog::error("[Renderer3D]: Cannot draw more than {} instances in a frame!", Internal::c_MaxInstanceCount);
+        return nullptr;
     }
+
+    offset = static_cast<std::uint32_t>(instances.size());
+    instances.resize(instances.size() + count);
+    return instances.data() + offset;
+}
+
+std::uint32_t Renderer3DInstance::CullInstances(const std::uint32_t offset, const std::size_t count, const BoundingSphere& bounds) noexcept
+{
+    const auto total{ static_cast<std::uint32_t>(count) };
+    if (!m_Storage->IsCullingEnabled || bounds.Radius <= 0.0f)
+    {
+        m_Storage->VisibleInstances += total;
+        return total;
+    }
+
+    const auto startTime{ std::chrono::steady_clock::now() };
+
+    auto* instances{ m_Storage->Instances.data() + offset };
+    auto& spheres{ m_Storage->CullSpheres };
+    auto& visibility{ m_Storage->CullVisibility };
+
+    spheres.Resize(count);
+    visibility.resize(count);
+    for (std::size_t i = 0u; i < count; ++i)
+        spheres.Set(i, bounds.Transform(instances[i].ModelMatrix));
+
+    const auto visible{ static_cast<std::uint32_t>(CullSpheres(m_Storage->ViewFrustum, spheres, visibility.data())) };
+
+    // Compacted in place, the survivors keep their order.
+    if (visible != total)
+    {
+        std::size_t last{ 0u };
+        for (std::size_t i = 0u; i < count; ++i)
+            if (visibility[i]) instances[last++] = instances[i];
+
+        m_Storage->Instances.resize(offset + visible);
+    }
+
+    m_Storage->VisibleInstances += visible;
+    m_Storage->CulledInstances  += total - visible;
+    m_Storage->CullTime += std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - startTime }.count();
+
+    return visible;
+}
+
+void Renderer3DInstance::RequestTextureDetail(const DrawPayload& payload, const BoundingSphere& bounds) noexcept
+{
+    auto& textures{ *m_Storage->Textures };
+    if (bounds.Radius <= 0.0f || std::none_of(payload.Textures.begin(), payload.Textures.end(), [&textures](const auto* texture) { return textures.IsStreamed(texture); }))
+        return;
+
+    const auto viewPosition{ glm::vec3{ m_Storage->FrameData.ViewPosition } };
+
+    // The closest instance decides, the texture is assumed to span the whole object.
+    float pixels{ 0.0f };
+    for (std::uint32_t i = 0u; i < payload.InstanceCount; ++i)
+    {
+        const auto sphere{ bounds.Transform(m_Storage->Instances[payload.InstanceOffset + i].ModelMatrix) };
+        const auto distance{ m_Storage->IsPerspective ? std::max(glm::distance(sphere.Center, viewPosition), sphere.Radius) : 1.0f };
+
+        pixels = std::max(pixels, 2.0f * sphere.Radius * m_Storage->DetailScale / distance);
+    }
+
+    for (const auto* texture : payload.Textures)
+        textures.RequestDetail(texture, pixels);
+}
+
+Shader* Renderer3DInstance::GetSceneShader() const noexcept
+{
+    return m_Storage->TextureSlots->IsBindless() ? m_Storage->BindlessShader.get() : m_Storage->FlatShader.get();
+}
+
+void Renderer3DInstance::Submit(const DrawPayload& payload)
+{
+    const auto getHandle{ [](const auto* resource) {
+        return resource ? resource->GetResourceHandle() : c_EmptyValue<RendererID>;
+    } };
+
+    // The instances say which material and texture layers they use, the draw only has to bind the arrays.
+    auto resolved{ payload };
+    glm::uvec4 material{ payload.Material, TextureTable::c_EmptySlot, TextureTable::c_EmptySlot, TextureTable::c_EmptySlot, };
+
+    for (std::size_t unit = 0u; unit < payload.Textures.size(); ++unit)
+    {
+        const auto slot{ m_Storage->TextureSlots->Resolve(payload.Textures[unit]) };
+        resolved.TextureArrays[unit] = slot.Array;
+        material[static_cast<glm::length_t>(unit + 1u)] = slot.Index;
+    }
+
+    for (std::uint32_t i = 0u; i < payload.InstanceCount; ++i)
+        m_Storage->Instances[payload.InstanceOffset + i].Material = material;
+
+    // Arrays are only ever bound together, they are keyed as one set. By address, growing an array changes its handle.
+    auto textures{ Hash::c_OffsetBasis };
+    for (const auto* array : resolved.TextureArrays)
+        textures = Hash::FNV1aValue(array, textures);
+
+    // Instanced draws are keyed by their first instance.
+    const auto& modelMatrix{ m_Storage->Instances[payload.InstanceOffset].ModelMatrix };
+    const auto viewPosition{ m_Storage->FrameData.ViewMatrix * modelMatrix[3] };
+
+    const auto key{ SortKey::Encode(
+        static_cast<std::uint32_t>(payload.Layer),
+        getHandle(payload.ShaderPtr),
+        static_cast<std::uint32_t>(textures),
+        getHandle(payload.VertexArrayPtr),
+        payload.Material,
+        SortKey::QuantizeDepth(-viewPosition.z, Internal::c_SortFarDistance)) };
+
+    m_Storage->Commands.Submit(key, resolved);
+}
+
+void Renderer3DInstance::Flush() noexcept
+{
+    auto& commands{ m_Storage->Commands };
+    auto& statistics{ m_Storage->Statistics };
+    statistics = RendererStatistics{ .Packets = commands.GetSize(), };
+
+    const auto sortStartTime{ std::chrono::steady_clock::now() };
+    commands.Sort();
+    statistics.SortTime = std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - sortStartTime }.count();
+
+    // Every texture of the frame is resolved by now.
+    m_Storage->TextureSlots->Upload();
+
+    auto* instanceRegion{ static_cast<InstanceData*>(m_Storage->InstanceBuffer->AcquireRegion()) };
+    auto* indirectRegion{ static_cast<DrawIndirectCommand*>(m_Storage->IndirectBuffer->AcquireRegion()) };
+    if (!instanceRegion || !indirectRegion) return;
+
+    m_Storage->InstanceBuffer->Bind();
+    m_Storage->IndirectBuffer->Bind();
+
+    // GL state as left by the previous batch, only the differences are applied.
+    Shader* currentShader{ nullptr };
+    const VertexArray* currentVertexArray{ nullptr };
+    std::array<RendererID, 3u> currentTextures{};
+    currentTextures.fill(c_InvalidValue<RendererID>);
+    auto currentLayer{ DrawLayer::Opaque };
+
+    const auto& packets{ commands.GetPackets() };
+    const auto& instances{ m_Storage->Instances };
+    std::uint32_t instanceCursor{ 0u };
+    std::uint32_t commandCursor{ 0u };
+
+    for (std::size_t first = 0u, last = 0u; first < packets.size(); first = last)
+    {
+        const auto& payload{ commands.GetPayload(packets[first]) };
+        if (!payload.ShaderPtr || !payload.VertexArrayPtr)
+        {
+            last = first + 1u;
+            continue;
+        }
+
+        // Packets sharing all the state are adjacent after the sort, their instances are gathered
+        // in submission order so the whole run is one contiguous instanced draw. Runs of pool meshes
+        // get an indirect command per mesh, adjacent packets of the same mesh share theirs.
+        const auto isMultiDraw{ payload.Range.IndexCount != 0u };
+        const auto baseInstance{ instanceCursor };
+        const auto baseCommand{ commandCursor };
+
+        for (last = first; last < packets.size(); ++last)
+        {
+            const auto& other{ commands.GetPayload(packets[last]) };
+            if (last != first && !payload.CanBatchWith(other)) break;
+
+            if (isMultiDraw)
+            {
+                if (commandCursor != baseCommand && commands.GetPayload(packets[last - 1u]).Range == other.Range)
+                {
+                    indirectRegion[commandCursor - 1u].InstanceCount += other.InstanceCount;
+                }
+                else
+                {
+                    indirectRegion[commandCursor++] = {
+                        .IndexCount    = other.Range.IndexCount,
+                        .InstanceCount = other.InstanceCount,
+                        .FirstIndex    = other.Range.FirstIndex,
+                        .BaseVertex    = other.Range.BaseVertex,
+                        .BaseInstance  = instanceCursor,
+                    };
+                }
+
+                if (other.Layer == DrawLayer::Opaque)
+                    statistics.Primitives += other.Range.IndexCount / 3u * other.InstanceCount;
+            }
+
+            std::memcpy(instanceRegion + instanceCursor, instances.data() + other.InstanceOffset, other.InstanceCount * sizeof(InstanceData));
+            instanceCursor += other.InstanceCount;
+        }
+
+        if (payload.ShaderPtr != currentShader)
+        {
+            payload.ShaderPtr->Bind();
+            currentShader = payload.ShaderPtr;
+            ++statistics.StateChanges;
+        }
+
+        if (payload.VertexArrayPtr != currentVertexArray)
+        {
+            payload.VertexArrayPtr->Bind();
+            currentVertexArray = payload.VertexArrayPtr;
+            ++statistics.StateChanges;
+        }
+
+        for (std::size_t unit = 0u; unit < payload.TextureArrays.size(); ++unit)
+        {
+            // An empty slot unbinds the unit, the instances hold no layer of it anyway. Bindless draws have none bound.
+            const auto* array{ payload.TextureArrays[unit] };
+            const auto handle{ array ? array->GetResourceHandle() : c_EmptyValue<RendererID> };
+            if (handle == currentTextures[unit]) continue;
+
+            StateCache::Get().BindTextureUnit(static_cast<std::uint32_t>(unit), handle);
+            currentTextures[unit] = handle;
+            ++statistics.StateChanges;
+        }
+
+        if (payload.Layer != currentLayer)
+        {
+            if (payload.Layer == DrawLayer::Wireframe)
+            {
+                glLineWidth(3.0f);
+                StateCache::Get().SetPolygonMode(PolygonMode::Line);
+            }
+            else StateCache::Get().SetPolygonMode(PolygonMode::Fill);
+
+            currentLayer = payload.Layer;
+            ++statistics.StateChanges;
+        }
+
+        const auto instanceCount{ instanceCursor - baseInstance };
+
+        ++statistics.DrawCalls;
+        statistics.Instances += instanceCount;
+        if (last - first > 1u) ++statistics.Batches;
+
+        if (isMultiDraw)
+        {
+            const auto commandCount{ commandCursor - baseCommand };
+            const auto indirectOffset{ m_Storage->IndirectBuffer->GetCurrentOffset() + baseCommand * sizeof(DrawIndirectCommand) };
+
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                reinterpret_cast<const void*>(indirectOffset), { static_cast<GLsizei>(commandCount) }, 0);
+
+            statistics.IndirectCommands += commandCount;
+            continue;
+        }
+
+        const auto& indexBuffer{ payload.VertexArrayPtr->GetIndexBuffer() };
+        const auto isIndexed{ indexBuffer.get() && indexBuffer->GetCount() };
+        const auto elementCount{ isIndexed ? indexBuffer->GetCount() : payload.VertexArrayPtr->GetVertexBuffer()->GetSize() };
+
+        isIndexed
+            ? glDrawElementsInstancedBaseInstance(GL_TRIANGLES, { static_cast<GLsizei>(elementCount) }, GL_UNSIGNED_INT, nullptr,
+                { static_cast<GLsizei>(instanceCount) }, { baseInstance })
+            : glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, { static_cast<GLsizei>(elementCount) },
+                { static_cast<GLsizei>(instanceCount) }, { baseInstance });
+
+        if (payload.Layer == DrawLayer::Opaque) statistics.Primitives += elementCount / 3u * instanceCount;
+    }
+
+    if (currentLayer != DrawLayer::Opaque)
+        StateCache::Get().SetPolygonMode(PolygonMode::Fill);
 }
 
 NAMESPACE_END(Renderer)
@@ -4,6 +4,15 @@
 
 #include "Renderer/RenderCommand.hpp"
 #include "Renderer/RendererElements.hpp"
+#include "Renderer/MaterialRegistry.hpp"
+#include "Renderer/CommandBuffer.hpp"
+#include "Renderer/GeometryPool.hpp"
+#include "Renderer/TransformBatch.hpp"
+#include "Renderer/TransformHierarchy.hpp"
+#include "Renderer/Culling.hpp"
+#include "Renderer/TextureStreamer.hpp"
+#include "Renderer/TextureTable.hpp"
+#include "Renderer/ResourceCache.hpp"
 
 #include "Renderer/Backend/Buffers.hpp"
 #include "Renderer/Backend/Shader.hpp"
@@ -12,6 +21,9 @@
 #include "Renderer/Camera/OrthographicCamera.hpp"
 #include "Renderer/Camera/PerspectiveCamera.hpp"
 
+#include <span>
+#include <vector>
+
 NAMESPACE_BEGIN(Renderer)
 
 class RendererInstance
@@ -26,6 +38,31 @@ public:
 
 struct Renderer3DStorage;
 
+// Counters of the last finished scene.
+struct RendererStatistics
+{
+    std::size_t DrawCalls{ 0u };
+    std::size_t StateChanges{ 0u };
+    std::size_t Primitives{ 0u };
+    std::size_t Packets{ 0u };
+    std::size_t Instances{ 0u };
+    std::size_t IndirectCommands{ 0u };
+
+    // Draw calls that merged more than one packet.
+    std::size_t Batches{ 0u };
+
+    double SortTime{ 0.0 }; // ms
+
+    // GL state calls of the frame and how many of them the state cache dropped as redundant.
+    std::size_t StateCalls{ 0u };
+    std::size_t StateAvoided{ 0u };
+
+    // Instances tested against the view frustum, and how many of them were dropped before submission.
+    std::size_t VisibleInstances{ 0u };
+    std::size_t CulledInstances{ 0u };
+    double CullTime{ 0.0 }; // ms
+};
+
 class Renderer3DInstance : public RendererInstance
 {
 public: // experimental
@@ -33,17 +70,60 @@ public: // experimental
     
     std::size_t GetPrimitivesRendered() const noexcept;
 
+    // Batches merging several packets, and the average number of packets per draw call.
+    std::size_t GetBatchCount() const noexcept;
+    double GetBatchEfficiency() const noexcept;
+    const RendererStatistics& GetStatistics() const noexcept;
+
+    MaterialRegistry& GetMaterials() noexcept;
+
+    // Textures loaded through it start out white and are swapped in once decoded and uploaded, BeginScene() drives the uploads.
+    TextureStreamer& GetTextures() noexcept;
+
+    // Where the draws' textures are packed for the shaders.
+    const TextureTable& GetTextureTable() const noexcept;
+
+    // Off by default, the textures are then copied into texture arrays. Outside of a scene only, fails without ARB_bindless_texture.
+    bool SetBindlessTextures(const bool enabled) noexcept;
+    bool IsBindlessTexturesEnabled() const noexcept;
+
+    // On by default, draws of meshes without bounds are never culled.
+    void SetFrustumCulling(const bool enabled) noexcept;
+    bool IsFrustumCullingEnabled() const noexcept;
+
+    // Object space bounds of the built-in cube, for callers culling or picking cubes themselves.
+    const MeshBounds& GetCubeBounds() const noexcept;
+
 public:
     virtual bool OnInitialization() noexcept override;
     virtual void OnShutdown() noexcept override;
 
 public:
+    // Draws are only recorded in between, EndScene() sorts and submits them.
     virtual void BeginScene(Camera* camera) noexcept override;
     virtual void EndScene() noexcept override;
 
 public:
-    void DrawPlane(const Translation& translation);
-    void DrawCube(const Translation& translation, const glm::vec3& color = glm::vec3(1.0f));
+    void DrawPlane(const Translation& translation, MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
+    void DrawCube(const Translation& translation, const glm::vec3& color = glm::vec3(1.0f), MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
+
+    // One instanced draw for all the cubes, colors are optional and matched by index.
+    void DrawCubes(
+        std::span<const Translation> translations,
+        std::span<const glm::vec3> colors = {},
+        MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
+
+    // Same as above, the matrices are composed by the SIMD kernel straight into the instance data.
+    void DrawCubes(
+        const TranslationBatch& translations,
+        std::span<const glm::vec3> colors = {},
+        MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
+
+    // Already composed model matrices, e.g. TransformHierarchy::GetWorldMatrices().
+    void DrawCubes(
+        std::span<const glm::mat4> modelMatrices,
+        std::span<const glm::vec3> colors = {},
+        MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
 
     void SetPointLight(const glm::vec3& position, const glm::vec3& color);
 
@@ -52,7 +132,47 @@ public:
         const std::shared_ptr<Texture2D>& diffuse,
         const std::shared_ptr<Texture2D>& specular,
         const std::shared_ptr<Texture2D>& emission,
-        bool wireframe = false);
+        bool wireframe = false,
+        MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
+
+    // Draws the vertex array once per model matrix in a single call.
+    void DrawInstanced(
+        const std::shared_ptr<VertexArray>& vertexArray,
+        std::span<const glm::mat4> modelMatrices,
+        std::span<const glm::vec3> colors = {},
+        const std::shared_ptr<Texture2D>& diffuse = {},
+        const std::shared_ptr<Texture2D>& specular = {},
+        const std::shared_ptr<Texture2D>& emission = {},
+        MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
+
+    // Meshes of a pool are drawn with glMultiDrawElementsIndirect(), all of them in as few calls as the state allows.
+    void DrawMesh(
+        const GeometryPool& pool,
+        const GeometryMesh& mesh,
+        std::span<const glm::mat4> modelMatrices,
+        std::span<const glm::vec3> colors = {},
+        const std::shared_ptr<Texture2D>& diffuse = {},
+        const std::shared_ptr<Texture2D>& specular = {},
+        const std::shared_ptr<Texture2D>& emission = {},
+        MaterialIndex material = MaterialRegistry::c_DefaultMaterial);
+
+private:
+    // Appends count entries to the frame's instance data, returns the first one or nullptr when it is full.
+    InstanceData* PushInstances(const std::size_t count, std::uint32_t& offset) noexcept;
+
+    // Drops the instances starting at offset whose bounds are outside the frustum, the last pushed ones only.
+    // The bounds are in the space the instance matrices transform from, returns how many are left.
+    std::uint32_t CullInstances(const std::uint32_t offset, const std::size_t count, const BoundingSphere& bounds) noexcept;
+
+    // Reports to the streamer how large the visible instances of the draw come out on screen, for its streamed textures.
+    void RequestTextureDetail(const DrawPayload& payload, const BoundingSphere& bounds) noexcept;
+
+    // The fragment shader matching the TextureTable's mode.
+    Shader* GetSceneShader() const noexcept;
+
+    // Resolves the textures and writes the material and texture indices into the draw's instances.
+    void Submit(const DrawPayload& payload);
+    void Flush() noexcept;
 
 public:
     std::unique_ptr<Renderer3DStorage> m_Storage{};
@@ -67,12 +187,40 @@ struct Renderer3DStorage
     ResourceHandle<VertexArray> CubeVArray{};
     
     ResourceHandle<Shader> FlatShader{};
+    ResourceHandle<Shader> BindlessShader{}; // only with ARB_bindless_texture
 
     ResourceHandle<Texture2D> FlatTexture{};
     ResourceHandle<Texture2D> CubeTexture{};
+    ResourceHandle<TextureStreamer> Textures{};
+    ResourceHandle<TextureTable> TextureSlots{};
+
+    ResourceHandle<UniformBuffer> FrameUniformBuffer{};
+    FrameUniformData FrameData{};
+
+    ResourceHandle<MaterialRegistry> Materials{};
+
+    // Instances of every draw in the frame, gathered into the ring buffer in sorted order by EndScene().
+    ResourceHandle<RingBuffer> InstanceBuffer{};
+    std::vector<InstanceData> Instances{};
+
+    // Commands of the pool draws, built on the CPU while flushing.
+    ResourceHandle<RingBuffer> IndirectBuffer{};
+
+    CommandBuffer Commands{};
+    RendererStatistics Statistics{};
+
+    // Set up by BeginScene(), the world space spheres of the instances are tested in SoA form.
+    Frustum ViewFrustum{};
+    bool IsCullingEnabled{ true };
+    SphereBatch CullSpheres{};
+    std::vector<std::uint8_t> CullVisibility{};
+    std::size_t VisibleInstances{ 0u };
+    std::size_t CulledInstances{ 0u };
+    double CullTime{ 0.0 };
 
-    std::size_t PrimitivesCount{ 0u };
-    std::size_t PrimitivesCountTemp{ 0u };
+    // Screen pixels per world unit at distance 1, at any distance for an orthographic camera.
+    float DetailScale{ 0.0f };
+    bool IsPerspective{ true };
 };
 
 NAMESPACE_END(Renderer)
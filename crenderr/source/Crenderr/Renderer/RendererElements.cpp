@@ -1,6 +1,7 @@
 #include "RendererElements.hpp"
 
 #include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 NAMESPACE_BEGIN(Renderer)
 
@@ -16,4 +17,36 @@ glm::mat4 Translation::ComposeModelMatrix() const
     return model;
 }
 
+PositionQuantization PositionQuantization::FromBounds(const glm::vec3& min, const glm::vec3& max) noexcept
+{
+    // One scale for every axis keeps the transform uniform, so the normals need no correction.
+    const auto extent{ (max - min) * 0.5f };
+    const auto scale{ glm::max(extent.x, glm::max(extent.y, extent.z)) };
+
+    return PositionQuantization{
+        .Offset = (min + max) * 0.5f,
+        .Scale  = scale > 0.0f ? scale : 1.0f,
+    };
+}
+
+glm::mat4 PositionQuantization::GetTransform() const
+{
+    auto transform{ glm::identity<glm::mat4>() };
+    transform = glm::translate(transform, Offset);
+    transform = glm::scale(transform, glm::vec3(Scale));
+
+    return transform;
+}
+
+Vertex3DPacked Vertex3DPacked::Pack(const Vertex3D& vertex, const PositionQuantization& quantization) noexcept
+{
+    const auto position{ (vertex.Position - quantization.Offset) / quantization.Scale };
+
+    return Vertex3DPacked{
+        .Position = glm::packSnorm4x16(glm::vec4{ position, 1.0f }),
+        .Normal   = glm::packSnorm3x10_1x2(glm::vec4{ vertex.Normal, 0.0f }),
+        .Texcoord = glm::packHalf2x16(vertex.Texcoord),
+    };
+}
+
 NAMESPACE_END(Renderer)
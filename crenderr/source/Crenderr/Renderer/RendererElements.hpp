@@ -6,6 +6,8 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
+
 NAMESPACE_BEGIN(Renderer)
 
 struct Vertex3D
@@ -21,6 +23,64 @@ struct Vertex3D
     };
 };
 
+// Uniform dequantization of snorm16 positions, position = Offset + Scale * snorm.
+struct PositionQuantization
+{
+    glm::vec3 Offset{ 0.0f };
+    float Scale{ 1.0f };
+
+    static PositionQuantization FromBounds(const glm::vec3& min, const glm::vec3& max) noexcept;
+
+    glm::mat4 GetTransform() const;
+};
+
+// 16 bytes instead of the 32 of a Vertex3D, the positions need the PositionQuantization transform.
+struct Vertex3DPacked
+{
+    std::uint64_t Position{ 0u }; // snorm16 x4, w is always 1.0
+    std::uint32_t Normal{ 0u };   // snorm 10_10_10_2
+    std::uint32_t Texcoord{ 0u }; // half x2
+
+    inline static const BufferLayout c_Layout{
+        { LayoutDataType::Short4Norm,     "a_Position", },
+        { LayoutDataType::Int2101010Norm, "a_Normal",   },
+        { LayoutDataType::Half2,          "a_Texcoord", },
+    };
+
+    static Vertex3DPacked Pack(const Vertex3D& vertex, const PositionQuantization& quantization) noexcept;
+};
+
+// Mirrors the std140 FrameData block of the shaders, shared by every program through c_FrameDataBinding.
+struct FrameUniformData
+{
+    static constexpr std::uint32_t c_FrameDataBinding{ 0u };
+
+    glm::mat4 ViewMatrix{ 1.0f };
+    glm::mat4 ProjectionMatrix{ 1.0f };
+    glm::mat4 ViewProjectionMatrix{ 1.0f };
+
+    // vec3s are padded to 16 bytes in std140 anyway, w is unused.
+    glm::vec4 ViewPosition{ 0.0f };
+    glm::vec4 LightPosition{ 0.0f };
+    glm::vec4 LightColor{ 1.0f };
+};
+
+static_assert(sizeof(FrameUniformData) == 3u * sizeof(glm::mat4) + 3u * sizeof(glm::vec4), "FrameUniformData has to match the std140 layout!");
+
+// std430 entry of the InstanceTable buffer, a draw reads its instances from gl_BaseInstance on.
+struct InstanceData
+{
+    static constexpr std::uint32_t c_InstanceDataBinding{ 1u };
+
+    glm::mat4 ModelMatrix{ 1.0f };
+    glm::vec4 Color{ 1.0f };
+
+    // Index into the MaterialTable, then the diffuse, specular and emission TextureTable indices. Written on submission.
+    glm::uvec4 Material{ 0u };
+};
+
+static_assert(sizeof(InstanceData) == sizeof(glm::mat4) + sizeof(glm::vec4) + sizeof(glm::uvec4), "InstanceData has to match the std430 layout!");
+
 struct Translation
 {
     glm::vec3 Scale    = { glm::vec3(1.0f) };
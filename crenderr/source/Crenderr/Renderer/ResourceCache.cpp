@@ -0,0 +1,71 @@
+#include "ResourceCache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    // Entries stored before Acquire() prunes for the first time, the threshold then follows the live count.
+    constexpr std::size_t c_MinPruneThreshold{ 64u };
+}
+
+ResourceCache& ResourceCache::Get() noexcept
+{
+    static ResourceCache s_Instance{};
+    return s_Instance;
+}
+
+void ResourceCache::Prune() noexcept
+{
+    m_Statistics.Resources     = 0u;
+    m_Statistics.ResidentBytes = 0u;
+
+    for (auto it = m_Entries.begin(); it != m_Entries.end();)
+    {
+        const auto resource{ it->second.Resource.lock() };
+        if (!resource)
+        {
+            ++m_Statistics.Expired;
+            it = m_Entries.erase(it);
+            continue;
+        }
+
+        ++m_Statistics.Resources;
+        m_Statistics.ResidentBytes += it->second.GetByteSize(resource.get());
+        ++it;
+    }
+
+    m_PruneThreshold = std::max(Internal::c_MinPruneThreshold, m_Entries.size() * 2u);
+}
+
+std::shared_ptr<void> ResourceCache::Find(const Hash::ValueType key, const std::type_index type) const noexcept
+{
+    const auto found{ m_Entries.find(key) };
+    if (found == m_Entries.end()) return nullptr;
+
+    if (found->second.Type != type)
+    {
+        spdlog::warn("[ResourceCache]: Key {:#018x} is taken by a {}, the {} is not shared.", key, found->second.Type.name(), type.name());
+        return nullptr;
+    }
+
+    return found->second.Resource.lock();
+}
+
+void ResourceCache::Insert(const Hash::ValueType key, const std::type_index type, std::shared_ptr<void> resource, const ByteSizeFunction getByteSize) noexcept
+{
+    // Replaces an expired entry, or one of another type colliding with the key.
+    m_Entries[key] = Entry{
+        .Resource    = std::move(resource),
+        .Type        = type,
+        .GetByteSize = getByteSize,
+    };
+
+    if (m_Entries.size() >= std::max(m_PruneThreshold, Internal::c_MinPruneThreshold))
+        ResourceCache::Prune();
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/Backend/RendererResource.hpp"
+
+#include "Utility/Hash.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+NAMESPACE_BEGIN(Renderer)
+
+struct ResourceCacheStatistics
+{
+    std::size_t Hits{ 0u };
+    std::size_t Misses{ 0u };
+    std::size_t Failures{ 0u }; // misses whose resource failed to initialize, nothing was stored
+
+    // Of the misses right after initialization, and of the resources handed out again instead of being loaded once more.
+    std::size_t LoadedBytes{ 0u };
+    std::size_t ReusedBytes{ 0u };
+
+    // Entries dropped because their last user released the resource.
+    std::size_t Expired{ 0u };
+
+    // Live resources and their current size, as of the last Prune().
+    std::size_t Resources{ 0u };
+    std::size_t ResidentBytes{ 0u };
+};
+
+/**
+ * Shares resources loaded from the same source. Acquire() hashes the props into a key, mixed with
+ * the resource type, and returns the live resource stored under it, or creates, initializes and
+ * stores a new one. Entries only hold weak references: a resource goes away as soon as its last
+ * user drops it, the cache never keeps anything alive, and the expired entry is dropped by the next Prune().
+ *
+ * The props are hashed by a GetPropsHash() overload next to the resource, found by argument dependent
+ * lookup. Keys are 64 bit hashes and two sources hashing the same are not told apart. Only resources
+ * whose contents follow from their props belong here, e.g. files read by OnInitialize(), never
+ * buffers or textures written after creation: whoever gets the shared one sees the writes.
+ *
+ * Sizes come from the resource's GetByteSize() when it has one. GL thread only, like the resources.
+ */
+class ResourceCache
+{
+public:
+    static ResourceCache& Get() noexcept;
+
+    // Created from the props with AllocateResource() and OnInitialize() on a miss. nullptr when that fails.
+    template<typename _Ty, typename _Props = typename _Ty::PropsType>
+    std::shared_ptr<_Ty> Acquire(const _Props& props) noexcept
+    {
+        return ResourceCache::Acquire<_Ty>(GetPropsHash(props), [&props]() -> std::shared_ptr<_Ty> {
+            auto resource{ AllocateResource<_Ty>(props) };
+            return resource->OnInitialize() ? resource : nullptr;
+        });
+    }
+
+    // For resources made some other way, e.g. by a loader. create() returns the initialized resource or nullptr.
+    template<typename _Ty, typename _Create>
+    std::shared_ptr<_Ty> Acquire(const Hash::ValueType key, _Create&& create) noexcept
+    {
+        const std::type_index type{ typeid(_Ty) };
+        const auto typedKey{ Hash::Combine(key, type.hash_code()) };
+
+        if (auto found{ ResourceCache::Find(typedKey, type) })
+        {
+            auto resource{ std::static_pointer_cast<_Ty>(std::move(found)) };
+
+            ++m_Statistics.Hits;
+            m_Statistics.ReusedBytes += ResourceCache::GetByteSize<_Ty>(resource.get());
+            return resource;
+        }
+
+        std::shared_ptr<_Ty> resource{ create() };
+        ++m_Statistics.Misses;
+
+        if (!resource)
+        {
+            ++m_Statistics.Failures;
+            return nullptr;
+        }
+
+        m_Statistics.LoadedBytes += ResourceCache::GetByteSize<_Ty>(resource.get());
+        ResourceCache::Insert(typedKey, type, resource, &ResourceCache::GetByteSize<_Ty>);
+
+        return resource;
+    }
+
+    // Drops the expired entries and measures the live ones. Acquire() prunes on its own as the entries pile up.
+    void Prune() noexcept;
+
+    inline const auto& GetStatistics() const noexcept { return m_Statistics; }
+
+private:
+    using ByteSizeFunction = std::size_t (*)(const void* resource);
+
+    struct Entry
+    {
+        std::weak_ptr<void> Resource{};
+        std::type_index Type{ typeid(void) };
+        ByteSizeFunction GetByteSize{ nullptr };
+    };
+
+    template<typename _Ty>
+    static std::size_t GetByteSize(const void* resource) noexcept
+    {
+        if constexpr (requires(const _Ty& typed) { typed.GetByteSize(); })
+            return static_cast<std::size_t>(static_cast<const _Ty*>(resource)->GetByteSize());
+        else
+            return 0u;
+    }
+
+    // The live resource under the key, nullptr for an expired entry or one of another type.
+    std::shared_ptr<void> Find(const Hash::ValueType key, const std::type_index type) const noexcept;
+    void Insert(const Hash::ValueType key, const std::type_index type, std::shared_ptr<void> resource, const ByteSizeFunction getByteSize) noexcept;
+
+private:
+    ResourceCache() = default;
+
+private:
+    std::unordered_map<Hash::ValueType, Entry> m_Entries{};
+    std::size_t m_PruneThreshold{ 0u };
+
+    ResourceCacheStatistics m_Statistics{};
+};
+
+// Shared alternative to AllocateResource(): the same props give the same, already initialized, resource while anyone holds it.
+template<typename _Ty, typename _Props = typename _Ty::PropsType>
+inline std::shared_ptr<_Ty> AcquireResource(const _Props& props) noexcept
+{
+    return ResourceCache::Get().Acquire<_Ty>(props);
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,38 @@
+#include "Simd.hpp"
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    static SimdLevel DetectSimdLevel() noexcept
+    {
+#if CRENDERR_X86_SIMD
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4]{};
+        __cpuid(info, 1);
+        const bool hasFMA{ (info[2] & (1 << 12)) != 0 };
+        const bool hasOSXSave{ (info[2] & (1 << 27)) != 0 };
+
+        __cpuidex(info, 7, 0);
+        const bool hasAVX2{ (info[1] & (1 << 5)) != 0 };
+
+        // The OS has to save the upper halves of the ymm registers.
+        const bool hasYmmState{ hasOSXSave && (_xgetbv(0) & 0x6) == 0x6 };
+        return hasFMA && hasAVX2 && hasYmmState ? SimdLevel::AVX2 : SimdLevel::SSE;
+    #else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? SimdLevel::AVX2 : SimdLevel::SSE;
+    #endif
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+}
+
+SimdLevel GetSupportedSimdLevel() noexcept
+{
+    static const auto s_Level{ Internal::DetectSimdLevel() };
+    return s_Level;
+}
+
+NAMESPACE_END(Renderer)
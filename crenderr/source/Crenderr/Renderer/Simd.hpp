@@ -0,0 +1,32 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+// The kernels are compiled for x86-64 only, CRENDERR_TARGET_AVX2 enables AVX2 and FMA for a single function.
+#if defined(__x86_64__) || defined(_M_X64)
+    #define CRENDERR_X86_SIMD 1
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define CRENDERR_TARGET_AVX2
+    #else
+        #define CRENDERR_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #endif
+#else
+    #define CRENDERR_X86_SIMD 0
+#endif
+
+NAMESPACE_BEGIN(Renderer)
+
+enum class SimdLevel
+{
+    Scalar,
+    SSE,  // SSE2, the x86-64 baseline
+    AVX2, // with FMA
+};
+
+// Checked once at runtime, the binary itself only assumes the baseline.
+SimdLevel GetSupportedSimdLevel() noexcept;
+
+NAMESPACE_END(Renderer)
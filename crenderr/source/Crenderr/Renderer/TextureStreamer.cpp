@@ -0,0 +1,434 @@
+#include "TextureStreamer.hpp"
+
+#include "Renderer/ResourceCache.hpp"
+#include "Renderer/Loaders/DDSFile.hpp"
+
+#include "Utility/ThreadPool.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <stb_image.h>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    // The first level change goes straight to the levels this many texels across and smaller.
+    constexpr float c_InitialSide{ 64.0f };
+
+    // Keeps streamed textures apart from the same files loaded in one go by Texture2D::OnInitialize().
+    constexpr Hash::ValueType c_StreamedTextureKey{ Hash::FNV1a("TextureStreamer") };
+
+    template<typename _Ty>
+    static inline double GetElapsed(const _Ty& startTime) noexcept
+    {
+        return std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - startTime }.count();
+    }
+
+    // The finest level at most side texels across, the coarsest one when none is.
+    static std::uint32_t GetCoarseLevel(const glm::ivec2& size, const std::uint32_t levelCount, const float side) noexcept
+    {
+        const auto largest{ static_cast<float>(std::max(size.x, size.y)) };
+        const auto level{ largest > side ? static_cast<std::uint32_t>(std::ceil(std::log2(largest / side))) : 0u };
+
+        return std::min(level, levelCount - 1u);
+    }
+
+    // The coarsest level still at least pixels texels across, so the texture is never magnified on screen.
+    static std::uint32_t GetDetailLevel(const glm::ivec2& size, const std::uint32_t levelCount, const float pixels) noexcept
+    {
+        const auto largest{ static_cast<float>(std::max(size.x, size.y)) };
+        if (pixels >= largest) return 0u;
+        if (pixels <= 1.0f) return levelCount - 1u;
+
+        return std::min(static_cast<std::uint32_t>(std::log2(largest / pixels)), levelCount - 1u);
+    }
+
+    // Runs on the thread pool, the flip flag is set per thread so the loads on the GL thread are unaffected.
+    static TextureStreamer::DecodedImage DecodeImage(const std::string& filepath, const bool mipmaps) noexcept
+    {
+        const auto startTime{ std::chrono::steady_clock::now() };
+
+        // A converted file only has to be read, its blocks and levels are ready for the GPU.
+        if (const auto compressedPath{ FindCompressedTexture(filepath) }; !compressedPath.empty())
+        {
+            TextureStreamer::DecodedImage image{};
+            if (!ReadDDSFile(compressedPath, image.Levels, mipmaps ? 0u : 1u)) return {};
+
+            image.DecodeTime = Internal::GetElapsed(startTime);
+            return image;
+        }
+
+        stbi_set_flip_vertically_on_load_thread(1);
+
+        int width{}, height{}, channels{};
+        auto* pixels{ stbi_load(filepath.c_str(), &width, &height, &channels, STBI_rgb_alpha) };
+        if (!pixels)
+        {
+            if (stbi_failure_reason())
+                spdlog::error("[stbi_image]: {}: {}", stbi_failure_reason(), filepath);
+            else
+                spdlog::error("[stbi_image]: failed without any reason: {}", filepath);
+
+            return {};
+        }
+
+        TextureStreamer::DecodedImage image{};
+        image.Levels.Generate(pixels, { width, height, }, mipmaps ? 0u : 1u);
+        stbi_image_free(pixels);
+
+        image.DecodeTime = Internal::GetElapsed(startTime);
+        return image;
+    }
+}
+
+TextureStreamer::TextureStreamer(const TextureStreamerProps& props)
+    : m_Props{ props } {}
+
+std::shared_ptr<Texture2D> TextureStreamer::Load(const Texture2DProps& props) noexcept
+{
+    return ResourceCache::Get().Acquire<Texture2D>(Hash::Combine(GetPropsHash(props), Internal::c_StreamedTextureKey), [this, &props]() {
+        return TextureStreamer::Stream(props);
+    });
+}
+
+std::shared_ptr<Texture2D> TextureStreamer::Stream(const Texture2DProps& props) noexcept
+{
+    auto placeholder{ AllocateResource<Texture2D>({
+        .Size      = { 1u, 1u, },
+        .Wrapping  = props.Wrapping,
+        .Filtering = props.Filtering,
+    }) };
+    if (!placeholder->OnInitialize()) return nullptr;
+
+    if (props.Filepath.empty()) return placeholder;
+
+    m_Lookup[placeholder.get()] = m_Textures.size();
+    m_Textures.push_back(StreamedTexture{
+        .Props     = props,
+        .Target    = placeholder,
+        .Decoding  = ThreadPool::GetShared().Submit([filepath = props.Filepath, mipmaps = props.Mipmaps]() {
+            return Internal::DecodeImage(filepath, mipmaps);
+        }),
+        .StartTime = std::chrono::steady_clock::now(),
+    });
+
+    return placeholder;
+}
+
+void TextureStreamer::RequestDetail(const Texture2D* texture, const float pixels) noexcept
+{
+    const auto found{ m_Lookup.find(texture) };
+    if (found == m_Lookup.end()) return;
+
+    auto& streamed{ m_Textures[found->second] };
+    streamed.RequestedPixels  = streamed.LastRequestFrame == m_Frame ? std::max(streamed.RequestedPixels, pixels) : pixels;
+    streamed.LastRequestFrame = m_Frame;
+}
+
+void TextureStreamer::BeginFrame() noexcept
+{
+    auto& statistics{ m_Statistics };
+    statistics.UploadedBytes = 0u;
+    statistics.UploadTime    = 0.0;
+
+    const auto startTime{ std::chrono::steady_clock::now() };
+
+    // Update() may evict levels of any other texture, so the vector must not be reordered while it runs.
+    bool isAnyDropped{ false };
+    for (auto& texture : m_Textures)
+    {
+        texture.IsDropped = !TextureStreamer::Update(texture);
+        isAnyDropped      = isAnyDropped || texture.IsDropped;
+    }
+
+    if (isAnyDropped)
+    {
+        std::erase_if(m_Textures, [](const StreamedTexture& texture) { return texture.IsDropped; });
+
+        m_Lookup.clear();
+        for (std::size_t i = 0u; i < m_Textures.size(); ++i)
+            if (const auto target{ m_Textures[i].Target.lock() }) m_Lookup[target.get()] = i;
+    }
+
+    // Only bites when the budget was lowered, growing never goes beyond it.
+    TextureStreamer::FreeResidentBytes(0u, false);
+
+    std::uint8_t* region{ nullptr };
+    std::size_t regionUsed{ 0u };
+
+    // In the order of the Load() calls, a texture only gets budget once the ones before it are done for the frame.
+    for (auto& texture : m_Textures)
+        if (texture.Pending) TextureStreamer::Upload(texture, region, regionUsed);
+
+    if (region)
+    {
+        m_Staging->Unbind();
+        m_Staging->ReleaseRegion();
+    }
+
+    statistics.Decoding      = static_cast<std::size_t>(std::count_if(m_Textures.begin(), m_Textures.end(), [](const auto& texture) { return !texture.IsDecoded; }));
+    statistics.Uploading     = static_cast<std::size_t>(std::count_if(m_Textures.begin(), m_Textures.end(), [](const auto& texture) { return texture.Pending != nullptr; }));
+    statistics.ResidentBytes = m_ResidentBytes;
+    statistics.UploadTime    = Internal::GetElapsed(startTime);
+
+    ++m_Frame;
+}
+
+bool TextureStreamer::IsIdle() const noexcept
+{
+    return std::none_of(m_Textures.begin(), m_Textures.end(), [](const auto& texture) { return !texture.IsDecoded || texture.Pending; });
+}
+
+bool TextureStreamer::Update(StreamedTexture& texture) noexcept
+{
+    const auto target{ texture.Target.lock() };
+    if (!target)
+    {
+        m_ResidentBytes -= texture.ResidentBytes;
+        return false;
+    }
+
+    if (!texture.IsDecoded)
+    {
+        if (texture.Decoding.wait_for(std::chrono::seconds{ 0 }) != std::future_status::ready) return true;
+
+        // The placeholder stays in place for good when the file cannot be decoded.
+        texture.Image = texture.Decoding.get();
+        if (texture.Image.Levels.IsEmpty()) return false;
+
+        texture.IsDecoded     = true;
+        texture.ResidentLevel = texture.GetLevelCount();
+        texture.DesiredLevel  = m_Props.StreamLevels
+            ? Internal::GetCoarseLevel(texture.Image.Levels.GetSize(0u), texture.GetLevelCount(), Internal::c_InitialSide)
+            : 0u;
+    }
+
+    const auto levelCount{ texture.GetLevelCount() };
+
+    // The draws of the frame that just ended decide how fine the texture should be.
+    if (m_Props.StreamLevels && texture.LastRequestFrame == m_Frame)
+        texture.DesiredLevel = Internal::GetDetailLevel(texture.Image.Levels.GetSize(0u), levelCount, texture.RequestedPixels);
+
+    if (texture.Pending || texture.DesiredLevel >= texture.ResidentLevel) return true;
+
+    // The first change lands on all the coarse levels at once, every further one adds a single level.
+    if (texture.ResidentLevel == levelCount)
+    {
+        const auto level{ m_Props.StreamLevels
+            ? std::max(texture.DesiredLevel, Internal::GetCoarseLevel(texture.Image.Levels.GetSize(0u), levelCount, Internal::c_InitialSide))
+            : 0u };
+
+        TextureStreamer::BeginLevelChange(texture, *target, level);
+        return true;
+    }
+
+    // Only what was drawn last frame grows, the rest keeps its levels until it is evicted.
+    if (texture.LastRequestFrame != m_Frame) return true;
+
+    const auto level{ texture.ResidentLevel - 1u };
+    if (!TextureStreamer::FreeResidentBytes(texture.Image.Levels.GetByteSize(level), true, &texture)) return true;
+
+    TextureStreamer::BeginLevelChange(texture, *target, level);
+    return true;
+}
+
+bool TextureStreamer::BeginLevelChange(StreamedTexture& texture, const Texture2D& target, const std::uint32_t level) noexcept
+{
+    const auto& levels{ texture.Image.Levels };
+    const auto levelCount{ levels.GetLevelCount() };
+
+    auto pending{ AllocateResource<Texture2D>({
+        .Wrapping  = texture.Props.Wrapping,
+        .Filtering = texture.Props.Filtering,
+    }) };
+    if (!pending->AllocateStorage(levels.GetSize(level), levelCount - level, levels.GetFormat()))
+    {
+        spdlog::error("[TextureStreamer]: Failed to allocate {}x{} texture: {}", levels.GetSize(level).x, levels.GetSize(level).y, texture.Props.Filepath);
+        return false;
+    }
+
+    // The resident levels are copied on the GPU, only the finer ones go through the staging buffer.
+    if (texture.ResidentLevel < levelCount)
+        pending->CopyLevels(target, 0u, texture.ResidentLevel - level, levelCount - texture.ResidentLevel);
+
+    texture.Pending      = std::move(pending);
+    texture.PendingLevel = level;
+    texture.UploadLevel  = texture.ResidentLevel - 1u;
+    texture.NextRow      = 0u;
+
+    const auto residentBytes{ levels.GetByteSize(level, levelCount) };
+    m_ResidentBytes += residentBytes - texture.ResidentBytes;
+    texture.ResidentBytes = residentBytes;
+
+    return true;
+}
+
+bool TextureStreamer::EvictLevel(StreamedTexture& texture, Texture2D& target) noexcept
+{
+    const auto& levels{ texture.Image.Levels };
+    const auto levelCount{ levels.GetLevelCount() };
+    const auto level{ texture.ResidentLevel + 1u };
+
+    auto smaller{ AllocateResource<Texture2D>({
+        .Wrapping  = texture.Props.Wrapping,
+        .Filtering = texture.Props.Filtering,
+    }) };
+    if (!smaller->AllocateStorage(levels.GetSize(level), levelCount - level, levels.GetFormat())) return false;
+
+    smaller->CopyLevels(target, 1u, 0u, levelCount - level);
+    target.Swap(*smaller);
+
+    texture.ResidentLevel = level;
+
+    const auto residentBytes{ levels.GetByteSize(level, levelCount) };
+    m_ResidentBytes -= texture.ResidentBytes - residentBytes;
+    texture.ResidentBytes = residentBytes;
+
+    ++m_Statistics.Evictions;
+    return true;
+}
+
+void TextureStreamer::Upload(StreamedTexture& texture, std::uint8_t*& region, std::size_t& regionUsed) noexcept
+{
+    const auto target{ texture.Target.lock() };
+    if (!target) return;
+
+    const auto& levels{ texture.Image.Levels };
+    const auto budget{ std::min(m_Props.UploadBudget, m_Staging->GetRegionSize()) };
+
+    while (texture.Pending)
+    {
+        // Rows of blocks for compressed formats.
+        const auto levelRowCount{ levels.GetRowCount(texture.UploadLevel) };
+        const auto rowSize{ levels.GetRowSize(texture.UploadLevel) };
+
+        const auto remainingRows{ static_cast<std::size_t>(levelRowCount) - texture.NextRow };
+        const auto rowCount{ std::min(remainingRows, (budget - std::min(regionUsed, budget)) / rowSize) };
+        const auto* source{ levels.GetPixels(texture.UploadLevel) + texture.NextRow * rowSize };
+
+        // Levels of the pending texture start at PendingLevel of the chain.
+        const auto level{ texture.UploadLevel - texture.PendingLevel };
+
+        if (rowCount)
+        {
+            if (!region)
+            {
+                region = static_cast<std::uint8_t*>(m_Staging->AcquireRegion());
+                if (!region) return;
+
+                m_Staging->Bind();
+            }
+
+            std::memcpy(region + regionUsed, source, rowCount * rowSize);
+
+            // With the unpack buffer bound the pointer is an offset into it.
+            const auto offset{ m_Staging->GetCurrentOffset() + regionUsed };
+            texture.Pending->SetRows(level, texture.NextRow, static_cast<std::uint32_t>(rowCount), reinterpret_cast<const void*>(offset));
+
+            regionUsed += rowCount * rowSize;
+            texture.NextRow += static_cast<std::uint32_t>(rowCount);
+            m_Statistics.UploadedBytes += rowCount * rowSize;
+        }
+        else if (!regionUsed && rowSize > budget)
+        {
+            // A single row does not fit into the budget, it goes straight from the decoded image so the texture still moves.
+            m_Staging->Unbind();
+            texture.Pending->SetRows(level, texture.NextRow, 1u, source);
+            if (region) m_Staging->Bind();
+
+            regionUsed = budget;
+            texture.NextRow += 1u;
+            m_Statistics.UploadedBytes += rowSize;
+        }
+        else return;
+
+        if (texture.NextRow < levelRowCount) continue;
+
+        if (texture.UploadLevel > texture.PendingLevel)
+        {
+            --texture.UploadLevel;
+            texture.NextRow = 0u;
+            continue;
+        }
+
+        // Draws recorded from now on sample the new levels, the old object goes away with Pending.
+        const auto isFirst{ texture.ResidentLevel == levels.GetLevelCount() };
+
+        target->Swap(*texture.Pending);
+        texture.Pending.reset();
+        texture.ResidentLevel = texture.PendingLevel;
+
+        if (isFirst)
+        {
+            ++m_Statistics.Completed;
+            spdlog::info("[TextureStreamer]: {} ({}x{}) first levels after {:.1f} ms, decoded in {:.1f} ms", texture.Props.Filepath,
+                levels.GetSize(0u).x, levels.GetSize(0u).y, Internal::GetElapsed(texture.StartTime), texture.Image.DecodeTime);
+        }
+    }
+}
+
+bool TextureStreamer::FreeResidentBytes(const std::size_t bytes, const bool unusedOnly, const StreamedTexture* exclude) noexcept
+{
+    const auto isBetterVictim{ [](const StreamedTexture& texture, const StreamedTexture& victim) {
+        const auto isSurplus{ texture.ResidentLevel < texture.DesiredLevel };
+        const auto isVictimSurplus{ victim.ResidentLevel < victim.DesiredLevel };
+        if (isSurplus != isVictimSurplus) return isSurplus;
+        if (texture.LastRequestFrame != victim.LastRequestFrame) return texture.LastRequestFrame < victim.LastRequestFrame;
+
+        return texture.Image.Levels.GetByteSize(texture.ResidentLevel) > victim.Image.Levels.GetByteSize(victim.ResidentLevel);
+    } };
+
+    if (bytes > m_Props.ResidentBudget) return false;
+
+    while (m_ResidentBytes + bytes > m_Props.ResidentBudget)
+    {
+        StreamedTexture* victim{ nullptr };
+        for (auto& texture : m_Textures)
+        {
+            // The coarsest level always stays. An expired texture has nothing to evict, its bytes go with the next Update().
+            if (&texture == exclude || texture.IsDropped || texture.Target.expired() || !texture.IsDecoded || texture.Pending ||
+                texture.ResidentLevel + 1u >= texture.GetLevelCount()) continue;
+            if (unusedOnly && texture.LastRequestFrame == m_Frame && texture.ResidentLevel >= texture.DesiredLevel) continue;
+
+            if (!victim || isBetterVictim(texture, *victim)) victim = &texture;
+        }
+
+        const auto target{ victim ? victim->Target.lock() : nullptr };
+        if (!target || !TextureStreamer::EvictLevel(*victim, *target)) return false;
+    }
+
+    return true;
+}
+
+bool TextureStreamer::OnInitialize() noexcept
+{
+    m_Staging = AllocateResource<RingBuffer>({
+        .RegionSize  = m_Props.UploadBudget,
+        .RegionCount = m_Props.StagingRegions,
+        .Target      = BufferTarget::PixelUnpack,
+    });
+    if (!m_Staging->OnInitialize())
+    {
+        spdlog::error("[TextureStreamer]: Failed to create the staging buffer!");
+        return false;
+    }
+
+    return true;
+}
+
+void TextureStreamer::Bind() const
+{
+    if (m_Staging) m_Staging->Bind();
+}
+
+void TextureStreamer::Unbind() const
+{
+    if (m_Staging) m_Staging->Unbind();
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/Backend/Buffers.hpp"
+#include "Renderer/Backend/Texture2D.hpp"
+#include "Renderer/MipChain.hpp"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+struct TextureStreamerProps
+{
+    // Bytes copied into the staging buffer and uploaded per frame, at least one row of the next image goes through.
+    std::size_t UploadBudget{ 4u * 1024u * 1024u };
+    std::size_t StagingRegions{ 3u };
+
+    // GPU memory of the streamed textures, beyond it the finest levels of the least recently drawn ones are evicted.
+    std::size_t ResidentBudget{ 256u * 1024u * 1024u };
+
+    // Off uploads every level of a texture in one go, on starts with the coarse ones and refines as far as the draws need.
+    bool StreamLevels{ true };
+};
+
+// Counters of the last BeginFrame().
+struct TextureStreamerStatistics
+{
+    std::size_t Decoding{ 0u };  // still on the thread pool
+    std::size_t Uploading{ 0u }; // a level change in flight
+    std::size_t Completed{ 0u }; // since the streamer was created
+
+    std::size_t ResidentBytes{ 0u };
+    std::size_t Evictions{ 0u }; // levels, since the streamer was created
+
+    std::size_t UploadedBytes{ 0u };
+    double UploadTime{ 0.0 }; // ms, CPU side of the copies and the upload calls
+};
+
+/**
+ * Loads image files without stalling the GL thread. Load() hands out a 1x1 white texture right
+ * away, the file is decoded and its mip chain box filtered on the shared thread pool. BeginFrame()
+ * then uploads the levels through a persistently mapped pixel unpack ring, no more than the budget
+ * per frame, and swaps the finished texture into the placeholder. The callers keep the same
+ * Texture2D and just sample the new levels from the next draw on.
+ *
+ * A streamed texture only holds the levels [ResidentLevel, count) of its chain, as its own levels
+ * [0, count - ResidentLevel). It starts with the ones up to 64 texels and moves one level finer at
+ * a time while the drawn size reported through RequestDetail() asks for it. Each move allocates
+ * the larger texture, copies the resident levels over on the GPU and uploads only the new one.
+ * Evicting goes the other way without any upload. The decoded chain stays in memory, so an evicted
+ * level can come back without decoding the file again.
+ *
+ * Decoding always expands to RGBA, the rows are then tightly packed whatever the width. When an up to
+ * date .dds made by the texture compressor sits next to the file, it is read instead: no decoding, no
+ * filtering, and its blocks go up as they are, a row of blocks at a time.
+ */
+class TextureStreamer : public RendererResource<TextureStreamerProps>
+{
+public:
+    explicit TextureStreamer(const TextureStreamerProps& props);
+    ~TextureStreamer() = default;
+
+    // props.Filepath is decoded in the background, the size is taken from the file. Returns nullptr only when the placeholder fails.
+    // Goes through the ResourceCache: a file still held, loaded by any streamer, is handed out again and driven by the streamer that started it.
+    std::shared_ptr<Texture2D> Load(const Texture2DProps& props) noexcept;
+
+    // Screen pixels across the largest object the texture was drawn on this frame, the largest report of the frame wins.
+    void RequestDetail(const Texture2D* texture, const float pixels) noexcept;
+    inline bool IsStreamed(const Texture2D* texture) const noexcept { return texture && m_Lookup.contains(texture); }
+
+    // GL thread, once per frame before the draws. Evicts, picks up the decoded images and uploads within the budget.
+    void BeginFrame() noexcept;
+
+    // Nothing decoding and no level change in flight.
+    bool IsIdle() const noexcept;
+
+    // Never more than the staging regions, which are sized by the budget given at construction.
+    inline void SetUploadBudget(const std::size_t budget) noexcept { m_Props.UploadBudget = budget; }
+    inline auto GetUploadBudget() const noexcept { return m_Props.UploadBudget; }
+
+    inline void SetResidentBudget(const std::size_t budget) noexcept { m_Props.ResidentBudget = budget; }
+    inline auto GetResidentBudget() const noexcept { return m_Props.ResidentBudget; }
+
+    inline const auto& GetStatistics() const noexcept { return m_Statistics; }
+
+public:
+    virtual bool OnInitialize() noexcept override;
+
+public:
+    virtual void Bind() const override;
+    virtual void Unbind() const override;
+
+public:
+    inline virtual RendererID GetResourceHandle() const override { return m_Staging ? m_Staging->GetResourceHandle() : c_EmptyValue<RendererID>; }
+
+public:
+    struct DecodedImage
+    {
+        MipChain Levels{}; // empty when the file could not be decoded
+        double DecodeTime{ 0.0 }; // ms, the filtering included
+    };
+
+private:
+    struct StreamedTexture
+    {
+        Texture2DProps Props{};
+
+        // The placeholder handed out, the texture is dropped once nobody holds it anymore.
+        std::weak_ptr<Texture2D> Target{};
+        std::future<DecodedImage> Decoding{};
+        DecodedImage Image{};
+        bool IsDecoded{ false };
+        bool IsDropped{ false }; // Update() gave up on it, erased at the end of the pass
+
+        // Levels [ResidentLevel, count) are on the GPU, count itself means only the placeholder is.
+        std::uint32_t ResidentLevel{ 0u };
+        std::uint32_t DesiredLevel{ 0u };
+        std::size_t ResidentBytes{ 0u }; // a level change in flight counts with its new size
+
+        float RequestedPixels{ 0.0f };
+        std::uint64_t LastRequestFrame{ 0u };
+
+        // The level change in flight, Pending receives [PendingLevel, count). UploadLevel and NextRow
+        // walk the levels not copied from the resident texture, from the coarsest one down.
+        std::shared_ptr<Texture2D> Pending{};
+        std::uint32_t PendingLevel{ 0u };
+        std::uint32_t UploadLevel{ 0u };
+        std::uint32_t NextRow{ 0u };
+
+        std::chrono::steady_clock::time_point StartTime{};
+
+        inline auto GetLevelCount() const noexcept { return Image.Levels.GetLevelCount(); }
+    };
+
+    // Creates the placeholder and starts decoding, on a cache miss of Load().
+    std::shared_ptr<Texture2D> Stream(const Texture2DProps& props) noexcept;
+
+    // Returns false when the texture is to be dropped, it is gone or its file failed.
+    bool Update(StreamedTexture& texture) noexcept;
+
+    bool BeginLevelChange(StreamedTexture& texture, const Texture2D& target, const std::uint32_t level) noexcept;
+    bool EvictLevel(StreamedTexture& texture, Texture2D& target) noexcept;
+
+    // Uploads rows of the level change until it is done or the region is full. The region is acquired on the first upload of the frame.
+    void Upload(StreamedTexture& texture, std::uint8_t*& region, std::size_t& regionUsed) noexcept;
+
+    /**
+     * Drops the finest levels, one at a time, until bytes more would fit the budget. Textures finer
+     * than they were asked for go first, then the least recently drawn ones. With unusedOnly the
+     * textures drawn last frame are kept at what they asked for. Returns whether the bytes fit.
+     */
+    bool FreeResidentBytes(const std::size_t bytes, const bool unusedOnly, const StreamedTexture* exclude = nullptr) noexcept;
+
+private:
+    TextureStreamerProps m_Props{};
+    std::shared_ptr<RingBuffer> m_Staging{};
+
+    std::vector<StreamedTexture> m_Textures{};
+    std::unordered_map<const Texture2D*, std::size_t> m_Lookup{}; // target to index into m_Textures
+
+    std::uint64_t m_Frame{ 1u };
+    std::size_t m_ResidentBytes{ 0u };
+    TextureStreamerStatistics m_Statistics{};
+};
+
+NAMESPACE_END(Renderer)
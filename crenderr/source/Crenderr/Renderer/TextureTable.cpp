@@ -0,0 +1,293 @@
+#include "TextureTable.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    constexpr std::size_t c_HandleRegionCount{ 3u };
+
+    // ARB_bindless_texture is not part of the generated loader, its few entry points are fetched by hand.
+    struct BindlessFunctions
+    {
+        GLuint64 (APIENTRYP GetTextureHandle)(GLuint texture){ nullptr };
+        void (APIENTRYP MakeTextureHandleResident)(GLuint64 handle){ nullptr };
+        GLboolean (APIENTRYP IsTextureHandleResident)(GLuint64 handle){ nullptr };
+    };
+
+    static BindlessFunctions s_Bindless{};
+
+    static bool LoadBindlessFunctions() noexcept
+    {
+        if (!glfwExtensionSupported("GL_ARB_bindless_texture")) return false;
+
+        s_Bindless.GetTextureHandle          = reinterpret_cast<decltype(s_Bindless.GetTextureHandle)>(glfwGetProcAddress("glGetTextureHandleARB"));
+        s_Bindless.MakeTextureHandleResident = reinterpret_cast<decltype(s_Bindless.MakeTextureHandleResident)>(glfwGetProcAddress("glMakeTextureHandleResidentARB"));
+        s_Bindless.IsTextureHandleResident   = reinterpret_cast<decltype(s_Bindless.IsTextureHandleResident)>(glfwGetProcAddress("glIsTextureHandleResidentARB"));
+
+        return s_Bindless.GetTextureHandle && s_Bindless.MakeTextureHandleResident && s_Bindless.IsTextureHandleResident;
+    }
+}
+
+TextureTable::TextureTable(const TextureTableProps& props)
+    : m_Props{ props } {}
+
+bool TextureTable::SetBindless(const bool enabled) noexcept
+{
+    if (enabled && !m_IsBindlessSupported) return false;
+    if (enabled == m_IsBindless) return true;
+
+    TextureTable::ReleaseAll();
+    m_IsBindless = enabled;
+
+    return true;
+}
+
+TextureSlot TextureTable::Resolve(const Texture2D* texture) noexcept
+{
+    if (!texture || texture->GetResourceHandle() == c_EmptyValue<RendererID>) return {};
+
+    auto& entry{ m_Entries[texture] };
+    entry.LastResolveFrame = m_Frame;
+
+    if (entry.Revision != texture->GetRevision())
+    {
+        const auto isResolved{ m_IsBindless
+            ? TextureTable::AcquireHandle(*texture, entry)
+            : TextureTable::AcquireLayer(*texture, entry) };
+
+        if (!isResolved)
+        {
+            TextureTable::ReleaseEntry(entry);
+            m_Entries.erase(texture);
+            return {};
+        }
+
+        entry.Revision = texture->GetRevision();
+        ++m_Statistics.Copies;
+    }
+
+    return TextureSlot{
+        .Array = entry.ArrayIndex != c_EmptySlot ? m_Arrays[entry.ArrayIndex].Array.get() : nullptr,
+        .Index = entry.Index,
+    };
+}
+
+void TextureTable::BeginFrame() noexcept
+{
+    ++m_Frame;
+    m_Statistics.Copies = 0u;
+
+    for (auto it = m_Entries.begin(); it != m_Entries.end();)
+    {
+        if (it->second.LastResolveFrame + m_Props.ReleaseFrames >= m_Frame)
+        {
+            ++it;
+            continue;
+        }
+
+        TextureTable::ReleaseEntry(it->second);
+        it = m_Entries.erase(it);
+    }
+
+    m_Statistics.Textures   = m_Entries.size();
+    m_Statistics.Arrays     = 0u;
+    m_Statistics.ArrayBytes = 0u;
+
+    for (auto& packed : m_Arrays)
+    {
+        if (packed.Array && packed.FreeLayers.size() == packed.UsedLayers)
+            packed = PackedArray{};
+
+        if (!packed.Array) continue;
+
+        ++m_Statistics.Arrays;
+        m_Statistics.ArrayBytes += packed.Array->GetByteSize();
+    }
+}
+
+void TextureTable::Upload() noexcept
+{
+    if (!m_IsBindless) return;
+
+    auto* region{ static_cast<std::uint64_t*>(m_Handles->AcquireRegion()) };
+    if (!region) return;
+
+    std::memcpy(region, m_HandleValues.data(), m_HandleValues.size() * sizeof(std::uint64_t));
+    m_Handles->Bind();
+}
+
+void TextureTable::EndFrame() noexcept
+{
+    if (m_IsBindless) m_Handles->ReleaseRegion();
+}
+
+bool TextureTable::OnInitialize() noexcept
+{
+    m_IsBindlessSupported = Internal::LoadBindlessFunctions();
+    if (!m_IsBindlessSupported) m_IsBindless = false;
+
+    GLint maxLayers{};
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    m_Props.MaxLayers     = std::clamp(m_Props.MaxLayers, 1u, static_cast<std::uint32_t>(std::max(maxLayers, 1)));
+    m_Props.InitialLayers = std::clamp(m_Props.InitialLayers, 1u, m_Props.MaxLayers);
+
+    m_Handles = AllocateResource<RingBuffer>({
+        .RegionSize  = m_Props.Capacity * sizeof(std::uint64_t),
+        .RegionCount = Internal::c_HandleRegionCount,
+        .Target      = BufferTarget::ShaderStorage,
+        .Binding     = m_Props.Binding,
+    });
+    if (!m_Handles->OnInitialize()) return false;
+
+    TextureTable::ReleaseAll();
+    return true;
+}
+
+void TextureTable::Bind() const
+{
+    m_Handles->Bind();
+}
+
+void TextureTable::Unbind() const
+{
+    m_Handles->Unbind();
+}
+
+bool TextureTable::AcquireLayer(const Texture2D& texture, Entry& entry) noexcept
+{
+    // Changed in place, the layer it has still fits.
+    if (entry.ArrayIndex != c_EmptySlot)
+    {
+        const auto& array{ *m_Arrays[entry.ArrayIndex].Array };
+        if (array.IsCompatible(texture)) return array.CopyLayer(texture, entry.Index);
+
+        TextureTable::ReleaseEntry(entry);
+    }
+
+    auto emptySlot{ c_EmptySlot };
+    for (std::uint32_t i = 0u; i < m_Arrays.size(); ++i)
+    {
+        auto& packed{ m_Arrays[i] };
+        if (!packed.Array)
+        {
+            emptySlot = std::min(emptySlot, i);
+            continue;
+        }
+
+        if (!packed.Array->IsCompatible(texture)) continue;
+
+        if (packed.FreeLayers.empty() && packed.UsedLayers == packed.Array->GetLayerCount())
+        {
+            if (packed.UsedLayers >= m_Props.MaxLayers) continue;
+            if (!packed.Array->Resize(std::min(packed.UsedLayers * 2u, m_Props.MaxLayers))) continue;
+        }
+
+        if (!packed.FreeLayers.empty())
+        {
+            entry.Index = packed.FreeLayers.back();
+            packed.FreeLayers.pop_back();
+        }
+        else entry.Index = packed.UsedLayers++;
+
+        entry.ArrayIndex = i;
+        return packed.Array->CopyLayer(texture, entry.Index);
+    }
+
+    auto array{ std::make_unique<TextureArray>(TextureArrayProps{
+        .Size       = glm::ivec2{ texture.GetSize() },
+        .LevelCount = texture.GetLevelCount(),
+        .LayerCount = m_Props.InitialLayers,
+        .Format     = texture.GetFormat(),
+        .Wrapping   = texture.GetWrapping(),
+        .Filtering  = texture.GetFiltering(),
+    }) };
+    if (!array->OnInitialize()) return false;
+
+    if (emptySlot == c_EmptySlot)
+    {
+        emptySlot = static_cast<std::uint32_t>(m_Arrays.size());
+        m_Arrays.emplace_back();
+    }
+
+    auto& packed{ m_Arrays[emptySlot] };
+    packed.Array      = std::move(array);
+    packed.UsedLayers = 1u;
+    packed.FreeLayers.clear();
+
+    entry.ArrayIndex = emptySlot;
+    entry.Index      = 0u;
+
+    return packed.Array->CopyLayer(texture, entry.Index);
+}
+
+bool TextureTable::AcquireHandle(const Texture2D& texture, Entry& entry) noexcept
+{
+    if (entry.Index == c_EmptySlot)
+    {
+        if (!m_FreeHandles.empty())
+        {
+            entry.Index = m_FreeHandles.back();
+            m_FreeHandles.pop_back();
+        }
+        else if (m_HandleValues.size() < m_Props.Capacity)
+        {
+            entry.Index = static_cast<std::uint32_t>(m_HandleValues.size());
+            m_HandleValues.push_back(0u);
+        }
+        else
+        {
+            spdlog::error("[TextureTable]: Cannot hold more than {} texture handles!", m_Props.Capacity);
+            return false;
+        }
+    }
+
+    // The same texture object always gives the same handle, a new one is only made resident once.
+    const auto handle{ Internal::s_Bindless.GetTextureHandle(texture.GetResourceHandle()) };
+    if (!handle) return false;
+
+    if (!Internal::s_Bindless.IsTextureHandleResident(handle))
+        Internal::s_Bindless.MakeTextureHandleResident(handle);
+
+    m_HandleValues[entry.Index] = handle;
+    return true;
+}
+
+void TextureTable::ReleaseEntry(Entry& entry) noexcept
+{
+    if (entry.Index == c_EmptySlot) return;
+
+    if (entry.ArrayIndex == c_EmptySlot)
+    {
+        // The handle stays resident, it goes away with its texture. An unused entry reads as an empty slot.
+        m_HandleValues[entry.Index] = 0u;
+        m_FreeHandles.push_back(entry.Index);
+    }
+    else
+    {
+        // Emptied arrays are dropped by BeginFrame(), draws recorded this frame may still point at them.
+        m_Arrays[entry.ArrayIndex].FreeLayers.push_back(entry.Index);
+    }
+
+    entry.ArrayIndex = c_EmptySlot;
+    entry.Index      = c_EmptySlot;
+    entry.Revision   = 0u;
+}
+
+void TextureTable::ReleaseAll() noexcept
+{
+    m_Entries.clear();
+    m_Arrays.clear();
+
+    m_HandleValues.clear();
+    m_FreeHandles.clear();
+}
+
+NAMESPACE_END(Renderer)
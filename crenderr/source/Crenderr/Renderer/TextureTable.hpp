@@ -0,0 +1,144 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/Backend/Buffers.hpp"
+#include "Renderer/Backend/Texture2D.hpp"
+#include "Renderer/Backend/TextureArray.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+struct TextureTableProps
+{
+    // Layers of a new array. A full one doubles, up to MaxLayers, before another array of the same kind is started.
+    std::uint32_t InitialLayers{ 4u };
+    std::uint32_t MaxLayers{ 256u };
+
+    // Entries of the bindless handle buffer and its shader storage binding.
+    std::size_t Capacity{ 4096u };
+    std::uint32_t Binding{ 2u };
+
+    // Textures not resolved for this many frames give their layer, or handle entry, back.
+    std::uint64_t ReleaseFrames{ 600u };
+};
+
+// Where the shaders find a texture: a layer of the array bound to the slot's unit, or an entry of the handle buffer.
+struct TextureSlot
+{
+    const TextureArray* Array{ nullptr };
+    std::uint32_t Index{ c_InvalidValue<std::uint32_t> };
+};
+
+struct TextureTableStatistics
+{
+    std::size_t Textures{ 0u };
+    std::size_t Arrays{ 0u };
+    std::size_t ArrayBytes{ 0u };
+
+    // Since the last BeginFrame(), textures new to the table or changed since their last copy.
+    std::size_t Copies{ 0u };
+};
+
+/**
+ * Lets one draw sample different textures per instance. The draws resolve their textures into
+ * indices the instances carry to the shaders, so objects with different textures and materials
+ * go out as one batch as long as the rest of their state matches.
+ *
+ * By default a texture is copied on the GPU into a layer of a GL_TEXTURE_2D_ARRAY holding only
+ * textures of its size, level count, format and sampling. A draw then binds one array per slot
+ * and everything drawn from the same arrays batches. Textures are copied again whenever their
+ * revision changes, e.g. when the streamer swaps in finer levels, which may move them to another
+ * array. Every copy costs GPU memory as large as the texture, arrays are dropped once empty.
+ *
+ * With ARB_bindless_texture the index is an entry of a buffer of texture handles instead. Nothing
+ * is copied and any textures batch, but sampling with a handle that differs within a draw relies
+ * on the driver handling non-uniform handles, which the extension alone does not promise.
+ */
+class TextureTable : public RendererResource<TextureTableProps>
+{
+public:
+    // Index of an empty slot, the shaders sample it as black.
+    static constexpr std::uint32_t c_EmptySlot{ c_InvalidValue<std::uint32_t> };
+
+public:
+    explicit TextureTable(const TextureTableProps& props);
+    ~TextureTable() = default;
+
+    // Whether the context has ARB_bindless_texture, known after OnInitialize().
+    inline bool IsBindlessSupported() const noexcept { return m_IsBindlessSupported; }
+    inline bool IsBindless() const noexcept { return m_IsBindless; }
+
+    // Outside of a frame, switching forgets every resolved texture. Returns false when the extension is missing.
+    bool SetBindless(const bool enabled) noexcept;
+
+    // Between BeginFrame() and Upload(). A texture without storage resolves to an empty slot.
+    TextureSlot Resolve(const Texture2D* texture) noexcept;
+
+    // Releases the textures nobody resolved for a while, once per frame before any Resolve().
+    void BeginFrame() noexcept;
+
+    // Writes the handles into the next region of the ring and binds it, after the last Resolve() of the frame.
+    void Upload() noexcept;
+
+    // Has to be called after the last draw reading the handles of this frame.
+    void EndFrame() noexcept;
+
+    inline const auto& GetStatistics() const noexcept { return m_Statistics; }
+
+public:
+    virtual bool OnInitialize() noexcept override;
+
+public:
+    virtual void Bind() const override;
+    virtual void Unbind() const override;
+
+public:
+    inline virtual RendererID GetResourceHandle() const override { return m_Handles ? m_Handles->GetResourceHandle() : c_EmptyValue<RendererID>; }
+
+private:
+    struct PackedArray
+    {
+        std::unique_ptr<TextureArray> Array{};
+        std::uint32_t UsedLayers{ 0u }; // high water mark, the free ones below it are in FreeLayers
+        std::vector<std::uint32_t> FreeLayers{};
+    };
+
+    struct Entry
+    {
+        std::uint64_t Revision{ 0u };
+        std::uint64_t LastResolveFrame{ 0u };
+
+        // Into m_Arrays, or c_EmptySlot in bindless mode.
+        std::uint32_t ArrayIndex{ c_EmptySlot };
+        std::uint32_t Index{ c_EmptySlot };
+    };
+
+    // Finds a free layer in an array the texture fits, grows one or starts a new one.
+    bool AcquireLayer(const Texture2D& texture, Entry& entry) noexcept;
+    bool AcquireHandle(const Texture2D& texture, Entry& entry) noexcept;
+
+    void ReleaseEntry(Entry& entry) noexcept;
+    void ReleaseAll() noexcept;
+
+private:
+    TextureTableProps m_Props{};
+    bool m_IsBindlessSupported{ false };
+    bool m_IsBindless{ false };
+
+    std::unordered_map<const Texture2D*, Entry> m_Entries{};
+    std::vector<PackedArray> m_Arrays{};
+
+    std::shared_ptr<RingBuffer> m_Handles{};
+    std::vector<std::uint64_t> m_HandleValues{};
+    std::vector<std::uint32_t> m_FreeHandles{};
+
+    std::uint64_t m_Frame{ 1u };
+    TextureTableStatistics m_Statistics{};
+};
+
+NAMESPACE_END(Renderer)
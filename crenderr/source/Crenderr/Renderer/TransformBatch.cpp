@@ -0,0 +1,344 @@
+#include "TransformBatch.hpp"
+
+#include <numbers>
+
+#include <algorithm>
+#include <cmath>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    constexpr float c_DegreesToRadians{ std::numbers::pi_v<float> / 180.0f };
+
+    // Cody-Waite split of pi/2 and the minimax polynomials of sin/cos on [-pi/4, pi/4] (Cephes sinf/cosf).
+    constexpr float c_TwoOverPi{ 0.636619772367581343f };
+    constexpr float c_HalfPi1{ 1.5703125f };
+    constexpr float c_HalfPi2{ 4.837512969970703125e-4f };
+    constexpr float c_HalfPi3{ 7.54978995489188216e-8f };
+
+    constexpr float c_Sin0{ -1.6666654611e-1f };
+    constexpr float c_Sin1{  8.3321608736e-3f };
+    constexpr float c_Sin2{ -1.9515295891e-4f };
+
+    constexpr float c_Cos0{  4.166664568298827e-2f };
+    constexpr float c_Cos1{ -1.388731625493765e-3f };
+    constexpr float c_Cos2{  2.443315711809948e-5f };
+
+    // Columns of T * Rx * Ry * Rz * S, the rotations multiplied out by hand.
+    // Every kernel writes matrix first to output and the following ones stride bytes apart.
+    static void ComposeScalar(const TranslationBatch& batch, std::size_t first, const std::size_t last, std::uint8_t* output, const std::size_t stride) noexcept
+    {
+        for (; first < last; ++first, output += stride)
+        {
+            const auto ax{ batch.RotationX[first] * c_DegreesToRadians };
+            const auto ay{ batch.RotationY[first] * c_DegreesToRadians };
+            const auto az{ batch.RotationZ[first] * c_DegreesToRadians };
+
+            const auto sa{ std::sin(ax) }, ca{ std::cos(ax) };
+            const auto sb{ std::sin(ay) }, cb{ std::cos(ay) };
+            const auto sc{ std::sin(az) }, cc{ std::cos(az) };
+
+            const auto sx{ batch.ScaleX[first] }, sy{ batch.ScaleY[first] }, sz{ batch.ScaleZ[first] };
+
+            auto* matrix{ reinterpret_cast<float*>(output) };
+            matrix[ 0] = cb * cc * sx;
+            matrix[ 1] = (ca * sc + sa * sb * cc) * sx;
+            matrix[ 2] = (sa * sc - ca * sb * cc) * sx;
+            matrix[ 3] = 0.0f;
+
+            matrix[ 4] = -cb * sc * sy;
+            matrix[ 5] = (ca * cc - sa * sb * sc) * sy;
+            matrix[ 6] = (sa * cc + ca * sb * sc) * sy;
+            matrix[ 7] = 0.0f;
+
+            matrix[ 8] = sb * sz;
+            matrix[ 9] = -sa * cb * sz;
+            matrix[10] = ca * cb * sz;
+            matrix[11] = 0.0f;
+
+            matrix[12] = batch.PositionX[first];
+            matrix[13] = batch.PositionY[first];
+            matrix[14] = batch.PositionZ[first];
+            matrix[15] = 1.0f;
+        }
+    }
+
+#if CRENDERR_X86_SIMD
+    static inline void SinCos(const __m128 degrees, __m128& sine, __m128& cosine) noexcept
+    {
+        const auto x{ _mm_mul_ps(degrees, _mm_set1_ps(c_DegreesToRadians)) };
+
+        // Quadrant and the remainder in [-pi/4, pi/4].
+        const auto quadrant{ _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(c_TwoOverPi))) };
+        const auto q{ _mm_cvtepi32_ps(quadrant) };
+
+        auto r{ _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(c_HalfPi1))) };
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(c_HalfPi2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(c_HalfPi3)));
+
+        const auto r2{ _mm_mul_ps(r, r) };
+
+        auto s{ _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(c_Sin2)), _mm_set1_ps(c_Sin1)) };
+        s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(c_Sin0));
+        s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+
+        auto c{ _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(c_Cos2)), _mm_set1_ps(c_Cos1)) };
+        c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(c_Cos0));
+        c = _mm_mul_ps(_mm_mul_ps(c, r2), r2);
+        c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+        // Odd quadrants swap the two, the signs follow the quadrant.
+        const auto one{ _mm_set1_epi32(1) };
+        const auto swap{ _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one)) };
+        const auto sineSign{ _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30)) };
+        const auto cosineSign{ _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), _mm_set1_epi32(2)), 30)) };
+
+        sine   = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sineSign);
+        cosine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosineSign);
+    }
+
+    static void ComposeSSE(const TranslationBatch& batch, std::size_t first, const std::size_t last, std::uint8_t* output, const std::size_t stride) noexcept
+    {
+        for (; first + 4u <= last; first += 4u, output += 4u * stride)
+        {
+            __m128 sa, ca, sb, cb, sc, cc;
+            SinCos(_mm_loadu_ps(&batch.RotationX[first]), sa, ca);
+            SinCos(_mm_loadu_ps(&batch.RotationY[first]), sb, cb);
+            SinCos(_mm_loadu_ps(&batch.RotationZ[first]), sc, cc);
+
+            const auto sx{ _mm_loadu_ps(&batch.ScaleX[first]) };
+            const auto sy{ _mm_loadu_ps(&batch.ScaleY[first]) };
+            const auto sz{ _mm_loadu_ps(&batch.ScaleZ[first]) };
+
+            const auto sbcc{ _mm_mul_ps(sb, cc) };
+            const auto sbsc{ _mm_mul_ps(sb, sc) };
+
+            // columns[j][k] is component k of column j for all four matrices.
+            __m128 columns[4][4]{
+                {
+                    _mm_mul_ps(_mm_mul_ps(cb, cc), sx),
+                    _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ca, sc), _mm_mul_ps(sa, sbcc)), sx),
+                    _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(sa, sc), _mm_mul_ps(ca, sbcc)), sx),
+                    _mm_setzero_ps(),
+                },
+                {
+                    _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(cb, sc)), sy),
+                    _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(ca, cc), _mm_mul_ps(sa, sbsc)), sy),
+                    _mm_mul_ps(_mm_add_ps(_mm_mul_ps(sa, cc), _mm_mul_ps(ca, sbsc)), sy),
+                    _mm_setzero_ps(),
+                },
+                {
+                    _mm_mul_ps(sb, sz),
+                    _mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(sa, cb)), sz),
+                    _mm_mul_ps(_mm_mul_ps(ca, cb), sz),
+                    _mm_setzero_ps(),
+                },
+                {
+                    _mm_loadu_ps(&batch.PositionX[first]),
+                    _mm_loadu_ps(&batch.PositionY[first]),
+                    _mm_loadu_ps(&batch.PositionZ[first]),
+                    _mm_set1_ps(1.0f),
+                },
+            };
+
+            for (std::size_t column = 0u; column < 4u; ++column)
+            {
+                auto& [x, y, z, w]{ columns[column] };
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                _mm_storeu_ps(reinterpret_cast<float*>(output + 0u * stride) + column * 4u, x);
+                _mm_storeu_ps(reinterpret_cast<float*>(output + 1u * stride) + column * 4u, y);
+                _mm_storeu_ps(reinterpret_cast<float*>(output + 2u * stride) + column * 4u, z);
+                _mm_storeu_ps(reinterpret_cast<float*>(output + 3u * stride) + column * 4u, w);
+            }
+        }
+
+        ComposeScalar(batch, first, last, output, stride);
+    }
+
+    CRENDERR_TARGET_AVX2 static inline void SinCos(const __m256 degrees, __m256& sine, __m256& cosine) noexcept
+    {
+        const auto x{ _mm256_mul_ps(degrees, _mm256_set1_ps(c_DegreesToRadians)) };
+
+        const auto quadrant{ _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(c_TwoOverPi))) };
+        const auto q{ _mm256_cvtepi32_ps(quadrant) };
+
+        auto r{ _mm256_fnmadd_ps(q, _mm256_set1_ps(c_HalfPi1), x) };
+        r = _mm256_fnmadd_ps(q, _mm256_set1_ps(c_HalfPi2), r);
+        r = _mm256_fnmadd_ps(q, _mm256_set1_ps(c_HalfPi3), r);
+
+        const auto r2{ _mm256_mul_ps(r, r) };
+
+        auto s{ _mm256_fmadd_ps(r2, _mm256_set1_ps(c_Sin2), _mm256_set1_ps(c_Sin1)) };
+        s = _mm256_fmadd_ps(s, r2, _mm256_set1_ps(c_Sin0));
+        s = _mm256_fmadd_ps(_mm256_mul_ps(s, r2), r, r);
+
+        auto c{ _mm256_fmadd_ps(r2, _mm256_set1_ps(c_Cos2), _mm256_set1_ps(c_Cos1)) };
+        c = _mm256_fmadd_ps(c, r2, _mm256_set1_ps(c_Cos0));
+        c = _mm256_mul_ps(_mm256_mul_ps(c, r2), r2);
+        c = _mm256_add_ps(_mm256_fnmadd_ps(r2, _mm256_set1_ps(0.5f), c), _mm256_set1_ps(1.0f));
+
+        const auto one{ _mm256_set1_epi32(1) };
+        const auto swap{ _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, one), one)) };
+        const auto sineSign{ _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30)) };
+        const auto cosineSign{ _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, one), _mm256_set1_epi32(2)), 30)) };
+
+        sine   = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sineSign);
+        cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosineSign);
+    }
+
+    CRENDERR_TARGET_AVX2 static void ComposeAVX2(const TranslationBatch& batch, std::size_t first, const std::size_t last, std::uint8_t* output, const std::size_t stride) noexcept
+    {
+        for (; first + 8u <= last; first += 8u, output += 8u * stride)
+        {
+            __m256 sa, ca, sb, cb, sc, cc;
+            SinCos(_mm256_loadu_ps(&batch.RotationX[first]), sa, ca);
+            SinCos(_mm256_loadu_ps(&batch.RotationY[first]), sb, cb);
+            SinCos(_mm256_loadu_ps(&batch.RotationZ[first]), sc, cc);
+
+            const auto sx{ _mm256_loadu_ps(&batch.ScaleX[first]) };
+            const auto sy{ _mm256_loadu_ps(&batch.ScaleY[first]) };
+            const auto sz{ _mm256_loadu_ps(&batch.ScaleZ[first]) };
+
+            const auto sbcc{ _mm256_mul_ps(sb, cc) };
+            const auto sbsc{ _mm256_mul_ps(sb, sc) };
+
+            const __m256 columns[4][4]{
+                {
+                    _mm256_mul_ps(_mm256_mul_ps(cb, cc), sx),
+                    _mm256_mul_ps(_mm256_fmadd_ps(ca, sc, _mm256_mul_ps(sa, sbcc)), sx),
+                    _mm256_mul_ps(_mm256_fmsub_ps(sa, sc, _mm256_mul_ps(ca, sbcc)), sx),
+                    _mm256_setzero_ps(),
+                },
+                {
+                    _mm256_mul_ps(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(cb, sc)), sy),
+                    _mm256_mul_ps(_mm256_fmsub_ps(ca, cc, _mm256_mul_ps(sa, sbsc)), sy),
+                    _mm256_mul_ps(_mm256_fmadd_ps(sa, cc, _mm256_mul_ps(ca, sbsc)), sy),
+                    _mm256_setzero_ps(),
+                },
+                {
+                    _mm256_mul_ps(sb, sz),
+                    _mm256_mul_ps(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(sa, cb)), sz),
+                    _mm256_mul_ps(_mm256_mul_ps(ca, cb), sz),
+                    _mm256_setzero_ps(),
+                },
+                {
+                    _mm256_loadu_ps(&batch.PositionX[first]),
+                    _mm256_loadu_ps(&batch.PositionY[first]),
+                    _mm256_loadu_ps(&batch.PositionZ[first]),
+                    _mm256_set1_ps(1.0f),
+                },
+            };
+
+            for (std::size_t column = 0u; column < 4u; ++column)
+            {
+                const auto& [x, y, z, w]{ columns[column] };
+
+                // 4x4 transposes within each 128-bit half, the low half holds matrices 0-3, the high one 4-7.
+                const auto xy0{ _mm256_unpacklo_ps(x, y) }, xy1{ _mm256_unpackhi_ps(x, y) };
+                const auto zw0{ _mm256_unpacklo_ps(z, w) }, zw1{ _mm256_unpackhi_ps(z, w) };
+
+                const __m256 matrices[4]{
+                    _mm256_shuffle_ps(xy0, zw0, 0x44),
+                    _mm256_shuffle_ps(xy0, zw0, 0xEE),
+                    _mm256_shuffle_ps(xy1, zw1, 0x44),
+                    _mm256_shuffle_ps(xy1, zw1, 0xEE),
+                };
+
+                for (std::size_t i = 0u; i < 4u; ++i)
+                {
+                    _mm_storeu_ps(reinterpret_cast<float*>(output + (i + 0u) * stride) + column * 4u, _mm256_castps256_ps128(matrices[i]));
+                    _mm_storeu_ps(reinterpret_cast<float*>(output + (i + 4u) * stride) + column * 4u, _mm256_extractf128_ps(matrices[i], 1));
+                }
+            }
+        }
+
+        ComposeSSE(batch, first, last, output, stride);
+    }
+#endif
+}
+
+void TranslationBatch::Resize(const std::size_t size)
+{
+    for (auto* component : { &PositionX, &PositionY, &PositionZ, &RotationX, &RotationY, &RotationZ })
+        component->resize(size, 0.0f);
+
+    for (auto* component : { &ScaleX, &ScaleY, &ScaleZ })
+        component->resize(size, 1.0f);
+}
+
+void TranslationBatch::Clear() noexcept
+{
+    TranslationBatch::Resize(0u);
+}
+
+void TranslationBatch::Push(const Translation& translation)
+{
+    TranslationBatch::Resize(TranslationBatch::GetSize() + 1u);
+    TranslationBatch::Set(TranslationBatch::GetSize() - 1u, translation);
+}
+
+void TranslationBatch::Set(const std::size_t index, const Translation& translation) noexcept
+{
+    PositionX[index] = translation.Position.x;
+    PositionY[index] = translation.Position.y;
+    PositionZ[index] = translation.Position.z;
+
+    RotationX[index] = translation.Rotation.x;
+    RotationY[index] = translation.Rotation.y;
+    RotationZ[index] = translation.Rotation.z;
+
+    ScaleX[index] = translation.Scale.x;
+    ScaleY[index] = translation.Scale.y;
+    ScaleZ[index] = translation.Scale.z;
+}
+
+Translation TranslationBatch::Get(const std::size_t index) const noexcept
+{
+    return Translation{
+        .Scale    = { ScaleX[index], ScaleY[index], ScaleZ[index], },
+        .Position = { PositionX[index], PositionY[index], PositionZ[index], },
+        .Rotation = { RotationX[index], RotationY[index], RotationZ[index], },
+    };
+}
+
+void ComposeModelMatrices(const TranslationBatch& batch, glm::mat4* output, const std::size_t stride) noexcept
+{
+    ComposeModelMatrices(batch, 0u, batch.GetSize(), output, stride, GetSupportedSimdLevel());
+}
+
+void ComposeModelMatrices(const TranslationBatch& batch, glm::mat4* output, const std::size_t stride, const SimdLevel level) noexcept
+{
+    ComposeModelMatrices(batch, 0u, batch.GetSize(), output, stride, level);
+}
+
+void ComposeModelMatrices(
+    const TranslationBatch& batch,
+    const std::size_t first, const std::size_t count,
+    glm::mat4* output, const std::size_t stride, const SimdLevel level) noexcept
+{
+    auto* bytes{ reinterpret_cast<std::uint8_t*>(output) };
+    const auto last{ std::min(first + count, batch.GetSize()) };
+    if (first >= last) return;
+
+    // Never above what the CPU runs.
+    switch (std::min(level, GetSupportedSimdLevel()))
+    {
+#if CRENDERR_X86_SIMD
+    case SimdLevel::AVX2:
+        Internal::ComposeAVX2(batch, first, last, bytes, stride);
+        return;
+
+    case SimdLevel::SSE:
+        Internal::ComposeSSE(batch, first, last, bytes, stride);
+        return;
+#endif
+
+    default:
+        Internal::ComposeScalar(batch, first, last, bytes, stride);
+        return;
+    }
+}
+
+NAMESPACE_END(Renderer)
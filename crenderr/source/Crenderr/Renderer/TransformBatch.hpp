@@ -0,0 +1,47 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/RendererElements.hpp"
+#include "Renderer/Simd.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+// Structure of arrays version of Translation, one array per component so the kernels load 4 or 8 lanes at once.
+struct TranslationBatch
+{
+    std::vector<float> PositionX{}, PositionY{}, PositionZ{};
+    std::vector<float> RotationX{}, RotationY{}, RotationZ{}; // degrees, like Translation::Rotation
+    std::vector<float> ScaleX{}, ScaleY{}, ScaleZ{};
+
+    inline auto GetSize() const noexcept { return PositionX.size(); }
+
+    void Resize(const std::size_t size);
+    void Clear() noexcept;
+
+    void Push(const Translation& translation);
+    void Set(const std::size_t index, const Translation& translation) noexcept;
+    Translation Get(const std::size_t index) const noexcept;
+};
+
+/**
+ * Same matrices as Translation::ComposeModelMatrix(), T * Rx * Ry * Rz * S, written out in closed
+ * form instead of five 4x4 products. Matrix i goes to output + i * stride bytes, so they can be
+ * written straight into an InstanceData array. The SIMD paths use their own sin/cos, they agree
+ * with the scalar one to about 1e-6 per element.
+ */
+void ComposeModelMatrices(const TranslationBatch& batch, glm::mat4* output, const std::size_t stride = sizeof(glm::mat4)) noexcept;
+void ComposeModelMatrices(const TranslationBatch& batch, glm::mat4* output, const std::size_t stride, const SimdLevel level) noexcept;
+
+// Only the translations [first, first + count), output receives the one at first.
+void ComposeModelMatrices(
+    const TranslationBatch& batch,
+    const std::size_t first, const std::size_t count,
+    glm::mat4* output, const std::size_t stride = sizeof(glm::mat4), const SimdLevel level = GetSupportedSimdLevel()) noexcept;
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,170 @@
+#include "TransformHierarchy.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+NAMESPACE_BEGIN(Renderer)
+
+namespace Internal
+{
+    constexpr inline auto c_NoIndex{ c_InvalidValue<std::uint32_t> };
+
+    template<typename _Ty>
+    static void InsertAt(std::vector<_Ty>& values, const std::size_t position, const _Ty& value)
+    {
+        values.insert(values.begin() + static_cast<std::ptrdiff_t>(position), value);
+    }
+
+    static void InsertAt(TranslationBatch& batch, const std::size_t position, const Translation& translation)
+    {
+        InsertAt(batch.PositionX, position, translation.Position.x);
+        InsertAt(batch.PositionY, position, translation.Position.y);
+        InsertAt(batch.PositionZ, position, translation.Position.z);
+        InsertAt(batch.RotationX, position, translation.Rotation.x);
+        InsertAt(batch.RotationY, position, translation.Rotation.y);
+        InsertAt(batch.RotationZ, position, translation.Rotation.z);
+        InsertAt(batch.ScaleX, position, translation.Scale.x);
+        InsertAt(batch.ScaleY, position, translation.Scale.y);
+        InsertAt(batch.ScaleZ, position, translation.Scale.z);
+    }
+}
+
+void TransformHierarchy::Reserve(const std::size_t count)
+{
+    m_Parents.reserve(count);
+    m_SubtreeSizes.reserve(count);
+    m_WorldMatrices.reserve(count);
+    m_DirtyFlags.reserve(count);
+    m_IndexToHandle.reserve(count);
+    m_HandleToIndex.reserve(count);
+
+    for (auto* component : {
+        &m_LocalTranslations.PositionX, &m_LocalTranslations.PositionY, &m_LocalTranslations.PositionZ,
+        &m_LocalTranslations.RotationX, &m_LocalTranslations.RotationY, &m_LocalTranslations.RotationZ,
+        &m_LocalTranslations.ScaleX,    &m_LocalTranslations.ScaleY,    &m_LocalTranslations.ScaleZ, })
+        component->reserve(count);
+}
+
+void TransformHierarchy::Clear() noexcept
+{
+    m_Parents.clear();
+    m_SubtreeSizes.clear();
+    m_LocalTranslations.Clear();
+    m_WorldMatrices.clear();
+    m_DirtyFlags.clear();
+    m_IndexToHandle.clear();
+    m_HandleToIndex.clear();
+    m_DirtyNodes.clear();
+}
+
+NodeHandle TransformHierarchy::AddNode(const Translation& local, const NodeHandle parent)
+{
+    if (parent != c_NoParent && !IsValid(parent))
+    {
+        spdlog::error("[TransformHierarchy]: Parent node {} does not exist!", parent);
+        return c_NoParent;
+    }
+
+    const auto parentIndex{ parent != c_NoParent ? m_HandleToIndex[parent] : Internal::c_NoIndex };
+    const auto position{ parentIndex != Internal::c_NoIndex
+        ? parentIndex + m_SubtreeSizes[parentIndex]
+        : static_cast<std::uint32_t>(m_Parents.size()) };
+
+    // Everything from the insertion point on moves one slot further, the ancestors all come before it.
+    if (position < m_Parents.size())
+    {
+        for (auto& index : m_Parents)
+            if (index != Internal::c_NoIndex && index >= position) ++index;
+
+        for (auto& index : m_HandleToIndex)
+            if (index >= position) ++index;
+    }
+
+    for (auto ancestor{ parentIndex }; ancestor != Internal::c_NoIndex; ancestor = m_Parents[ancestor])
+        ++m_SubtreeSizes[ancestor];
+
+    const auto handle{ static_cast<NodeHandle>(m_HandleToIndex.size()) };
+    m_HandleToIndex.push_back(position);
+
+    Internal::InsertAt(m_Parents, position, parentIndex);
+    Internal::InsertAt(m_SubtreeSizes, position, 1u);
+    Internal::InsertAt(m_LocalTranslations, position, local);
+    Internal::InsertAt(m_WorldMatrices, position, glm::mat4{ 1.0f });
+    Internal::InsertAt(m_DirtyFlags, position, std::uint8_t{ 0u });
+    Internal::InsertAt(m_IndexToHandle, position, handle);
+
+    TransformHierarchy::MarkDirty(position);
+    return handle;
+}
+
+void TransformHierarchy::SetLocal(const NodeHandle node, const Translation& local) noexcept
+{
+    if (!IsValid(node)) return;
+
+    const auto index{ m_HandleToIndex[node] };
+    m_LocalTranslations.Set(index, local);
+    TransformHierarchy::MarkDirty(index);
+}
+
+Translation TransformHierarchy::GetLocal(const NodeHandle node) const noexcept
+{
+    return IsValid(node) ? m_LocalTranslations.Get(m_HandleToIndex[node]) : Translation{};
+}
+
+NodeHandle TransformHierarchy::GetParent(const NodeHandle node) const noexcept
+{
+    if (!IsValid(node)) return c_NoParent;
+
+    const auto parentIndex{ m_Parents[m_HandleToIndex[node]] };
+    return parentIndex != Internal::c_NoIndex ? m_IndexToHandle[parentIndex] : c_NoParent;
+}
+
+std::size_t TransformHierarchy::Update() noexcept
+{
+    if (m_DirtyNodes.empty()) return 0u;
+
+    m_DirtyIndices.clear();
+    for (const auto node : m_DirtyNodes)
+        m_DirtyIndices.push_back(m_HandleToIndex[node]);
+    m_DirtyNodes.clear();
+
+    // In hierarchy order a dirty ancestor comes first and its range covers the dirty nodes below it.
+    std::sort(m_DirtyIndices.begin(), m_DirtyIndices.end());
+
+    std::size_t updated{ 0u };
+    std::uint32_t coveredEnd{ 0u };
+
+    for (const auto first : m_DirtyIndices)
+    {
+        if (first < coveredEnd) continue;
+
+        const auto last{ first + m_SubtreeSizes[first] };
+        ComposeModelMatrices(m_LocalTranslations, first, last - first, &m_WorldMatrices[first]);
+
+        // Parents come before their children, so each one is already final when its children read it.
+        for (auto i{ first }; i < last; ++i)
+        {
+            const auto parent{ m_Parents[i] };
+            if (parent != Internal::c_NoIndex)
+                m_WorldMatrices[i] = m_WorldMatrices[parent] * m_WorldMatrices[i];
+
+            m_DirtyFlags[i] = 0u;
+        }
+
+        updated   += last - first;
+        coveredEnd = last;
+    }
+
+    return updated;
+}
+
+void TransformHierarchy::MarkDirty(const std::uint32_t index) noexcept
+{
+    if (m_DirtyFlags[index]) return;
+
+    m_DirtyFlags[index] = 1u;
+    m_DirtyNodes.push_back(m_IndexToHandle[index]);
+}
+
+NAMESPACE_END(Renderer)
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "RendererCore.hpp"
+
+#include "Renderer/RendererElements.hpp"
+#include "Renderer/TransformBatch.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+NAMESPACE_BEGIN(Renderer)
+
+// Stays the same for the node's lifetime, unlike its position in the arrays.
+using NodeHandle = std::uint32_t;
+
+/**
+ * Parent/child transforms kept in flat arrays sorted in depth first order, so every parent comes
+ * before its children and a node's subtree is the contiguous range [index, index + subtree size).
+ * SetLocal() only marks the node dirty, Update() recomposes the dirty subtrees in a single forward
+ * pass and leaves everything else alone. The world matrices are one contiguous array that can be
+ * handed to the renderer's instanced draws as is.
+ */
+class TransformHierarchy
+{
+public:
+    static constexpr NodeHandle c_NoParent{ c_InvalidValue<NodeHandle> };
+
+public:
+    TransformHierarchy() = default;
+    ~TransformHierarchy() = default;
+
+    void Reserve(const std::size_t count);
+    void Clear() noexcept;
+
+    /**
+     * The node goes at the end of its parent's subtree. Building the tree depth first only ever
+     * appends, adding to a subtree that is already followed by other nodes shifts all of them.
+     * Returns c_NoParent when the parent does not exist.
+     */
+    NodeHandle AddNode(const Translation& local, const NodeHandle parent = c_NoParent);
+
+    void SetLocal(const NodeHandle node, const Translation& local) noexcept;
+    Translation GetLocal(const NodeHandle node) const noexcept;
+
+    NodeHandle GetParent(const NodeHandle node) const noexcept;
+
+    // Recomputes the world matrices of the dirty nodes and everything below them, returns how many it touched.
+    std::size_t Update() noexcept;
+
+public:
+    // Valid after the last Update().
+    inline const auto& GetWorldMatrix(const NodeHandle node) const noexcept { return m_WorldMatrices[m_HandleToIndex[node]]; }
+
+    // All of them in hierarchy order, GetIndex() tells where a node is.
+    inline std::span<const glm::mat4> GetWorldMatrices() const noexcept { return m_WorldMatrices; }
+
+    // Its subtree in the world matrix array.
+    inline std::span<const glm::mat4> GetWorldMatrices(const NodeHandle node) const noexcept
+    {
+        const auto index{ m_HandleToIndex[node] };
+        return std::span<const glm::mat4>{ m_WorldMatrices }.subspan(index, m_SubtreeSizes[index]);
+    }
+
+    inline auto GetIndex(const NodeHandle node) const noexcept { return m_HandleToIndex[node]; }
+    inline auto GetSize() const noexcept { return m_Parents.size(); }
+    inline auto IsValid(const NodeHandle node) const noexcept { return node < m_HandleToIndex.size(); }
+
+private:
+    void MarkDirty(const std::uint32_t index) noexcept;
+
+private:
+    // Indexed by the position in hierarchy order.
+    std::vector<std::uint32_t> m_Parents{};
+    std::vector<std::uint32_t> m_SubtreeSizes{}; // the node itself included
+    TranslationBatch m_LocalTranslations{};
+    std::vector<glm::mat4> m_WorldMatrices{};
+    std::vector<std::uint8_t> m_DirtyFlags{};
+    std::vector<NodeHandle> m_IndexToHandle{};
+
+    std::vector<std::uint32_t> m_HandleToIndex{};
+
+    // Handles, indices move when nodes are inserted.
+    std::vector<NodeHandle> m_DirtyNodes{};
+    std::vector<std::uint32_t> m_DirtyIndices{};
+};
+
+NAMESPACE_END(Renderer)
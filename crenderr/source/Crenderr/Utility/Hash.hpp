@@ -0,0 +1,49 @@
+#pragma once
+
+#include "NonConstructible.hpp"
+
+#include <type_traits>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Source: http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ */
+class Hash : public NonConstructible
+{
+public:
+    using ValueType = std::uint64_t;
+
+    static constexpr ValueType c_OffsetBasis{ 14695981039346656037ull };
+    static constexpr ValueType c_Prime{ 1099511628211ull };
+
+public:
+    static constexpr ValueType FNV1a(const std::string_view data, ValueType hash = c_OffsetBasis) noexcept
+    {
+        for (const auto byte : data)
+        {
+            hash ^= static_cast<std::uint8_t>(byte);
+            hash *= c_Prime;
+        }
+
+        return hash;
+    }
+
+    static inline ValueType FNV1a(const void* data, const std::size_t size, const ValueType hash = c_OffsetBasis) noexcept
+    {
+        return Hash::FNV1a(std::string_view{ static_cast<const char*>(data), size }, hash);
+    }
+
+    template<typename _Ty>
+    static inline ValueType FNV1aValue(const _Ty& value, const ValueType hash = c_OffsetBasis) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<_Ty>, "Only trivially copyable values can be hashed bytewise!");
+        return Hash::FNV1a(&value, sizeof(_Ty), hash);
+    }
+
+    static constexpr ValueType Combine(const ValueType seed, const ValueType value) noexcept
+    {
+        return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6u) + (seed >> 2u));
+    }
+};
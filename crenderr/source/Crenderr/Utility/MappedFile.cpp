@@ -0,0 +1,174 @@
+#include "MappedFile.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+static bool ReadWholeFile(const std::string& filepath, std::string& buffer) noexcept
+{
+    std::ifstream file{ filepath, std::ios::binary | std::ios::ate };
+    if (!file.is_open()) return false;
+
+    const auto size{ static_cast<std::size_t>(file.tellg()) };
+    file.seekg(0, std::ios::beg);
+
+    buffer.resize(size);
+    return static_cast<bool>(file.read(buffer.data(), static_cast<std::streamsize>(size)));
+}
+
+MappedFile::MappedFile(const std::string_view filepath) noexcept
+{
+    MappedFile::Open(filepath);
+}
+
+MappedFile::~MappedFile()
+{
+    MappedFile::Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    MappedFile::Swap(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        MappedFile::Close();
+        MappedFile::Swap(other);
+    }
+
+    return *this;
+}
+
+bool MappedFile::Open(const std::string_view filepath) noexcept
+{
+    MappedFile::Close();
+
+    const std::string path{ filepath };
+
+#ifdef _WIN32
+
+    HANDLE file{ CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    if (size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return (m_IsEmpty = true);
+    }
+
+    HANDLE mapping{ CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+    CloseHandle(file);
+
+    if (mapping)
+    {
+        if (const auto view{ MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) })
+        {
+            m_Data    = static_cast<const char*>(view);
+            m_Size    = static_cast<std::size_t>(size.QuadPart);
+            m_Mapping = mapping;
+            return true;
+        }
+
+        CloseHandle(mapping);
+    }
+
+#else
+
+    const int file{ ::open(path.c_str(), O_RDONLY) };
+    if (file < 0) return false;
+
+    struct stat info{};
+    if (::fstat(file, &info) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    if (info.st_size == 0)
+    {
+        ::close(file);
+        return (m_IsEmpty = true);
+    }
+
+    const auto size{ static_cast<std::size_t>(info.st_size) };
+    void* view{ ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) };
+    ::close(file);
+
+    if (view != MAP_FAILED)
+    {
+        ::madvise(view, size, MADV_SEQUENTIAL);
+
+        m_Data    = static_cast<const char*>(view);
+        m_Size    = size;
+        m_Mapping = view;
+        return true;
+    }
+
+#endif
+
+    spdlog::warn("[MappedFile]: Failed to map the file, reading it instead: {}", path);
+
+    if (!ReadWholeFile(path, m_Buffer)) return false;
+
+    m_Data = m_Buffer.data();
+    m_Size = m_Buffer.size();
+    return true;
+}
+
+void MappedFile::Close() noexcept
+{
+    if (m_Mapping)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_Data);
+        CloseHandle(static_cast<HANDLE>(m_Mapping));
+#else
+        ::munmap(m_Mapping, m_Size);
+#endif
+    }
+
+    m_Data    = nullptr;
+    m_Size    = 0u;
+    m_IsEmpty = false;
+    m_Mapping = nullptr;
+    m_Buffer  = {};
+}
+
+void MappedFile::Swap(MappedFile& other) noexcept
+{
+    std::swap(m_Data, other.m_Data);
+    std::swap(m_Size, other.m_Size);
+    std::swap(m_IsEmpty, other.m_IsEmpty);
+    std::swap(m_Buffer, other.m_Buffer);
+    std::swap(m_Mapping, other.m_Mapping);
+
+    // The fallback buffer owns the data, so the pointers have to follow it.
+    if (!m_Mapping && !m_Buffer.empty()) m_Data = m_Buffer.data();
+    if (!other.m_Mapping && !other.m_Buffer.empty()) other.m_Data = other.m_Buffer.data();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "NonCopyable.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <string>
+
+/**
+ * Read-only view of a whole file. Uses the OS memory mapping facilities where
+ * available and falls back to reading the file in one large block otherwise.
+ */
+class MappedFile : public NonCopyable<MappedFile>
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string_view filepath) noexcept;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+public:
+    bool Open(const std::string_view filepath) noexcept;
+    void Close() noexcept;
+
+public:
+    inline const char* GetData() const noexcept { return m_Data; }
+    inline std::size_t GetSize() const noexcept { return m_Size; }
+    inline std::string_view GetView() const noexcept { return { m_Data, m_Size }; }
+
+    inline bool IsOpen() const noexcept { return m_Data != nullptr || m_IsEmpty; }
+    inline operator bool() const noexcept { return MappedFile::IsOpen(); }
+
+private:
+    void Swap(MappedFile& other) noexcept;
+
+private:
+    const char* m_Data{ nullptr };
+    std::size_t m_Size{ 0u };
+    bool m_IsEmpty{ false };
+
+    // Set when the file could not be mapped and was read into m_Buffer instead.
+    std::string m_Buffer{};
+
+    void* m_Mapping{ nullptr };
+};
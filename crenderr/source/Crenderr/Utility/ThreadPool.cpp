@@ -0,0 +1,127 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+ThreadPool& ThreadPool::GetShared() noexcept
+{
+    static ThreadPool s_SharedPool{};
+    return s_SharedPool;
+}
+
+std::size_t ThreadPool::GetHardwareThreadCount() noexcept
+{
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1u);
+}
+
+ThreadPool::ThreadPool(const std::size_t threadCount) noexcept
+{
+    m_Workers.reserve(threadCount);
+    for (std::size_t i = 0u; i < threadCount; ++i)
+        m_Workers.emplace_back([this]() { ThreadPool::WorkerLoop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{ m_Mutex };
+        m_Stopping = true;
+    }
+
+    m_Condition.notify_all();
+    for (auto& worker : m_Workers) worker.join();
+}
+
+void ThreadPool::ParallelFor(const std::size_t count, const std::function<void(std::size_t)>& function)
+{
+    if (count == 0u) return;
+
+    struct SharedState
+    {
+        std::function<void(std::size_t)> Function;
+        std::size_t Count{ 0u };
+
+        std::atomic<std::size_t> Next{ 0u };
+        std::atomic<std::size_t> Done{ 0u };
+
+        std::mutex Mutex{};
+        std::condition_variable Finished{};
+        std::exception_ptr Exception{}; // the first one thrown, guarded by Mutex
+    };
+
+    // Helpers may start after the loop is already finished, so they must not reference the stack.
+    auto state{ std::make_shared<SharedState>() };
+    state->Function = function;
+    state->Count    = count;
+
+    const auto run{ [state]() {
+        for (auto index{ state->Next++ }; index < state->Count; index = state->Next++)
+        {
+            // A throwing index still counts as done, otherwise the caller would wait forever.
+            try
+            {
+                state->Function(index);
+            }
+            catch (...)
+            {
+                std::lock_guard lock{ state->Mutex };
+                if (!state->Exception) state->Exception = std::current_exception();
+            }
+
+            if (++state->Done == state->Count)
+            {
+                std::lock_guard lock{ state->Mutex };
+                state->Finished.notify_all();
+            }
+        }
+    } };
+
+    const auto helperCount{ std::min(count - 1u, m_Workers.size()) };
+    for (std::size_t i = 0u; i < helperCount; ++i)
+        ThreadPool::Enqueue(Task{ run });
+
+    run();
+
+    std::unique_lock lock{ state->Mutex };
+    state->Finished.wait(lock, [&state]() { return state->Done == state->Count; });
+
+    if (state->Exception) std::rethrow_exception(state->Exception);
+}
+
+void ThreadPool::Enqueue(Task&& task)
+{
+    // A pool without workers degrades to running everything on the calling thread.
+    if (m_Workers.empty())
+    {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard lock{ m_Mutex };
+        m_Tasks.push_back(std::move(task));
+    }
+
+    m_Condition.notify_one();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        Task task{};
+
+        {
+            std::unique_lock lock{ m_Mutex };
+            m_Condition.wait(lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+
+            if (m_Stopping && m_Tasks.empty()) return;
+
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+        }
+
+        task();
+    }
+}
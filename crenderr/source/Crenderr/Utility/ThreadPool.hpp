@@ -0,0 +1,62 @@
+#pragma once
+
+#include "NonCopyable.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+class ThreadPool : public NonCopyable<ThreadPool>
+{
+public:
+    using Task = std::function<void()>;
+
+public:
+    // Pool shared by the whole framework, sized to the hardware concurrency.
+    static ThreadPool& GetShared() noexcept;
+
+    static std::size_t GetHardwareThreadCount() noexcept;
+
+public:
+    explicit ThreadPool(std::size_t threadCount = ThreadPool::GetHardwareThreadCount()) noexcept;
+    ~ThreadPool();
+
+public:
+    template<typename _Fn>
+    inline auto Submit(_Fn&& function) -> std::future<std::invoke_result_t<_Fn>>
+    {
+        using ResultType = std::invoke_result_t<_Fn>;
+
+        auto task{ std::make_shared<std::packaged_task<ResultType()>>(std::forward<_Fn>(function)) };
+        auto future{ task->get_future() };
+
+        ThreadPool::Enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+    /**
+     * Calls function(index) for every index in [0, count) and blocks until all of them return.
+     * The calling thread takes part in the work, so it is safe to call this from within a task.
+     * If any call throws, the rest still run and the first exception is rethrown here afterwards.
+     */
+    void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& function);
+
+    inline std::size_t GetThreadCount() const noexcept { return m_Workers.size(); }
+
+private:
+    void Enqueue(Task&& task);
+    void WorkerLoop();
+
+private:
+    std::vector<std::thread> m_Workers{};
+    std::deque<Task> m_Tasks{};
+
+    std::mutex m_Mutex{};
+    std::condition_variable m_Condition{};
+    bool m_Stopping{ false };
+};
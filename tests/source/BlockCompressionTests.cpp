@@ -0,0 +1,332 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/BlockCompression.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    constexpr int c_BlockSide{ 4 };
+    constexpr int c_BlockTexels{ c_BlockSide * c_BlockSide };
+
+    // One decoded block, row major RGBA.
+    using Texel = std::array<int, 4u>;
+    using Block = std::array<Texel, c_BlockTexels>;
+
+    enum class ImageKind
+    {
+        Gradient,
+        Solid,
+        Cutout,
+        Random,
+    };
+
+    /**
+     * How far a round trip may be off, per format. The largest channel difference of a texel on the images
+     * with a structure, the gradient is one line through color space in every block, and the root mean
+     * square one on random texels, where every encoder has to give up something.
+     */
+    struct ErrorBound
+    {
+        Renderer::TextureFormat Format{};
+        int Gradient{ 0 };
+        int Solid{ 0 };
+        int Cutout{ 0 };
+        float Random{ 0.0f };
+    };
+
+    struct RoundTripError
+    {
+        int Max{ 0 };
+        float RootMeanSquare{ 0.0f };
+    };
+
+    static std::uint64_t ReadBits(const std::uint8_t* block, const std::size_t byteCount) noexcept
+    {
+        std::uint64_t bits{ 0u };
+        for (std::size_t i = 0u; i < byteCount; ++i) bits |= static_cast<std::uint64_t>(block[i]) << (8u * i);
+        return bits;
+    }
+
+    static Texel Unpack565(const unsigned color) noexcept
+    {
+        const auto r{ static_cast<int>((color >> 11u) & 31u) }, g{ static_cast<int>((color >> 5u) & 63u) }, b{ static_cast<int>(color & 31u) };
+        return Texel{ (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 255 };
+    }
+
+    /**
+     * The color block as the GPU reads it. color0 > color1 is the four color mode, anything else has
+     * the midpoint and transparent black. Inside BC3 the block is always four colors.
+     */
+    static bool IsFourColorBlock(const std::uint8_t* block) noexcept
+    {
+        return ReadBits(block, 2u) > ReadBits(block + 2u, 2u);
+    }
+
+    static void DecodeBC1(const std::uint8_t* block, const bool isAlwaysFourColor, Block& texels) noexcept
+    {
+        const auto color0{ Internal::Unpack565(static_cast<unsigned>(ReadBits(block, 2u))) };
+        const auto color1{ Internal::Unpack565(static_cast<unsigned>(ReadBits(block + 2u, 2u))) };
+        const auto isFourColor{ isAlwaysFourColor || Internal::IsFourColorBlock(block) };
+
+        std::array<Texel, 4u> palette{ color0, color1, Texel{ 0, 0, 0, 0 }, Texel{ 0, 0, 0, 0 } };
+        for (std::size_t channel = 0u; channel < 3u; ++channel)
+        {
+            if (isFourColor)
+            {
+                palette[2][channel] = (2 * color0[channel] + color1[channel]) / 3;
+                palette[3][channel] = (color0[channel] + 2 * color1[channel]) / 3;
+            }
+            else palette[2][channel] = (color0[channel] + color1[channel]) / 2;
+        }
+        palette[2][3] = 255;
+        palette[3][3] = isFourColor ? 255 : 0;
+
+        const auto indices{ ReadBits(block + 4u, 4u) };
+        for (int i = 0; i < c_BlockTexels; ++i) texels[i] = palette[(indices >> (2u * i)) & 3u];
+    }
+
+    // 8 values between the two endpoints when the first is larger, otherwise 6 and the ends of the range.
+    static void DecodeBC4(const std::uint8_t* block, const std::size_t channel, Block& texels) noexcept
+    {
+        const int value0{ block[0] }, value1{ block[1] };
+
+        std::array<int, 8u> palette{ value0, value1 };
+        for (int i = 2; i < 8; ++i)
+        {
+            if (value0 > value1) palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
+            else palette[i] = i < 6 ? ((6 - i) * value0 + (i - 1) * value1) / 5 : (i == 6 ? 0 : 255);
+        }
+
+        const auto indices{ ReadBits(block + 2u, 6u) };
+        for (int i = 0; i < c_BlockTexels; ++i) texels[i][channel] = palette[(indices >> (3u * i)) & 7u];
+    }
+
+    /**
+     * Mode 6 only: the mode as 6 zero bits and a one, 7 bits per endpoint channel in R0 R1 G0 G1 B0 B1 A0 A1
+     * order, a parity bit under each endpoint, then 4 bit indices with the top bit of the first one implied
+     * zero. Any other mode is a failure, the encoder never writes one.
+     */
+    static bool DecodeBC7(const std::uint8_t* block, Block& texels) noexcept
+    {
+        constexpr int c_Weights[16]{ 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        std::size_t position{ 0u };
+        const auto read{ [&](const std::size_t count) {
+            unsigned value{ 0u };
+            for (std::size_t i = 0u; i < count; ++i, ++position)
+                value |= static_cast<unsigned>((block[position / 8u] >> (position % 8u)) & 1u) << i;
+            return value;
+        } };
+
+        if (read(7u) != 1u << 6u) return false;
+
+        std::array<Texel, 2u> endpoints{};
+        for (std::size_t channel = 0u; channel < 4u; ++channel)
+            for (auto& endpoint : endpoints) endpoint[channel] = static_cast<int>(read(7u));
+
+        for (auto& endpoint : endpoints)
+        {
+            const auto parity{ static_cast<int>(read(1u)) };
+            for (auto& value : endpoint) value = (value << 1) | parity;
+        }
+
+        for (int i = 0; i < c_BlockTexels; ++i)
+        {
+            const auto weight{ c_Weights[read(i == 0 ? 3u : 4u)] };
+            for (std::size_t channel = 0u; channel < 4u; ++channel)
+                texels[i][channel] = ((64 - weight) * endpoints[0][channel] + weight * endpoints[1][channel] + 32) >> 6;
+        }
+
+        return position == 128u;
+    }
+
+    static std::vector<std::uint8_t> CreateImage(const ImageKind kind, const glm::ivec2& size, std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> value{ 0, 255 };
+
+        // Odd in every channel, so the endpoints of BC7 share their parity and come out exact.
+        const Texel base{ value(random) | 1, value(random) | 1, value(random) | 1, 255 };
+
+        std::vector<std::uint8_t> pixels(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4u);
+        for (int y = 0; y < size.y; ++y)
+        {
+            for (int x = 0; x < size.x; ++x)
+            {
+                auto* texel{ pixels.data() + (static_cast<std::size_t>(y) * size.x + x) * 4u };
+
+                // A ramp along x + y on every channel at once, one line through color space per block.
+                const auto step{ x + y };
+                for (std::size_t channel = 0u; channel < 4u; ++channel)
+                {
+                    switch (kind)
+                    {
+                    case ImageKind::Gradient:
+                        texel[channel] = static_cast<std::uint8_t>(channel == 3u ? 255 - 8 * step : 20 + (channel + 1u) * 4u * step);
+                        break;
+                    case ImageKind::Solid:
+                        texel[channel] = static_cast<std::uint8_t>(base[channel]);
+                        break;
+                    case ImageKind::Cutout:
+                        texel[channel] = static_cast<std::uint8_t>(channel == 3u ? ((x / 2 + y) % 3 ? 255 : 0) : 20 + (channel + 1u) * 4u * step);
+                        break;
+                    case ImageKind::Random:
+                        texel[channel] = static_cast<std::uint8_t>(value(random));
+                        break;
+                    }
+                }
+            }
+        }
+
+        return pixels;
+    }
+
+    /**
+     * Decodes every block of the image and compares the texels inside it in the channels the format keeps.
+     * False when a block is not what the format asks for: BC1 with a transparent texel in four color mode or
+     * an opaque one in the mode with transparent black, a texel with the wrong one bit alpha, a BC7 block in
+     * another mode.
+     */
+    static bool RoundTrip(const std::vector<std::uint8_t>& pixels, const glm::ivec2& size, const Renderer::TextureFormat format, RoundTripError& error)
+    {
+        std::vector<std::uint8_t> blocks(Renderer::GetFormatImageSize(format, size));
+        Renderer::CompressImage(pixels.data(), size, format, blocks.data());
+
+        const auto blockSize{ Renderer::GetFormatRowSize(format, c_BlockSide) };
+        const auto blocksPerRow{ (size.x + c_BlockSide - 1) / c_BlockSide };
+        const auto isBC1{ format == Renderer::TextureFormat::BC1 };
+
+        error = RoundTripError{};
+        double squareSum{ 0.0 };
+        std::size_t valueCount{ 0u };
+
+        for (int blockY = 0; blockY < static_cast<int>(Renderer::GetFormatRowCount(format, size.y)); ++blockY)
+        {
+            for (int blockX = 0; blockX < blocksPerRow; ++blockX)
+            {
+                const auto* block{ blocks.data() + (static_cast<std::size_t>(blockY) * blocksPerRow + blockX) * blockSize };
+
+                Block texels{};
+                std::size_t channelCount{ 4u };
+
+                switch (format)
+                {
+                case Renderer::TextureFormat::BC1:
+                    Internal::DecodeBC1(block, false, texels);
+                    channelCount = 3u;
+                    break;
+                case Renderer::TextureFormat::BC3:
+                    Internal::DecodeBC1(block + 8u, true, texels);
+                    Internal::DecodeBC4(block, 3u, texels);
+                    break;
+                case Renderer::TextureFormat::BC5:
+                    Internal::DecodeBC4(block, 0u, texels);
+                    Internal::DecodeBC4(block + 8u, 1u, texels);
+                    channelCount = 2u;
+                    break;
+                case Renderer::TextureFormat::BC7:
+                    if (!Internal::DecodeBC7(block, texels))
+                    {
+                        spdlog::error("[Tests]:   block {}, {} is not in mode 6", blockX, blockY);
+                        return false;
+                    }
+                    break;
+                default:
+                    return false;
+                }
+
+                bool hasTransparent{ false };
+                for (int y = 0; y < c_BlockSide && blockY * c_BlockSide + y < size.y; ++y)
+                {
+                    for (int x = 0; x < c_BlockSide && blockX * c_BlockSide + x < size.x; ++x)
+                    {
+                        const auto* source{ pixels.data() + (static_cast<std::size_t>(blockY * c_BlockSide + y) * size.x + blockX * c_BlockSide + x) * 4u };
+                        const auto& texel{ texels[y * c_BlockSide + x] };
+
+                        // BC1 keeps one bit of alpha and no color under the transparent texels.
+                        if (isBC1)
+                        {
+                            const auto isTransparent{ source[3] < 128u };
+                            if (texel[3] != (isTransparent ? 0 : 255))
+                            {
+                                spdlog::error("[Tests]:   texel {}, {} has alpha {} for {}", blockX * c_BlockSide + x, blockY * c_BlockSide + y, texel[3], source[3]);
+                                return false;
+                            }
+
+                            hasTransparent |= isTransparent;
+                            if (isTransparent) continue;
+                        }
+
+                        for (std::size_t channel = 0u; channel < channelCount; ++channel)
+                        {
+                            const auto difference{ std::abs(texel[channel] - static_cast<int>(source[channel])) };
+                            error.Max = std::max(error.Max, difference);
+                            squareSum += static_cast<double>(difference * difference);
+                            ++valueCount;
+                        }
+                    }
+                }
+
+                // Equal endpoints read as the three color mode, the encoder only uses the first entry then.
+                if (isBC1 && Internal::IsFourColorBlock(block) == hasTransparent && ReadBits(block, 2u) != ReadBits(block + 2u, 2u))
+                {
+                    spdlog::error("[Tests]:   block {}, {} has its endpoints the wrong way round", blockX, blockY);
+                    return false;
+                }
+            }
+        }
+
+        error.RootMeanSquare = valueCount ? static_cast<float>(std::sqrt(squareSum / static_cast<double>(valueCount))) : 0.0f;
+        return true;
+    }
+}
+
+void TestBlockCompression()
+{
+    using Renderer::TextureFormat;
+
+    std::mt19937 random{ 42u };
+
+    // A single block, a few, and an odd size with blocks reaching past the right and bottom edge.
+    constexpr glm::ivec2 c_Sizes[]{ { 4, 4 }, { 8, 8 }, { 7, 5 } };
+
+    /**
+     * A block of the gradient spans 7 steps of up to 12 per channel. BC1 has 4 entries on 565 endpoints for
+     * them, BC4 8 exact ones, BC7 16 on 7 bit endpoints with a parity shared by the channels. The cutout has
+     * its alpha on the same line in BC7, far off the color ramp. Random texels decoded from the wrong bits
+     * would be around 104 off.
+     */
+    constexpr Internal::ErrorBound c_Bounds[]{
+        { .Format = TextureFormat::BC1, .Gradient = 16, .Solid = 4, .Cutout = 16, .Random = 56.0f, },
+        { .Format = TextureFormat::BC3, .Gradient = 16, .Solid = 4, .Cutout = 16, .Random = 56.0f, },
+        { .Format = TextureFormat::BC5, .Gradient =  4, .Solid = 0, .Cutout =  4, .Random = 12.0f, },
+        { .Format = TextureFormat::BC7, .Gradient =  4, .Solid = 0, .Cutout = 40, .Random = 64.0f, },
+    };
+
+    for (const auto& bound : c_Bounds)
+    {
+        for (const auto& size : c_Sizes)
+        {
+            Internal::RoundTripError error{};
+
+            TEST_CHECK(Internal::RoundTrip(Internal::CreateImage(Internal::ImageKind::Gradient, size, random), size, bound.Format, error));
+            TEST_CHECK(error.Max <= bound.Gradient);
+
+            TEST_CHECK(Internal::RoundTrip(Internal::CreateImage(Internal::ImageKind::Solid, size, random), size, bound.Format, error));
+            TEST_CHECK(error.Max <= bound.Solid);
+
+            TEST_CHECK(Internal::RoundTrip(Internal::CreateImage(Internal::ImageKind::Cutout, size, random), size, bound.Format, error));
+            TEST_CHECK(error.Max <= bound.Cutout);
+
+            TEST_CHECK(Internal::RoundTrip(Internal::CreateImage(Internal::ImageKind::Random, size, random), size, bound.Format, error));
+            TEST_CHECK(error.RootMeanSquare <= bound.Random);
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/Culling.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    // The kernels run 8 and 4 volumes at a time, every count up to here ends on a different tail.
+    constexpr std::size_t c_MaxCount{ 17u };
+
+    constexpr Renderer::SimdLevel c_Levels[]{ Renderer::SimdLevel::Scalar, Renderer::SimdLevel::SSE, Renderer::SimdLevel::AVX2 };
+
+    // Written after the last volume, a kernel must not touch them.
+    constexpr std::size_t c_GuardSize{ 8u };
+    constexpr std::uint8_t c_Guard{ 0xCDu };
+
+    // The box [-8, 8] x [-8, 8] x [-16, 0], every term of the plane tests is exact for integer volumes.
+    static const Renderer::Frustum c_BoxFrustum{ .Planes = {
+        glm::vec4{  1.0f,  0.0f,  0.0f,  8.0f },
+        glm::vec4{ -1.0f,  0.0f,  0.0f,  8.0f },
+        glm::vec4{  0.0f,  1.0f,  0.0f,  8.0f },
+        glm::vec4{  0.0f, -1.0f,  0.0f,  8.0f },
+        glm::vec4{  0.0f,  0.0f, -1.0f,  0.0f },
+        glm::vec4{  0.0f,  0.0f,  1.0f, 16.0f },
+    }, };
+
+    static Renderer::Frustum GetPerspectiveFrustum() noexcept
+    {
+        const auto projection{ glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f) };
+        const auto view{ glm::lookAt(glm::vec3{ 1.0f, 2.0f, 3.0f }, glm::vec3{ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }) };
+        return Renderer::Frustum::FromMatrix(projection * view);
+    }
+
+    // Touching each plane of the box frustum from outside, and one step further out, which is not visible anymore.
+    static std::vector<Renderer::BoundingSphere> CreatePlaneSpheres()
+    {
+        std::vector<Renderer::BoundingSphere> spheres{};
+        for (const auto& plane : c_BoxFrustum.Planes)
+        {
+            const glm::vec3 normal{ plane };
+            const auto center{ normal * (-plane.w) + glm::vec3{ 0.0f, 0.0f, -8.0f } * (1.0f - std::abs(normal.z)) };
+
+            spheres.push_back(Renderer::BoundingSphere{ .Center = center - normal * 2.0f, .Radius = 2.0f, });
+            spheres.push_back(Renderer::BoundingSphere{ .Center = center - normal * 3.0f, .Radius = 2.0f, });
+            spheres.push_back(Renderer::BoundingSphere{ .Center = center, .Radius = 0.0f, });
+        }
+
+        return spheres;
+    }
+
+    static std::vector<Renderer::BoundingBox> CreatePlaneBoxes()
+    {
+        std::vector<Renderer::BoundingBox> boxes{};
+        for (const auto& sphere : Internal::CreatePlaneSpheres())
+            boxes.push_back(Renderer::BoundingBox{ .Min = sphere.Center - glm::vec3{ sphere.Radius }, .Max = sphere.Center + glm::vec3{ sphere.Radius }, });
+
+        return boxes;
+    }
+
+    static std::vector<Renderer::BoundingSphere> CreateRandomSpheres(const std::size_t count, std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position{ -50.0f, 50.0f };
+        std::uniform_real_distribution<float> radius{ 0.0f, 10.0f };
+
+        std::vector<Renderer::BoundingSphere> spheres(count);
+        for (auto& sphere : spheres)
+            sphere = Renderer::BoundingSphere{ .Center = { position(random), position(random), position(random) }, .Radius = radius(random), };
+
+        return spheres;
+    }
+
+    static std::vector<Renderer::BoundingBox> CreateRandomBoxes(const std::size_t count, std::mt19937& random)
+    {
+        std::vector<Renderer::BoundingBox> boxes{};
+        for (const auto& sphere : Internal::CreateRandomSpheres(count, random))
+            boxes.push_back(Renderer::BoundingBox{ .Min = sphere.Center - glm::vec3{ sphere.Radius * 0.5f }, .Max = sphere.Center + glm::vec3{ sphere.Radius }, });
+
+        return boxes;
+    }
+
+    // Every level on the first count volumes against Frustum::Intersects(), one volume at a time.
+    template<typename _Batch, typename _Volume, typename _Cull>
+    static bool MatchesIntersects(const Renderer::Frustum& frustum, const std::vector<_Volume>& volumes, const std::size_t count, _Cull&& cull)
+    {
+        _Batch batch{};
+        for (std::size_t i = 0u; i < count; ++i) batch.Push(volumes[i]);
+
+        std::vector<std::uint8_t> expected(count + c_GuardSize, c_Guard);
+        for (std::size_t i = 0u; i < count; ++i) expected[i] = frustum.Intersects(volumes[i]);
+
+        const auto visibleCount{ static_cast<std::size_t>(std::count(expected.begin(), expected.begin() + count, std::uint8_t{ 1u })) };
+
+        bool isMatching{ true };
+        for (const auto level : c_Levels)
+        {
+            if (level > Renderer::GetSupportedSimdLevel()) continue;
+
+            std::vector<std::uint8_t> visibility(count + c_GuardSize, c_Guard);
+            if (cull(frustum, batch, visibility.data(), level) != visibleCount || visibility != expected)
+            {
+                spdlog::error("[Tests]:   level {} disagrees on {} volumes", static_cast<int>(level), count);
+                isMatching = false;
+            }
+        }
+
+        return isMatching;
+    }
+}
+
+void TestCulling()
+{
+    std::mt19937 random{ 42u };
+
+    const auto cullSpheres{ [](const auto& frustum, const auto& batch, auto* visibility, const auto level) {
+        return Renderer::CullSpheres(frustum, batch, visibility, level);
+    } };
+    const auto cullBoxes{ [](const auto& frustum, const auto& batch, auto* visibility, const auto level) {
+        return Renderer::CullBoxes(frustum, batch, visibility, level);
+    } };
+
+    // The volumes on the planes come out right however they are split between the lanes and the tail.
+    const auto planeSpheres{ Internal::CreatePlaneSpheres() };
+    const auto planeBoxes{ Internal::CreatePlaneBoxes() };
+    TEST_CHECK(planeSpheres.size() > Internal::c_MaxCount);
+
+    for (std::size_t i = 0u; i < planeSpheres.size(); i += 3u)
+    {
+        TEST_CHECK(Internal::c_BoxFrustum.Intersects(planeSpheres[i]) && Internal::c_BoxFrustum.Intersects(planeBoxes[i]));
+        TEST_CHECK(!Internal::c_BoxFrustum.Intersects(planeSpheres[i + 1u]) && !Internal::c_BoxFrustum.Intersects(planeBoxes[i + 1u]));
+        TEST_CHECK(Internal::c_BoxFrustum.Intersects(planeSpheres[i + 2u]) && Internal::c_BoxFrustum.Intersects(planeBoxes[i + 2u]));
+    }
+
+    const auto perspective{ Internal::GetPerspectiveFrustum() };
+    for (std::size_t count = 0u; count <= Internal::c_MaxCount; ++count)
+    {
+        TEST_CHECK(Internal::MatchesIntersects<Renderer::SphereBatch>(Internal::c_BoxFrustum, planeSpheres, count, cullSpheres));
+        TEST_CHECK(Internal::MatchesIntersects<Renderer::BoxBatch>(Internal::c_BoxFrustum, planeBoxes, count, cullBoxes));
+
+        const auto spheres{ Internal::CreateRandomSpheres(count, random) };
+        TEST_CHECK(Internal::MatchesIntersects<Renderer::SphereBatch>(perspective, spheres, count, cullSpheres));
+
+        const auto boxes{ Internal::CreateRandomBoxes(count, random) };
+        TEST_CHECK(Internal::MatchesIntersects<Renderer::BoxBatch>(perspective, boxes, count, cullBoxes));
+    }
+
+    // Enough of both to have some visible and some not.
+    const auto spheres{ Internal::CreateRandomSpheres(1'000u, random) };
+    TEST_CHECK(Internal::MatchesIntersects<Renderer::SphereBatch>(perspective, spheres, spheres.size(), cullSpheres));
+
+    const auto boxes{ Internal::CreateRandomBoxes(1'000u, random) };
+    TEST_CHECK(Internal::MatchesIntersects<Renderer::BoxBatch>(perspective, boxes, boxes.size(), cullBoxes));
+}
@@ -0,0 +1,119 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/Loaders/DDSFile.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Internal
+{
+    // Offsets into the file, the magic comes before the header.
+    constexpr std::size_t c_HeightOffset{ 12u };
+    constexpr std::size_t c_WidthOffset{ 16u };
+    constexpr std::size_t c_MipMapCountOffset{ 28u };
+    constexpr std::size_t c_HeaderSize{ 128u };
+
+    static std::vector<char> ReadBytes(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::binary };
+        return { std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    }
+
+    static void WriteBytes(const std::filesystem::path& path, const std::vector<char>& bytes)
+    {
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    static void SetField(std::vector<char>& bytes, const std::size_t offset, const std::uint32_t value) noexcept
+    {
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+    }
+
+    // A file made from the valid one with a single edit has to be turned down, leaving the chain empty.
+    static bool IsRejected(const std::filesystem::path& path, const std::vector<char>& bytes)
+    {
+        Internal::WriteBytes(path, bytes);
+
+        Renderer::MipChain levels{};
+        return !ReadDDSFile(path.string(), levels) && levels.IsEmpty();
+    }
+}
+
+void TestDDSFile()
+{
+    const auto path{ std::filesystem::temp_directory_path() / "crenderr-tests-dds-file.dds" };
+
+    // 64x32 RGBA8, seven levels.
+    std::vector<std::uint8_t> pixels(64u * 32u * 4u);
+    for (std::size_t i = 0u; i < pixels.size(); ++i) pixels[i] = static_cast<std::uint8_t>(i * 7u);
+
+    Renderer::MipChain source{};
+    source.Generate(pixels.data(), { 64, 32 });
+    TEST_CHECK(source.GetLevelCount() == 7u);
+    TEST_CHECK(WriteDDSFile(path.string(), source));
+
+    Renderer::MipChain levels{};
+    TEST_CHECK(ReadDDSFile(path.string(), levels));
+    TEST_CHECK(levels.GetLevelCount() == source.GetLevelCount());
+    TEST_CHECK(std::memcmp(levels.GetPixels(0u), source.GetPixels(0u), source.GetByteSize(0u, source.GetLevelCount())) == 0);
+
+    // The headers of corrupted files, none of them gets as far as allocating the levels.
+    const auto bytes{ Internal::ReadBytes(path) };
+    TEST_CHECK(bytes.size() == Internal::c_HeaderSize + source.GetByteSize(0u, source.GetLevelCount()));
+
+    {
+        auto corrupted{ bytes };
+        Internal::SetField(corrupted, Internal::c_WidthOffset, 0x80000000u);
+        TEST_CHECK(Internal::IsRejected(path, corrupted));
+
+        Internal::SetField(corrupted, Internal::c_WidthOffset, 0u);
+        TEST_CHECK(Internal::IsRejected(path, corrupted));
+    }
+    {
+        auto corrupted{ bytes };
+        Internal::SetField(corrupted, Internal::c_HeightOffset, static_cast<std::uint32_t>(Renderer::MipChain::GetMaxSize()) + 1u);
+        TEST_CHECK(Internal::IsRejected(path, corrupted));
+    }
+    {
+        // Claims more levels than 64x32 has.
+        auto corrupted{ bytes };
+        Internal::SetField(corrupted, Internal::c_MipMapCountOffset, 40u);
+        TEST_CHECK(Internal::IsRejected(path, corrupted));
+    }
+    {
+        // Within the limits, but far more data than the file holds.
+        auto corrupted{ bytes };
+        Internal::SetField(corrupted, Internal::c_WidthOffset, 16384u);
+        Internal::SetField(corrupted, Internal::c_HeightOffset, 16384u);
+        TEST_CHECK(Internal::IsRejected(path, corrupted));
+    }
+    {
+        auto truncated{ bytes };
+        truncated.pop_back();
+        TEST_CHECK(Internal::IsRejected(path, truncated));
+    }
+
+    // A lower limit set by the graphics context applies to files that were fine before.
+    Renderer::MipChain::SetMaxSize(32);
+    TEST_CHECK(Internal::IsRejected(path, bytes));
+    Renderer::MipChain::SetMaxSize(Renderer::MipChain::c_MinMaxSize);
+
+    // Assign() validates the same way.
+    Renderer::MipChain assigned{};
+    TEST_CHECK(!assigned.Assign(Renderer::TextureFormat::RGBA8, { 64, 32 }, 8u, pixels.data(), pixels.size() * 2u));
+    TEST_CHECK(!assigned.Assign(Renderer::TextureFormat::RGBA8, { 64, 32 }, 2u, pixels.data(), pixels.size()));
+    TEST_CHECK(!assigned.Assign(Renderer::TextureFormat::RGBA8, { 0, 32 }, 1u, pixels.data(), pixels.size()));
+    TEST_CHECK(assigned.IsEmpty());
+    TEST_CHECK(assigned.Assign(Renderer::TextureFormat::RGBA8, { 64, 32 }, 1u, pixels.data(), pixels.size()));
+
+    std::size_t byteSize{};
+    TEST_CHECK(Renderer::MipChain::GetChainByteSize(Renderer::TextureFormat::BC1, { 5, 5 }, 3u, byteSize) && byteSize == 4u * 8u + 8u + 8u);
+
+    std::error_code error{};
+    std::filesystem::remove(path, error);
+}
@@ -0,0 +1,214 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/MeshBVH.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    // A flat grid of 16x16 quads on y = 0, [0, 16] on x and z, with random triangles floating above it.
+    constexpr std::uint32_t c_GridSize{ 16u };
+    constexpr std::size_t c_FloatingCount{ 200u };
+    constexpr std::size_t c_RandomRayCount{ 2'000u };
+
+    constexpr float c_Tolerance{ 1e-4f };
+
+    constexpr Renderer::SimdLevel c_Levels[]{ Renderer::SimdLevel::Scalar, Renderer::SimdLevel::SSE, Renderer::SimdLevel::AVX2 };
+
+    struct Mesh
+    {
+        std::vector<glm::vec3> Positions{};
+        std::vector<std::uint32_t> Indices{};
+    };
+
+    static Mesh CreateMesh(std::mt19937& random)
+    {
+        Mesh mesh{};
+
+        for (std::uint32_t z = 0u; z <= c_GridSize; ++z)
+            for (std::uint32_t x = 0u; x <= c_GridSize; ++x) mesh.Positions.emplace_back(static_cast<float>(x), 0.0f, static_cast<float>(z));
+
+        const auto row{ c_GridSize + 1u };
+        for (std::uint32_t z = 0u; z < c_GridSize; ++z)
+        {
+            for (std::uint32_t x = 0u; x < c_GridSize; ++x)
+            {
+                const auto a{ z * row + x }, b{ a + 1u }, c{ a + row }, d{ c + 1u };
+                mesh.Indices.insert(mesh.Indices.end(), { a, c, b, b, c, d, });
+            }
+        }
+
+        std::uniform_real_distribution<float> position{ 0.0f, static_cast<float>(c_GridSize) };
+        std::uniform_real_distribution<float> height{ 0.5f, 4.0f };
+        std::uniform_real_distribution<float> offset{ -1.0f, 1.0f };
+
+        for (std::size_t i = 0u; i < c_FloatingCount; ++i)
+        {
+            const glm::vec3 center{ position(random), height(random), position(random) };
+            for (std::size_t corner = 0u; corner < 3u; ++corner)
+            {
+                mesh.Indices.push_back(static_cast<std::uint32_t>(mesh.Positions.size()));
+                mesh.Positions.push_back(center + glm::vec3{ offset(random), offset(random), offset(random) });
+            }
+        }
+
+        return mesh;
+    }
+
+    // Möller-Trumbore on one triangle of the index list, written out again so the tree is checked against something of its own.
+    static Renderer::TriangleHit IntersectTriangle(const Mesh& mesh, const std::uint32_t triangle, const Renderer::Ray& ray) noexcept
+    {
+        const auto& a{ mesh.Positions[mesh.Indices[triangle * 3u]] };
+        const auto edge1{ mesh.Positions[mesh.Indices[triangle * 3u + 1u]] - a };
+        const auto edge2{ mesh.Positions[mesh.Indices[triangle * 3u + 2u]] - a };
+
+        const auto p{ glm::cross(ray.Direction, edge2) };
+        const auto determinant{ glm::dot(edge1, p) };
+        if (std::abs(determinant) <= 1e-12f) return {};
+
+        const auto t{ ray.Origin - a };
+        const auto u{ glm::dot(t, p) / determinant };
+        const auto q{ glm::cross(t, edge1) };
+        const auto v{ glm::dot(ray.Direction, q) / determinant };
+        const auto distance{ glm::dot(edge2, q) / determinant };
+
+        if (u < 0.0f || v < 0.0f || u + v > 1.0f || distance <= 0.0f) return {};
+        return Renderer::TriangleHit{ .Triangle = triangle, .Distance = distance, .Barycentrics = { u, v, }, };
+    }
+
+    // Every triangle, the nearest one closer than maxDistance wins.
+    static Renderer::TriangleHit IntersectBruteForce(const Mesh& mesh, const Renderer::Ray& ray, const float maxDistance) noexcept
+    {
+        Renderer::TriangleHit nearest{ .Distance = maxDistance, };
+        for (std::uint32_t triangle = 0u; triangle < mesh.Indices.size() / 3u; ++triangle)
+        {
+            const auto hit{ Internal::IntersectTriangle(mesh, triangle, ray) };
+            if (hit.IsValid() && hit.Distance < nearest.Distance) nearest = hit;
+        }
+
+        return nearest.IsValid() ? nearest : Renderer::TriangleHit{};
+    }
+
+    static bool IsClose(const float value, const float expected) noexcept
+    {
+        return std::abs(value - expected) <= c_Tolerance * std::max(1.0f, std::abs(expected));
+    }
+
+    /**
+     * Two triangles sharing an edge are both right for a ray through it, at the same distance. So the
+     * distance has to match the nearest one, and the triangle and barycentrics have to be what the
+     * reported triangle gives on its own.
+     */
+    static bool MatchesBruteForce(const Mesh& mesh, const Renderer::Ray& ray, const Renderer::TriangleHit& hit,
+        const float maxDistance = std::numeric_limits<float>::max()) noexcept
+    {
+        const auto expected{ Internal::IntersectBruteForce(mesh, ray, maxDistance) };
+        if (!expected.IsValid()) return !hit.IsValid();
+        if (!hit.IsValid() || !Internal::IsClose(hit.Distance, expected.Distance)) return false;
+
+        const auto own{ Internal::IntersectTriangle(mesh, hit.Triangle, ray) };
+        return own.IsValid() && Internal::IsClose(hit.Distance, own.Distance)
+            && Internal::IsClose(hit.Barycentrics.x, own.Barycentrics.x) && Internal::IsClose(hit.Barycentrics.y, own.Barycentrics.y);
+    }
+
+    static std::vector<Renderer::Ray> CreateRays(std::mt19937& random)
+    {
+        const auto size{ static_cast<float>(c_GridSize) };
+        std::vector<Renderer::Ray> rays{};
+
+        // Straight down onto the grid vertices and the middle of the edges in between, grazing two or more triangles.
+        for (float z = 0.0f; z <= size; z += 0.5f)
+            for (float x = 0.0f; x <= size; x += 0.5f) rays.push_back(Renderer::Ray{ .Origin = { x, 10.0f, z }, .Direction = { 0.0f, -1.0f, 0.0f }, });
+
+        // Along the diagonals of the quads, which are edges too.
+        for (float x = 0.25f; x < size; x += 1.0f)
+            rays.push_back(Renderer::Ray{ .Origin = { x, 10.0f, 1.0f - (x - std::floor(x)) }, .Direction = { 0.0f, -1.0f, 0.0f }, });
+
+        // Misses: next to the grid, pointing away from it, and parallel to it above the floating triangles.
+        rays.push_back(Renderer::Ray{ .Origin = { -1.0f, 10.0f, 8.0f }, .Direction = { 0.0f, -1.0f, 0.0f }, });
+        rays.push_back(Renderer::Ray{ .Origin = { size + 0.001f, 10.0f, 8.0f }, .Direction = { 0.0f, -1.0f, 0.0f }, });
+        rays.push_back(Renderer::Ray{ .Origin = { 8.0f, 10.0f, 8.0f }, .Direction = { 0.0f, 1.0f, 0.0f }, });
+        rays.push_back(Renderer::Ray{ .Origin = { -4.0f, 10.0f, 8.0f }, .Direction = { 1.0f, 0.0f, 0.0f }, });
+        rays.push_back(Renderer::Ray{ .Origin = { 8.0f, -1.0f, 8.0f }, .Direction = { 0.0f, -1.0f, 0.0f }, });
+
+        // Anywhere into any direction, some longer than unit length.
+        std::uniform_real_distribution<float> position{ -4.0f, size + 4.0f };
+        std::uniform_real_distribution<float> direction{ -1.0f, 1.0f };
+        std::uniform_real_distribution<float> length{ 0.5f, 3.0f };
+
+        for (std::size_t i = 0u; i < c_RandomRayCount; ++i)
+        {
+            const glm::vec3 origin{ position(random), 0.5f * position(random), position(random) };
+            const glm::vec3 target{ position(random), 0.0f, position(random) };
+            const auto forward{ glm::normalize(target - origin + glm::vec3{ direction(random), direction(random), direction(random) }) };
+            rays.push_back(Renderer::Ray{ .Origin = origin, .Direction = forward * (i % 4u ? 1.0f : length(random)), });
+        }
+
+        return rays;
+    }
+}
+
+void TestMeshBVH()
+{
+    std::mt19937 random{ 42u };
+
+    const auto mesh{ Internal::CreateMesh(random) };
+    const auto rays{ Internal::CreateRays(random) };
+
+    Renderer::MeshBVH bvh{};
+    bvh.Build(mesh.Positions.data(), mesh.Positions.size(), mesh.Indices);
+    TEST_CHECK(bvh.GetTriangleCount() == mesh.Indices.size() / 3u);
+
+    std::size_t hitCount{ 0u };
+    for (const auto& ray : rays)
+    {
+        const auto hit{ bvh.Intersect(ray) };
+        hitCount += hit.IsValid();
+
+        if (!Internal::MatchesBruteForce(mesh, ray, hit))
+        {
+            spdlog::error("[Tests]:   single ray from ({}, {}, {}) is off", ray.Origin.x, ray.Origin.y, ray.Origin.z);
+            TEST_CHECK(false);
+        }
+    }
+
+    // Both outcomes have to be in there for the comparison to say anything.
+    TEST_CHECK(hitCount > rays.size() / 4u && hitCount < rays.size());
+
+    for (const auto level : Internal::c_Levels)
+    {
+        if (level > Renderer::GetSupportedSimdLevel()) continue;
+
+        std::vector<Renderer::TriangleHit> hits(rays.size());
+        bvh.IntersectRays(rays, hits, std::numeric_limits<float>::max(), level);
+
+        std::size_t mismatchCount{ 0u };
+        for (std::size_t i = 0u; i < rays.size(); ++i)
+            mismatchCount += !Internal::MatchesBruteForce(mesh, rays[i], hits[i]);
+
+        if (mismatchCount) spdlog::error("[Tests]:   level {}: {} of {} rays are off", static_cast<int>(level), mismatchCount, rays.size());
+        TEST_CHECK(mismatchCount == 0u);
+    }
+
+    // Cut short, only the floating triangles within reach are found and the grid 10 below the vertical rays never is.
+    constexpr float c_MaxDistance{ 8.0f };
+    std::vector<Renderer::TriangleHit> hits(rays.size());
+    bvh.IntersectRays(rays, hits, c_MaxDistance);
+
+    for (std::size_t i = 0u; i < rays.size(); ++i)
+    {
+        TEST_CHECK(Internal::MatchesBruteForce(mesh, rays[i], bvh.Intersect(rays[i], c_MaxDistance), c_MaxDistance));
+        TEST_CHECK(Internal::MatchesBruteForce(mesh, rays[i], hits[i], c_MaxDistance));
+    }
+
+    // Nothing to hit once cleared.
+    const Renderer::Ray down{ .Origin = { 0.5f, 10.0f, 0.5f }, .Direction = { 0.0f, -1.0f, 0.0f }, };
+    bvh.Clear();
+    TEST_CHECK(!bvh.Intersect(down).IsValid());
+}
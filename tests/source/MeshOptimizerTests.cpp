@@ -0,0 +1,124 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/Loaders/MeshOptimizer.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    constexpr std::size_t c_GridSize{ 64u };
+
+    struct GridMesh
+    {
+        std::vector<glm::vec3> Positions{};
+        std::vector<std::uint32_t> Indices{};
+    };
+
+    // Scan-line order, one row of quads after the other, two triangles each.
+    static GridMesh CreateGrid(const std::size_t size)
+    {
+        GridMesh grid{};
+
+        const auto row{ static_cast<std::uint32_t>(size + 1u) };
+        for (std::uint32_t y = 0u; y < row; ++y)
+            for (std::uint32_t x = 0u; x < row; ++x)
+                grid.Positions.emplace_back(static_cast<float>(x), 0.0f, static_cast<float>(y));
+
+        for (std::uint32_t y = 0u; y + 1u < row; ++y)
+        {
+            for (std::uint32_t x = 0u; x + 1u < row; ++x)
+            {
+                const auto a{ y * row + x }, b{ a + 1u }, c{ a + row }, d{ c + 1u };
+                grid.Indices.insert(grid.Indices.end(), { a, c, b, b, c, d, });
+            }
+        }
+
+        return grid;
+    }
+
+    static void ShuffleTriangles(std::vector<std::uint32_t>& indices)
+    {
+        std::vector<std::array<std::uint32_t, 3u>> triangles(indices.size() / 3u);
+        std::copy(indices.begin(), indices.end(), triangles.front().data());
+
+        std::mt19937 random{ 1234u };
+        std::shuffle(triangles.begin(), triangles.end(), random);
+
+        std::copy(triangles.front().data(), triangles.front().data() + indices.size(), indices.begin());
+    }
+
+    // Every triangle rotated to start at its smallest index, which keeps the winding, then all of them sorted.
+    static std::vector<std::array<std::uint32_t, 3u>> GetTriangleSet(const std::vector<std::uint32_t>& indices)
+    {
+        std::vector<std::array<std::uint32_t, 3u>> triangles{};
+        for (std::size_t i = 0u; i + 2u < indices.size(); i += 3u)
+        {
+            std::array<std::uint32_t, 3u> triangle{ indices[i], indices[i + 1u], indices[i + 2u] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    static void TestVertexCacheOrder(const char* name, GridMesh grid)
+    {
+        const auto triangles{ Internal::GetTriangleSet(grid.Indices) };
+        const auto before{ AnalyzeVertexCache(grid.Indices.data(), grid.Indices.size(), grid.Positions.size()) };
+
+        OptimizeVertexCache(grid.Indices.data(), grid.Indices.size(), grid.Positions.size());
+        const auto after{ AnalyzeVertexCache(grid.Indices.data(), grid.Indices.size(), grid.Positions.size()) };
+
+        spdlog::info("[Tests]:   {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", name, before.ACMR, after.ACMR, before.ATVR, after.ATVR);
+
+        TEST_CHECK(after.ACMR < before.ACMR);
+        TEST_CHECK(after.ATVR < before.ATVR);
+        TEST_CHECK(after.ACMR >= 0.5f);
+        TEST_CHECK(Internal::GetTriangleSet(grid.Indices) == triangles);
+
+        // Reordering for overdraw has to keep the same triangles, and most of the cache hits.
+        OptimizeOverdraw(grid.Indices.data(), grid.Indices.size(), grid.Positions.data(), sizeof(glm::vec3), grid.Positions.size());
+        const auto sorted{ AnalyzeVertexCache(grid.Indices.data(), grid.Indices.size(), grid.Positions.size()) };
+
+        TEST_CHECK(Internal::GetTriangleSet(grid.Indices) == triangles);
+        TEST_CHECK(sorted.ACMR < before.ACMR);
+
+        // Moving the vertices around must leave every corner pointing at the same position.
+        std::vector<glm::vec3> corners{};
+        for (const auto index : grid.Indices) corners.push_back(grid.Positions[index]);
+
+        const auto vertexCount{ OptimizeVertexFetch(grid.Positions.data(), sizeof(glm::vec3), grid.Indices.data(), grid.Indices.size(), grid.Positions.size()) };
+        TEST_CHECK(vertexCount == grid.Positions.size());
+
+        bool isSameGeometry{ true };
+        for (std::size_t i = 0u; i < grid.Indices.size(); ++i)
+            isSameGeometry = isSameGeometry && grid.Indices[i] < vertexCount && grid.Positions[grid.Indices[i]] == corners[i];
+
+        TEST_CHECK(isSameGeometry);
+    }
+}
+
+void TestMeshOptimizer()
+{
+    // A scan-line grid is already decent, rows wider than the cache still miss on every new row.
+    Internal::TestVertexCacheOrder("scan-line grid", Internal::CreateGrid(Internal::c_GridSize));
+
+    auto shuffled{ Internal::CreateGrid(Internal::c_GridSize) };
+    Internal::ShuffleTriangles(shuffled.Indices);
+    Internal::TestVertexCacheOrder("shuffled grid", std::move(shuffled));
+
+    // Empty input and a single triangle must come through untouched.
+    std::vector<std::uint32_t> none{};
+    OptimizeVertexCache(none.data(), none.size(), 0u);
+    TEST_CHECK(AnalyzeVertexCache(none.data(), none.size(), 0u).VerticesTransformed == 0u);
+
+    std::vector<std::uint32_t> single{ 0u, 1u, 2u };
+    OptimizeVertexCache(single.data(), single.size(), 3u);
+    TEST_CHECK(Internal::GetTriangleSet(single) == Internal::GetTriangleSet({ 0u, 1u, 2u }));
+}
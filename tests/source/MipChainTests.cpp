@@ -0,0 +1,123 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/MipChain.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    // The kernels take 4 and 8 destination texels at a time, every width up to here ends on a different tail.
+    constexpr int c_MaxWidth{ 41 };
+    constexpr int c_Heights[]{ 1, 2, 3, 4, 7 };
+
+    constexpr std::size_t c_BytesPerTexel{ 4u };
+
+    // Written after the destination, no kernel may touch them.
+    constexpr std::size_t c_GuardSize{ 64u };
+    constexpr std::uint8_t c_Guard{ 0xCDu };
+
+    constexpr Renderer::SimdLevel c_Levels[]{ Renderer::SimdLevel::Scalar, Renderer::SimdLevel::SSE, Renderer::SimdLevel::AVX2 };
+
+    // The rounded mean of each 2x2 block, texel by texel, the last row and column repeated for a side of 1.
+    static std::vector<std::uint8_t> DownsampleReference(const std::vector<std::uint8_t>& source, const glm::ivec2& sourceSize)
+    {
+        const auto size{ glm::max(sourceSize / 2, glm::ivec2{ 1 }) };
+        const auto getTexel{ [&](const int x, const int y, const std::size_t channel) -> unsigned {
+            return source[(static_cast<std::size_t>(y) * static_cast<std::size_t>(sourceSize.x) + static_cast<std::size_t>(x)) * c_BytesPerTexel + channel];
+        } };
+
+        std::vector<std::uint8_t> destination(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * c_BytesPerTexel);
+        for (int y = 0; y < size.y; ++y)
+        {
+            for (int x = 0; x < size.x; ++x)
+            {
+                const auto x1{ std::min(2 * x + 1, sourceSize.x - 1) };
+                const auto y1{ std::min(2 * y + 1, sourceSize.y - 1) };
+
+                for (std::size_t channel = 0u; channel < c_BytesPerTexel; ++channel)
+                {
+                    const auto sum{ getTexel(2 * x, 2 * y, channel) + getTexel(x1, 2 * y, channel) + getTexel(2 * x, y1, channel) + getTexel(x1, y1, channel) + 2u };
+                    destination[(static_cast<std::size_t>(y) * static_cast<std::size_t>(size.x) + static_cast<std::size_t>(x)) * c_BytesPerTexel + channel] =
+                        static_cast<std::uint8_t>(sum >> 2u);
+                }
+            }
+        }
+
+        return destination;
+    }
+
+    // Every level on one source, each has to give exactly the reference and leave the guard alone.
+    static bool MatchesReference(const std::vector<std::uint8_t>& source, const glm::ivec2& sourceSize)
+    {
+        const auto expected{ Internal::DownsampleReference(source, sourceSize) };
+
+        bool isMatching{ true };
+        for (const auto level : c_Levels)
+        {
+            if (level > Renderer::GetSupportedSimdLevel()) continue;
+
+            std::vector<std::uint8_t> destination(expected.size() + c_GuardSize, c_Guard);
+            Renderer::DownsampleBox(source.data(), sourceSize, destination.data(), level);
+
+            if (std::memcmp(destination.data(), expected.data(), expected.size()) != 0 ||
+                !std::all_of(destination.begin() + static_cast<std::ptrdiff_t>(expected.size()), destination.end(), [](const auto byte) { return byte == c_Guard; }))
+            {
+                spdlog::error("[Tests]:   level {} is off for {}x{}", static_cast<int>(level), sourceSize.x, sourceSize.y);
+                isMatching = false;
+            }
+        }
+
+        return isMatching;
+    }
+}
+
+void TestMipChain()
+{
+    std::mt19937 random{ 42u };
+    std::uniform_int_distribution<int> value{ 0, 255 };
+
+    // Odd and even widths, 1 texel wide and 1 texel high sources among them.
+    for (int width = 1; width <= Internal::c_MaxWidth; ++width)
+    {
+        for (const auto height : Internal::c_Heights)
+        {
+            // Sized exactly, so a kernel reading past the last row would show up in a sanitized build.
+            std::vector<std::uint8_t> source(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * Internal::c_BytesPerTexel);
+            for (auto& byte : source) byte = static_cast<std::uint8_t>(value(random));
+
+            TEST_CHECK(Internal::MatchesReference(source, { width, height }));
+
+            // Tall ones as well, where only the rows get halved.
+            TEST_CHECK(Internal::MatchesReference(source, { height, width }));
+        }
+    }
+
+    // The extremes of every channel, the 16 bit sums must not overflow and the rounding must hold at both ends.
+    for (const auto fill : { std::uint8_t{ 0u }, std::uint8_t{ 1u }, std::uint8_t{ 254u }, std::uint8_t{ 255u } })
+    {
+        std::vector<std::uint8_t> source(64u * 2u * Internal::c_BytesPerTexel, fill);
+        TEST_CHECK(Internal::MatchesReference(source, { 64, 2 }));
+    }
+
+    // A whole chain built at every level is the same, down to the 1x1 level.
+    std::vector<std::uint8_t> pixels(37u * 19u * Internal::c_BytesPerTexel);
+    for (auto& byte : pixels) byte = static_cast<std::uint8_t>(value(random));
+
+    Renderer::MipChain expected{};
+    expected.Generate(pixels.data(), { 37, 19 }, 0u, Renderer::SimdLevel::Scalar);
+    TEST_CHECK(expected.GetLevelCount() == 6u);
+
+    for (const auto level : Internal::c_Levels)
+    {
+        Renderer::MipChain chain{};
+        chain.Generate(pixels.data(), { 37, 19 }, 0u, level);
+
+        TEST_CHECK(chain.GetLevelCount() == expected.GetLevelCount());
+        TEST_CHECK(std::memcmp(chain.GetPixels(0u), expected.GetPixels(0u), expected.GetByteSize(0u, expected.GetLevelCount())) == 0);
+    }
+}
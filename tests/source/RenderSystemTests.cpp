@@ -0,0 +1,90 @@
+#include "Test.hpp"
+
+#include <Crenderr/Application/RenderSystem.hpp>
+
+#include <entt/entt.hpp>
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace Internal
+{
+    // The renderer's cube, a unit box around the origin.
+    static Renderer::MeshBounds GetCubeBounds() noexcept
+    {
+        const glm::vec3 corners[]{ glm::vec3{ -0.5f }, glm::vec3{ 0.5f } };
+        return Renderer::MeshBounds::FromPositions(corners, 2u);
+    }
+
+    static auto GetRenderables(entt::registry& registry)
+    {
+        return registry.group<MeshRendererComponent, MaterialComponent, TransformComponent>();
+    }
+
+    // Down the z axis through every cube, the one at the front is hit first.
+    constexpr Renderer::Ray c_Ray{ .Origin = { 0.0f, 0.0f, 10.0f }, .Direction = { 0.0f, 0.0f, -1.0f }, };
+
+    // Removing any of the three takes the entity out of the group, the next Prepare() must not see it anymore.
+    template<typename _Component>
+    static void TestRemoval(entt::registry& registry, RenderSystem& system, const entt::entity front, const entt::entity behind)
+    {
+        const auto component{ registry.get<_Component>(front) };
+        registry.remove<_Component>(front);
+
+        // Without a rebuild the picking would still run against the old boxes.
+        TEST_CHECK(system.Pick(Internal::c_Ray) == entt::null);
+
+        system.Prepare(Internal::GetCubeBounds());
+        TEST_CHECK(!Internal::GetRenderables(registry).contains(front));
+        TEST_CHECK(system.Pick(Internal::c_Ray) == behind);
+
+        registry.emplace<_Component>(front, component);
+        system.Prepare(Internal::GetCubeBounds());
+        TEST_CHECK(Internal::GetRenderables(registry).contains(front));
+        TEST_CHECK(system.Pick(Internal::c_Ray) == front);
+    }
+}
+
+void TestRenderSystem()
+{
+    entt::registry registry{};
+    RenderSystem system{ registry };
+
+    std::array<entt::entity, 3u> entities{};
+    for (std::size_t i = 0u; i < entities.size(); ++i)
+    {
+        entities[i] = registry.create();
+        registry.emplace<TransformComponent>(entities[i], Renderer::Translation{ .Position = { 0.0f, 0.0f, -5.0f * static_cast<float>(i) }, });
+        registry.emplace<MeshRendererComponent>(entities[i]);
+        registry.emplace<MaterialComponent>(entities[i]);
+    }
+
+    TEST_CHECK(system.Pick(Internal::c_Ray) == entt::null);
+
+    system.Prepare(Internal::GetCubeBounds());
+    TEST_CHECK(system.Pick(Internal::c_Ray) == entities[0]);
+
+    Internal::TestRemoval<MeshRendererComponent>(registry, system, entities[0], entities[1]);
+    Internal::TestRemoval<MaterialComponent>(registry, system, entities[0], entities[1]);
+    Internal::TestRemoval<TransformComponent>(registry, system, entities[0], entities[1]);
+
+    // Moving one through patch() only refits, the front cube out of the way lets the ray through to the next.
+    registry.patch<TransformComponent>(entities[0], [](auto& transform) { transform.Translation.Position.x = 10.0f; });
+    system.Prepare(Internal::GetCubeBounds());
+    TEST_CHECK(system.Pick(Internal::c_Ray) == entities[1]);
+
+    // Destroying the entity removes all three at once.
+    registry.destroy(entities[1]);
+    system.Prepare(Internal::GetCubeBounds());
+    TEST_CHECK(system.Pick(Internal::c_Ray) == entities[2]);
+
+    // Without bounds a mesh is never culled, it stays out of the tree and so cannot be picked or found twice.
+    registry.patch<MeshRendererComponent>(entities[2], [](auto&) {});
+    system.Prepare(Renderer::MeshBounds{});
+    TEST_CHECK(system.Pick(Internal::c_Ray) == entt::null);
+
+    registry.patch<TransformComponent>(entities[2], [](auto& transform) { transform.Translation.Position.z = 1.0f; });
+    system.Prepare(Renderer::MeshBounds{});
+    TEST_CHECK(system.Pick(Internal::c_Ray) == entt::null);
+}
@@ -0,0 +1,137 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/ResourceCache.hpp>
+
+#include <memory>
+#include <string>
+
+namespace Internal
+{
+    struct DummyProps
+    {
+        std::string Name{};
+        std::size_t ByteSize{ 0u };
+        bool IsValid{ true };
+    };
+
+    // Found by argument dependent lookup, like the overloads next to the real resources.
+    static Hash::ValueType GetPropsHash(const DummyProps& props) noexcept
+    {
+        return Hash::FNV1a(props.Name);
+    }
+
+    // Counts its constructions, so a hit can be told from a reload. Fails to initialize when the props say so.
+    class DummyResource : public Renderer::RendererResource<DummyProps>
+    {
+    public:
+        static inline std::size_t s_CreateCount{ 0u };
+
+    public:
+        explicit DummyResource(const DummyProps& props)
+            : m_Props{ props } { ++s_CreateCount; }
+
+        inline std::size_t GetByteSize() const noexcept { return m_Props.ByteSize; }
+
+    public:
+        virtual bool OnInitialize() noexcept override { return m_Props.IsValid; }
+
+    public:
+        virtual void Bind() const override {}
+        virtual void Unbind() const override {}
+
+    public:
+        inline virtual Renderer::RendererID GetResourceHandle() const override { return 1u; }
+
+    private:
+        DummyProps m_Props{};
+    };
+
+    // Another type under the same keys, without a size.
+    class OtherResource : public Renderer::RendererResource<DummyProps>
+    {
+    public:
+        explicit OtherResource(const DummyProps&) {}
+
+    public:
+        virtual bool OnInitialize() noexcept override { return true; }
+
+    public:
+        virtual void Bind() const override {}
+        virtual void Unbind() const override {}
+
+    public:
+        inline virtual Renderer::RendererID GetResourceHandle() const override { return 1u; }
+    };
+}
+
+void TestResourceCache()
+{
+    using Internal::DummyResource;
+
+    // Shared with every other case, so only the changes are compared.
+    auto& cache{ Renderer::ResourceCache::Get() };
+    cache.Prune();
+
+    const auto before{ cache.GetStatistics() };
+    const auto createCount{ DummyResource::s_CreateCount };
+
+    // Equal props, one object.
+    const Internal::DummyProps texture{ .Name = "texture", .ByteSize = 100u, };
+    auto first{ Renderer::AcquireResource<DummyResource>(texture) };
+    auto second{ Renderer::AcquireResource<DummyResource>(texture) };
+
+    TEST_CHECK(first && first == second && DummyResource::s_CreateCount == createCount + 1u);
+    TEST_CHECK(cache.GetStatistics().Misses == before.Misses + 1u && cache.GetStatistics().Hits == before.Hits + 1u);
+    TEST_CHECK(cache.GetStatistics().LoadedBytes == before.LoadedBytes + 100u && cache.GetStatistics().ReusedBytes == before.ReusedBytes + 100u);
+
+    // The key alone finds it too, create() is not called on a hit.
+    bool isCreated{ false };
+    auto byKey{ cache.Acquire<DummyResource>(Internal::GetPropsHash(texture), [&isCreated]() -> std::shared_ptr<DummyResource> {
+        isCreated = true;
+        return nullptr;
+    }) };
+    TEST_CHECK(byKey == first && !isCreated);
+    byKey.reset();
+
+    // The same key for another type is another object.
+    auto other{ cache.Acquire<Internal::OtherResource>(Internal::GetPropsHash(texture), [&texture]() {
+        return Renderer::AllocateResource<Internal::OtherResource>(texture);
+    }) };
+    TEST_CHECK(other && static_cast<const void*>(other.get()) != static_cast<const void*>(first.get()));
+    TEST_CHECK(cache.GetStatistics().Misses == before.Misses + 2u);
+
+    // A resource failing to initialize is not stored, the next acquire creates it again.
+    const Internal::DummyProps broken{ .Name = "broken", .ByteSize = 50u, .IsValid = false, };
+    TEST_CHECK(!Renderer::AcquireResource<DummyResource>(broken));
+    TEST_CHECK(cache.GetStatistics().Failures == before.Failures + 1u && cache.GetStatistics().LoadedBytes == before.LoadedBytes + 100u);
+
+    const auto failedCount{ DummyResource::s_CreateCount };
+    auto repaired{ Renderer::AcquireResource<DummyResource>(Internal::DummyProps{ .Name = "broken", .ByteSize = 50u, }) };
+    TEST_CHECK(repaired && DummyResource::s_CreateCount == failedCount + 1u);
+    TEST_CHECK(cache.GetStatistics().Failures == before.Failures + 1u && cache.GetStatistics().Misses == before.Misses + 4u);
+
+    // Nobody holds it anymore, so it is loaded again instead of handed out.
+    first.reset();
+    second.reset();
+
+    const auto releasedCount{ DummyResource::s_CreateCount };
+    auto reloaded{ Renderer::AcquireResource<DummyResource>(texture) };
+    TEST_CHECK(reloaded && DummyResource::s_CreateCount == releasedCount + 1u);
+    TEST_CHECK(cache.GetStatistics().Misses == before.Misses + 5u && cache.GetStatistics().Hits == before.Hits + 2u);
+
+    // The reloaded one replaced its entry, the two released below expire. Only the reloaded one stays resident.
+    other.reset();
+    repaired.reset();
+    cache.Prune();
+
+    TEST_CHECK(cache.GetStatistics().Expired == before.Expired + 2u);
+    TEST_CHECK(cache.GetStatistics().Resources == before.Resources + 1u && cache.GetStatistics().ResidentBytes == before.ResidentBytes + 100u);
+
+    // Dropped for good, nothing expires twice.
+    reloaded.reset();
+    cache.Prune();
+    cache.Prune();
+
+    TEST_CHECK(cache.GetStatistics().Expired == before.Expired + 3u);
+    TEST_CHECK(cache.GetStatistics().Resources == before.Resources && cache.GetStatistics().ResidentBytes == before.ResidentBytes);
+}
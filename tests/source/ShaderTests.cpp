@@ -0,0 +1,109 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/Backend/Shader.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace Internal
+{
+    // Stand-in driver, the linked program reports the uniforms of s_Uniforms, the index being the location.
+    namespace StubGL
+    {
+        static std::span<const std::string_view> s_Uniforms{};
+
+        static GLuint APIENTRY CreateProgram() { return 1u; }
+        static void APIENTRY LinkProgram(GLuint) {}
+        static void APIENTRY DeleteProgram(GLuint) {}
+
+        static void APIENTRY GetProgramiv(GLuint, GLenum, GLint* params) { *params = GL_TRUE; }
+
+        static void APIENTRY GetProgramInterfaceiv(GLuint, GLenum, GLenum pname, GLint* params)
+        {
+            *params = pname == GL_ACTIVE_RESOURCES ? static_cast<GLint>(s_Uniforms.size()) : 32;
+        }
+
+        // Names with a dot are members of a uniform block, which have no location.
+        static void APIENTRY GetProgramResourceiv(GLuint, GLenum, GLuint index, GLsizei, const GLenum*, GLsizei, GLsizei*, GLint* params)
+        {
+            *params = s_Uniforms[index].find('.') == std::string_view::npos ? static_cast<GLint>(index) : -1;
+        }
+
+        static void APIENTRY GetProgramResourceName(GLuint, GLenum, GLuint index, GLsizei bufferSize, GLsizei* length, GLchar* name)
+        {
+            const auto& source{ s_Uniforms[index] };
+            const auto size{ std::min<std::size_t>(source.size(), static_cast<std::size_t>(bufferSize)) };
+            std::memcpy(name, source.data(), size);
+            *length = static_cast<GLsizei>(size);
+        }
+
+        static void Install() noexcept
+        {
+            glad_glCreateProgram          = &CreateProgram;
+            glad_glLinkProgram            = &LinkProgram;
+            glad_glDeleteProgram          = &DeleteProgram;
+            glad_glGetProgramiv           = &GetProgramiv;
+            glad_glGetProgramInterfaceiv  = &GetProgramInterfaceiv;
+            glad_glGetProgramResourceiv   = &GetProgramResourceiv;
+            glad_glGetProgramResourceName = &GetProgramResourceName;
+        }
+    }
+
+    static GLint GetLocation(const Renderer::Shader& shader, const std::string_view name) noexcept
+    {
+        return shader.GetUniformLocation(Renderer::UniformHandle{ name });
+    }
+
+    // Links a program with the given uniforms, then looks every one up, by the plain name too for arrays.
+    static void TestProgram(const std::span<const std::string_view> uniforms)
+    {
+        StubGL::s_Uniforms = uniforms;
+
+        Renderer::Shader shader{ Renderer::ShaderProps{} };
+        TEST_CHECK(shader.Link());
+
+        for (std::size_t i = 0u; i < uniforms.size(); ++i)
+        {
+            const auto name{ uniforms[i] };
+            const auto location{ name.find('.') == std::string_view::npos ? static_cast<GLint>(i) : -1 };
+            TEST_CHECK(Internal::GetLocation(shader, name) == location);
+
+            if (name.ends_with("[0]"))
+                TEST_CHECK(Internal::GetLocation(shader, name.substr(0u, name.size() - 3u)) == location);
+        }
+
+        // Each of these has to come back, however full the table is.
+        TEST_CHECK(Internal::GetLocation(shader, "u_Missing") == -1);
+        TEST_CHECK(Internal::GetLocation(shader, "u_Lights[1]") == -1);
+        TEST_CHECK(Internal::GetLocation(shader, "") == -1);
+    }
+}
+
+void TestShader()
+{
+    Internal::StubGL::Install();
+
+    // Every uniform an array, each one takes two slots of the table.
+    constexpr std::string_view c_Arrays[]{ "u_Lights[0]", "u_Bones[0]", "u_Cascades[0]", "u_Kernel[0]" };
+    Internal::TestProgram(c_Arrays);
+
+    constexpr std::string_view c_OddArrays[]{
+        "u_A[0]", "u_B[0]", "u_C[0]", "u_D[0]", "u_E[0]", "u_F[0]", "u_G[0]",
+        "u_H[0]", "u_I[0]", "u_J[0]", "u_K[0]", "u_L[0]", "u_M[0]",
+    };
+    Internal::TestProgram(c_OddArrays);
+
+    constexpr std::string_view c_Single[]{ "u_Lights[0]" };
+    Internal::TestProgram(c_Single);
+
+    // Plain uniforms, arrays and block members together.
+    constexpr std::string_view c_Mixed[]{ "u_Model", "u_Color", "Camera.u_View", "u_Lights[0]", "Camera.u_Projection" };
+    Internal::TestProgram(c_Mixed);
+
+    // Nothing active, every lookup misses.
+    Internal::TestProgram({});
+}
@@ -0,0 +1,142 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/Backend/StateCache.hpp>
+
+#include <glad/glad.h>
+
+#include <string_view>
+#include <vector>
+
+namespace Internal
+{
+    struct GLCall
+    {
+        std::string_view Function{};
+        std::uint32_t First{ 0u };
+        std::uint32_t Second{ 0u };
+
+        inline bool operator==(const GLCall&) const noexcept = default;
+    };
+
+    // Everything the mocked table received, in order.
+    static std::vector<GLCall> s_Calls{};
+
+    static Renderer::GLFunctionTable CreateMockTable() noexcept
+    {
+        return {
+            .UseProgram      = [](std::uint32_t program) { s_Calls.push_back({ "UseProgram", program }); },
+            .BindVertexArray = [](std::uint32_t array) { s_Calls.push_back({ "BindVertexArray", array }); },
+            .ActiveTexture   = [](std::uint32_t texture) { s_Calls.push_back({ "ActiveTexture", texture }); },
+            .BindTexture     = [](std::uint32_t target, std::uint32_t texture) { s_Calls.push_back({ "BindTexture", target, texture }); },
+            .BindTextureUnit = [](std::uint32_t unit, std::uint32_t texture) { s_Calls.push_back({ "BindTextureUnit", unit, texture }); },
+            .BindFramebuffer = [](std::uint32_t target, std::uint32_t framebuffer) { s_Calls.push_back({ "BindFramebuffer", target, framebuffer }); },
+            .Enable          = [](std::uint32_t capability) { s_Calls.push_back({ "Enable", capability }); },
+            .Disable         = [](std::uint32_t capability) { s_Calls.push_back({ "Disable", capability }); },
+            .PolygonMode     = [](std::uint32_t face, std::uint32_t mode) { s_Calls.push_back({ "PolygonMode", face, mode }); },
+            .BlendFunc       = [](std::uint32_t source, std::uint32_t destination) { s_Calls.push_back({ "BlendFunc", source, destination }); },
+        };
+    }
+
+    // The calls made since the last time, which are then forgotten.
+    static std::vector<GLCall> TakeCalls()
+    {
+        auto calls{ std::move(s_Calls) };
+        s_Calls.clear();
+        return calls;
+    }
+}
+
+void TestStateCache()
+{
+    using Internal::GLCall;
+
+    Renderer::StateCache cache{ Internal::CreateMockTable() };
+
+    // Programs and vertex arrays: only a change reaches GL.
+    cache.UseProgram(3u);
+    cache.UseProgram(3u);
+    cache.UseProgram(4u);
+    cache.BindVertexArray(7u);
+    cache.BindVertexArray(7u);
+    TEST_CHECK(Internal::TakeCalls() == std::vector<GLCall>({
+        { "UseProgram", 3u }, { "UseProgram", 4u }, { "BindVertexArray", 7u },
+    }));
+
+    // 2D textures are tracked per unit, and both ways of binding them share the record.
+    cache.ActiveTexture(0u);
+    cache.BindTexture(GL_TEXTURE_2D, 5u);
+    cache.BindTexture(GL_TEXTURE_2D, 5u);
+    cache.BindTextureUnit(0u, 5u);
+    cache.BindTextureUnit(1u, 5u);
+    cache.ActiveTexture(1u);
+    cache.BindTexture(GL_TEXTURE_2D, 5u);
+    TEST_CHECK(Internal::TakeCalls() == std::vector<GLCall>({
+        { "ActiveTexture", GL_TEXTURE0 }, { "BindTexture", GL_TEXTURE_2D, 5u },
+        { "BindTextureUnit", 1u, 5u }, { "ActiveTexture", GL_TEXTURE0 + 1u },
+    }));
+
+    // Other targets are not tracked, they always go through.
+    cache.BindTexture(GL_TEXTURE_2D_ARRAY, 6u);
+    cache.BindTexture(GL_TEXTURE_2D_ARRAY, 6u);
+    TEST_CHECK(Internal::TakeCalls().size() == 2u);
+
+    // Binding both framebuffer targets at once counts as binding each.
+    cache.BindFramebuffer(Renderer::FramebufferTarget::Both, 2u);
+    cache.BindFramebuffer(Renderer::FramebufferTarget::Read, 2u);
+    cache.BindFramebuffer(Renderer::FramebufferTarget::Draw, 2u);
+    cache.BindFramebuffer(Renderer::FramebufferTarget::Draw, 0u);
+    cache.BindFramebuffer(Renderer::FramebufferTarget::Both, 0u);
+    TEST_CHECK(Internal::TakeCalls() == std::vector<GLCall>({
+        { "BindFramebuffer", GL_FRAMEBUFFER, 2u }, { "BindFramebuffer", GL_DRAW_FRAMEBUFFER, 0u },
+        { "BindFramebuffer", GL_FRAMEBUFFER, 0u },
+    }));
+
+    cache.SetCapability(Renderer::Capability::DepthTest, true);
+    cache.SetCapability(Renderer::Capability::DepthTest, true);
+    cache.SetCapability(Renderer::Capability::DepthTest, false);
+    cache.SetPolygonMode(Renderer::PolygonMode::Line);
+    cache.SetPolygonMode(Renderer::PolygonMode::Line);
+    cache.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    cache.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    cache.SetBlendFunc(GL_ONE, GL_ONE);
+    TEST_CHECK(Internal::TakeCalls() == std::vector<GLCall>({
+        { "Enable", GL_DEPTH_TEST }, { "Disable", GL_DEPTH_TEST },
+        { "PolygonMode", GL_FRONT_AND_BACK, GL_LINE },
+        { "BlendFunc", GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA }, { "BlendFunc", GL_ONE, GL_ONE },
+    }));
+
+    // A deleted name may come back for a new object, so it has to be bound again.
+    cache.ForgetProgram(4u);
+    cache.UseProgram(4u);
+    cache.ForgetTexture(5u);
+    cache.ActiveTexture(0u);
+    cache.BindTexture(GL_TEXTURE_2D, 5u);
+    TEST_CHECK(Internal::TakeCalls() == std::vector<GLCall>({
+        { "UseProgram", 4u }, { "ActiveTexture", GL_TEXTURE0 }, { "BindTexture", GL_TEXTURE_2D, 5u },
+    }));
+
+    // After Invalidate() nothing is assumed about GL anymore.
+    cache.ResetStatistics();
+    cache.Invalidate();
+    cache.UseProgram(4u);
+    cache.UseProgram(4u);
+    cache.BindVertexArray(7u);
+    TEST_CHECK(Internal::TakeCalls().size() == 2u);
+    TEST_CHECK(cache.GetStatistics().Calls == 3u);
+    TEST_CHECK(cache.GetStatistics().Avoided == 1u);
+
+    // A frame of draws with the same program and maps, alternating between two meshes.
+    cache.ResetStatistics();
+    for (std::uint32_t draw = 0u; draw < 100u; ++draw)
+    {
+        cache.UseProgram(4u);
+        cache.BindVertexArray(7u + draw % 2u);
+        cache.BindTextureUnit(0u, 10u);
+        cache.BindTextureUnit(1u, 11u);
+    }
+
+    const auto calls{ Internal::TakeCalls() };
+    TEST_CHECK(calls.size() == 2u + 99u);
+    TEST_CHECK(cache.GetStatistics().Calls == 400u);
+    TEST_CHECK(cache.GetStatistics().Avoided == 400u - calls.size());
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <string_view>
+
+namespace Test
+{
+    // Failed checks of the run so far, main() turns them into the exit code.
+    inline std::size_t& GetFailureCount() noexcept
+    {
+        static std::size_t s_FailureCount{ 0u };
+        return s_FailureCount;
+    }
+
+    inline bool Check(const bool condition, const std::string_view expression, const char* file, const int line)
+    {
+        if (condition) return true;
+
+        spdlog::error("[Tests]: {}:{}: check failed: {}", file, line, expression);
+        ++Test::GetFailureCount();
+        return false;
+    }
+}
+
+// Logs and counts the failure, the case keeps running so one run reports everything that is wrong.
+#define TEST_CHECK(_Condition) ::Test::Check(static_cast<bool>(_Condition), #_Condition, __FILE__, __LINE__)
+
+// The cases, run by Tests.cpp in this order.
+void TestBlockCompression();
+void TestCulling();
+void TestDDSFile();
+void TestMeshBVH();
+void TestMeshOptimizer();
+void TestMipChain();
+void TestRenderSystem();
+void TestResourceCache();
+void TestShader();
+void TestStateCache();
+void TestTextureTable();
+void TestTransformBatch();
+void TestTransformHierarchy();
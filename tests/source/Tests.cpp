@@ -0,0 +1,73 @@
+#include "Test.hpp"
+
+#include <string_view>
+#include <vector>
+
+/**
+ * CPU side tests, none of them needs a window or a GL context:
+ *
+ *   crenderr-tests [case]...
+ *
+ * Without arguments every case runs, otherwise the ones named. CTest runs every case on its own.
+ */
+
+namespace Internal
+{
+    struct TestCase
+    {
+        std::string_view Name{};
+        void (*Function)(){ nullptr };
+    };
+
+    constexpr TestCase c_Cases[]{
+        { "block-compression", &TestBlockCompression },
+        { "culling", &TestCulling },
+        { "dds-file", &TestDDSFile },
+        { "mesh-bvh", &TestMeshBVH },
+        { "mesh-optimizer", &TestMeshOptimizer },
+        { "mip-chain", &TestMipChain },
+        { "render-system", &TestRenderSystem },
+        { "resource-cache", &TestResourceCache },
+        { "shader", &TestShader },
+        { "state-cache", &TestStateCache },
+        { "texture-table", &TestTextureTable },
+        { "transform-batch", &TestTransformBatch },
+        { "transform-hierarchy", &TestTransformHierarchy },
+    };
+
+    static bool IsSelected(const std::string_view name, const std::vector<std::string_view>& filters) noexcept
+    {
+        if (filters.empty()) return true;
+
+        for (const auto filter : filters)
+            if (name == filter) return true;
+
+        return false;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::vector<std::string_view> filters(argv + 1, argv + argc);
+
+    std::size_t caseCount{ 0u };
+    for (const auto& testCase : Internal::c_Cases)
+    {
+        if (!Internal::IsSelected(testCase.Name, filters)) continue;
+
+        const auto failureCount{ Test::GetFailureCount() };
+        testCase.Function();
+        ++caseCount;
+
+        if (Test::GetFailureCount() == failureCount) spdlog::info("[Tests]: {} passed", testCase.Name);
+        else spdlog::error("[Tests]: {} failed", testCase.Name);
+    }
+
+    if (!caseCount)
+    {
+        spdlog::error("[Tests]: No case matches the arguments!");
+        return EXIT_FAILURE;
+    }
+
+    return Test::GetFailureCount() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/TextureTable.hpp>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace Internal
+{
+    // Stand-in driver, it hands out texture names in order and keeps what the table did to each of them.
+    namespace StubGL
+    {
+        struct TextureObject
+        {
+            GLenum Target{ 0u };
+            GLsizei LayerCount{ 0 };
+            bool IsDeleted{ false };
+        };
+
+        // Names are the index + 1.
+        static std::vector<TextureObject> s_Textures{};
+        static std::vector<std::uint8_t> s_MappedBuffer{};
+
+        // The last texture copied into an array layer, resizes copy from array to array and are left out.
+        static GLuint s_LastCopyName{ 0u };
+        static GLint s_LastCopyLayer{ -1 };
+
+        static void APIENTRY CreateTextures(GLenum target, GLsizei n, GLuint* textures)
+        {
+            for (GLsizei i = 0; i < n; ++i)
+            {
+                s_Textures.push_back(TextureObject{ .Target = target, });
+                textures[i] = static_cast<GLuint>(s_Textures.size());
+            }
+        }
+
+        static void APIENTRY DeleteTextures(GLsizei n, const GLuint* textures)
+        {
+            for (GLsizei i = 0; i < n; ++i) s_Textures[textures[i] - 1u].IsDeleted = true;
+        }
+
+        static void APIENTRY TextureStorage3D(GLuint texture, GLsizei, GLenum, GLsizei, GLsizei, GLsizei depth)
+        {
+            s_Textures[texture - 1u].LayerCount = depth;
+        }
+
+        static void APIENTRY CopyImageSubData(GLuint, GLenum srcTarget, GLint, GLint, GLint, GLint,
+            GLuint dstName, GLenum, GLint dstLevel, GLint, GLint, GLint dstZ, GLsizei, GLsizei, GLsizei)
+        {
+            if (srcTarget != GL_TEXTURE_2D || dstLevel != 0) return;
+
+            s_LastCopyName  = dstName;
+            s_LastCopyLayer = dstZ;
+        }
+
+        static void APIENTRY GetIntegerv(GLenum pname, GLint* data) { *data = pname == GL_MAX_ARRAY_TEXTURE_LAYERS ? 2048 : 256; }
+
+        static void APIENTRY TextureParameteri(GLuint, GLenum, GLint) {}
+        static void APIENTRY TextureStorage2D(GLuint, GLsizei, GLenum, GLsizei, GLsizei) {}
+        static void APIENTRY TextureSubImage2D(GLuint, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*) {}
+
+        static void APIENTRY CreateBuffers(GLsizei, GLuint* buffers) { *buffers = 1u; }
+        static void APIENTRY NamedBufferStorage(GLuint, GLsizeiptr, const void*, GLbitfield) {}
+        static void APIENTRY DeleteBuffers(GLsizei, const GLuint*) {}
+        static GLboolean APIENTRY UnmapNamedBuffer(GLuint) { return GL_TRUE; }
+
+        static void* APIENTRY MapNamedBufferRange(GLuint, GLintptr, GLsizeiptr length, GLbitfield)
+        {
+            s_MappedBuffer.resize(static_cast<std::size_t>(length));
+            return s_MappedBuffer.data();
+        }
+
+        static void Install() noexcept
+        {
+            glad_glCreateTextures      = &CreateTextures;
+            glad_glDeleteTextures      = &DeleteTextures;
+            glad_glTextureStorage3D    = &TextureStorage3D;
+            glad_glCopyImageSubData    = &CopyImageSubData;
+            glad_glGetIntegerv         = &GetIntegerv;
+            glad_glTextureParameteri   = &TextureParameteri;
+            glad_glTextureStorage2D    = &TextureStorage2D;
+            glad_glTextureSubImage2D   = &TextureSubImage2D;
+            glad_glCreateBuffers       = &CreateBuffers;
+            glad_glNamedBufferStorage  = &NamedBufferStorage;
+            glad_glDeleteBuffers       = &DeleteBuffers;
+            glad_glUnmapNamedBuffer    = &UnmapNamedBuffer;
+            glad_glMapNamedBufferRange = &MapNamedBufferRange;
+        }
+
+        static const TextureObject& GetTexture(const Renderer::RendererID name) noexcept { return s_Textures[name - 1u]; }
+    }
+
+    static std::unique_ptr<Renderer::Texture2D> CreateTexture(const glm::ivec2& size)
+    {
+        auto texture{ std::make_unique<Renderer::Texture2D>(Renderer::Texture2DProps{ .Mipmaps = false, }) };
+        texture->AllocateStorage(size);
+        return texture;
+    }
+
+    // Resolved to the given layer of the array, which the driver saw the texture copied into.
+    static bool IsCopiedTo(const Renderer::TextureSlot& slot, const Renderer::TextureArray* array, const std::uint32_t layer) noexcept
+    {
+        return slot.Array == array && slot.Index == layer
+            && StubGL::s_LastCopyName == array->GetResourceHandle() && StubGL::s_LastCopyLayer == static_cast<GLint>(layer);
+    }
+}
+
+void TestTextureTable()
+{
+    using Renderer::TextureTable;
+
+    Internal::StubGL::Install();
+
+    // A new array has 2 layers, then 4 and 6, never 8.
+    constexpr std::uint64_t c_ReleaseFrames{ 2u };
+    TextureTable table{ Renderer::TextureTableProps{ .InitialLayers = 2u, .MaxLayers = 6u, .Capacity = 16u, .ReleaseFrames = c_ReleaseFrames, } };
+
+    TEST_CHECK(table.OnInitialize());
+    TEST_CHECK(!table.IsBindless());
+
+    table.BeginFrame();
+
+    // Nothing to copy from either.
+    const Renderer::Texture2D noStorage{ Renderer::Texture2DProps{} };
+    TEST_CHECK(!table.Resolve(nullptr).Array && table.Resolve(nullptr).Index == TextureTable::c_EmptySlot);
+    TEST_CHECK(!table.Resolve(&noStorage).Array && table.Resolve(&noStorage).Index == TextureTable::c_EmptySlot);
+
+    std::vector<std::unique_ptr<Renderer::Texture2D>> small{};
+    for (std::size_t i = 0u; i < 8u; ++i) small.push_back(Internal::CreateTexture({ 8, 8 }));
+
+    const auto large{ Internal::CreateTexture({ 16, 16 }) };
+
+    // Layers in order, the array doubles when full, but only up to MaxLayers.
+    const auto first{ table.Resolve(small[0].get()) };
+    const auto* array{ first.Array };
+    TEST_CHECK(array && Internal::IsCopiedTo(first, array, 0u));
+    TEST_CHECK(Internal::StubGL::GetTexture(array->GetResourceHandle()).LayerCount == 2);
+
+    constexpr GLsizei c_LayerCounts[]{ 2, 4, 4, 6, 6 };
+    for (std::uint32_t i = 1u; i < 6u; ++i)
+    {
+        TEST_CHECK(Internal::IsCopiedTo(table.Resolve(small[i].get()), array, i));
+        TEST_CHECK(array->GetLayerCount() == static_cast<std::uint32_t>(c_LayerCounts[i - 1u]));
+        TEST_CHECK(Internal::StubGL::GetTexture(array->GetResourceHandle()).LayerCount == c_LayerCounts[i - 1u]);
+    }
+
+    // Full at MaxLayers, the next texture of the kind starts another array, as does one of another size.
+    const auto second{ table.Resolve(small[6].get()) };
+    TEST_CHECK(second.Array && second.Array != array && Internal::IsCopiedTo(second, second.Array, 0u));
+    TEST_CHECK(second.Array->GetLayerCount() == 2u);
+
+    const auto third{ table.Resolve(large.get()) };
+    TEST_CHECK(third.Array && third.Array != array && third.Array != second.Array && Internal::IsCopiedTo(third, third.Array, 0u));
+    TEST_CHECK(table.GetStatistics().Copies == 8u);
+
+    // Unchanged, nothing is copied again.
+    Internal::StubGL::s_LastCopyName = 0u;
+    TEST_CHECK(table.Resolve(small[0].get()).Index == 0u && table.GetStatistics().Copies == 8u);
+    TEST_CHECK(Internal::StubGL::s_LastCopyName == 0u);
+
+    // Written to, copied again into the layer it has.
+    const std::vector<std::uint8_t> pixels(8u * 8u * 4u, 255u);
+    small[1]->SetRows(0u, 0u, 8u, pixels.data());
+    TEST_CHECK(Internal::IsCopiedTo(table.Resolve(small[1].get()), array, 1u));
+    TEST_CHECK(table.GetStatistics().Copies == 9u);
+
+    // Grown to another size, it moves over to the array of that size. The layer it leaves is the next one handed out.
+    small[3]->AllocateStorage({ 16, 16 });
+    TEST_CHECK(Internal::IsCopiedTo(table.Resolve(small[3].get()), third.Array, 1u));
+    TEST_CHECK(Internal::IsCopiedTo(table.Resolve(small[7].get()), array, 3u));
+
+    table.BeginFrame();
+    TEST_CHECK(table.GetStatistics().Textures == 9u && table.GetStatistics().Arrays == 3u && table.GetStatistics().Copies == 0u);
+
+    // Only the first two stay in use, the others are released once they were not resolved for ReleaseFrames frames.
+    const auto secondName{ second.Array->GetResourceHandle() };
+    const auto thirdName{ third.Array->GetResourceHandle() };
+
+    for (std::uint64_t frame = 0u; frame <= c_ReleaseFrames; ++frame)
+    {
+        TEST_CHECK(table.GetStatistics().Textures == (frame < c_ReleaseFrames ? 9u : 2u));
+
+        table.Resolve(small[0].get());
+        table.Resolve(small[1].get());
+        table.BeginFrame();
+    }
+
+    // The arrays nothing is left in are gone, the one still in use keeps its layers.
+    const auto& statistics{ table.GetStatistics() };
+    TEST_CHECK(statistics.Textures == 2u && statistics.Arrays == 1u && statistics.ArrayBytes == array->GetByteSize());
+    TEST_CHECK(Internal::StubGL::GetTexture(secondName).IsDeleted && Internal::StubGL::GetTexture(thirdName).IsDeleted);
+    TEST_CHECK(!Internal::StubGL::GetTexture(array->GetResourceHandle()).IsDeleted);
+
+    // Released layers are reused before the array grows, a texture of the dropped kind starts over.
+    const auto reused{ table.Resolve(small[2].get()) };
+    TEST_CHECK(reused.Array == array && reused.Index >= 2u && reused.Index < 6u && array->GetLayerCount() == 6u);
+
+    const auto restarted{ table.Resolve(large.get()) };
+    TEST_CHECK(restarted.Array && restarted.Array != array && restarted.Index == 0u);
+
+    table.BeginFrame();
+    TEST_CHECK(table.GetStatistics().Textures == 4u && table.GetStatistics().Arrays == 2u);
+}
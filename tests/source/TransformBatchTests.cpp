@@ -0,0 +1,131 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/TransformBatch.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    // The kernels run 8 and 4 lanes at a time, every count up to here ends on a different tail.
+    constexpr std::size_t c_MaxBatchSize{ 37u };
+    constexpr std::size_t c_RandomBatchSize{ 10'000u };
+
+    // The closed form and the SIMD sin/cos round differently than glm's chain of products.
+    // Relative to the largest scale of the matrix, the translation column has to match exactly.
+    constexpr float c_Tolerance{ 2e-6f };
+
+    constexpr Renderer::SimdLevel c_Levels[]{ Renderer::SimdLevel::Scalar, Renderer::SimdLevel::SSE, Renderer::SimdLevel::AVX2 };
+
+    static const char* GetLevelName(const Renderer::SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+        case Renderer::SimdLevel::AVX2: return "AVX2";
+        case Renderer::SimdLevel::SSE:  return "SSE";
+        default:                        return "scalar";
+        }
+    }
+
+    static Renderer::TranslationBatch CreateRandomBatch(const std::size_t size, std::mt19937& random)
+    {
+        // Angles well past a full turn and negative ones exercise the range reduction of the SIMD sin/cos.
+        std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+        std::uniform_real_distribution<float> rotation{ -1080.0f, 1080.0f };
+        std::uniform_real_distribution<float> scale{ 0.05f, 20.0f };
+        std::bernoulli_distribution isMirrored{ 0.1 };
+
+        Renderer::TranslationBatch batch{};
+        for (std::size_t i = 0u; i < size; ++i)
+        {
+            batch.Push(Renderer::Translation{
+                .Scale    = { scale(random) * (isMirrored(random) ? -1.0f : 1.0f), scale(random), scale(random), },
+                .Position = { position(random), position(random), position(random), },
+                .Rotation = { rotation(random), rotation(random), rotation(random), },
+            });
+        }
+
+        return batch;
+    }
+
+    static bool IsClose(const glm::mat4& matrix, const glm::mat4& expected) noexcept
+    {
+        const auto maxScale{ std::max({ std::abs(expected[0][0]), std::abs(expected[0][1]), std::abs(expected[0][2]),
+                                        std::abs(expected[1][0]), std::abs(expected[1][1]), std::abs(expected[1][2]),
+                                        std::abs(expected[2][0]), std::abs(expected[2][1]), std::abs(expected[2][2]), 1.0f, }) };
+
+        for (int column = 0; column < 3; ++column)
+        {
+            for (int row = 0; row < 4; ++row)
+                if (!(std::abs(matrix[column][row] - expected[column][row]) <= c_Tolerance * maxScale)) return false;
+        }
+
+        return matrix[3] == expected[3];
+    }
+
+    // Composes batch[first, first + count) into a strided array with the given level and compares every matrix.
+    static bool MatchesGLM(const Renderer::TranslationBatch& batch, const std::size_t first, const std::size_t count, const Renderer::SimdLevel level)
+    {
+        // InstanceData sized stride, the bytes in between the matrices must stay untouched.
+        constexpr std::size_t c_Stride{ sizeof(glm::mat4) + 32u };
+        constexpr std::uint8_t c_Guard{ 0xCDu };
+
+        std::vector<std::uint8_t> output((count + 1u) * c_Stride, c_Guard);
+        Renderer::ComposeModelMatrices(batch, first, count, reinterpret_cast<glm::mat4*>(output.data()), c_Stride, level);
+
+        for (std::size_t i = 0u; i < count; ++i)
+        {
+            glm::mat4 matrix{};
+            std::memcpy(&matrix, output.data() + i * c_Stride, sizeof(glm::mat4));
+
+            if (!Internal::IsClose(matrix, batch.Get(first + i).ComposeModelMatrix()))
+            {
+                spdlog::error("[Tests]:   {}: matrix {} of [{}, {}) is off", Internal::GetLevelName(level), first + i, first, first + count);
+                return false;
+            }
+        }
+
+        return std::all_of(output.begin() + sizeof(glm::mat4), output.begin() + c_Stride, [](const auto byte) { return byte == c_Guard; })
+            && std::all_of(output.begin() + count * c_Stride, output.end(), [](const auto byte) { return byte == c_Guard; });
+    }
+}
+
+void TestTransformBatch()
+{
+    std::mt19937 random{ 42u };
+
+    spdlog::info("[Tests]:   supported: {}", Internal::GetLevelName(Renderer::GetSupportedSimdLevel()));
+
+    for (const auto level : Internal::c_Levels)
+    {
+        // Every tail length of both vector widths, starting at the front and at an unaligned offset.
+        for (std::size_t size = 1u; size <= Internal::c_MaxBatchSize; ++size)
+        {
+            const auto batch{ Internal::CreateRandomBatch(size + 3u, random) };
+            TEST_CHECK(Internal::MatchesGLM(batch, 0u, size, level));
+            TEST_CHECK(Internal::MatchesGLM(batch, 3u, size, level));
+        }
+
+        const auto batch{ Internal::CreateRandomBatch(Internal::c_RandomBatchSize, random) };
+        TEST_CHECK(Internal::MatchesGLM(batch, 0u, batch.GetSize(), level));
+
+        // The identity transform has to come out exactly.
+        Renderer::TranslationBatch identity{};
+        identity.Push(Renderer::Translation{});
+
+        glm::mat4 matrix{ 0.0f };
+        Renderer::ComposeModelMatrices(identity, &matrix, sizeof(glm::mat4), level);
+        TEST_CHECK(matrix == glm::mat4{ 1.0f });
+    }
+
+    // A range past the end writes nothing.
+    const auto batch{ Internal::CreateRandomBatch(4u, random) };
+    glm::mat4 untouched{ 2.0f };
+    Renderer::ComposeModelMatrices(batch, 4u, 10u, &untouched);
+    TEST_CHECK(untouched == glm::mat4{ 2.0f });
+}
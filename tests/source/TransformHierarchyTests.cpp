@@ -0,0 +1,216 @@
+#include "Test.hpp"
+
+#include <Crenderr/Renderer/TransformHierarchy.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    constexpr std::size_t c_NodeCount{ 500u };
+
+    // The closed form composition against glm's, multiplied down chains of a few levels.
+    constexpr float c_Tolerance{ 1e-4f };
+
+    // What the hierarchy has to agree with, every node keeps its local transform and parent by handle.
+    struct NaiveNode
+    {
+        Renderer::Translation Local{};
+        Renderer::NodeHandle Parent{ Renderer::TransformHierarchy::c_NoParent };
+    };
+
+    static Renderer::Translation CreateRandomTranslation(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> position{ -10.0f, 10.0f };
+        std::uniform_real_distribution<float> rotation{ -180.0f, 180.0f };
+        std::uniform_real_distribution<float> scale{ 0.5f, 1.5f };
+
+        return Renderer::Translation{
+            .Scale    = { scale(random), scale(random), scale(random), },
+            .Position = { position(random), position(random), position(random), },
+            .Rotation = { rotation(random), rotation(random), rotation(random), },
+        };
+    }
+
+    // The parent chain multiplied out one node at a time.
+    static glm::mat4 GetNaiveWorldMatrix(const std::vector<NaiveNode>& nodes, Renderer::NodeHandle node)
+    {
+        auto matrix{ nodes[node].Local.ComposeModelMatrix() };
+        for (auto parent{ nodes[node].Parent }; parent != Renderer::TransformHierarchy::c_NoParent; parent = nodes[parent].Parent)
+            matrix = nodes[parent].Local.ComposeModelMatrix() * matrix;
+
+        return matrix;
+    }
+
+    static bool IsInSubtree(const std::vector<NaiveNode>& nodes, const Renderer::NodeHandle root, Renderer::NodeHandle node) noexcept
+    {
+        for (; node != Renderer::TransformHierarchy::c_NoParent; node = nodes[node].Parent)
+            if (node == root) return true;
+
+        return false;
+    }
+
+    static std::size_t GetSubtreeSize(const std::vector<NaiveNode>& nodes, const Renderer::NodeHandle root) noexcept
+    {
+        std::size_t size{ 0u };
+        for (Renderer::NodeHandle node = 0u; node < nodes.size(); ++node)
+            size += Internal::IsInSubtree(nodes, root, node);
+
+        return size;
+    }
+
+    static bool IsClose(const glm::mat4& matrix, const glm::mat4& expected) noexcept
+    {
+        float maxValue{ 1.0f };
+        for (int column = 0; column < 4; ++column)
+            for (int row = 0; row < 4; ++row) maxValue = std::max(maxValue, std::abs(expected[column][row]));
+
+        for (int column = 0; column < 4; ++column)
+        {
+            for (int row = 0; row < 4; ++row)
+                if (!(std::abs(matrix[column][row] - expected[column][row]) <= c_Tolerance * maxValue)) return false;
+        }
+
+        return true;
+    }
+
+    // Every node against its parent chain, looked up by handle and through the contiguous array.
+    static bool MatchesNaive(const Renderer::TransformHierarchy& hierarchy, const std::vector<NaiveNode>& nodes)
+    {
+        if (hierarchy.GetSize() != nodes.size()) return false;
+
+        const auto worldMatrices{ hierarchy.GetWorldMatrices() };
+        for (Renderer::NodeHandle node = 0u; node < nodes.size(); ++node)
+        {
+            const auto expected{ Internal::GetNaiveWorldMatrix(nodes, node) };
+            const auto subtree{ hierarchy.GetWorldMatrices(node) };
+
+            if (hierarchy.GetParent(node) != nodes[node].Parent ||
+                !Internal::IsClose(hierarchy.GetWorldMatrix(node), expected) ||
+                !Internal::IsClose(worldMatrices[hierarchy.GetIndex(node)], expected) ||
+                subtree.size() != Internal::GetSubtreeSize(nodes, node) || subtree.front() != hierarchy.GetWorldMatrix(node))
+            {
+                spdlog::error("[Tests]:   node {} at index {} is off", node, hierarchy.GetIndex(node));
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static std::vector<glm::mat4> GetMatricesByHandle(const Renderer::TransformHierarchy& hierarchy)
+    {
+        std::vector<glm::mat4> matrices(hierarchy.GetSize());
+        for (Renderer::NodeHandle node = 0u; node < matrices.size(); ++node)
+            matrices[node] = hierarchy.GetWorldMatrix(node);
+
+        return matrices;
+    }
+
+    static Renderer::NodeHandle AddNode(Renderer::TransformHierarchy& hierarchy, std::vector<NaiveNode>& nodes,
+        const Renderer::NodeHandle parent, std::mt19937& random)
+    {
+        const NaiveNode node{ .Local = Internal::CreateRandomTranslation(random), .Parent = parent, };
+        const auto handle{ hierarchy.AddNode(node.Local, parent) };
+
+        // Handed out in order and never reused.
+        TEST_CHECK(handle == nodes.size());
+        nodes.push_back(node);
+        return handle;
+    }
+}
+
+void TestTransformHierarchy()
+{
+    using Renderer::TransformHierarchy;
+
+    std::mt19937 random{ 42u };
+    std::bernoulli_distribution isRoot{ 0.05 };
+
+    TransformHierarchy hierarchy{};
+    std::vector<Internal::NaiveNode> nodes{};
+
+    // Two small trees, the first one grown after the second is in place shifts the second one back.
+    const auto first{ Internal::AddNode(hierarchy, nodes, TransformHierarchy::c_NoParent, random) };
+    const auto second{ Internal::AddNode(hierarchy, nodes, TransformHierarchy::c_NoParent, random) };
+    const auto secondChild{ Internal::AddNode(hierarchy, nodes, second, random) };
+    TEST_CHECK(hierarchy.GetIndex(second) == 1u && hierarchy.GetIndex(secondChild) == 2u);
+
+    const auto firstChild{ Internal::AddNode(hierarchy, nodes, first, random) };
+    TEST_CHECK(hierarchy.GetIndex(firstChild) == 1u);
+    TEST_CHECK(hierarchy.GetIndex(second) == 2u && hierarchy.GetIndex(secondChild) == 3u);
+
+    // Then parents anywhere in the tree, most inserts land in front of nodes that are already there.
+    while (nodes.size() < Internal::c_NodeCount)
+    {
+        std::uniform_int_distribution<Renderer::NodeHandle> parent{ 0u, static_cast<Renderer::NodeHandle>(nodes.size() - 1u) };
+        Internal::AddNode(hierarchy, nodes, isRoot(random) ? TransformHierarchy::c_NoParent : parent(random), random);
+    }
+
+    TEST_CHECK(hierarchy.Update() == nodes.size());
+    TEST_CHECK(Internal::MatchesNaive(hierarchy, nodes));
+
+    // The handles still lead to what was set on them, wherever the nodes moved.
+    for (Renderer::NodeHandle node = 0u; node < nodes.size(); ++node)
+    {
+        const auto local{ hierarchy.GetLocal(node) };
+        TEST_CHECK(local.Position == nodes[node].Local.Position && local.Rotation == nodes[node].Local.Rotation && local.Scale == nodes[node].Local.Scale);
+    }
+
+    // Nothing dirty, nothing touched.
+    const auto before{ Internal::GetMatricesByHandle(hierarchy) };
+    TEST_CHECK(hierarchy.Update() == 0u);
+    TEST_CHECK(Internal::GetMatricesByHandle(hierarchy) == before);
+
+    // One dirty node with children below it, only its subtree may change.
+    auto dirtyNode{ firstChild };
+    for (Renderer::NodeHandle node = 0u; node < nodes.size(); ++node)
+    {
+        const auto size{ Internal::GetSubtreeSize(nodes, node) };
+        if (nodes[node].Parent != TransformHierarchy::c_NoParent && size > 3u && size < nodes.size() / 4u)
+        {
+            dirtyNode = node;
+            break;
+        }
+    }
+
+    nodes[dirtyNode].Local = Internal::CreateRandomTranslation(random);
+    hierarchy.SetLocal(dirtyNode, nodes[dirtyNode].Local);
+    hierarchy.SetLocal(dirtyNode, nodes[dirtyNode].Local);
+
+    TEST_CHECK(hierarchy.Update() == Internal::GetSubtreeSize(nodes, dirtyNode));
+    TEST_CHECK(Internal::MatchesNaive(hierarchy, nodes));
+
+    const auto after{ Internal::GetMatricesByHandle(hierarchy) };
+    for (Renderer::NodeHandle node = 0u; node < nodes.size(); ++node)
+    {
+        if (Internal::IsInSubtree(nodes, dirtyNode, node)) TEST_CHECK(after[node] != before[node]);
+        else TEST_CHECK(std::memcmp(&after[node], &before[node], sizeof(glm::mat4)) == 0);
+    }
+
+    // A dirty node below a dirty ancestor is covered by the ancestor's pass.
+    const auto dirtyChild{ static_cast<Renderer::NodeHandle>(std::find_if(nodes.begin(), nodes.end(),
+        [dirtyNode](const auto& node) { return node.Parent == dirtyNode; }) - nodes.begin()) };
+    hierarchy.SetLocal(dirtyChild, nodes[dirtyChild].Local);
+    hierarchy.SetLocal(dirtyNode, nodes[dirtyNode].Local);
+    TEST_CHECK(hierarchy.Update() == Internal::GetSubtreeSize(nodes, dirtyNode));
+
+    // Nodes added to the front subtree after an update, the ones moved back keep their matrices.
+    for (std::size_t i = 0u; i < 20u; ++i)
+        Internal::AddNode(hierarchy, nodes, i % 2u ? first : firstChild, random);
+
+    hierarchy.Update();
+    TEST_CHECK(Internal::MatchesNaive(hierarchy, nodes));
+
+    // A parent that does not exist adds nothing.
+    TEST_CHECK(hierarchy.AddNode(Renderer::Translation{}, static_cast<Renderer::NodeHandle>(nodes.size())) == TransformHierarchy::c_NoParent);
+    TEST_CHECK(hierarchy.GetSize() == nodes.size());
+
+    hierarchy.Clear();
+    TEST_CHECK(hierarchy.GetSize() == 0u && hierarchy.Update() == 0u);
+}
@@ -0,0 +1,97 @@
+#include "Benchmark.hpp"
+
+#include <Crenderr/Renderer/BoundingVolumeHierarchy.hpp>
+#include <Crenderr/Renderer/Culling.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    constexpr std::size_t c_StaticCount{ 1'000'000u };
+    constexpr std::size_t c_DynamicCount{ 10'000u };
+    constexpr std::size_t c_RayCount{ 100'000u };
+
+    constexpr float c_SceneExtent{ 1000.0f };
+
+    // How far a dynamic object moves between two frames.
+    constexpr float c_FrameStep{ 0.5f };
+
+    static Renderer::BoundingBox CreateBox(const glm::vec3& center, const glm::vec3& extent) noexcept
+    {
+        return Renderer::BoundingBox{ .Min = center - extent, .Max = center + extent, };
+    }
+}
+
+void BenchmarkBoundingVolumeHierarchy()
+{
+    std::mt19937 random{ 42u };
+    std::uniform_real_distribution<float> position{ -Internal::c_SceneExtent, Internal::c_SceneExtent };
+    std::uniform_real_distribution<float> size{ 0.5f, 5.0f };
+    std::uniform_real_distribution<float> step{ -Internal::c_FrameStep, Internal::c_FrameStep };
+
+    // The dynamic objects come last, the way a scene adds its moving entities after the level geometry.
+    const auto objectCount{ Internal::c_StaticCount + Internal::c_DynamicCount };
+    std::vector<Renderer::BoundingBox> bounds(objectCount);
+    for (auto& box : bounds)
+        box = Internal::CreateBox({ position(random), position(random), position(random) }, { size(random), size(random), size(random) });
+
+    Renderer::BoundingVolumeHierarchy tree{};
+    const auto buildTime{ Benchmark::Measure(5u, [&tree, &bounds]() { tree.Build(bounds); }) };
+
+    // Every frame moves each dynamic object a little and refits, a different step each run.
+    const auto refitTime{ Benchmark::Measure(10u, [&]() {
+        for (std::size_t i = Internal::c_StaticCount; i < objectCount; ++i)
+        {
+            const glm::vec3 offset{ step(random), step(random), step(random) };
+            bounds[i] = Renderer::BoundingBox{ .Min = bounds[i].Min + offset, .Max = bounds[i].Max + offset, };
+            tree.SetBounds(static_cast<std::uint32_t>(i), bounds[i]);
+        }
+
+        tree.Refit();
+    }) };
+
+    // The same frustum as the culling case, the tree against testing every box of the batch.
+    const auto projection{ glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, Internal::c_SceneExtent) };
+    const auto view{ glm::lookAt(glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 0.0f, -1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }) };
+    const auto frustum{ Renderer::Frustum::FromMatrix(projection * view) };
+
+    std::vector<std::uint32_t> visibleObjects{};
+    const auto queryTime{ Benchmark::Measure(10u, [&tree, &frustum, &visibleObjects]() {
+        visibleObjects.clear();
+        tree.QueryFrustum(frustum, visibleObjects);
+    }) };
+
+    Renderer::BoxBatch batch{};
+    for (const auto& box : bounds) batch.Push(box);
+
+    std::vector<std::uint8_t> visibility(objectCount);
+    std::size_t visibleCount{ 0u };
+    const auto cullTime{ Benchmark::Measure(10u, [&]() { visibleCount = Renderer::CullBoxes(frustum, batch, visibility.data()); }) };
+
+    if (visibleObjects.size() != visibleCount)
+        spdlog::warn("[Benchmarks]:   The tree found {} visible boxes, the batch {}!", visibleObjects.size(), visibleCount);
+
+    // Rays from the camera into random directions, like picking with the cursor anywhere on the screen.
+    std::vector<Renderer::Ray> rays(Internal::c_RayCount);
+    for (auto& ray : rays)
+        ray = Renderer::Ray{ .Direction = glm::normalize(glm::vec3{ position(random), position(random), position(random) }), };
+
+    std::size_t hitCount{ 0u };
+    const auto rayTime{ Benchmark::Measure(5u, [&tree, &rays, &hitCount]() {
+        hitCount = 0u;
+        for (const auto& ray : rays) hitCount += tree.Raycast(ray).IsValid();
+    }) };
+
+    spdlog::info("[Benchmarks]:   {} static, {} dynamic boxes, {} nodes, depth {}", Internal::c_StaticCount, Internal::c_DynamicCount,
+        tree.GetNodeCount(), tree.GetMaxDepth());
+    spdlog::info("[Benchmarks]:   build                  {:8.2f} ms", buildTime);
+    spdlog::info("[Benchmarks]:   move dynamic + refit   {:8.2f} ms", refitTime);
+    spdlog::info("[Benchmarks]:   frustum, tree          {:8.2f} ms, {} visible", queryTime, visibleObjects.size());
+    spdlog::info("[Benchmarks]:   frustum, every box     {:8.2f} ms ({:.1f}x)", cullTime, queryTime > 0.0 ? cullTime / queryTime : 0.0);
+    spdlog::info("[Benchmarks]:   raycast                {:8.2f} ms {:8.2f} M rays/s, {} hits", rayTime,
+        Benchmark::GetRate(Internal::c_RayCount, rayTime) / 1e6, hitCount);
+}
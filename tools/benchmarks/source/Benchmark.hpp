@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Crenderr/Renderer/Simd.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace Benchmark
+{
+    // Median wall time of the runs in milliseconds, after one run thrown away to warm the caches up.
+    template<typename _Fn>
+    inline double Measure(const std::size_t runCount, _Fn&& function)
+    {
+        function();
+
+        std::vector<double> times(std::max<std::size_t>(runCount, 1u));
+        for (auto& time : times)
+        {
+            const auto startTime{ std::chrono::steady_clock::now() };
+            function();
+            time = std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - startTime }.count();
+        }
+
+        std::nth_element(times.begin(), times.begin() + times.size() / 2u, times.end());
+        return times[times.size() / 2u];
+    }
+
+    // The loaders log every call, which would end up in the measured time.
+    class QuietLog
+    {
+    public:
+        QuietLog() noexcept : m_Level{ spdlog::get_level() } { spdlog::set_level(spdlog::level::warn); }
+        ~QuietLog() { spdlog::set_level(m_Level); }
+
+        QuietLog(const QuietLog&) = delete;
+        QuietLog& operator=(const QuietLog&) = delete;
+
+    private:
+        spdlog::level::level_enum m_Level{};
+    };
+
+    inline double GetRate(const double count, const double milliseconds) noexcept
+    {
+        return milliseconds > 0.0 ? count / (milliseconds / 1000.0) : 0.0;
+    }
+
+    inline const char* GetLevelName(const Renderer::SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+        case Renderer::SimdLevel::AVX2: return "AVX2";
+        case Renderer::SimdLevel::SSE:  return "SSE";
+        default:                        return "scalar";
+        }
+    }
+
+    // Generated inputs go here, the directory is removed once every case ran.
+    std::filesystem::path GetScratchDirectory();
+
+    // Wavy grid of size x size quads with texcoords and normals, written once per size and reused.
+    std::filesystem::path WriteGridOBJ(std::size_t size);
+}
+
+// The cases, run by Benchmarks.cpp in this order.
+void BenchmarkOBJParser();
+void BenchmarkOBJParserScaling();
+void BenchmarkMeshCache();
+void BenchmarkUniformCache();
+void BenchmarkTransformBatch();
+void BenchmarkTransformHierarchy();
+void BenchmarkFrustumCulling();
+void BenchmarkBoundingVolumeHierarchy();
+void BenchmarkMeshBVH();
+void BenchmarkSceneIteration();
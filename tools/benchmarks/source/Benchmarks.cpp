@@ -0,0 +1,71 @@
+#include "Benchmark.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <string_view>
+#include <vector>
+
+/**
+ * CPU side benchmarks of the loaders and the scene, none of them needs a window or a GL context:
+ *
+ *   crenderr-benchmarks [case]...
+ *
+ * Without arguments every case runs, otherwise the ones whose name starts with any of the arguments.
+ * Build in Release, the numbers of a debug build say nothing.
+ */
+
+namespace Internal
+{
+    struct BenchmarkCase
+    {
+        std::string_view Name{};
+        void (*Function)(){ nullptr };
+    };
+
+    constexpr BenchmarkCase c_Cases[]{
+        { "obj-parser", &BenchmarkOBJParser },
+        { "obj-parser-scaling", &BenchmarkOBJParserScaling },
+        { "mesh-cache", &BenchmarkMeshCache },
+        { "uniform-cache", &BenchmarkUniformCache },
+        { "transform-batch", &BenchmarkTransformBatch },
+        { "transform-hierarchy", &BenchmarkTransformHierarchy },
+        { "frustum-culling", &BenchmarkFrustumCulling },
+        { "bvh", &BenchmarkBoundingVolumeHierarchy },
+        { "mesh-bvh", &BenchmarkMeshBVH },
+        { "scene-iteration", &BenchmarkSceneIteration },
+    };
+
+    static bool IsSelected(const std::string_view name, const std::vector<std::string_view>& filters) noexcept
+    {
+        if (filters.empty()) return true;
+
+        for (const auto filter : filters)
+            if (name.starts_with(filter)) return true;
+
+        return false;
+    }
+}
+
+std::filesystem::path Benchmark::GetScratchDirectory()
+{
+    const auto directory{ std::filesystem::temp_directory_path() / "crenderr-benchmarks" };
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+int main(int argc, char** argv)
+{
+    const std::vector<std::string_view> filters(argv + 1, argv + argc);
+
+    for (const auto& benchmarkCase : Internal::c_Cases)
+    {
+        if (!Internal::IsSelected(benchmarkCase.Name, filters)) continue;
+
+        spdlog::info("[Benchmarks]: {}", benchmarkCase.Name);
+        benchmarkCase.Function();
+    }
+
+    std::error_code error{};
+    std::filesystem::remove_all(std::filesystem::temp_directory_path() / "crenderr-benchmarks", error);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#include "Benchmark.hpp"
+
+#include <Crenderr/Renderer/Culling.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    constexpr std::size_t c_VolumeCount{ 1'000'000u };
+
+    // Scattered around a camera at the origin looking down -z, about a tenth ends up in view.
+    constexpr float c_SceneExtent{ 1000.0f };
+
+    static Renderer::Frustum GetFrustum() noexcept
+    {
+        const auto projection{ glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, Internal::c_SceneExtent) };
+        const auto view{ glm::lookAt(glm::vec3{ 0.0f }, glm::vec3{ 0.0f, 0.0f, -1.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }) };
+        return Renderer::Frustum::FromMatrix(projection * view);
+    }
+
+    // One entry per level the kernels run at, timed and checked against the per volume test.
+    template<typename _Batch, typename _Volume, typename _Cull>
+    static void MeasureCulling(const char* name, const std::vector<_Volume>& volumes, _Cull&& cull)
+    {
+        const auto frustum{ Internal::GetFrustum() };
+
+        _Batch batch{};
+        for (const auto& volume : volumes) batch.Push(volume);
+
+        // What the renderer did before the batches, Frustum::Intersects() on one volume after the other.
+        std::vector<std::uint8_t> expected(volumes.size());
+        const auto loopTime{ Benchmark::Measure(5u, [&]() {
+            for (std::size_t i = 0u; i < volumes.size(); ++i)
+                expected[i] = frustum.Intersects(volumes[i]);
+        }) };
+
+        const auto visibleCount{ std::count(expected.begin(), expected.end(), std::uint8_t{ 1u }) };
+        spdlog::info("[Benchmarks]:   {}: {} visible", name, visibleCount);
+        spdlog::info("[Benchmarks]:   per volume             {:8.2f} ms {:8.1f} M/s", loopTime, Benchmark::GetRate(volumes.size(), loopTime) / 1e6);
+
+        std::vector<std::uint8_t> visibility(volumes.size());
+        for (const auto level : { Renderer::SimdLevel::Scalar, Renderer::SimdLevel::SSE, Renderer::SimdLevel::AVX2 })
+        {
+            if (level > Renderer::GetSupportedSimdLevel()) continue;
+
+            const auto time{ Benchmark::Measure(5u, [&]() { cull(frustum, batch, visibility.data(), level); }) };
+            if (visibility != expected)
+                spdlog::warn("[Benchmarks]:   The {} kernel disagrees with the per volume test!", Benchmark::GetLevelName(level));
+
+            spdlog::info("[Benchmarks]:   batch, {:6}          {:8.2f} ms {:8.1f} M/s ({:.1f}x)", Benchmark::GetLevelName(level), time,
+                Benchmark::GetRate(volumes.size(), time) / 1e6, time > 0.0 ? loopTime / time : 0.0);
+        }
+    }
+}
+
+void BenchmarkFrustumCulling()
+{
+    std::mt19937 random{ 42u };
+    std::uniform_real_distribution<float> position{ -Internal::c_SceneExtent, Internal::c_SceneExtent };
+    std::uniform_real_distribution<float> size{ 0.5f, 5.0f };
+
+    std::vector<Renderer::BoundingSphere> spheres(Internal::c_VolumeCount);
+    std::vector<Renderer::BoundingBox> boxes(Internal::c_VolumeCount);
+    for (std::size_t i = 0u; i < Internal::c_VolumeCount; ++i)
+    {
+        const glm::vec3 center{ position(random), position(random), position(random) };
+        const glm::vec3 extent{ size(random), size(random), size(random) };
+
+        spheres[i] = Renderer::BoundingSphere{ .Center = center, .Radius = glm::length(extent), };
+        boxes[i]   = Renderer::BoundingBox{ .Min = center - extent, .Max = center + extent, };
+    }
+
+    spdlog::info("[Benchmarks]:   {} volumes, supported: {}", Internal::c_VolumeCount, Benchmark::GetLevelName(Renderer::GetSupportedSimdLevel()));
+
+    Internal::MeasureCulling<Renderer::SphereBatch>("spheres", spheres, [](const auto& frustum, const auto& batch, auto* visibility, const auto level) {
+        Renderer::CullSpheres(frustum, batch, visibility, level);
+    });
+    Internal::MeasureCulling<Renderer::BoxBatch>("boxes", boxes, [](const auto& frustum, const auto& batch, auto* visibility, const auto level) {
+        Renderer::CullBoxes(frustum, batch, visibility, level);
+    });
+}
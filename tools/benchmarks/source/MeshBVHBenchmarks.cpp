@@ -0,0 +1,144 @@
+#include "Benchmark.hpp"
+
+#include <Crenderr/Renderer/MeshBVH.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    // 8k, 131k and 2.1M triangles.
+    constexpr std::size_t c_MeshGridSizes[]{ 64u, 256u, 1024u };
+
+    constexpr std::size_t c_CameraResolution{ 512u };
+    constexpr std::size_t c_RandomRayCount{ 262'144u };
+
+    struct GridMesh
+    {
+        std::vector<glm::vec3> Positions{};
+        std::vector<std::uint32_t> Indices{};
+    };
+
+    // The surface of Benchmark::WriteGridOBJ(), made in memory so the parser is not part of the numbers.
+    static GridMesh CreateGrid(const std::size_t size)
+    {
+        GridMesh grid{};
+
+        const auto step{ 1.0f / static_cast<float>(size) };
+        for (std::size_t y = 0u; y <= size; ++y)
+        {
+            for (std::size_t x = 0u; x <= size; ++x)
+            {
+                const auto u{ static_cast<float>(x) * step };
+                const auto v{ static_cast<float>(y) * step };
+                grid.Positions.emplace_back(u - 0.5f, 0.05f * std::sin(u * 25.0f) * std::cos(v * 25.0f), v - 0.5f);
+            }
+        }
+
+        const auto row{ static_cast<std::uint32_t>(size + 1u) };
+        for (std::uint32_t y = 0u; y + 1u < row; ++y)
+        {
+            for (std::uint32_t x = 0u; x + 1u < row; ++x)
+            {
+                const auto a{ y * row + x }, b{ a + 1u }, c{ a + row }, d{ c + 1u };
+                grid.Indices.insert(grid.Indices.end(), { a, b, c, b, d, c, });
+            }
+        }
+
+        return grid;
+    }
+
+    // A 60 degree camera looking down at the grid from above one corner, neighbouring pixels next to each other.
+    static std::vector<Renderer::Ray> CreateCameraRays()
+    {
+        const glm::vec3 origin{ 0.0f, 0.8f, 0.8f };
+        const auto forward{ glm::normalize(-origin) };
+        const auto right{ glm::normalize(glm::cross(forward, glm::vec3{ 0.0f, 1.0f, 0.0f })) };
+        const auto up{ glm::cross(right, forward) };
+
+        const auto halfSize{ std::tan(glm::radians(30.0f)) };
+        const auto resolution{ static_cast<float>(Internal::c_CameraResolution) };
+
+        std::vector<Renderer::Ray> rays{};
+        for (std::size_t y = 0u; y < Internal::c_CameraResolution; ++y)
+        {
+            for (std::size_t x = 0u; x < Internal::c_CameraResolution; ++x)
+            {
+                const auto u{ (2.0f * (static_cast<float>(x) + 0.5f) / resolution - 1.0f) * halfSize };
+                const auto v{ (2.0f * (static_cast<float>(y) + 0.5f) / resolution - 1.0f) * halfSize };
+                rays.push_back(Renderer::Ray{ .Origin = origin, .Direction = glm::normalize(forward + right * u + up * v), });
+            }
+        }
+
+        return rays;
+    }
+
+    // Incoherent rays, from anywhere around the grid into any direction, about half of them miss.
+    static std::vector<Renderer::Ray> CreateRandomRays()
+    {
+        std::mt19937 random{ 42u };
+        std::uniform_real_distribution<float> position{ -1.0f, 1.0f };
+
+        std::vector<Renderer::Ray> rays(Internal::c_RandomRayCount);
+        for (auto& ray : rays)
+        {
+            const glm::vec3 origin{ position(random), position(random), position(random) };
+            const glm::vec3 target{ 0.5f * position(random), 0.05f * position(random), 0.5f * position(random) };
+            ray = Renderer::Ray{ .Origin = origin, .Direction = glm::normalize(target - origin + 0.5f * glm::vec3{ position(random), 0.0f, position(random) }), };
+        }
+
+        return rays;
+    }
+
+    // Rays per second at every supported level, SSE and AVX2 are compared against the scalar hits.
+    static void MeasureRays(const char* name, const Renderer::MeshBVH& mesh, const std::vector<Renderer::Ray>& rays)
+    {
+        std::vector<Renderer::TriangleHit> expected(rays.size()), hits(rays.size());
+
+        std::string line{};
+        for (const auto level : { Renderer::SimdLevel::Scalar, Renderer::SimdLevel::SSE, Renderer::SimdLevel::AVX2 })
+        {
+            if (level > Renderer::GetSupportedSimdLevel()) continue;
+
+            auto& output{ level == Renderer::SimdLevel::Scalar ? expected : hits };
+            const auto time{ Benchmark::Measure(3u, [&]() { mesh.IntersectRays(rays, output, std::numeric_limits<float>::max(), level); }) };
+
+            std::size_t mismatchCount{ 0u };
+            for (std::size_t i = 0u; i < rays.size(); ++i)
+                mismatchCount += output[i].Triangle != expected[i].Triangle;
+
+            line += fmt::format(" {} {:.2f}", Benchmark::GetLevelName(level), Benchmark::GetRate(rays.size(), time) / 1e6);
+            if (mismatchCount) line += fmt::format(" ({} differ)", mismatchCount);
+        }
+
+        std::size_t hitCount{ 0u };
+        for (const auto& hit : expected) hitCount += hit.IsValid();
+
+        spdlog::info("[Benchmarks]:     {}, {} hits, M rays/s:{}", name, hitCount, line);
+    }
+}
+
+void BenchmarkMeshBVH()
+{
+    const auto cameraRays{ Internal::CreateCameraRays() };
+    const auto randomRays{ Internal::CreateRandomRays() };
+
+    spdlog::info("[Benchmarks]:   {}x{} camera rays, {} random rays, supported: {}", Internal::c_CameraResolution, Internal::c_CameraResolution,
+        randomRays.size(), Benchmark::GetLevelName(Renderer::GetSupportedSimdLevel()));
+
+    for (const auto size : Internal::c_MeshGridSizes)
+    {
+        const auto grid{ Internal::CreateGrid(size) };
+
+        Renderer::MeshBVH mesh{};
+        const auto buildTime{ Benchmark::Measure(3u, [&mesh, &grid]() { mesh.Build(grid.Positions.data(), grid.Positions.size(), grid.Indices); }) };
+
+        spdlog::info("[Benchmarks]:   {} triangles, build {:.1f} ms", mesh.GetTriangleCount(), buildTime);
+        Internal::MeasureRays("camera", mesh, cameraRays);
+        Internal::MeasureRays("random", mesh, randomRays);
+    }
+}
@@ -0,0 +1,234 @@
+#include "Benchmark.hpp"
+
+#include <Crenderr/Renderer/Loaders/OBJLoader.hpp>
+#include <Crenderr/Renderer/Loaders/MeshCache.hpp>
+#include <Crenderr/Utility/ThreadPool.hpp>
+
+#include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <tuple>
+
+namespace Internal
+{
+    constexpr std::size_t c_ParserGridSize{ 512u };
+
+    // Two million triangles, large enough for every thread count to get chunks of its own.
+    constexpr std::size_t c_ScalingGridSize{ 1024u };
+    constexpr std::size_t c_ScalingThreadCounts[]{ 1u, 2u, 4u, 8u, 16u };
+
+    constexpr std::size_t c_CacheGridSize{ 512u };
+    constexpr std::uint64_t c_CacheLoaderKey{ 0u };
+
+    static std::tuple<std::uint32_t, std::uint32_t, std::uint32_t> SplitFace(const std::string& face)
+    {
+        constexpr char delimeter{ '/' };
+
+        const auto firstDelimeter{ face.find(delimeter) };
+        const auto secondDelimeter{ face.find(delimeter, firstDelimeter + 1u) };
+
+        const auto substr1{ face.substr(0u, firstDelimeter) };
+        const auto substr2{ firstDelimeter == std::string::npos ? "" : face.substr(firstDelimeter + 1u, secondDelimeter - firstDelimeter - 1u) };
+        const auto substr3{ secondDelimeter == std::string::npos ? "" : face.substr(secondDelimeter + 1u, face.size() - secondDelimeter) };
+
+        return std::make_tuple(
+            static_cast<std::uint32_t>(std::stoi(substr1.empty() ? "-1" : substr1)),
+            static_cast<std::uint32_t>(std::stoi(substr2.empty() ? "-1" : substr2)),
+            static_cast<std::uint32_t>(std::stoi(substr3.empty() ? "-1" : substr3))
+        );
+    }
+
+    // The ifstream and stoi based loader the mapped parser replaced, triangles only, kept as the baseline.
+    static std::vector<Renderer::Vertex3D> LoadOBJFileWithStreams(const std::string& filepath)
+    {
+        std::ifstream file{ filepath };
+        if (!file.is_open()) return {};
+
+        std::vector<glm::vec3> vertices{};
+        std::vector<glm::vec3> normals{};
+        std::vector<glm::vec2> texCoords{};
+
+        std::vector<Renderer::Vertex3D> data{};
+
+        while (!file.eof())
+        {
+            std::string lineHeader{};
+            file >> lineHeader;
+
+            if (lineHeader == "v")
+            {
+                glm::vec3 vertex{};
+                file >> vertex.x >> vertex.y >> vertex.z;
+                vertices.push_back(vertex);
+            }
+            else if (lineHeader == "vt")
+            {
+                glm::vec2 texCoord{};
+                file >> texCoord.x >> texCoord.y;
+                texCoords.push_back(texCoord);
+            }
+            else if (lineHeader == "vn")
+            {
+                glm::vec3 normal{};
+                file >> normal.x >> normal.y >> normal.z;
+                normals.push_back(normal);
+            }
+            else if (lineHeader == "f")
+            {
+                std::string faces[3u]{};
+                file >> faces[0u] >> faces[1u] >> faces[2u];
+
+                for (std::size_t i = 0u; i < 3u; ++i)
+                {
+                    constexpr auto invalidValue{ static_cast<std::uint32_t>(-1) };
+                    const auto [vi, ti, ni]{ Internal::SplitFace(faces[i]) };
+
+                    data.push_back({
+                        vi == invalidValue ? glm::vec3{} : vertices.at(vi - 1u),
+                        ni == invalidValue ? glm::vec3{} : normals.at(ni - 1u),
+                        ti == invalidValue ? glm::vec2{} : texCoords.at(ti - 1u)
+                    });
+                }
+            }
+        }
+
+        return data;
+    }
+}
+
+std::filesystem::path Benchmark::WriteGridOBJ(const std::size_t size)
+{
+    const auto path{ Benchmark::GetScratchDirectory() / fmt::format("grid-{}.obj", size) };
+    if (std::filesystem::exists(path)) return path;
+
+    std::string text{};
+    auto output{ std::back_inserter(text) };
+
+    const auto step{ 1.0f / static_cast<float>(size) };
+    for (std::size_t y = 0u; y <= size; ++y)
+    {
+        for (std::size_t x = 0u; x <= size; ++x)
+        {
+            const auto u{ static_cast<float>(x) * step };
+            const auto v{ static_cast<float>(y) * step };
+            const auto height{ 0.05f * std::sin(u * 25.0f) * std::cos(v * 25.0f) };
+
+            fmt::format_to(output, "v {:.6f} {:.6f} {:.6f}\nvt {:.6f} {:.6f}\nvn {:.6f} {:.6f} {:.6f}\n",
+                u - 0.5f, height, v - 0.5f, u, v, 0.0f, 1.0f, 0.0f);
+        }
+    }
+
+    // Two triangles per quad, every corner indexes all three attributes with the same number.
+    const auto row{ size + 1u };
+    for (std::size_t y = 0u; y < size; ++y)
+    {
+        for (std::size_t x = 0u; x < size; ++x)
+        {
+            const auto a{ y * row + x + 1u }, b{ a + 1u }, c{ a + row }, d{ c + 1u };
+            fmt::format_to(output, "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\nf {1}/{1}/{1} {3}/{3}/{3} {2}/{2}/{2}\n", a, b, c, d);
+        }
+    }
+
+    std::ofstream file{ path, std::ios::binary };
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return path;
+}
+
+void BenchmarkOBJParser()
+{
+    const auto path{ Benchmark::WriteGridOBJ(Internal::c_ParserGridSize).string() };
+    const auto megabytes{ static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0) };
+
+    double streamTime{}, mappedTime{};
+    {
+        const Benchmark::QuietLog quiet{};
+
+        streamTime = Benchmark::Measure(3u, [&path]() { Internal::LoadOBJFileWithStreams(path); });
+        mappedTime = Benchmark::Measure(3u, [&path]() {
+            LoadOBJFile(path, OBJLoaderProps{ .ThreadCount = 1u, .OptimizeVertexCache = false, });
+        });
+    }
+
+    spdlog::info("[Benchmarks]:   {:.1f} MB, {} triangles", megabytes, Internal::c_ParserGridSize * Internal::c_ParserGridSize * 2u);
+    spdlog::info("[Benchmarks]:   ifstream + stoi        {:8.1f} ms {:8.1f} MB/s", streamTime, Benchmark::GetRate(megabytes, streamTime));
+    spdlog::info("[Benchmarks]:   mapped + from_chars    {:8.1f} ms {:8.1f} MB/s ({:.1f}x)", mappedTime, Benchmark::GetRate(megabytes, mappedTime),
+        mappedTime > 0.0 ? streamTime / mappedTime : 0.0);
+}
+
+void BenchmarkOBJParserScaling()
+{
+    const auto path{ Benchmark::WriteGridOBJ(Internal::c_ScalingGridSize).string() };
+    const auto megabytes{ static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0) };
+
+    spdlog::info("[Benchmarks]:   {:.1f} MB, {} triangles, {} hardware threads", megabytes,
+        Internal::c_ScalingGridSize * Internal::c_ScalingGridSize * 2u, ThreadPool::GetHardwareThreadCount());
+
+    double serialTime{ 0.0 };
+    for (const auto threadCount : Internal::c_ScalingThreadCounts)
+    {
+        double time{};
+        {
+            const Benchmark::QuietLog quiet{};
+            time = Benchmark::Measure(3u, [&path, threadCount]() {
+                LoadOBJFile(path, OBJLoaderProps{ .ThreadCount = threadCount, .OptimizeVertexCache = false, });
+            });
+        }
+
+        if (threadCount == 1u) serialTime = time;
+        spdlog::info("[Benchmarks]:   {:2} threads {:8.1f} ms {:8.1f} MB/s ({:.2f}x)", threadCount, time,
+            Benchmark::GetRate(megabytes, time), time > 0.0 ? serialTime / time : 0.0);
+    }
+}
+
+void BenchmarkMeshCache()
+{
+    const auto path{ Benchmark::WriteGridOBJ(Internal::c_CacheGridSize).string() };
+    const auto& layout{ Renderer::Vertex3D::c_Layout };
+
+    // Cold is what the first run of LoadOBJModel() does on the CPU, warm what every later run does.
+    // Both stop where the buffers would be created, the warm one reads every mapped byte like the upload would.
+    std::size_t vertexCount{ 0u }, indexCount{ 0u };
+    double coldTime{}, warmTime{};
+    {
+        const Benchmark::QuietLog quiet{};
+
+        coldTime = Benchmark::Measure(3u, [&]() {
+            const auto model{ LoadOBJFile(path, OBJLoaderProps{}) };
+            WriteMeshCache(path, Internal::c_CacheLoaderKey, {
+                .Vertices    = model.Data.data(),
+                .VertexCount = model.Data.size(),
+                .Indices     = model.Indices.data(),
+                .IndexCount  = model.Indices.size(),
+                .Layout      = &layout,
+                .Bounds      = model.Bounds,
+            });
+
+            vertexCount = model.Data.size();
+            indexCount  = model.Indices.size();
+        });
+
+        std::uint64_t checksum{ 0u };
+        warmTime = Benchmark::Measure(10u, [&]() {
+            MeshCacheData cache{};
+            if (!ReadMeshCache(path, Internal::c_CacheLoaderKey, layout, cache)) return;
+
+            const auto* bytes{ static_cast<const std::uint8_t*>(cache.Vertices) };
+            checksum += std::accumulate(bytes, bytes + cache.VertexCount * layout.GetStride(), std::uint64_t{ 0u });
+            checksum += std::accumulate(cache.Indices, cache.Indices + cache.IndexCount, std::uint64_t{ 0u });
+        });
+
+        if (!checksum) spdlog::warn("[Benchmarks]:   The mesh cache was never read!");
+    }
+
+    std::error_code error{};
+    std::filesystem::remove(GetMeshCachePath(path), error);
+
+    spdlog::info("[Benchmarks]:   {} vertices, {} indices", vertexCount, indexCount);
+    spdlog::info("[Benchmarks]:   cold, parse + write    {:8.1f} ms", coldTime);
+    spdlog::info("[Benchmarks]:   warm, mapped cache     {:8.1f} ms ({:.1f}x)", warmTime, warmTime > 0.0 ? coldTime / warmTime : 0.0);
+}
@@ -0,0 +1,99 @@
+#include "Benchmark.hpp"
+
+#include <Crenderr/Application/RenderSystem.hpp>
+
+#include <entt/entt.hpp>
+
+#include <glm/glm.hpp>
+
+#include <random>
+
+namespace Internal
+{
+    constexpr std::size_t c_RenderableCount{ 250'000u };
+
+    // Lights, cameras and empties have a transform too, they sit in between the renderables of the transform pool.
+    constexpr std::size_t c_TransformOnlyCount{ 50'000u };
+
+    constexpr std::uint32_t c_MeshCount{ 8u };
+    constexpr std::uint32_t c_MaterialCount{ 4u };
+
+    // Same entities in the same order every time, renderables interleaved with transform only entities.
+    static void PopulateScene(entt::registry& registry)
+    {
+        std::mt19937 random{ 7u };
+        std::uniform_real_distribution<float> position{ -500.0f, 500.0f };
+        std::uniform_int_distribution<std::uint32_t> mesh{ 0u, Internal::c_MeshCount - 1u };
+        std::uniform_int_distribution<std::uint32_t> material{ 0u, Internal::c_MaterialCount - 1u };
+
+        const auto transformStep{ Internal::c_RenderableCount / Internal::c_TransformOnlyCount };
+        for (std::size_t i = 0u; i < Internal::c_RenderableCount; ++i)
+        {
+            if (i % transformStep == 0u)
+                registry.emplace<TransformComponent>(registry.create());
+
+            const auto entity{ registry.create() };
+            registry.emplace<TransformComponent>(entity, Renderer::Translation{ .Position = { position(random), position(random), position(random) }, });
+            registry.emplace<MeshRendererComponent>(entity, mesh(random));
+            registry.emplace<MaterialComponent>(entity, material(random), glm::vec3{ 1.0f });
+        }
+    }
+
+    // Stands in for the gather of RenderSystem::Submit(), every component read once.
+    struct GatherResult
+    {
+        Renderer::TranslationBatch Translations{};
+        std::uint64_t StateChecksum{ 0u };
+
+        inline void Gather(const MeshRendererComponent& mesh, const MaterialComponent& material, const TransformComponent& transform)
+        {
+            Translations.Push(transform.Translation);
+            StateChecksum += mesh.Mesh * Internal::c_MaterialCount + material.Material;
+        }
+    };
+}
+
+void BenchmarkSceneIteration()
+{
+    // A view over the three pools iterates the smallest one and looks the entity up in the other two.
+    entt::registry viewRegistry{};
+    Internal::PopulateScene(viewRegistry);
+
+    // The render system owns the group, so the three pools are packed and sorted by mesh and material.
+    entt::registry groupRegistry{};
+    RenderSystem system{ groupRegistry };
+    Internal::PopulateScene(groupRegistry);
+    system.Prepare(Renderer::MeshBounds{});
+
+    Internal::GatherResult viewResult{}, groupResult{};
+    const auto viewTime{ Benchmark::Measure(10u, [&viewRegistry, &viewResult]() {
+        viewResult.Translations.Clear();
+        viewResult.StateChecksum = 0u;
+        for (auto [entity, mesh, material, transform] : viewRegistry.view<MeshRendererComponent, MaterialComponent, TransformComponent>().each())
+            viewResult.Gather(mesh, material, transform);
+    }) };
+
+    const auto groupTime{ Benchmark::Measure(10u, [&groupRegistry, &groupResult]() {
+        groupResult.Translations.Clear();
+        groupResult.StateChecksum = 0u;
+        for (auto [entity, mesh, material, transform] : groupRegistry.group<MeshRendererComponent, MaterialComponent, TransformComponent>().each())
+            groupResult.Gather(mesh, material, transform);
+    }) };
+
+    // Patching one renderable's mesh puts the group out of order, Prepare() sorts it again and rebuilds the boxes.
+    const auto resortTime{ Benchmark::Measure(10u, [&groupRegistry, &system]() {
+        const auto entity{ *groupRegistry.group<MeshRendererComponent, MaterialComponent, TransformComponent>().begin() };
+        groupRegistry.patch<MeshRendererComponent>(entity, [](auto& mesh) { mesh.Mesh = (mesh.Mesh + 1u) % Internal::c_MeshCount; });
+        system.Prepare(Renderer::MeshBounds{});
+    }) };
+
+    if (viewResult.StateChecksum != groupResult.StateChecksum || viewResult.Translations.GetSize() != groupResult.Translations.GetSize())
+        spdlog::warn("[Benchmarks]:   The view and the group gathered different renderables!");
+
+    const auto count{ static_cast<double>(Internal::c_RenderableCount) };
+    spdlog::info("[Benchmarks]:   {} renderables, {} transform only entities", Internal::c_RenderableCount, Internal::c_TransformOnlyCount);
+    spdlog::info("[Benchmarks]:   view                   {:8.3f} ms {:8.1f} M/s", viewTime, Benchmark::GetRate(count, viewTime) / 1e6);
+    spdlog::info("[Benchmarks]:   owning group           {:8.3f} ms {:8.1f} M/s ({:.1f}x)", groupTime, Benchmark::GetRate(count, groupTime) / 1e6,
+        groupTime > 0.0 ? viewTime / groupTime : 0.0);
+    spdlog::info("[Benchmarks]:   one patch + Prepare()  {:8.3f} ms", resortTime);
+}
@@ -0,0 +1,113 @@
+#include "Benchmark.hpp"
+
+#include <Crenderr/Renderer/Backend/Shader.hpp>
+
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace Internal
+{
+    constexpr std::size_t c_UniformSetCount{ 100'000u };
+
+    // What a draw of the renderer sets, a few more than the five the flat shader needs.
+    constexpr std::array<std::string_view, 8u> c_UniformNames{
+        "u_Model", "u_Color", "u_ViewProjection", "u_DiffuseTexture",
+        "u_SpecularTexture", "u_EmissionTexture", "u_LightPosition", "u_LightColor",
+    };
+
+    // Stand-in driver, it links a program with the uniforms above and looks their names up with strcmp.
+    // It only makes the CPU side of both paths comparable, a real driver's lookup costs more.
+    namespace StubGL
+    {
+        static volatile GLint s_Sink{ 0 };
+
+        static GLuint APIENTRY CreateProgram() { return 1u; }
+        static void APIENTRY LinkProgram(GLuint) {}
+        static void APIENTRY DeleteProgram(GLuint) {}
+
+        static void APIENTRY GetProgramiv(GLuint, GLenum, GLint* params) { *params = GL_TRUE; }
+
+        static void APIENTRY GetProgramInterfaceiv(GLuint, GLenum, GLenum pname, GLint* params)
+        {
+            *params = pname == GL_ACTIVE_RESOURCES ? static_cast<GLint>(c_UniformNames.size()) : 32;
+        }
+
+        static void APIENTRY GetProgramResourceiv(GLuint, GLenum, GLuint index, GLsizei, const GLenum*, GLsizei, GLsizei*, GLint* params)
+        {
+            *params = static_cast<GLint>(index);
+        }
+
+        static void APIENTRY GetProgramResourceName(GLuint, GLenum, GLuint index, GLsizei bufferSize, GLsizei* length, GLchar* name)
+        {
+            const auto& source{ c_UniformNames[index] };
+            const auto size{ std::min<std::size_t>(source.size(), static_cast<std::size_t>(bufferSize)) };
+            std::memcpy(name, source.data(), size);
+            *length = static_cast<GLsizei>(size);
+        }
+
+        static GLint APIENTRY GetUniformLocation(GLuint, const GLchar* name)
+        {
+            for (std::size_t i = 0u; i < c_UniformNames.size(); ++i)
+                if (c_UniformNames[i] == name) return static_cast<GLint>(i);
+
+            return -1;
+        }
+
+        static void APIENTRY Uniform1i(GLint location, GLint value) { s_Sink = location + value; }
+
+        static void Install() noexcept
+        {
+            glad_glCreateProgram             = &CreateProgram;
+            glad_glLinkProgram               = &LinkProgram;
+            glad_glDeleteProgram             = &DeleteProgram;
+            glad_glGetProgramiv              = &GetProgramiv;
+            glad_glGetProgramInterfaceiv     = &GetProgramInterfaceiv;
+            glad_glGetProgramResourceiv      = &GetProgramResourceiv;
+            glad_glGetProgramResourceName    = &GetProgramResourceName;
+            glad_glGetUniformLocation        = &GetUniformLocation;
+            glad_glUniform1i                 = &Uniform1i;
+        }
+    }
+}
+
+void BenchmarkUniformCache()
+{
+    Internal::StubGL::Install();
+
+    Renderer::Shader shader{ Renderer::ShaderProps{} };
+    if (!shader.Link())
+    {
+        spdlog::error("[Benchmarks]:   Failed to link the stub program!");
+        return;
+    }
+
+    // Handles made once up front, the way the renderer keeps them in constexpr tables.
+    std::vector<Renderer::UniformHandle> handles{};
+    for (const auto name : Internal::c_UniformNames) handles.emplace_back(name);
+
+    // The old path, glGetUniformLocation() with the name on every set.
+    const auto lookupTime{ Benchmark::Measure(10u, [&shader]() {
+        for (std::size_t i = 0u; i < Internal::c_UniformSetCount; ++i)
+        {
+            const auto name{ Internal::c_UniformNames[i % Internal::c_UniformNames.size()] };
+            glUniform1i(glGetUniformLocation(shader.GetResourceHandle(), name.data()), static_cast<int>(i));
+        }
+    }) };
+
+    const auto nameTime{ Benchmark::Measure(10u, [&shader]() {
+        for (std::size_t i = 0u; i < Internal::c_UniformSetCount; ++i)
+            shader.SetUniform<int>(Internal::c_UniformNames[i % Internal::c_UniformNames.size()], static_cast<int>(i));
+    }) };
+
+    const auto handleTime{ Benchmark::Measure(10u, [&shader, &handles]() {
+        for (std::size_t i = 0u; i < Internal::c_UniformSetCount; ++i)
+            shader.SetUniform<int>(handles[i % handles.size()], static_cast<int>(i));
+    }) };
+
+    spdlog::info("[Benchmarks]:   {} uniform sets, {} uniforms, stub driver", Internal::c_UniformSetCount, Internal::c_UniformNames.size());
+    spdlog::info("[Benchmarks]:   glGetUniformLocation   {:8.3f} ms", lookupTime);
+    spdlog::info("[Benchmarks]:   cached, by name        {:8.3f} ms ({:.1f}x)", nameTime, nameTime > 0.0 ? lookupTime / nameTime : 0.0);
+    spdlog::info("[Benchmarks]:   cached, by handle      {:8.3f} ms ({:.1f}x)", handleTime, handleTime > 0.0 ? lookupTime / handleTime : 0.0);
+}
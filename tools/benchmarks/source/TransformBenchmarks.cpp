@@ -0,0 +1,118 @@
+#include "Benchmark.hpp"
+
+#include <Crenderr/Renderer/TransformBatch.hpp>
+#include <Crenderr/Renderer/TransformHierarchy.hpp>
+
+#include <random>
+#include <vector>
+
+namespace Internal
+{
+    constexpr std::size_t c_TransformCount{ 1'000'000u };
+
+    // 1000 roots, each with 9 children of 10 leaves, 100k nodes.
+    constexpr std::size_t c_RootCount{ 1'000u };
+    constexpr std::size_t c_ChildCount{ 9u };
+    constexpr std::size_t c_LeafCount{ 10u };
+
+    // What moves in a typical frame, characters and vehicles with everything attached to them.
+    constexpr std::size_t c_DirtyRootCount{ 100u };
+}
+
+void BenchmarkTransformBatch()
+{
+    std::mt19937 random{ 42u };
+    std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+    std::uniform_real_distribution<float> rotation{ -180.0f, 180.0f };
+    std::uniform_real_distribution<float> scale{ 0.5f, 2.0f };
+
+    Renderer::TranslationBatch batch{};
+    batch.Resize(Internal::c_TransformCount);
+    for (std::size_t i = 0u; i < Internal::c_TransformCount; ++i)
+    {
+        batch.Set(i, Renderer::Translation{
+            .Scale    = { scale(random), scale(random), scale(random), },
+            .Position = { position(random), position(random), position(random), },
+            .Rotation = { rotation(random), rotation(random), rotation(random), },
+        });
+    }
+
+    // Written the way the renderer writes them, straight into the instance array.
+    std::vector<Renderer::InstanceData> instances(Internal::c_TransformCount);
+
+    const auto glmTime{ Benchmark::Measure(5u, [&batch, &instances]() {
+        for (std::size_t i = 0u; i < instances.size(); ++i)
+            instances[i].ModelMatrix = batch.Get(i).ComposeModelMatrix();
+    }) };
+
+    spdlog::info("[Benchmarks]:   {} transforms, supported: {}", Internal::c_TransformCount, Benchmark::GetLevelName(Renderer::GetSupportedSimdLevel()));
+    spdlog::info("[Benchmarks]:   glm, 5 products        {:8.2f} ms {:8.1f} M/s", glmTime, Benchmark::GetRate(Internal::c_TransformCount, glmTime) / 1e6);
+
+    for (const auto level : { Renderer::SimdLevel::Scalar, Renderer::SimdLevel::SSE, Renderer::SimdLevel::AVX2 })
+    {
+        if (level > Renderer::GetSupportedSimdLevel()) continue;
+
+        const auto time{ Benchmark::Measure(5u, [&batch, &instances, level]() {
+            Renderer::ComposeModelMatrices(batch, &instances.front().ModelMatrix, sizeof(Renderer::InstanceData), level);
+        }) };
+
+        spdlog::info("[Benchmarks]:   closed form, {:6}    {:8.2f} ms {:8.1f} M/s ({:.1f}x)", Benchmark::GetLevelName(level), time,
+            Benchmark::GetRate(Internal::c_TransformCount, time) / 1e6, time > 0.0 ? glmTime / time : 0.0);
+    }
+}
+
+void BenchmarkTransformHierarchy()
+{
+    std::mt19937 random{ 42u };
+    std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+    std::uniform_real_distribution<float> rotation{ -180.0f, 180.0f };
+
+    const auto createTranslation{ [&]() {
+        return Renderer::Translation{ .Position = { position(random), position(random), position(random), }, .Rotation = { 0.0f, rotation(random), 0.0f, }, };
+    } };
+
+    // Depth first, so building only ever appends.
+    Renderer::TransformHierarchy hierarchy{};
+    std::vector<Renderer::NodeHandle> roots{};
+    const auto buildTime{ Benchmark::Measure(3u, [&]() {
+        hierarchy.Clear();
+        roots.clear();
+
+        for (std::size_t i = 0u; i < Internal::c_RootCount; ++i)
+        {
+            const auto root{ hierarchy.AddNode(createTranslation()) };
+            roots.push_back(root);
+
+            for (std::size_t j = 0u; j < Internal::c_ChildCount; ++j)
+            {
+                const auto child{ hierarchy.AddNode(createTranslation(), root) };
+                for (std::size_t k = 0u; k < Internal::c_LeafCount; ++k) hierarchy.AddNode(createTranslation(), child);
+            }
+        }
+    }) };
+    hierarchy.Update();
+
+    // Each run moves the roots somewhere else, so the work is never skipped.
+    std::size_t touched{ 0u };
+    const auto updateRoots{ [&](const std::size_t step) {
+        for (std::size_t i = 0u; i < roots.size(); i += step)
+            hierarchy.SetLocal(roots[i], createTranslation());
+
+        touched = hierarchy.Update();
+    } };
+
+    const auto fullTime{ Benchmark::Measure(10u, [&updateRoots]() { updateRoots(1u); }) };
+    const auto fullCount{ touched };
+
+    const auto partialTime{ Benchmark::Measure(10u, [&updateRoots]() { updateRoots(Internal::c_RootCount / Internal::c_DirtyRootCount); }) };
+    const auto partialCount{ touched };
+
+    const auto cleanTime{ Benchmark::Measure(10u, [&hierarchy, &touched]() { touched = hierarchy.Update(); }) };
+
+    spdlog::info("[Benchmarks]:   {} nodes, {} roots", hierarchy.GetSize(), roots.size());
+    spdlog::info("[Benchmarks]:   build                  {:8.3f} ms", buildTime);
+    spdlog::info("[Benchmarks]:   every root dirty       {:8.3f} ms {:8.1f} M/s, {} nodes", fullTime, Benchmark::GetRate(fullCount, fullTime) / 1e6, fullCount);
+    spdlog::info("[Benchmarks]:   {} roots dirty        {:8.3f} ms ({:.1f}x), {} nodes", Internal::c_DirtyRootCount, partialTime,
+        partialTime > 0.0 ? fullTime / partialTime : 0.0, partialCount);
+    spdlog::info("[Benchmarks]:   nothing dirty          {:8.3f} ms, {} nodes", cleanTime, touched);
+}
@@ -0,0 +1,182 @@
+#include <Crenderr/Renderer/BlockCompression.hpp>
+#include <Crenderr/Renderer/MipChain.hpp>
+#include <Crenderr/Renderer/Loaders/DDSFile.hpp>
+
+#include <spdlog/spdlog.h>
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Converts images into .dds files next to them, block compressed and with every mip level, which
+ * TextureStreamer and Texture2D then pick up in place of the originals:
+ *
+ *   crenderr-texture-compressor [--format auto|bc1|bc3|bc5|bc7] [--force] <image or directory>...
+ *
+ * Directories are walked recursively for .jpg, .jpeg, .png, .tga and .bmp files. Images whose .dds
+ * is newer than they are get skipped unless --force is given. The auto format takes BC1 for opaque
+ * images and BC7 for ones with alpha, bc7 is the better choice for color maps that can spare the
+ * memory, bc5 for normal maps.
+ */
+
+namespace Internal
+{
+    constexpr std::string_view c_Usage{ "Usage: crenderr-texture-compressor [--format auto|bc1|bc3|bc5|bc7] [--force] <image or directory>..." };
+
+    struct CompressorOptions
+    {
+        std::optional<Renderer::TextureFormat> Format{}; // none picks one per image
+        bool IsForced{ false };
+        std::vector<std::filesystem::path> Inputs{};
+    };
+
+    static std::optional<Renderer::TextureFormat> ParseFormat(const std::string_view name) noexcept
+    {
+        if (name == "bc1") return Renderer::TextureFormat::BC1;
+        if (name == "bc3") return Renderer::TextureFormat::BC3;
+        if (name == "bc5") return Renderer::TextureFormat::BC5;
+        if (name == "bc7") return Renderer::TextureFormat::BC7;
+
+        return std::nullopt;
+    }
+
+    static std::string_view GetFormatName(const Renderer::TextureFormat format) noexcept
+    {
+        switch (format)
+        {
+        case Renderer::TextureFormat::BC1: return "BC1";
+        case Renderer::TextureFormat::BC3: return "BC3";
+        case Renderer::TextureFormat::BC5: return "BC5";
+        case Renderer::TextureFormat::BC7: return "BC7";
+        default:                           return "RGBA8";
+        }
+    }
+
+    static bool IsImageFile(const std::filesystem::path& path) noexcept
+    {
+        auto extension{ path.extension().string() };
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        return extension == ".jpg" || extension == ".jpeg" || extension == ".png" || extension == ".tga" || extension == ".bmp";
+    }
+
+    static bool ParseArguments(const int argc, char** argv, CompressorOptions& options) noexcept
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view argument{ argv[i] };
+
+            if (argument == "--force")
+            {
+                options.IsForced = true;
+            }
+            else if (argument == "--format" && i + 1 < argc)
+            {
+                const std::string_view name{ argv[++i] };
+                options.Format = Internal::ParseFormat(name);
+                if (!options.Format && name != "auto")
+                {
+                    spdlog::error("[TextureCompressor]: Unknown format: {}", name);
+                    return false;
+                }
+            }
+            else if (argument.starts_with("--"))
+            {
+                spdlog::error("[TextureCompressor]: Unknown option: {}", argument);
+                return false;
+            }
+            else options.Inputs.emplace_back(argument);
+        }
+
+        return !options.Inputs.empty();
+    }
+
+    static bool CompressTexture(const std::filesystem::path& path, const CompressorOptions& options) noexcept
+    {
+        const auto startTime{ std::chrono::steady_clock::now() };
+        const auto sourcePath{ path.string() };
+
+        if (!options.IsForced && !FindCompressedTexture(sourcePath).empty())
+        {
+            spdlog::info("[TextureCompressor]: Up to date: {}", sourcePath);
+            return true;
+        }
+
+        // Flipped like the runtime loaders flip the images they decode.
+        stbi_set_flip_vertically_on_load(1);
+
+        int width{}, height{}, channels{};
+        auto* pixels{ stbi_load(sourcePath.c_str(), &width, &height, &channels, STBI_rgb_alpha) };
+        if (!pixels)
+        {
+            spdlog::error("[TextureCompressor]: {}: {}", stbi_failure_reason() ? stbi_failure_reason() : "failed without any reason", sourcePath);
+            return false;
+        }
+
+        auto hasAlpha{ false };
+        if (channels == 2 || channels == 4)
+        {
+            const auto texelCount{ static_cast<std::size_t>(width) * height };
+            for (std::size_t i = 0u; i < texelCount && !hasAlpha; ++i)
+                hasAlpha = pixels[i * 4u + 3u] != 255u;
+        }
+
+        Renderer::MipChain levels{};
+        levels.Generate(pixels, { width, height, });
+        stbi_image_free(pixels);
+
+        const auto format{ options.Format.value_or(hasAlpha ? Renderer::TextureFormat::BC7 : Renderer::TextureFormat::BC1) };
+
+        Renderer::MipChain blocks{};
+        if (!Renderer::CompressMipChain(levels, format, blocks)) return false;
+
+        const auto compressedPath{ GetCompressedTexturePath(sourcePath) };
+        if (!WriteDDSFile(compressedPath, blocks)) return false;
+
+        const auto elapsed{ std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - startTime }.count() };
+        spdlog::info("[TextureCompressor]: {} ({}x{}) -> {}, {} with {} levels, {:.1f} MB -> {:.1f} MB in {:.0f} ms",
+            sourcePath, width, height, compressedPath, Internal::GetFormatName(format), blocks.GetLevelCount(),
+            levels.GetByteSize(0u, levels.GetLevelCount()) / (1024.0 * 1024.0), blocks.GetByteSize(0u, blocks.GetLevelCount()) / (1024.0 * 1024.0), elapsed);
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Internal::CompressorOptions options{};
+    if (!Internal::ParseArguments(argc, argv, options))
+    {
+        spdlog::info("{}", Internal::c_Usage);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::filesystem::path> images{};
+    for (const auto& input : options.Inputs)
+    {
+        std::error_code error{};
+        if (std::filesystem::is_directory(input, error))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator{ input, error })
+                if (entry.is_regular_file() && Internal::IsImageFile(entry.path())) images.push_back(entry.path());
+        }
+        else images.push_back(input);
+    }
+
+    // Stable output from run to run, the directory walk has no order.
+    std::sort(images.begin(), images.end());
+
+    std::size_t failures{ 0u };
+    for (const auto& image : images)
+        if (!Internal::CompressTexture(image, options)) ++failures;
+
+    if (failures) spdlog::error("[TextureCompressor]: {} of {} images failed", failures, images.size());
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}